@@ -2,6 +2,7 @@
 #define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_ABSTRACTWRITER_HPP
 
 #include "internal/common.hpp"
+#include "internal/TableCollective.hpp"
 #include "TagValue.hpp"
 #include "Schema.hpp"
 
@@ -9,12 +10,17 @@
 
 #include <QObject>
 #include <QQmlListProperty>
+#include <QVector>
 
 namespace cutehmi {
 namespace dataacquisition {
 
 /**
  * Abstract database writer.
+ *
+ * Writer resolves names of its tag values to tag ids up front, so that values can be passed to the database along with their
+ * ids. Tags are resolved in a single batch, once schema has been validated. Tag values, which are appended or renamed afterwards,
+ * are resolved by database tables, when their values are stored for the first time.
  */
 class CUTEHMI_DATAACQUISITION_API AbstractWriter:
 	public QObject,
@@ -53,8 +59,28 @@ class CUTEHMI_DATAACQUISITION_API AbstractWriter:
 	protected:
 		typedef QList<TagValue *> TagValueContainer;
 
+		typedef QVector<int> TagIdContainer;
+
 		const TagValueContainer & values() const;
 
+		/**
+		 * Get tag ids.
+		 * @return tag ids of values(). Ids are stored at the same indices as corresponding tag values. Ids of tags, which have not
+		 * been resolved yet, are set to 0.
+		 */
+		const TagIdContainer & tagIds() const;
+
+		/**
+		 * Set table collective. Table collective is used to resolve tag ids.
+		 * @param tableCollective table collective.
+		 */
+		void setTableCollective(internal::TableCollective * tableCollective);
+
+		/**
+		 * Resolve tag ids. Ids of all tags, which have not been resolved yet, are requested from the table collective at once.
+		 */
+		void resolveTagIds();
+
 		QState * createWaitingForDatabaseConnectedSate(QState * parent, ServiceStatuses * statuses = nullptr, QState * target = nullptr);
 
 		QState * createValidatingSchemaSate(QState * parent, ServiceStatuses * statuses = nullptr, QState * target = nullptr);
@@ -62,6 +88,8 @@ class CUTEHMI_DATAACQUISITION_API AbstractWriter:
 	private slots:
 		void onSchemaValidated(bool result);
 
+		void onTagsResolved(QStringList names, QVector<int> ids);
+
 	private:
 		static int ValueListCount(QQmlListProperty<TagValue> * property);
 
@@ -71,15 +99,20 @@ class CUTEHMI_DATAACQUISITION_API AbstractWriter:
 
 		static void ValuesListAppend(QQmlListProperty<TagValue> * property, TagValue * value);
 
+		void resetTagIds();
+
 		struct Members
 		{
 			TagValueContainer values;
+			TagIdContainer tagIds;
 			QQmlListProperty<TagValue> valueList;
 			Schema * schema;
+			internal::TableCollective * tableCollective;
 
 			Members(AbstractWriter * p_parent):
 				valueList(p_parent, & values, & AbstractWriter::ValuesListAppend, & AbstractWriter::ValueListCount, & AbstractWriter::ValueListAt, & AbstractWriter::ValueListClear),
-				schema(nullptr)
+				schema(nullptr),
+				tableCollective(nullptr)
 			{
 			}
 		};
@@ -7,17 +7,96 @@
 
 #include <cutehmi/services/Serviceable.hpp>
 
+#include <QTimer>
+#include <QVector>
+
 namespace cutehmi {
 namespace dataacquisition {
 
+/**
+ * Event writer. Writer records changes of tag values. Events are not written one by one; instead they are appended to a bounded
+ * queue, which is flushed to the database with a single insert per event table, once it collects @a flushSize events, once its
+ * oldest event gets older than @a flushInterval or when writer stops.
+ */
 class CUTEHMI_DATAACQUISITION_API EventWriter:
 	public AbstractWriter
 {
 		Q_OBJECT
 
 	public:
+		enum OverflowPolicy {
+			DROP_OLDEST,	///< When queue is full, the oldest event is discarded to make room for the new one.
+			DROP_NEWEST		///< When queue is full, new events are discarded.
+		};
+		Q_ENUM(OverflowPolicy)
+
+		static constexpr int INITIAL_QUEUE_CAPACITY = 4096;
+		static constexpr int INITIAL_FLUSH_SIZE = 256;
+		static constexpr int INITIAL_FLUSH_INTERVAL = 1000;
+		static constexpr OverflowPolicy INITIAL_OVERFLOW_POLICY = DROP_OLDEST;
+
+		/**
+		  Queue capacity. Maximal number of events, which can be queued before they are written to the database. When queue is full,
+		  events are discarded according to @a overflowPolicy.
+
+		  @assumption{cutehmi::dataacquisition::EventWriter-queueCapacity_greater_than_zero}
+		  Value of @a queueCapacity property should be greater than zero.
+		  */
+		Q_PROPERTY(int queueCapacity READ queueCapacity WRITE setQueueCapacity NOTIFY queueCapacityChanged)
+
+		/**
+		  Queue depth. Number of events, which are currently waiting in the queue.
+		  */
+		Q_PROPERTY(int queueDepth READ queueDepth NOTIFY queueDepthChanged)
+
+		/**
+		  Overflow policy. Determines which events are discarded, when queue is full.
+		  */
+		Q_PROPERTY(OverflowPolicy overflowPolicy READ overflowPolicy WRITE setOverflowPolicy NOTIFY overflowPolicyChanged)
+
+		/**
+		  Number of events, which have been discarded due to queue overflow.
+		  */
+		Q_PROPERTY(int droppedCount READ droppedCount NOTIFY droppedCountChanged)
+
+		/**
+		  Flush size. Queue is flushed as soon as it collects given number of events.
+
+		  @assumption{cutehmi::dataacquisition::EventWriter-flushSize_greater_than_zero}
+		  Value of @a flushSize property should be greater than zero.
+		  */
+		Q_PROPERTY(int flushSize READ flushSize WRITE setFlushSize NOTIFY flushSizeChanged)
+
+		/**
+		  Flush interval [ms]. Maximal time an event can wait in the queue, before queue is flushed.
+
+		  @assumption{cutehmi::dataacquisition::EventWriter-flushInterval_non_negative}
+		  Value of @a flushInterval property should be non-negative.
+		  */
+		Q_PROPERTY(int flushInterval READ flushInterval WRITE setFlushInterval NOTIFY flushIntervalChanged)
+
 		EventWriter(QObject * parent = nullptr);
 
+		int queueCapacity() const;
+
+		void setQueueCapacity(int queueCapacity);
+
+		int queueDepth() const;
+
+		OverflowPolicy overflowPolicy() const;
+
+		void setOverflowPolicy(OverflowPolicy overflowPolicy);
+
+		int droppedCount() const;
+
+		int flushSize() const;
+
+		void setFlushSize(int flushSize);
+
+		int flushInterval() const;
+
+		void setFlushInterval(int flushInterval);
+
 		virtual std::unique_ptr<ServiceStatuses> configureStarting(QState * starting) override;
 
 		virtual std::unique_ptr<ServiceStatuses> configureStarted(QState * active, const QState * idling, const QState * yielding) override;
@@ -40,21 +119,65 @@ class CUTEHMI_DATAACQUISITION_API EventWriter:
 
 		virtual std::unique_ptr<QAbstractTransition> transitionToIdling() const override;
 
+	public slots:
+		/**
+		 * Flush queue. Queued events are handed over to the database.
+		 */
+		void flush();
+
+	signals:
+		void queueCapacityChanged();
+
+		void queueDepthChanged();
+
+		void overflowPolicyChanged();
+
+		void droppedCountChanged();
+
+		void flushSizeChanged();
+
+		void flushIntervalChanged();
+
 	private slots:
 		void onSchemaChanged();
 
-		void insertEvent(TagValue * tag);
+		void insertEvent(int index);
 
 		void connectTagSignals();
 
 		void disconnectTagSignals();
 
 	private:
+		typedef QVector<internal::EventCollective::Event> EventsContainer;
+
 		std::unique_ptr<services::Serviceable::ServiceStatuses> configureStartingOrRepairing(QState * parent);
 
+		void resizeQueue(int capacity);
+
 		struct Members
 		{
 			internal::EventCollective dbCollective;
+			EventsContainer queue;	///< Ring buffer of queued events.
+			int queueHead;			///< Index of the oldest event in the ring buffer.
+			int queueDepth;
+			OverflowPolicy overflowPolicy;
+			int droppedCount;
+			bool overflowing;		///< Whether events have been discarded since last flush.
+			int flushSize;
+			QTimer flushTimer;
+
+			Members():
+				queue(INITIAL_QUEUE_CAPACITY),
+				queueHead(0),
+				queueDepth(0),
+				overflowPolicy(INITIAL_OVERFLOW_POLICY),
+				droppedCount(0),
+				overflowing(false),
+				flushSize(INITIAL_FLUSH_SIZE)
+			{
+				flushTimer.setSingleShot(true);
+				flushTimer.setInterval(INITIAL_FLUSH_INTERVAL);
+			}
 		};
 
 		MPtr<Members> m;
@@ -0,0 +1,194 @@
+#ifndef H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_HISTORYMODEL_HPP
+#define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_HISTORYMODEL_HPP
+
+#include "internal/common.hpp"
+#include "HistoryReader.hpp"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QTimer>
+
+namespace cutehmi {
+namespace dataacquisition {
+
+/**
+ * History model. Model exposes history of a tag within time range given by @a from and @a to properties.
+ *
+ * Time range is split into @a resolution buckets (typically a width of a chart in pixels), which are downsampled by HistoryReader.
+ * As long as bucket width does not change, model loads incrementally: when time range is panned, only the uncovered part is
+ * fetched from the database and rows, which have fallen out of the range, are removed. Changing bucket width (zooming) reloads
+ * the whole range.
+ */
+class CUTEHMI_DATAACQUISITION_API HistoryModel:
+	public QAbstractListModel
+{
+		Q_OBJECT
+		typedef QAbstractListModel Parent;
+
+	public:
+		enum Role {
+			OPEN_TIME_ROLE = Qt::UserRole,
+			CLOSE_TIME_ROLE,
+			OPEN_ROLE,
+			CLOSE_ROLE,
+			MIN_ROLE,
+			MAX_ROLE,
+			COUNT_ROLE
+		};
+
+		static constexpr int INITIAL_RESOLUTION = 1000;
+		static constexpr HistoryReader::Downsampling INITIAL_DOWNSAMPLING = HistoryReader::MIN_MAX;
+
+		/**
+		  Database schema.
+		  */
+		Q_PROPERTY(cutehmi::dataacquisition::Schema * schema READ schema WRITE setSchema NOTIFY schemaChanged)
+
+		/**
+		  Name of the tag.
+		  */
+		Q_PROPERTY(QString tagName READ tagName WRITE setTagName NOTIFY tagNameChanged)
+
+		/**
+		  Beginning of time range.
+		  */
+		Q_PROPERTY(QDateTime from READ from WRITE setFrom NOTIFY fromChanged)
+
+		/**
+		  End of time range.
+		  */
+		Q_PROPERTY(QDateTime to READ to WRITE setTo NOTIFY toChanged)
+
+		/**
+		  Resolution. Amount of buckets, which time range is downsampled to. Zero disables downsampling.
+
+		  @assumption{cutehmi::dataacquisition::HistoryModel-resolution_non_negative}
+		  Value of @a resolution property should be non-negative.
+		  */
+		Q_PROPERTY(int resolution READ resolution WRITE setResolution NOTIFY resolutionChanged)
+
+		/**
+		  Downsampling method.
+		  */
+		Q_PROPERTY(cutehmi::dataacquisition::HistoryReader::Downsampling downsampling READ downsampling WRITE setDownsampling NOTIFY downsamplingChanged)
+
+		/**
+		  Indicates that model is loading data.
+		  */
+		Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
+
+		HistoryModel(QObject * parent = nullptr);
+
+		Schema * schema() const;
+
+		void setSchema(Schema * schema);
+
+		QString tagName() const;
+
+		void setTagName(const QString & tagName);
+
+		QDateTime from() const;
+
+		void setFrom(const QDateTime & from);
+
+		QDateTime to() const;
+
+		void setTo(const QDateTime & to);
+
+		int resolution() const;
+
+		void setResolution(int resolution);
+
+		HistoryReader::Downsampling downsampling() const;
+
+		void setDownsampling(HistoryReader::Downsampling downsampling);
+
+		bool busy() const;
+
+		int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+
+		QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+
+		QHash<int, QByteArray> roleNames() const override;
+
+	public slots:
+		/**
+		 * Reload whole time range.
+		 */
+		void reload();
+
+	signals:
+		void schemaChanged();
+
+		void tagNameChanged();
+
+		void fromChanged();
+
+		void toChanged();
+
+		void resolutionChanged();
+
+		void downsamplingChanged();
+
+		void busyChanged();
+
+	private slots:
+		void update();
+
+		void onSamplesRead(int request, cutehmi::dataacquisition::HistoryReader::SamplesContainer samples);
+
+	private:
+		struct Range
+		{
+			qint64 first;	///< Beginning of the range [ms since epoch].
+			qint64 last;	///< End of the range (exclusive) [ms since epoch].
+		};
+
+		typedef QHash<int, Range> RequestsContainer;
+
+		void scheduleUpdate();
+
+		void clear();
+
+		void fetch(qint64 first, qint64 last);
+
+		void trim(qint64 first, qint64 last);
+
+		int lowerBound(qint64 time) const;
+
+		struct Members
+		{
+			HistoryReader reader;
+			QString tagName;
+			QDateTime from;
+			QDateTime to;
+			int resolution;
+			HistoryReader::Downsampling downsampling;
+			HistoryReader::SamplesContainer samples;
+			Range loaded;			///< Time range covered by samples and pending requests.
+			qint64 bucketWidth;		///< Bucket width of loaded range [ms] or -1 if range has to be reloaded.
+			RequestsContainer requests;	///< Ranges of pending requests. Replies to requests, which are not listed here, are discarded.
+			QTimer updateTimer;
+
+			Members():
+				resolution(INITIAL_RESOLUTION),
+				downsampling(INITIAL_DOWNSAMPLING),
+				loaded{0, 0},
+				bucketWidth(-1)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,122 @@
+#ifndef H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_HISTORYREADER_HPP
+#define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_HISTORYREADER_HPP
+
+#include "internal/common.hpp"
+#include "DataObject.hpp"
+#include "Schema.hpp"
+
+#include <QDateTime>
+#include <QVector>
+
+namespace cutehmi {
+namespace dataacquisition {
+
+/**
+ * History reader. Reader fetches history of a tag asynchronously, on the database thread.
+ *
+ * Time range can be downsampled into buckets of given width. Buckets are aligned to multiples of their width since Unix epoch, so
+ * that adjacent time ranges can be fetched separately without splitting buckets. With MIN_MAX method each bucket is aggregated
+ * by the database into a single candle, which preserves extreme values. LTTB (Largest-Triangle-Three-Buckets) selects candles,
+ * which best preserve visual shape of close values. LTTB can not be expressed in SQL, so raw candles are fetched and downsampled
+ * on the database thread.
+ *
+ * Values of all types are converted to double.
+ */
+class CUTEHMI_DATAACQUISITION_API HistoryReader:
+	public DataObject
+{
+		Q_OBJECT
+
+	public:
+		/**
+		 * Downsampling method.
+		 */
+		enum Downsampling {
+			NONE,		///< Raw candles are fetched.
+			MIN_MAX,	///< Candles are aggregated per bucket by the database.
+			LTTB		///< Largest-Triangle-Three-Buckets. One candle is selected per bucket.
+		};
+		Q_ENUM(Downsampling)
+
+		/**
+		  Database schema.
+		  */
+		Q_PROPERTY(Schema * schema READ schema WRITE setSchema NOTIFY schemaChanged)
+
+		/**
+		 * Sample of history. Either a raw candle or an aggregate of candles, which fall into the same bucket.
+		 */
+		struct Sample
+		{
+			QDateTime openTime;
+			QDateTime closeTime;
+			double open = 0.0;
+			double close = 0.0;
+			double min = 0.0;
+			double max = 0.0;
+			int count = 0;	///< Amount of samples collected by the writer.
+		};
+
+		typedef QVector<Sample> SamplesContainer;
+
+		HistoryReader(QObject * parent = nullptr);
+
+		Schema * schema() const;
+
+		void setSchema(Schema * schema);
+
+		/**
+		 * Read history. Candles are selected by their open time.
+		 * @param tagName name of the tag.
+		 * @param from beginning of time range (inclusive).
+		 * @param to end of time range (exclusive).
+		 * @param bucketWidth width of a bucket [ms]. Zero disables downsampling.
+		 * @param downsampling downsampling method.
+		 * @return request identifier, which is passed to samplesRead() signal.
+		 */
+		int read(const QString & tagName, const QDateTime & from, const QDateTime & to, qint64 bucketWidth = 0, Downsampling downsampling = MIN_MAX);
+
+		/**
+		 * Downsample samples with Largest-Triangle-Three-Buckets algorithm. Close values are used as point values.
+		 * @param samples samples sorted by time.
+		 * @param threshold maximal amount of resulting samples.
+		 * @return downsampled samples. First and last sample are always preserved.
+		 */
+		static SamplesContainer LTTBDownsample(const SamplesContainer & samples, int threshold);
+
+	signals:
+		void schemaChanged();
+
+		/**
+		 * Samples have been read. Signal is emitted also if reading has failed, in which case @a samples is empty.
+		 * @param request request identifier returned by read().
+		 * @param samples samples sorted by time.
+		 */
+		void samplesRead(int request, cutehmi::dataacquisition::HistoryReader::SamplesContainer samples);
+
+	private:
+		static QString SourceQuery(const QString & driverName, const QString & schemaName, int tagId, const QDateTime & from, const QDateTime & to);
+
+		static QString BucketExpression(const QString & driverName, qint64 bucketWidth);
+
+		struct Members
+		{
+			Schema * schema = nullptr;
+			int requestCounter = 0;
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+
+Q_DECLARE_METATYPE(cutehmi::dataacquisition::HistoryReader::Sample)
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -107,19 +107,14 @@ class CUTEHMI_DATAACQUISITION_API HistoryWriter:
 	private:
 		std::unique_ptr<ServiceStatuses> configureStartingOrRepairing(QState * parent);
 
-		void addIntSample(const QString & tagName, int value);
-
-		void addBoolSample(const QString & tagName, bool value);
-
-		void addRealSample(const QString & tagName, double value);
-
 		void clearData();
 
 		template <typename T>
-		void addSample(T value, typename internal::HistoryTable<T>::Tuple & tuple);
+		void addSample(T value, int index, typename internal::HistoryTable<T>::TuplesContainer & tuples);
 
 		struct Members
 		{
+			// Candles are stored at the same indices as corresponding tag values.
 			internal::HistoryTable<int>::TuplesContainer intTuples;
 			internal::HistoryTable<bool>::TuplesContainer boolTuples;
 			internal::HistoryTable<double>::TuplesContainer realTuples;
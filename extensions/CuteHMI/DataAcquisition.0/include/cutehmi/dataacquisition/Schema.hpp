@@ -4,11 +4,24 @@
 #include "internal/common.hpp"
 #include "DataObject.hpp"
 
+#include <QTimer>
+#include <QDate>
+#include <QSet>
+#include <QMutex>
+
 namespace cutehmi {
 namespace dataacquisition {
 
 /**
  * Database schema.
+ *
+ * History and event tables are partitioned by time. PostgreSQL tables are declaratively partitioned by range of their time column
+ * (`open_time` for history and `time` for events). Rows, which do not fall into any partition, land in default partition. SQLite
+ * does not support partitioning, thus rolling tables are used instead. Rows are written to the base table and those, which are
+ * older than current partition period, are moved to archive tables by maintenance job. Union of base and archive tables is exposed
+ * through a view with `_all` suffix (e.g. `[schema.history_int_all]`).
+ *
+ * Partitions are maintained by maintain() slot, which is called periodically, once schema has been successfully validated.
  */
 class CUTEHMI_DATAACQUISITION_API Schema:
 	public DataObject
@@ -16,6 +29,21 @@ class CUTEHMI_DATAACQUISITION_API Schema:
 		Q_OBJECT
 
 	public:
+		/**
+		 * Partition period.
+		 */
+		enum PartitionPeriod {
+			DAY,	///< Daily partitions.
+			WEEK,	///< Weekly partitions. Weeks start on Monday.
+			MONTH	///< Monthly partitions.
+		};
+		Q_ENUM(PartitionPeriod)
+
+		static constexpr PartitionPeriod INITIAL_PARTITION_PERIOD = MONTH;
+		static constexpr int INITIAL_PARTITIONS_AHEAD = 2;
+		static constexpr int INITIAL_PARTITION_RETENTION = 0;
+		static constexpr int INITIAL_MAINTENANCE_INTERVAL = 3600000;
+
 		/**
 		  Schema name.
 		  */
@@ -26,6 +54,37 @@ class CUTEHMI_DATAACQUISITION_API Schema:
 		  */
 		Q_PROPERTY(QString user READ user WRITE setUser NOTIFY userChanged)
 
+		/**
+		  Partition period. Determines time range covered by a single partition. Period should not be changed once partitions have
+		  been created, because ranges of new partitions could overlap existing ones.
+		  */
+		Q_PROPERTY(PartitionPeriod partitionPeriod READ partitionPeriod WRITE setPartitionPeriod NOTIFY partitionPeriodChanged)
+
+		/**
+		  Amount of partitions created ahead of current one. Applies to PostgreSQL only.
+
+		  @assumption{cutehmi::dataacquisition::Schema-partitionsAhead_non_negative}
+		  Value of @a partitionsAhead property should be non-negative.
+		  */
+		Q_PROPERTY(int partitionsAhead READ partitionsAhead WRITE setPartitionsAhead NOTIFY partitionsAheadChanged)
+
+		/**
+		  Partition retention. Amount of past partitions, which are kept. Older partitions are dropped along with their data. Zero
+		  means that partitions are kept forever.
+
+		  @assumption{cutehmi::dataacquisition::Schema-partitionRetention_non_negative}
+		  Value of @a partitionRetention property should be non-negative.
+		  */
+		Q_PROPERTY(int partitionRetention READ partitionRetention WRITE setPartitionRetention NOTIFY partitionRetentionChanged)
+
+		/**
+		  Maintenance interval [ms]. Determines how often partitions are maintained. Zero disables automatic maintenance.
+
+		  @assumption{cutehmi::dataacquisition::Schema-maintenanceInterval_non_negative}
+		  Value of @a maintenanceInterval property should be non-negative.
+		  */
+		Q_PROPERTY(int maintenanceInterval READ maintenanceInterval WRITE setMaintenanceInterval NOTIFY maintenanceIntervalChanged)
+
 		explicit Schema(QObject * parent = nullptr);
 
 		QString name() const;
@@ -36,11 +95,50 @@ class CUTEHMI_DATAACQUISITION_API Schema:
 
 		void setUser(const QString & user);
 
+		PartitionPeriod partitionPeriod() const;
+
+		void setPartitionPeriod(PartitionPeriod partitionPeriod);
+
+		int partitionsAhead() const;
+
+		void setPartitionsAhead(int partitionsAhead);
+
+		int partitionRetention() const;
+
+		void setPartitionRetention(int partitionRetention);
+
+		int maintenanceInterval() const;
+
+		void setMaintenanceInterval(int maintenanceInterval);
+
+		/**
+		 * Get start of partition period.
+		 * @param date date.
+		 * @param period partition period.
+		 * @return first day of partition period, which given date belongs to.
+		 */
+		static QDate PeriodStart(const QDate & date, PartitionPeriod period);
+
+		/**
+		 * Add partition periods.
+		 * @param date first day of partition period.
+		 * @param period partition period.
+		 * @param count amount of periods to add. Can be negative.
+		 * @return first day of resulting partition period.
+		 */
+		static QDate AddPeriods(const QDate & date, PartitionPeriod period, int count);
+
 	public slots:
 		void create();
 
 		void drop();
 
+		/**
+		 * Maintain partitions. PostgreSQL partitions are created ahead of time and SQLite rows older than current partition period
+		 * are moved to archive tables. Partitions exceeding retention are dropped.
+		 */
+		void maintain();
+
 		/**
 		 * Validate schema. Validation is performed asynchronously. Validation status can be determined by connecting to validated()
 		 * signal and examining its @a result parameter.
@@ -52,23 +150,60 @@ class CUTEHMI_DATAACQUISITION_API Schema:
 
 		void userChanged();
 
+		void partitionPeriodChanged();
+
+		void partitionsAheadChanged();
+
+		void partitionRetentionChanged();
+
+		void maintenanceIntervalChanged();
+
 		void validated(bool result);
 
+	private slots:
+		void onValidated(bool result);
+
 	private:
 		static constexpr const char * SQL_SCRIPTS_SUBDIR = "sql";
 		static constexpr const char * POSTGRESQL_SCRIPTS_SUBDIR = "postgres";
 		static constexpr const char * SQLITE_SCRIPTS_SUBDIR = "sqlite";
+		static constexpr int MAX_SQLITE_ARCHIVES = 499;	///< Maximal amount of archive tables in a view (SQLite limits compound select to 500 terms).
 
 		bool validatePostgresTable(const QString & tableName, QSqlQuery & query);
 
 		bool validateSqliteTable(const QString & tableName, QSqlQuery & query);
 
+		bool maintainPartitions(QSqlDatabase & db);
+
+		bool maintainPostgresTable(const QString & tableName, const QString & timeColumn, QSqlDatabase & db);
+
+		bool maintainSqliteTable(const QString & tableName, const QString & timeColumn, QSqlDatabase & db);
+
+		QString partitionName(const QString & tableName, const QDate & start) const;
+
+		QDate partitionStart(const QString & tableName, const QString & partitionName) const;
+
 		QString readScript(const QString & dbms, const QString & scriptName) const;
 
 		struct Members
 		{
 			QString name;
 			QString user;
+			PartitionPeriod partitionPeriod;
+			int partitionsAhead;
+			int partitionRetention;
+			int maintenanceInterval;
+			QTimer maintenanceTimer;
+			QSet<QString> unpartitionedTables;	///< Tables, which have been reported as not partitioned.
+			QMutex unpartitionedTablesMutex;
+
+			Members():
+				partitionPeriod(INITIAL_PARTITION_PERIOD),
+				partitionsAhead(INITIAL_PARTITIONS_AHEAD),
+				partitionRetention(INITIAL_PARTITION_RETENTION),
+				maintenanceInterval(INITIAL_MAINTENANCE_INTERVAL)
+			{
+			}
 		};
 
 		MPtr<Members> m;
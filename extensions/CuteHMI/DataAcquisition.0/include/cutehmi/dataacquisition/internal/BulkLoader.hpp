@@ -0,0 +1,137 @@
+#ifndef H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_INTERNAL_BULKLOADER_HPP
+#define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_INTERNAL_BULKLOADER_HPP
+
+#include "common.hpp"
+
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QStringList>
+#include <QVariantList>
+#include <QList>
+
+namespace cutehmi {
+namespace dataacquisition {
+namespace internal {
+
+/**
+ * Bulk loader. Loader inserts many rows into a table at once, using the fastest method available for given database connection.
+ *
+ * With PostgreSQL rows are streamed using COPY protocol, provided that extension has been built against libpq client library
+ * (CUTEHMI_DATAACQUISITION_LIBPQ is defined). Otherwise rows are inserted with multi-row `INSERT ... VALUES` statements, which are
+ * split into chunks, so that they do not exceed limit of bound parameters. All the statements are executed within a single
+ * transaction.
+ *
+ * Method can be chosen explicitly, which allows to compare methods against each other. Default method can be overriden with
+ * `CUTEHMI_DATAACQUISITION_BULK_METHOD` environmental variable, which accepts `auto`, `copy-binary`, `copy-text`, `values` and
+ * `batch` values. Time spent on loading rows is logged as debug output.
+ *
+ * Loader is meant to be used from within database worker task.
+ */
+class CUTEHMI_DATAACQUISITION_PRIVATE BulkLoader
+{
+	public:
+		enum Method {
+			AUTO,			///< Binary COPY if available, multi-row VALUES otherwise.
+			COPY_BINARY,	///< COPY protocol with binary format (PostgreSQL only).
+			COPY_TEXT,		///< COPY protocol with text format (PostgreSQL only).
+			VALUES,			///< Multi-row `INSERT ... VALUES` statements.
+			BATCH			///< Prepared statement executed with QSqlQuery::execBatch(). Most drivers emulate it with one statement per row.
+		};
+
+		static constexpr int MAX_PARAMETERS = 999;	///< Maximal amount of parameters bound to single statement (default limit of SQLite prior to 3.32).
+		static constexpr int MAX_ROWS = 1000;	///< Maximal amount of rows inserted with single multi-row statement.
+		static constexpr int COPY_BUFFER_SIZE = 65536;	///< Size of buffer [B], after which COPY data is sent to the server.
+
+		/**
+		 * Constructor.
+		 * @param db database connection.
+		 * @param schemaName name of the schema.
+		 * @param tableName name of the table.
+		 * @param columns names of the columns, which are going to be loaded.
+		 */
+		BulkLoader(QSqlDatabase & db, const QString & schemaName, const QString & tableName, const QStringList & columns);
+
+		/**
+		 * Set conflict target. If conflict target is set, rows, which conflict with existing ones, update them instead of being
+		 * inserted (upsert). All columns, except the ones forming conflict target, are updated.
+		 * @param columns columns forming conflict target. Empty list disables upsert.
+		 */
+		void setConflictTarget(const QStringList & columns);
+
+		/**
+		 * Load rows.
+		 * @param values column values. Each list holds values of subsequent column. All lists must be of the same size.
+		 * @param method loading method. If requested method is not available for given database connection, then loader falls back
+		 * to multi-row VALUES statements.
+		 * @return @p true if rows have been loaded successfully, @p false otherwise, in which case lastError() can be used to
+		 * obtain details.
+		 */
+		bool load(const QList<QVariantList> & values, Method method = DefaultMethod());
+
+		/**
+		 * Get last error.
+		 * @return last error.
+		 */
+		QSqlError lastError() const;
+
+		/**
+		 * Get default method.
+		 * @return method determined by `CUTEHMI_DATAACQUISITION_BULK_METHOD` environmental variable or AUTO if variable is not set.
+		 */
+		static Method DefaultMethod();
+
+		/**
+		 * Check if COPY protocol is supported.
+		 * @return @p true if extension has been built with libpq client library, @p false otherwise.
+		 */
+		static bool CopySupported();
+
+	private:
+		Method resolve(Method method) const;
+
+		bool loadCopy(const QList<QVariantList> & values, bool binary);
+
+		bool loadValues(const QList<QVariantList> & values);
+
+		bool loadBatch(const QList<QVariantList> & values);
+
+		bool execValues(const QList<QVariantList> & values, int first, int count);
+
+		QString qualifiedTableName() const;
+
+		QString columnList() const;
+
+		QString conflictClause() const;
+
+		void setError(const QSqlError & error);
+
+		static QByteArray CopyText(const QVariant & value);
+
+		static void AppendCopyBinary(QByteArray & buffer, const QVariant & value);
+
+		static const char * MethodName(Method method);
+
+		struct Members
+		{
+			QSqlDatabase & db;
+			QString schemaName;
+			QString tableName;
+			QStringList columns;
+			QStringList conflictTarget;
+			QSqlError lastError;
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
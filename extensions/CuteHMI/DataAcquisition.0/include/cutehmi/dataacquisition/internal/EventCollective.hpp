@@ -2,15 +2,15 @@
 #define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_INTERNAL_EVENTCOLLECTIVE_HPP
 
 #include "common.hpp"
-#include "TagCache.hpp"
 #include "EventTable.hpp"
 #include "TableCollective.hpp"
 
+#include <QVariant>
+#include <QDateTime>
+#include <QVector>
+
 namespace cutehmi {
 namespace dataacquisition {
-
-class TagValue;
-
 namespace internal {
 
 class CUTEHMI_DATAACQUISITION_PRIVATE EventCollective:
@@ -19,20 +19,36 @@ class CUTEHMI_DATAACQUISITION_PRIVATE EventCollective:
 		Q_OBJECT
 
 	public:
+		/**
+		 * Event. Event captures value of a tag at the moment it has changed.
+		 */
+		struct Event
+		{
+			int tagId = 0;	///< Tag id or 0 if tag has not been resolved yet.
+			QString tagName;
+			QVariant value;
+			QDateTime time;
+		};
+
+		typedef QVector<Event> EventsContainer;
+
 		EventCollective();
 
-		void insert(const TagValue & tag);
+		/**
+		 * Insert events. Events are split by their value types and each event table receives its share with a single insert.
+		 * @param events events to be inserted.
+		 */
+		void insert(const EventsContainer & events);
 
 	protected:
 		void updateSchema(Schema * schema) override;
 
 	private:
 		template <typename T>
-		void insertIntoTable(const TagValue & tag, std::unique_ptr<EventTable<T>> & table);
+		void insertIntoTable(const typename EventTable<T>::TuplesContainer & tuples, std::unique_ptr<EventTable<T>> & table);
 
 		struct Members
 		{
-			std::unique_ptr<TagCache> tagCache;
 			std::unique_ptr<EventTable<int>> eventInt;
 			std::unique_ptr<EventTable<bool>> eventBool;
 			std::unique_ptr<EventTable<double>> eventReal;
@@ -5,8 +5,9 @@
 #include "TableObject.hpp"
 #include "TagCache.hpp"
 #include "TableNameTraits.hpp"
+#include "BulkLoader.hpp"
 
-#include <QHash>
+#include <QVector>
 
 namespace cutehmi {
 namespace dataacquisition {
@@ -21,15 +22,33 @@ class  EventTable:
 
 		struct Tuple
 		{
+			int tagId = 0;	///< Tag id or 0 if tag has not been resolved yet, in which case it is resolved by its name.
+			QString tagName;
 			T value = T();
 			QDateTime time;
 		};
 
+		typedef QVector<Tuple> TuplesContainer;
+
 		EventTable(TagCache * tagCache, Schema * schema, QObject * parent = nullptr);
 
-		void insert(const QString & tagName, const Tuple & tuple);
+		/**
+		 * Insert events. All the events are inserted by a single database worker with a BulkLoader.
+		 * @param tuples events to be inserted.
+		 */
+		void insert(const TuplesContainer & tuples);
 
 	protected:
+		struct ColumnValues
+		{
+			QVariantList tagId;
+			QStringList tagName;
+			QVariantList value;
+			QVariantList time;
+
+			ColumnValues(const TuplesContainer & tuples);
+		};
+
 		TagCache * tagCache() const;
 
 	private:
@@ -49,40 +68,35 @@ EventTable<T>::EventTable(TagCache * tag, Schema * schema, QObject * parent):
 }
 
 template <typename T>
-void EventTable<T>::insert(const QString & tagName, const EventTable<T>::Tuple & tuple)
+void EventTable<T>::insert(const EventTable<T>::TuplesContainer & tuples)
 {
+	ColumnValues columnValues(tuples);
 	QString tableName = TableNameTraits<T>::Affixed("event");
 
-	worker([this, tagName, tuple, tableName](QSqlDatabase & db) {
-		if (db.driverName() == "QPSQL") {
-			QSqlQuery query(db);
-			CUTEHMI_DEBUG("Storing '" << tableName << "' values...");
-
-			query.prepare(QString("INSERT INTO %1.%2(tag_id, value, time) VALUES (:tagId, :value, :time)").arg(schema()->name()).arg(tableName));
-			query.bindValue(":tagId", tagCache()->getId(tagName, db));
-			query.bindValue(":value", tuple.value);
-			query.bindValue(":time", tuple.time);
-			query.exec();
-
-			pushError(query.lastError());
-			query.finish();
-		} else if (db.driverName() == "QSQLITE") {
-			QSqlQuery query(db);
-			CUTEHMI_DEBUG("Storing '" << tableName << "' values...");
-
-			query.prepare(QString("INSERT INTO [%1.%2](tag_id, value, time) VALUES (:tagId, :value, :time)").arg(schema()->name()).arg(tableName));
-			query.bindValue(":tagId", tagCache()->getId(tagName, db));
-			query.bindValue(":value", tuple.value);
-			query.bindValue(":time", tuple.time);
-			query.exec();
-
-			pushError(query.lastError());
-			query.finish();
+	worker([this, columnValues, tableName](QSqlDatabase & db) {
+		if (db.driverName() == "QPSQL" || db.driverName() == "QSQLITE") {
+			CUTEHMI_DEBUG("Storing " << columnValues.tagId.count() << " '" << tableName << "' values...");
+			QVariantList tagIds = tagCache()->completeIds(columnValues.tagId, columnValues.tagName, db);
+
+			BulkLoader loader(db, schema()->name(), tableName, {"tag_id", "value", "time"});
+			if (!loader.load({tagIds, columnValues.value, columnValues.time}))
+				pushError(loader.lastError());
 		} else
 			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
 	})->work();
 }
 
+template <typename T>
+EventTable<T>::ColumnValues::ColumnValues(const EventTable<T>::TuplesContainer & tuples)
+{
+	for (typename EventTable<T>::TuplesContainer::const_iterator it = tuples.begin(); it != tuples.end(); ++it) {
+		tagId.append(it->tagId);
+		tagName.append(it->tagName);
+		value.append(it->value);
+		time.append(it->time);
+	}
+}
+
 template <typename T>
 TagCache * EventTable<T>::tagCache() const
 {
@@ -2,7 +2,6 @@
 #define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_INTERNAL_HISTORYCOLLECTIVE_HPP
 
 #include "common.hpp"
-#include "TagCache.hpp"
 #include "HistoryTable.hpp"
 #include "TableCollective.hpp"
 
@@ -33,7 +32,6 @@ class CUTEHMI_DATAACQUISITION_PRIVATE HistoryCollective:
 
 		struct Members
 		{
-			std::unique_ptr<TagCache> tagCache;
 			std::unique_ptr<HistoryTable<int>> historyInt;
 			std::unique_ptr<HistoryTable<bool>> historyBool;
 			std::unique_ptr<HistoryTable<double>> historyReal;
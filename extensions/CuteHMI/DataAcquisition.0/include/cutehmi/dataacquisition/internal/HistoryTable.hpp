@@ -5,8 +5,9 @@
 #include "TableObject.hpp"
 #include "TagCache.hpp"
 #include "TableNameTraits.hpp"
+#include "BulkLoader.hpp"
 
-#include <QHash>
+#include <QVector>
 
 #include <limits>
 
@@ -23,6 +24,8 @@ class HistoryTable:
 
 		struct Tuple
 		{
+			int tagId = 0;	///< Tag id or 0 if tag has not been resolved yet, in which case it is resolved by its name.
+			QString tagName;
 			T open = T();
 			T close = T();
 			T min = std::numeric_limits<T>::max();
@@ -32,15 +35,20 @@ class HistoryTable:
 			int count = 0;
 		};
 
-		typedef QHash<QString, Tuple> TuplesContainer;
+		typedef QVector<Tuple> TuplesContainer;
 
 		HistoryTable(TagCache * tagCache, Schema * schema, QObject * parent = nullptr);
 
+		/**
+		 * Insert candles.
+		 * @param tuples candles to be inserted. Tuples with @a count equal to zero are skipped.
+		 */
 		void insert(const TuplesContainer & tuples);
 
 	protected:
 		struct ColumnValues
 		{
+			QVariantList tagId;
 			QStringList tagName;
 			QVariantList open;
 			QVariantList close;
@@ -78,46 +86,13 @@ void HistoryTable<T>::insert(const HistoryTable<T>::TuplesContainer & tuples)
 	QString tableName = TableNameTraits<T>::Affixed("history");
 
 	worker([this, columnValues, tableName](QSqlDatabase & db) {
-		if (db.driverName() == "QPSQL") {
-			QSqlQuery query(db);
-			CUTEHMI_DEBUG("Storing '" << tableName << "' values...");
-			QVariantList tagIds;
-			for (QStringList::const_iterator tagName = columnValues.tagName.begin(); tagName != columnValues.tagName.end(); ++tagName)
-				tagIds.append(tagCache()->getId(*tagName, db));
-
-			query.prepare(QString("INSERT INTO %1.%2(tag_id, open, close, min, max, open_time, close_time, count) VALUES (:tagId, :open, :close, :min, :max, :open_time, :close_time, :count)").arg(schema()->name()).arg(tableName));
-			query.bindValue(":tagId", tagIds);
-			query.bindValue(":open", columnValues.open);
-			query.bindValue(":close", columnValues.close);
-			query.bindValue(":min", columnValues.min);
-			query.bindValue(":max", columnValues.max);
-			query.bindValue(":open_time", columnValues.openTime);
-			query.bindValue(":close_time", columnValues.closeTime);
-			query.bindValue(":count", columnValues.count);
-			query.execBatch();
-
-			pushError(query.lastError());
-			query.finish();
-		} else if (db.driverName() == "QSQLITE") {
-			QSqlQuery query(db);
-			CUTEHMI_DEBUG("Storing '" << tableName << "' values...");
-			QVariantList tagIds;
-			for (QStringList::const_iterator tagName = columnValues.tagName.begin(); tagName != columnValues.tagName.end(); ++tagName)
-				tagIds.append(tagCache()->getId(*tagName, db));
-
-			query.prepare(QString("INSERT INTO [%1.%2](tag_id, open, close, min, max, open_time, close_time, count) VALUES (:tagId, :open, :close, :min, :max, :open_time, :close_time, :count)").arg(schema()->name()).arg(tableName));
-			query.bindValue(":tagId", tagIds);
-			query.bindValue(":open", columnValues.open);
-			query.bindValue(":close", columnValues.close);
-			query.bindValue(":min", columnValues.min);
-			query.bindValue(":max", columnValues.max);
-			query.bindValue(":open_time", columnValues.openTime);
-			query.bindValue(":close_time", columnValues.closeTime);
-			query.bindValue(":count", columnValues.count);
-			query.execBatch();
-
-			pushError(query.lastError());
-			query.finish();
+		if (db.driverName() == "QPSQL" || db.driverName() == "QSQLITE") {
+			CUTEHMI_DEBUG("Storing " << columnValues.tagId.count() << " '" << tableName << "' values...");
+			QVariantList tagIds = tagCache()->completeIds(columnValues.tagId, columnValues.tagName, db);
+
+			BulkLoader loader(db, schema()->name(), tableName, {"tag_id", "open", "close", "min", "max", "open_time", "close_time", "count"});
+			if (!loader.load({tagIds, columnValues.open, columnValues.close, columnValues.min, columnValues.max, columnValues.openTime, columnValues.closeTime, columnValues.count}))
+				pushError(loader.lastError());
 		} else
 			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
 	})->work();
@@ -127,7 +102,11 @@ template <typename T>
 HistoryTable<T>::ColumnValues::ColumnValues(const HistoryTable<T>::TuplesContainer & tuples)
 {
 	for (typename HistoryTable<T>::TuplesContainer::const_iterator it = tuples.begin(); it != tuples.end(); ++it) {
-		tagName.append(it.key());
+		if (it->count == 0)
+			continue;
+
+		tagId.append(it->tagId);
+		tagName.append(it->tagName);
 		open.append(it->open);
 		close.append(it->close);
 		min.append(it->min);
@@ -2,7 +2,6 @@
 #define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_INTERNAL_RECENCYCOLLECTIVE_HPP
 
 #include "common.hpp"
-#include "TagCache.hpp"
 #include "RecencyTable.hpp"
 #include "TableCollective.hpp"
 
@@ -33,7 +32,6 @@ class CUTEHMI_DATAACQUISITION_PRIVATE RecencyCollective:
 
 		struct Members
 		{
-			std::unique_ptr<TagCache> tagCache;
 			std::unique_ptr<RecencyTable<int>> recencyInt;
 			std::unique_ptr<RecencyTable<bool>> recencyBool;
 			std::unique_ptr<RecencyTable<double>> recencyReal;
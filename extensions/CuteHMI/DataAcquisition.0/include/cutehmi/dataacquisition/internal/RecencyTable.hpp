@@ -5,10 +5,9 @@
 #include "TableObject.hpp"
 #include "TagCache.hpp"
 #include "TableNameTraits.hpp"
+#include "BulkLoader.hpp"
 
-#include <QHash>
-
-#include <limits>
+#include <QVector>
 
 namespace cutehmi {
 namespace dataacquisition {
@@ -23,11 +22,13 @@ class RecencyTable:
 
 		struct Tuple
 		{
+			int tagId = 0;	///< Tag id or 0 if tag has not been resolved yet, in which case it is resolved by its name.
+			QString tagName;
 			T value = T();
 			QDateTime time;
 		};
 
-		typedef QHash<QString, Tuple> TuplesContainer;
+		typedef QVector<Tuple> TuplesContainer;
 
 		RecencyTable(TagCache * tagCache, Schema * schema, QObject * parent = nullptr);
 
@@ -36,6 +37,7 @@ class RecencyTable:
 	protected:
 		struct ColumnValues
 		{
+			QVariantList tagId;
 			QStringList tagName;
 			QVariantList value;
 			QVariantList time;
@@ -68,38 +70,14 @@ void RecencyTable<T>::update(const RecencyTable<T>::TuplesContainer & tuples)
 	QString tableName = TableNameTraits<T>::Affixed("recency");
 
 	worker([this, columnValues, tableName](QSqlDatabase & db) {
-		if (db.driverName() == "QPSQL") {
-			QSqlQuery query(db);
-			CUTEHMI_DEBUG("Storing '" << tableName << "' values...");
-			QVariantList tagIds;
-			for (QStringList::const_iterator tagName = columnValues.tagName.begin(); tagName != columnValues.tagName.end(); ++tagName)
-				tagIds.append(tagCache()->getId(*tagName, db));
-
-			query.prepare(QString("INSERT INTO %1.%2 (tag_id, value, time) VALUES (:tagId, :value, :time)"
-							" ON CONFLICT (tag_id) DO UPDATE SET(value, time) = (:value, :time) WHERE %1.%2.tag_id = :tagId").arg(schema()->name()).arg(tableName));
-			query.bindValue(":tagId", tagIds);
-			query.bindValue(":value", columnValues.value);
-			query.bindValue(":time", columnValues.time);
-			query.execBatch();
-
-			pushError(query.lastError());
-			query.finish();
-		} else if (db.driverName() == "QSQLITE") {
-			QSqlQuery query(db);
-			CUTEHMI_DEBUG("Storing '" << tableName << "' values...");
-			QVariantList tagIds;
-			for (QStringList::const_iterator tagName = columnValues.tagName.begin(); tagName != columnValues.tagName.end(); ++tagName)
-				tagIds.append(tagCache()->getId(*tagName, db));
-
-			query.prepare(QString("INSERT INTO [%1.%2] (tag_id, value, time) VALUES (:tagId, :value, :time)"
-							" ON CONFLICT (tag_id) DO UPDATE SET(value, time) = (:value, :time)").arg(schema()->name()).arg(tableName));
-			query.bindValue(":tagId", tagIds);
-			query.bindValue(":value", columnValues.value);
-			query.bindValue(":time", columnValues.time);
-			query.execBatch();
-
-			pushError(query.lastError());
-			query.finish();
+		if (db.driverName() == "QPSQL" || db.driverName() == "QSQLITE") {
+			CUTEHMI_DEBUG("Storing " << columnValues.tagId.count() << " '" << tableName << "' values...");
+			QVariantList tagIds = tagCache()->completeIds(columnValues.tagId, columnValues.tagName, db);
+
+			BulkLoader loader(db, schema()->name(), tableName, {"tag_id", "value", "time"});
+			loader.setConflictTarget({"tag_id"});
+			if (!loader.load({tagIds, columnValues.value, columnValues.time}))
+				pushError(loader.lastError());
 		} else
 			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
 	})->work();
@@ -109,7 +87,8 @@ template <typename T>
 RecencyTable<T>::ColumnValues::ColumnValues(const RecencyTable<T>::TuplesContainer & tuples)
 {
 	for (typename RecencyTable<T>::TuplesContainer::const_iterator it = tuples.begin(); it != tuples.end(); ++it) {
-		tagName.append(it.key());
+		tagId.append(it->tagId);
+		tagName.append(it->tagName);
 		value.append(it->value);
 		time.append(it->time);
 	}
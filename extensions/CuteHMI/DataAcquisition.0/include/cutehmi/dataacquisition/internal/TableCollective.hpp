@@ -2,9 +2,14 @@
 #define H_EXTENSIONS_CUTEHMI_DATAACQUISITION_0_INCLUDE_CUTEHMI_DATAACQUISITION_INTERNAL_TABLECOLLECTIVE_HPP
 
 #include "common.hpp"
+#include "TagCache.hpp"
 #include "../Schema.hpp"
 
 #include <QObject>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
 
 namespace cutehmi {
 namespace dataacquisition {
@@ -22,6 +27,12 @@ class CUTEHMI_DATAACQUISITION_PRIVATE TableCollective:
 
 		void setSchema(Schema * schema);
 
+		/**
+		 * Resolve tag ids. Ids are resolved asynchronously, in a single batch, and announced with tagsResolved() signal.
+		 * @param names names of tags.
+		 */
+		void resolveTags(const QStringList & names);
+
 	public slots:
 		void confirmWorkersFinished();
 
@@ -30,15 +41,26 @@ class CUTEHMI_DATAACQUISITION_PRIVATE TableCollective:
 
 		void errored(cutehmi::InplaceError error);
 
+		/**
+		 * Tag ids have been resolved. Signal is emitted in response to resolveTags(), but also when tables resolve ids of tags,
+		 * which have been passed to them without ids.
+		 * @param names names of tags.
+		 * @param ids tag ids corresponding to @a names.
+		 */
+		void tagsResolved(QStringList names, QVector<int> ids);
+
 	protected:
 		virtual void updateSchema(Schema * schema) = 0;
 
+		TagCache * tagCache() const;
+
 		void accountInsertBusy(bool busy);
 
 	private:
 		struct Members
 		{
 			Schema * schema = nullptr;
+			std::unique_ptr<TagCache> tagCache;
 			int insertsBusy = 0;
 		};
 
@@ -5,6 +5,9 @@
 #include "TableObject.hpp"
 
 #include <QReadWriteLock>
+#include <QStringList>
+#include <QVariantList>
+#include <QVector>
 
 namespace cutehmi {
 namespace dataacquisition {
@@ -13,24 +16,59 @@ namespace internal {
 class CUTEHMI_DATAACQUISITION_PRIVATE TagCache:
 	public TableObject
 {
+		Q_OBJECT
+
 	public:
+		typedef QVector<int> IdsContainer;
+
 		explicit TagCache(Schema * schema, QObject * parent = nullptr);
 
-		int getId(const QString & name, QSqlDatabase & db);
+		/**
+		 * Resolve tag ids asynchronously. Result is announced with resolved() signal.
+		 * @param names names of tags.
+		 */
+		void resolve(const QStringList & names);
+
+		/**
+		 * Get tag ids. Tags, which are not cached, are looked up and inserted into the database in batches rather than one by
+		 * one. This function is meant to be used from within database worker task. Upon completion resolved() signal is emitted.
+		 * @param names names of tags.
+		 * @param db database connection.
+		 * @return tag ids corresponding to @a names. Ids of tags, which could not be obtained, are set to 0.
+		 */
+		IdsContainer getIds(const QStringList & names, QSqlDatabase & db);
+
+		/**
+		 * Complete tag ids. Ids, which are 0, are resolved from corresponding names with a single getIds() call.
+		 * @param ids tag ids.
+		 * @param names names of tags corresponding to @a ids.
+		 * @param db database connection.
+		 * @return completed tag ids.
+		 */
+		QVariantList completeIds(const QVariantList & ids, const QStringList & names, QSqlDatabase & db);
+
+	signals:
+		void resolved(QStringList names, QVector<int> ids);
 
 	protected:
-		void insert(const QString & name, QSqlDatabase & db);
+		void insert(const QStringList & names, QSqlDatabase & db);
+
+		void select(const QStringList & names, QSqlDatabase & db);
 
 		void update(QSqlDatabase & db);
 
 	private:
 		typedef QHash<QString, int> TagIdContainter;
 
+		QStringList lookup(const QStringList & names, IdsContainer & ids) const;
+
+		static QString Placeholders(int count, const QString & format);
+
 		struct Members
 		{
 			Schema * schema;
 			TagIdContainter tagIds;
-			QReadWriteLock tagIdsLock;
+			mutable QReadWriteLock tagIdsLock;
 		};
 
 		MPtr<Members> m;
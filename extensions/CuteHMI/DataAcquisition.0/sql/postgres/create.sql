@@ -31,31 +31,46 @@ CREATE TABLE %1.recency_real
 
 CREATE TABLE %1.event_bool
 (
-        id serial PRIMARY KEY,
+        id serial,
         tag_id integer REFERENCES %1.tag(id),
         value bool NOT NULL,
-        time timestamptz NOT NULL
-);
+        time timestamptz NOT NULL,
+        PRIMARY KEY (id, time)
+) PARTITION BY RANGE (time);
+
+CREATE TABLE %1.event_bool_default PARTITION OF %1.event_bool DEFAULT;
+
+CREATE INDEX index_event_bool_tag_id_time ON %1.event_bool (tag_id, time);
 
 CREATE TABLE %1.event_int
 (
-        id serial PRIMARY KEY,
+        id serial,
         tag_id integer REFERENCES %1.tag(id),
         value integer NOT NULL,
-        time timestamptz NOT NULL
-);
+        time timestamptz NOT NULL,
+        PRIMARY KEY (id, time)
+) PARTITION BY RANGE (time);
+
+CREATE TABLE %1.event_int_default PARTITION OF %1.event_int DEFAULT;
+
+CREATE INDEX index_event_int_tag_id_time ON %1.event_int (tag_id, time);
 
 CREATE TABLE %1.event_real
 (
-        id serial PRIMARY KEY,
+        id serial,
         tag_id integer REFERENCES %1.tag(id),
         value double precision NOT NULL,
-        time timestamptz NOT NULL
-);
+        time timestamptz NOT NULL,
+        PRIMARY KEY (id, time)
+) PARTITION BY RANGE (time);
+
+CREATE TABLE %1.event_real_default PARTITION OF %1.event_real DEFAULT;
+
+CREATE INDEX index_event_real_tag_id_time ON %1.event_real (tag_id, time);
 
 CREATE TABLE %1.history_bool
 (
-        id serial PRIMARY KEY,
+        id serial,
         tag_id integer REFERENCES %1.tag(id),
         open bool NOT NULL,
         close bool NOT NULL,
@@ -63,12 +78,17 @@ CREATE TABLE %1.history_bool
         max bool NOT NULL,
         open_time timestamptz NOT NULL,
         close_time timestamptz NOT NULL,
-        count integer NOT NULL
-);
+        count integer NOT NULL,
+        PRIMARY KEY (id, open_time)
+) PARTITION BY RANGE (open_time);
+
+CREATE TABLE %1.history_bool_default PARTITION OF %1.history_bool DEFAULT;
+
+CREATE INDEX index_history_bool_tag_id_open_time ON %1.history_bool (tag_id, open_time);
 
 CREATE TABLE %1.history_int
 (
-        id serial PRIMARY KEY,
+        id serial,
         tag_id integer REFERENCES %1.tag(id),
         open integer NOT NULL,
         close integer NOT NULL,
@@ -76,12 +96,17 @@ CREATE TABLE %1.history_int
         max integer NOT NULL,
         open_time timestamptz NOT NULL,
         close_time timestamptz NOT NULL,
-        count integer NOT NULL
-);
+        count integer NOT NULL,
+        PRIMARY KEY (id, open_time)
+) PARTITION BY RANGE (open_time);
+
+CREATE TABLE %1.history_int_default PARTITION OF %1.history_int DEFAULT;
+
+CREATE INDEX index_history_int_tag_id_open_time ON %1.history_int (tag_id, open_time);
 
 CREATE TABLE %1.history_real
 (
-        id serial PRIMARY KEY,
+        id serial,
         tag_id integer REFERENCES %1.tag(id),
         open double precision NOT NULL,
         close double precision NOT NULL,
@@ -89,6 +114,11 @@ CREATE TABLE %1.history_real
         max double precision NOT NULL,
         open_time timestamptz NOT NULL,
         close_time timestamptz NOT NULL,
-        count integer NOT NULL
-);
+        count integer NOT NULL,
+        PRIMARY KEY (id, open_time)
+) PARTITION BY RANGE (open_time);
+
+CREATE TABLE %1.history_real_default PARTITION OF %1.history_real DEFAULT;
+
+CREATE INDEX index_history_real_tag_id_open_time ON %1.history_real (tag_id, open_time);
 
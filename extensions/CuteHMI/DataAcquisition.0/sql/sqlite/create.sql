@@ -35,6 +35,10 @@ CREATE TABLE [%1.event_bool]
         time INTEGER NOT NULL
 );
 
+CREATE INDEX [%1.index_event_bool_tag_id_time] ON [%1.event_bool] (tag_id, time);
+
+CREATE VIEW [%1.event_bool_all] AS SELECT * FROM [%1.event_bool];
+
 CREATE TABLE [%1.event_int]
 (
         id serial PRIMARY KEY,
@@ -43,6 +47,10 @@ CREATE TABLE [%1.event_int]
         time INTEGER NOT NULL
 );
 
+CREATE INDEX [%1.index_event_int_tag_id_time] ON [%1.event_int] (tag_id, time);
+
+CREATE VIEW [%1.event_int_all] AS SELECT * FROM [%1.event_int];
+
 CREATE TABLE [%1.event_real]
 (
         id serial PRIMARY KEY,
@@ -51,6 +59,10 @@ CREATE TABLE [%1.event_real]
         time INTEGER NOT NULL
 );
 
+CREATE INDEX [%1.index_event_real_tag_id_time] ON [%1.event_real] (tag_id, time);
+
+CREATE VIEW [%1.event_real_all] AS SELECT * FROM [%1.event_real];
+
 CREATE TABLE [%1.history_bool]
 (
         id serial PRIMARY KEY,
@@ -64,6 +76,10 @@ CREATE TABLE [%1.history_bool]
         count INTEGER NOT NULL
 );
 
+CREATE INDEX [%1.index_history_bool_tag_id_open_time] ON [%1.history_bool] (tag_id, open_time);
+
+CREATE VIEW [%1.history_bool_all] AS SELECT * FROM [%1.history_bool];
+
 CREATE TABLE [%1.history_int]
 (
         id serial PRIMARY KEY,
@@ -77,6 +93,10 @@ CREATE TABLE [%1.history_int]
         count INTEGER NOT NULL
 );
 
+CREATE INDEX [%1.index_history_int_tag_id_open_time] ON [%1.history_int] (tag_id, open_time);
+
+CREATE VIEW [%1.history_int_all] AS SELECT * FROM [%1.history_int];
+
 CREATE TABLE [%1.history_real]
 (
         id serial PRIMARY KEY,
@@ -89,3 +109,7 @@ CREATE TABLE [%1.history_real]
         close_time INTEGER NOT NULL,
         count INTEGER NOT NULL
 );
+
+CREATE INDEX [%1.index_history_real_tag_id_open_time] ON [%1.history_real] (tag_id, open_time);
+
+CREATE VIEW [%1.history_real_all] AS SELECT * FROM [%1.history_real];
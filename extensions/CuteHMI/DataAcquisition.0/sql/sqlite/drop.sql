@@ -1,3 +1,9 @@
+DROP VIEW IF EXISTS [%1.event_bool_all];
+DROP VIEW IF EXISTS [%1.event_int_all];
+DROP VIEW IF EXISTS [%1.event_real_all];
+DROP VIEW IF EXISTS [%1.history_bool_all];
+DROP VIEW IF EXISTS [%1.history_int_all];
+DROP VIEW IF EXISTS [%1.history_real_all];
 DROP TABLE IF EXISTS [%1.tag];
 DROP INDEX IF EXISTS [%1.index_tag_name];
 DROP TABLE IF EXISTS [%1.recency_bool];
@@ -30,6 +30,8 @@ void AbstractWriter::setSchema(Schema * schema)
 			m->schema->disconnect(this);
 
 		m->schema = schema;
+		// Tag ids are specific to the schema.
+		resetTagIds();
 		emit schemaChanged();
 
 		if (m->schema) {
@@ -44,6 +46,39 @@ const AbstractWriter::TagValueContainer & AbstractWriter::values() const
 	return m->values;
 }
 
+const AbstractWriter::TagIdContainer & AbstractWriter::tagIds() const
+{
+	return m->tagIds;
+}
+
+void AbstractWriter::setTableCollective(internal::TableCollective * tableCollective)
+{
+	if (m->tableCollective)
+		disconnect(m->tableCollective, & internal::TableCollective::tagsResolved, this, & AbstractWriter::onTagsResolved);
+
+	m->tableCollective = tableCollective;
+
+	if (m->tableCollective)
+		connect(m->tableCollective, & internal::TableCollective::tagsResolved, this, & AbstractWriter::onTagsResolved);
+}
+
+void AbstractWriter::resolveTagIds()
+{
+	QStringList names;
+	for (int i = 0; i < m->values.count(); i++)
+		if (m->tagIds.at(i) == 0)
+			names.append(m->values.at(i)->name());
+
+	if (names.isEmpty())
+		return;
+
+	if (m->tableCollective) {
+		CUTEHMI_DEBUG("Resolving ids of " << names.count() << " tags.");
+		m->tableCollective->resolveTags(names);
+	} else
+		CUTEHMI_CRITICAL("Table collective is not set for '" << this << "' object.");
+}
+
 QState * AbstractWriter::createWaitingForDatabaseConnectedSate(QState * parent, services::Serviceable::ServiceStatuses * statuses, QState * target)
 {
 	QState * state = new QState(parent);
@@ -94,12 +129,26 @@ QState * AbstractWriter::createValidatingSchemaSate(QState * parent, services::S
 
 void AbstractWriter::onSchemaValidated(bool result)
 {
-	if (result)
+	if (result) {
+		resolveTagIds();
 		emit schemaValidated();
+	}
 	else
 		emit broke();
 }
 
+void AbstractWriter::onTagsResolved(QStringList names, QVector<int> ids)
+{
+	QHash<QString, int> resolvedIds;
+	for (int i = 0; i < names.count(); i++)
+		resolvedIds.insert(names.at(i), ids.at(i));
+
+	// Tags are matched by their current names, so that ids of tags, which have been renamed in the meantime, are not assigned.
+	for (int i = 0; i < m->values.count(); i++)
+		if (m->tagIds.at(i) == 0)
+			m->tagIds[i] = resolvedIds.value(m->values.at(i)->name());
+}
+
 int AbstractWriter::ValueListCount(QQmlListProperty<TagValue> * property)
 {
 	return static_cast<TagValueContainer *>(property->data)->count();
@@ -117,11 +166,26 @@ void AbstractWriter::ValueListClear(QQmlListProperty<TagValue> * property)
 		(*it)->disconnect(writer);
 	}
 	static_cast<TagValueContainer *>(property->data)->clear();
+	writer->m->tagIds.clear();
 }
 
 void AbstractWriter::ValuesListAppend(QQmlListProperty<TagValue> * property, TagValue * value)
 {
+	AbstractWriter * writer = static_cast<AbstractWriter *>(property->object);
 	static_cast<TagValueContainer *>(property->data)->append(value);
+	writer->m->tagIds.append(0);
+
+	// Renamed tag has to be resolved again.
+	connect(value, & TagValue::nameChanged, writer, [writer, value]() {
+		int index = writer->m->values.indexOf(value);
+		if (index != -1)
+			writer->m->tagIds[index] = 0;
+	});
+}
+
+void AbstractWriter::resetTagIds()
+{
+	m->tagIds.fill(0, m->values.count());
 }
 
 }
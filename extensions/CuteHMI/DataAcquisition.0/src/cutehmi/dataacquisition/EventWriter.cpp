@@ -1,13 +1,90 @@
 #include <cutehmi/dataacquisition/EventWriter.hpp>
 
+#include <QDateTime>
+
 namespace cutehmi {
 namespace dataacquisition {
 
+constexpr int EventWriter::INITIAL_QUEUE_CAPACITY;
+constexpr int EventWriter::INITIAL_FLUSH_SIZE;
+constexpr int EventWriter::INITIAL_FLUSH_INTERVAL;
+constexpr EventWriter::OverflowPolicy EventWriter::INITIAL_OVERFLOW_POLICY;
+
 EventWriter::EventWriter(QObject * parent):
 	AbstractWriter(parent),
 	m(new Members)
 {
+	setTableCollective(& m->dbCollective);
 	connect(this, & AbstractWriter::schemaChanged, this, & EventWriter::onSchemaChanged);
+	connect(& m->flushTimer, & QTimer::timeout, this, & EventWriter::flush);
+}
+
+int EventWriter::queueCapacity() const
+{
+	return m->queue.count();
+}
+
+void EventWriter::setQueueCapacity(int queueCapacity)
+{
+	CUTEHMI_ASSERT(queueCapacity > 0, "Value of 'queueCapacity' property should be greater than zero.");
+
+	if (m->queue.count() != queueCapacity) {
+		resizeQueue(queueCapacity);
+		emit queueCapacityChanged();
+	}
+}
+
+int EventWriter::queueDepth() const
+{
+	return m->queueDepth;
+}
+
+EventWriter::OverflowPolicy EventWriter::overflowPolicy() const
+{
+	return m->overflowPolicy;
+}
+
+void EventWriter::setOverflowPolicy(EventWriter::OverflowPolicy overflowPolicy)
+{
+	if (m->overflowPolicy != overflowPolicy) {
+		m->overflowPolicy = overflowPolicy;
+		emit overflowPolicyChanged();
+	}
+}
+
+int EventWriter::droppedCount() const
+{
+	return m->droppedCount;
+}
+
+int EventWriter::flushSize() const
+{
+	return m->flushSize;
+}
+
+void EventWriter::setFlushSize(int flushSize)
+{
+	CUTEHMI_ASSERT(flushSize > 0, "Value of 'flushSize' property should be greater than zero.");
+
+	if (m->flushSize != flushSize) {
+		m->flushSize = flushSize;
+		emit flushSizeChanged();
+	}
+}
+
+int EventWriter::flushInterval() const
+{
+	return m->flushTimer.interval();
+}
+
+void EventWriter::setFlushInterval(int flushInterval)
+{
+	CUTEHMI_ASSERT(flushInterval >= 0, "Value of 'flushInterval' property should be non-negative.");
+
+	if (m->flushTimer.interval() != flushInterval) {
+		m->flushTimer.setInterval(flushInterval);
+		emit flushIntervalChanged();
+	}
 }
 
 std::unique_ptr<services::Serviceable::ServiceStatuses> EventWriter::configureStarting(QState * starting)
@@ -39,6 +116,8 @@ std::unique_ptr<services::Serviceable::ServiceStatuses> EventWriter::configureSt
 	QState * waitingForWorkers = new QState(stopping);
 	stopping->setInitialState(waitingForWorkers);
 	statuses->insert(waitingForWorkers, tr("Waiting for database workers to finish"));
+	// Remaining events are flushed first. Workers account themselves as busy right away, so they are going to be awaited.
+	connect(waitingForWorkers, & QState::entered, this, & EventWriter::flush);
 	connect(waitingForWorkers, & QState::entered, & m->dbCollective, & internal::EventCollective::confirmWorkersFinished);
 
 	return statuses;
@@ -94,29 +173,90 @@ std::unique_ptr<QAbstractTransition> EventWriter::transitionToIdling() const
 	return nullptr;
 }
 
+void EventWriter::flush()
+{
+	m->flushTimer.stop();
+
+	if (m->queueDepth == 0)
+		return;
+
+	int capacity = m->queue.count();
+	EventsContainer events;
+	events.reserve(m->queueDepth);
+	for (int i = 0; i < m->queueDepth; i++) {
+		internal::EventCollective::Event & event = m->queue[(m->queueHead + i) % capacity];
+		events.append(event);
+		event = internal::EventCollective::Event();
+	}
+	m->queueHead = 0;
+	m->queueDepth = 0;
+	m->overflowing = false;
+	emit queueDepthChanged();
+
+	CUTEHMI_DEBUG("Flushing " << events.count() << " events.");
+	if (schema() && !schema()->name().isNull())
+		m->dbCollective.insert(events);
+	else
+		CUTEHMI_CRITICAL("Schema is not set for '" << this << "' object. Discarding " << events.count() << " events.");
+}
+
 void EventWriter::onSchemaChanged()
 {
 	m->dbCollective.setSchema(schema());
 }
 
-void EventWriter::insertEvent(TagValue * tag)
+void EventWriter::insertEvent(int index)
 {
-	m->dbCollective.insert(*tag);
+	TagValue * tag = values().at(index);
+	internal::EventCollective::Event event{tagIds().at(index), tag->name(), tag->value(), QDateTime::currentDateTimeUtc()};
+
+	int capacity = m->queue.count();
+	if (m->queueDepth == capacity) {
+		// Warn once per overflow rather than for each discarded event, since overflow typically happens during event storms.
+		if (!m->overflowing) {
+			CUTEHMI_WARNING("Event queue of '" << this << "' is full; discarding " << (m->overflowPolicy == DROP_OLDEST ? "oldest" : "newest") << " events.");
+			m->overflowing = true;
+		}
+		m->droppedCount++;
+		emit droppedCountChanged();
+
+		if (m->overflowPolicy == DROP_NEWEST)
+			return;
+
+		m->queue[m->queueHead] = event;
+		m->queueHead = (m->queueHead + 1) % capacity;
+	} else {
+		m->queue[(m->queueHead + m->queueDepth) % capacity] = event;
+		m->queueDepth++;
+		emit queueDepthChanged();
+	}
+
+	if (m->queueDepth >= m->flushSize)
+		flush();
+	else if (!m->flushTimer.isActive())
+		m->flushTimer.start();
 }
 
 void EventWriter::connectTagSignals()
 {
-	for (TagValueContainer::const_iterator it = values().begin(); it != values().end(); ++it) {
-		QObject::connect(*it, & TagValue::valueChanged, this, [it, this]() {
-			insertEvent(*it);
+	for (int i = 0; i < values().count(); i++) {
+		QObject::connect(values().at(i), & TagValue::valueChanged, this, [i, this]() {
+			insertEvent(i);
 		});
 	}
+
+	if (m->queueDepth > 0)
+		m->flushTimer.start();
 }
 
 void EventWriter::disconnectTagSignals()
 {
+	// Only value signals are disconnected, since writer also tracks tag names.
 	for (TagValueContainer::const_iterator it = values().begin(); it != values().end(); ++it)
-		(*it)->disconnect(this);
+		QObject::disconnect(*it, & TagValue::valueChanged, this, nullptr);
+
+	// Queued events are kept. They will be flushed when writer stops or after it gets repaired.
+	m->flushTimer.stop();
 }
 
 std::unique_ptr<services::Serviceable::ServiceStatuses> EventWriter::configureStartingOrRepairing(QState * parent)
@@ -131,6 +271,29 @@ std::unique_ptr<services::Serviceable::ServiceStatuses> EventWriter::configureSt
 	return statuses;
 }
 
+void EventWriter::resizeQueue(int capacity)
+{
+	// Queue is linearized. If it does not fit into new capacity, the oldest events are discarded.
+	int oldCapacity = m->queue.count();
+	int depth = qMin(m->queueDepth, capacity);
+	int dropped = m->queueDepth - depth;
+	EventsContainer queue(capacity);
+	for (int i = 0; i < depth; i++)
+		queue[i] = m->queue[(m->queueHead + dropped + i) % oldCapacity];
+	m->queue = queue;
+	m->queueHead = 0;
+
+	if (dropped > 0) {
+		CUTEHMI_WARNING("Discarding " << dropped << " events, which do not fit into event queue of new capacity.");
+		m->droppedCount += dropped;
+		emit droppedCountChanged();
+	}
+	if (m->queueDepth != depth) {
+		m->queueDepth = depth;
+		emit queueDepthChanged();
+	}
+}
+
 }
 }
 
@@ -0,0 +1,298 @@
+#include <cutehmi/dataacquisition/HistoryModel.hpp>
+
+#include <algorithm>
+
+namespace cutehmi {
+namespace dataacquisition {
+
+constexpr int HistoryModel::INITIAL_RESOLUTION;
+constexpr HistoryReader::Downsampling HistoryModel::INITIAL_DOWNSAMPLING;
+
+HistoryModel::HistoryModel(QObject * parent):
+	Parent(parent),
+	m(new Members)
+{
+	m->updateTimer.setSingleShot(true);
+	m->updateTimer.setInterval(0);
+	connect(& m->updateTimer, & QTimer::timeout, this, & HistoryModel::update);
+
+	connect(& m->reader, & HistoryReader::samplesRead, this, & HistoryModel::onSamplesRead);
+	connect(& m->reader, & HistoryReader::busyChanged, this, & HistoryModel::busyChanged);
+}
+
+Schema * HistoryModel::schema() const
+{
+	return m->reader.schema();
+}
+
+void HistoryModel::setSchema(Schema * schema)
+{
+	if (m->reader.schema() != schema) {
+		m->reader.setSchema(schema);
+		emit schemaChanged();
+		reload();
+	}
+}
+
+QString HistoryModel::tagName() const
+{
+	return m->tagName;
+}
+
+void HistoryModel::setTagName(const QString & tagName)
+{
+	if (m->tagName != tagName) {
+		m->tagName = tagName;
+		emit tagNameChanged();
+		reload();
+	}
+}
+
+QDateTime HistoryModel::from() const
+{
+	return m->from;
+}
+
+void HistoryModel::setFrom(const QDateTime & from)
+{
+	if (m->from != from) {
+		m->from = from;
+		emit fromChanged();
+		scheduleUpdate();
+	}
+}
+
+QDateTime HistoryModel::to() const
+{
+	return m->to;
+}
+
+void HistoryModel::setTo(const QDateTime & to)
+{
+	if (m->to != to) {
+		m->to = to;
+		emit toChanged();
+		scheduleUpdate();
+	}
+}
+
+int HistoryModel::resolution() const
+{
+	return m->resolution;
+}
+
+void HistoryModel::setResolution(int resolution)
+{
+	CUTEHMI_ASSERT(resolution >= 0, "Value of 'resolution' property should be non-negative.");
+
+	if (m->resolution != resolution) {
+		m->resolution = resolution;
+		emit resolutionChanged();
+		scheduleUpdate();
+	}
+}
+
+HistoryReader::Downsampling HistoryModel::downsampling() const
+{
+	return m->downsampling;
+}
+
+void HistoryModel::setDownsampling(HistoryReader::Downsampling downsampling)
+{
+	if (m->downsampling != downsampling) {
+		m->downsampling = downsampling;
+		emit downsamplingChanged();
+		reload();
+	}
+}
+
+bool HistoryModel::busy() const
+{
+	return m->reader.busy();
+}
+
+int HistoryModel::rowCount(const QModelIndex & parent) const
+{
+	if (parent.isValid())
+		return 0;
+
+	return m->samples.count();
+}
+
+QVariant HistoryModel::data(const QModelIndex & index, int role) const
+{
+	if (!index.isValid() || index.row() >= m->samples.count())
+		return QVariant();
+
+	const HistoryReader::Sample & sample = m->samples.at(index.row());
+	if (role == Qt::DisplayRole || role == CLOSE_ROLE)
+		return sample.close;
+	else if (role == OPEN_TIME_ROLE)
+		return sample.openTime;
+	else if (role == CLOSE_TIME_ROLE)
+		return sample.closeTime;
+	else if (role == OPEN_ROLE)
+		return sample.open;
+	else if (role == MIN_ROLE)
+		return sample.min;
+	else if (role == MAX_ROLE)
+		return sample.max;
+	else if (role == COUNT_ROLE)
+		return sample.count;
+
+	return QVariant();
+}
+
+QHash<int, QByteArray> HistoryModel::roleNames() const
+{
+	QHash<int, QByteArray> result = Parent::roleNames();
+	result[OPEN_TIME_ROLE] = "openTime";
+	result[CLOSE_TIME_ROLE] = "closeTime";
+	result[OPEN_ROLE] = "open";
+	result[CLOSE_ROLE] = "close";
+	result[MIN_ROLE] = "min";
+	result[MAX_ROLE] = "max";
+	result[COUNT_ROLE] = "count";
+	return result;
+}
+
+void HistoryModel::reload()
+{
+	m->bucketWidth = -1;
+	scheduleUpdate();
+}
+
+void HistoryModel::update()
+{
+	if (!schema() || m->tagName.isEmpty() || !m->from.isValid() || !m->to.isValid() || m->from >= m->to) {
+		clear();
+		return;
+	}
+
+	qint64 first = m->from.toMSecsSinceEpoch();
+	qint64 last = m->to.toMSecsSinceEpoch();
+	qint64 bucketWidth = 0;
+	if (m->resolution > 0 && m->downsampling != HistoryReader::NONE) {
+		bucketWidth = qMax<qint64>(1, (last - first) / m->resolution);
+		// Align range to bucket boundaries, so that panned ranges do not split buckets (floor division also for times before epoch).
+		first -= ((first % bucketWidth) + bucketWidth) % bucketWidth;
+		last += (bucketWidth - ((last % bucketWidth) + bucketWidth) % bucketWidth) % bucketWidth;
+	}
+
+	if (bucketWidth != m->bucketWidth || last <= m->loaded.first || first >= m->loaded.last) {
+		clear();
+		m->bucketWidth = bucketWidth;
+		m->loaded = Range{first, first};
+	}
+
+	if (first > m->loaded.first) {
+		trim(m->loaded.first, first);
+		m->loaded.first = first;
+	}
+	if (last < m->loaded.last) {
+		trim(last, m->loaded.last);
+		m->loaded.last = last;
+	}
+	if (first < m->loaded.first) {
+		fetch(first, m->loaded.first);
+		m->loaded.first = first;
+	}
+	if (last > m->loaded.last) {
+		fetch(m->loaded.last, last);
+		m->loaded.last = last;
+	}
+}
+
+void HistoryModel::onSamplesRead(int request, HistoryReader::SamplesContainer samples)
+{
+	RequestsContainer::iterator it = m->requests.find(request);
+	if (it == m->requests.end())
+		return;
+
+	Range range = *it;
+	m->requests.erase(it);
+
+	auto outOfRange = [& range](const HistoryReader::Sample & sample) {
+		qint64 time = sample.openTime.toMSecsSinceEpoch();
+		return time < range.first || time >= range.last;
+	};
+	samples.erase(std::remove_if(samples.begin(), samples.end(), outOfRange), samples.end());
+	if (samples.isEmpty())
+		return;
+
+	int row = lowerBound(samples.first().openTime.toMSecsSinceEpoch());
+	beginInsertRows(QModelIndex(), row, row + samples.count() - 1);
+	m->samples.insert(row, samples.count(), HistoryReader::Sample());
+	std::copy(samples.begin(), samples.end(), m->samples.begin() + row);
+	endInsertRows();
+}
+
+void HistoryModel::scheduleUpdate()
+{
+	// Timer coalesces property changes made within single event loop iteration (e.g. when both 'from' and 'to' are set).
+	m->updateTimer.start();
+}
+
+void HistoryModel::clear()
+{
+	// Replies to pending requests are going to be discarded.
+	m->requests.clear();
+	m->bucketWidth = -1;
+	m->loaded = Range{0, 0};
+	if (!m->samples.isEmpty()) {
+		beginResetModel();
+		m->samples.clear();
+		endResetModel();
+	}
+}
+
+void HistoryModel::fetch(qint64 first, qint64 last)
+{
+	int request = m->reader.read(m->tagName, QDateTime::fromMSecsSinceEpoch(first, Qt::UTC), QDateTime::fromMSecsSinceEpoch(last, Qt::UTC), m->bucketWidth, m->downsampling);
+	if (request != 0)
+		m->requests.insert(request, Range{first, last});
+}
+
+void HistoryModel::trim(qint64 first, qint64 last)
+{
+	int firstRow = lowerBound(first);
+	int lastRow = lowerBound(last);
+	if (lastRow > firstRow) {
+		beginRemoveRows(QModelIndex(), firstRow, lastRow - 1);
+		m->samples.remove(firstRow, lastRow - firstRow);
+		endRemoveRows();
+	}
+
+	// Pending requests, which overlap trimmed range, are discarded and their remaining parts are requested again. Otherwise
+	// their replies could duplicate samples, if trimmed range was fetched again before replies arrived.
+	QList<Range> remaining;
+	for (RequestsContainer::iterator it = m->requests.begin(); it != m->requests.end();) {
+		if (it->first < last && it->last > first) {
+			if (it->first < first)
+				remaining.append(Range{it->first, first});
+			if (it->last > last)
+				remaining.append(Range{last, it->last});
+			it = m->requests.erase(it);
+		} else
+			++it;
+	}
+	for (auto && range : remaining)
+		fetch(range.first, range.last);
+}
+
+int HistoryModel::lowerBound(qint64 time) const
+{
+	auto less = [](const HistoryReader::Sample & sample, qint64 time) {
+		return sample.openTime.toMSecsSinceEpoch() < time;
+	};
+	return static_cast<int>(std::lower_bound(m->samples.constBegin(), m->samples.constEnd(), time, less) - m->samples.constBegin());
+}
+
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
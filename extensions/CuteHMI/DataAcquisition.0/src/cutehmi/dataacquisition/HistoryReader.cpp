@@ -0,0 +1,229 @@
+#include <cutehmi/dataacquisition/HistoryReader.hpp>
+
+#include <QSqlRecord>
+
+#include <cmath>
+
+namespace cutehmi {
+namespace dataacquisition {
+
+HistoryReader::HistoryReader(QObject * parent):
+	DataObject(parent),
+	m(new Members)
+{
+	static int samplesContainerId = qRegisterMetaType<SamplesContainer>("cutehmi::dataacquisition::HistoryReader::SamplesContainer");
+	Q_UNUSED(samplesContainerId)
+}
+
+Schema * HistoryReader::schema() const
+{
+	return m->schema;
+}
+
+void HistoryReader::setSchema(Schema * schema)
+{
+	if (m->schema != schema) {
+		m->schema = schema;
+		if (m->schema)
+			setConnectionName(m->schema->connectionName());
+		emit schemaChanged();
+	}
+}
+
+int HistoryReader::read(const QString & tagName, const QDateTime & from, const QDateTime & to, qint64 bucketWidth, Downsampling downsampling)
+{
+	int request = ++m->requestCounter;
+
+	if (!schema()) {
+		CUTEHMI_CRITICAL("Schema is not set for '" << this << "' object.");
+		return 0;
+	}
+
+	QString schemaName = schema()->name();
+
+	worker([this, request, schemaName, tagName, from, to, bucketWidth, downsampling](QSqlDatabase & db) {
+		SamplesContainer samples;
+
+		if (db.driverName() == "QPSQL" || db.driverName() == "QSQLITE") {
+			QSqlQuery query(db);
+			CUTEHMI_DEBUG("Reading history of '" << tagName << "' tag...");
+
+			if (db.driverName() == "QPSQL")
+				query.prepare(QString("SELECT id FROM %1.tag WHERE name = :name").arg(schemaName));
+			else
+				query.prepare(QString("SELECT id FROM [%1.tag] WHERE name = :name").arg(schemaName));
+			query.bindValue(":name", tagName);
+			query.exec();
+			pushError(query.lastError());
+			bool tagFound = query.first();
+			int tagId = tagFound ? query.value(0).toInt() : 0;
+			query.finish();
+
+			if (tagFound) {
+				QString source = SourceQuery(db.driverName(), schemaName, tagId, from, to);
+				QString queryString;
+				if (bucketWidth > 0 && downsampling == MIN_MAX) {
+					// Window functions are used to pick open and close values, because both databases support them.
+					const char * minMaxQuery = R"SQL(
+						SELECT DISTINCT bucket,
+							MIN(open_time) OVER bucket_window AS open_time,
+							MAX(close_time) OVER bucket_window AS close_time,
+							FIRST_VALUE(open) OVER bucket_window AS open,
+							LAST_VALUE(close) OVER bucket_window AS close,
+							MIN(min) OVER bucket_window AS min,
+							MAX(max) OVER bucket_window AS max,
+							SUM(count) OVER bucket_window AS count
+						FROM (SELECT %1 AS bucket, source.* FROM (%2) AS source) AS bucketed
+						WINDOW bucket_window AS (PARTITION BY bucket ORDER BY open_time ROWS BETWEEN UNBOUNDED PRECEDING AND UNBOUNDED FOLLOWING)
+						ORDER BY bucket;
+					)SQL";
+					queryString = QString(minMaxQuery).arg(BucketExpression(db.driverName(), bucketWidth), source);
+				} else
+					queryString = QString("SELECT * FROM (%1) AS source ORDER BY open_time").arg(source);
+
+				query.exec(queryString);
+				pushError(query.lastError());
+				QSqlRecord record = query.record();
+				int openTimeIndex = record.indexOf("open_time");
+				int closeTimeIndex = record.indexOf("close_time");
+				int openIndex = record.indexOf("open");
+				int closeIndex = record.indexOf("close");
+				int minIndex = record.indexOf("min");
+				int maxIndex = record.indexOf("max");
+				int countIndex = record.indexOf("count");
+				while (query.next()) {
+					Sample sample;
+					sample.openTime = query.value(openTimeIndex).toDateTime();
+					sample.closeTime = query.value(closeTimeIndex).toDateTime();
+					// SQLite driver may store times without time zone designator, but they are always expressed in UTC.
+					if (sample.openTime.timeSpec() == Qt::LocalTime && db.driverName() == "QSQLITE") {
+						sample.openTime.setTimeSpec(Qt::UTC);
+						sample.closeTime.setTimeSpec(Qt::UTC);
+					}
+					sample.open = query.value(openIndex).toDouble();
+					sample.close = query.value(closeIndex).toDouble();
+					sample.min = query.value(minIndex).toDouble();
+					sample.max = query.value(maxIndex).toDouble();
+					sample.count = query.value(countIndex).toInt();
+					samples.append(sample);
+				}
+				query.finish();
+
+				if (bucketWidth > 0 && downsampling == LTTB)
+					samples = LTTBDownsample(samples, static_cast<int>((to.toMSecsSinceEpoch() - from.toMSecsSinceEpoch() + bucketWidth - 1) / bucketWidth));
+
+				CUTEHMI_DEBUG("Read " << samples.count() << " samples of '" << tagName << "' tag.");
+			} else
+				CUTEHMI_DEBUG("Tag '" << tagName << "' does not exist in the database.");
+		} else
+			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
+
+		emit samplesRead(request, samples);
+	})->work();
+
+	return request;
+}
+
+HistoryReader::SamplesContainer HistoryReader::LTTBDownsample(const SamplesContainer & samples, int threshold)
+{
+	if (threshold <= 0 || threshold >= samples.count())
+		return samples;
+
+	SamplesContainer result;
+	result.reserve(threshold);
+	result.append(samples.first());
+	if (threshold == 1)
+		return result;
+
+	// Time is measured relative to the first sample to preserve precision of triangle areas.
+	qint64 origin = samples.first().openTime.toMSecsSinceEpoch();
+	auto x = [origin](const Sample & sample) {
+		return static_cast<double>(sample.openTime.toMSecsSinceEpoch() - origin);
+	};
+
+	// First and last sample occupy their own buckets, remaining samples are split evenly between other buckets.
+	double bucketSize = threshold > 2 ? static_cast<double>(samples.count() - 2) / (threshold - 2) : 0.0;
+	int selected = 0;
+	for (int bucket = 0; bucket < threshold - 2; bucket++) {
+		int nextFirst = static_cast<int>(std::floor((bucket + 1) * bucketSize)) + 1;
+		int nextLast = qMin(static_cast<int>(std::floor((bucket + 2) * bucketSize)) + 1, samples.count());
+		double averageX = 0.0;
+		double averageY = 0.0;
+		for (int i = nextFirst; i < nextLast; i++) {
+			averageX += x(samples.at(i));
+			averageY += samples.at(i).close;
+		}
+		averageX /= nextLast - nextFirst;
+		averageY /= nextLast - nextFirst;
+
+		int first = static_cast<int>(std::floor(bucket * bucketSize)) + 1;
+		int last = static_cast<int>(std::floor((bucket + 1) * bucketSize)) + 1;
+		double selectedX = x(samples.at(selected));
+		double selectedY = samples.at(selected).close;
+		double maxArea = -1.0;
+		int candidate = first;
+		for (int i = first; i < last; i++) {
+			double area = std::abs((selectedX - averageX) * (samples.at(i).close - selectedY) - (selectedX - x(samples.at(i))) * (averageY - selectedY));
+			if (area > maxArea) {
+				maxArea = area;
+				candidate = i;
+			}
+		}
+
+		result.append(samples.at(candidate));
+		selected = candidate;
+	}
+	result.append(samples.last());
+
+	return result;
+}
+
+QString HistoryReader::SourceQuery(const QString & driverName, const QString & schemaName, int tagId, const QDateTime & from, const QDateTime & to)
+{
+	if (driverName == "QPSQL") {
+		const char * sourceQuery = R"SQL(
+			SELECT open_time, close_time, open::float8 AS open, close::float8 AS close, min::float8 AS min, max::float8 AS max, count
+			FROM %1.history_int WHERE tag_id = %2 AND open_time >= '%3' AND open_time < '%4'
+			UNION ALL
+			SELECT open_time, close_time, open::int::float8 AS open, close::int::float8 AS close, min::int::float8 AS min, max::int::float8 AS max, count
+			FROM %1.history_bool WHERE tag_id = %2 AND open_time >= '%3' AND open_time < '%4'
+			UNION ALL
+			SELECT open_time, close_time, open, close, min, max, count
+			FROM %1.history_real WHERE tag_id = %2 AND open_time >= '%3' AND open_time < '%4'
+		)SQL";
+
+		return QString(sourceQuery).arg(schemaName, QString::number(tagId), from.toUTC().toString(Qt::ISODateWithMs), to.toUTC().toString(Qt::ISODateWithMs));
+	}
+
+	// SQLite compares times as strings, so boundaries are formatted without time zone designator. Views include archive tables.
+	const char * sourceQuery = R"SQL(
+		SELECT open_time, close_time, CAST(open AS REAL) AS open, CAST(close AS REAL) AS close, CAST(min AS REAL) AS min, CAST(max AS REAL) AS max, count
+		FROM [%1.history_int_all] WHERE tag_id = %2 AND open_time >= '%3' AND open_time < '%4'
+		UNION ALL
+		SELECT open_time, close_time, CAST(open AS REAL) AS open, CAST(close AS REAL) AS close, CAST(min AS REAL) AS min, CAST(max AS REAL) AS max, count
+		FROM [%1.history_bool_all] WHERE tag_id = %2 AND open_time >= '%3' AND open_time < '%4'
+		UNION ALL
+		SELECT open_time, close_time, CAST(open AS REAL) AS open, CAST(close AS REAL) AS close, CAST(min AS REAL) AS min, CAST(max AS REAL) AS max, count
+		FROM [%1.history_real_all] WHERE tag_id = %2 AND open_time >= '%3' AND open_time < '%4'
+	)SQL";
+
+	return QString(sourceQuery).arg(schemaName, QString::number(tagId), from.toUTC().toString("yyyy-MM-ddTHH:mm:ss.zzz"), to.toUTC().toString("yyyy-MM-ddTHH:mm:ss.zzz"));
+}
+
+QString HistoryReader::BucketExpression(const QString & driverName, qint64 bucketWidth)
+{
+	if (driverName == "QPSQL")
+		return QString("floor(extract(epoch FROM open_time) * 1000 / %1)::bigint").arg(bucketWidth);
+
+	// Unix epoch expressed as Julian day is 2440587.5.
+	return QString("CAST((julianday(open_time) - 2440587.5) * 86400000.0 / %1 AS INTEGER)").arg(bucketWidth);
+}
+
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -12,6 +12,7 @@ HistoryWriter::HistoryWriter(QObject * parent):
 	AbstractWriter(parent),
 	m(new Members)
 {
+	setTableCollective(& m->dbCollective);
 	adjustSamplingTimer();
 	connect(this, & AbstractWriter::schemaChanged, this, & HistoryWriter::onSchemaChanged);
 	connect(this, & HistoryWriter::intervalChanged, this, & HistoryWriter::adjustSamplingTimer);
@@ -52,19 +53,27 @@ void HistoryWriter::sampleValues()
 {
 	CUTEHMI_DEBUG("Sampling values (count: " << m->sampleCounter + 1 << ").");
 
-	for (TagValueContainer::const_iterator it = values().begin(); it != values().end(); ++it) {
-		switch ((*it)->value().type()) {
+	// Tag values might have been appended since candles have been initialized.
+	if (m->intTuples.count() != values().count()) {
+		m->intTuples.resize(values().count());
+		m->boolTuples.resize(values().count());
+		m->realTuples.resize(values().count());
+	}
+
+	for (int i = 0; i < values().count(); i++) {
+		QVariant value = values().at(i)->value();
+		switch (value.type()) {
 			case QVariant::Int:
-				addIntSample((*it)->name(), (*it)->value().toInt());
+				addSample(value.toInt(), i, m->intTuples);
 				break;
 			case QVariant::Bool:
-				addBoolSample((*it)->name(), (*it)->value().toInt());
+				addSample(value.toBool(), i, m->boolTuples);
 				break;
 			case QVariant::Double:
-				addRealSample((*it)->name(), (*it)->value().toInt());
+				addSample(value.toDouble(), i, m->realTuples);
 				break;
 			default:
-				CUTEHMI_CRITICAL("Unsupported type ('" << (*it)->value().typeName() << "') provided as a 'value' of 'TagValue' object.");
+				CUTEHMI_CRITICAL("Unsupported type ('" << value.typeName() << "') provided as a 'value' of 'TagValue' object.");
 		}
 	}
 
@@ -231,34 +240,22 @@ std::unique_ptr<services::Serviceable::ServiceStatuses> HistoryWriter::configure
 	return statuses;
 }
 
-void HistoryWriter::addIntSample(const QString & tagName, int value)
-{
-	addSample(value, m->intTuples[tagName]);
-}
-
-void HistoryWriter::addBoolSample(const QString & tagName, bool value)
-{
-	addSample(value, m->boolTuples[tagName]);
-}
-
-void HistoryWriter::addRealSample(const QString & tagName, double value)
-{
-	addSample(value, m->realTuples[tagName]);
-}
-
 void HistoryWriter::clearData()
 {
-	m->intTuples.clear();
-	m->boolTuples.clear();
-	m->realTuples.clear();
+	m->intTuples.fill(internal::HistoryTable<int>::Tuple(), values().count());
+	m->boolTuples.fill(internal::HistoryTable<bool>::Tuple(), values().count());
+	m->realTuples.fill(internal::HistoryTable<double>::Tuple(), values().count());
 	m->sampleCounter = 0;
 }
 
 template <typename T>
-void HistoryWriter::addSample(T value, typename internal::HistoryTable<T>::Tuple & tuple)
+void HistoryWriter::addSample(T value, int index, typename internal::HistoryTable<T>::TuplesContainer & tuples)
 {
+	typename internal::HistoryTable<T>::Tuple & tuple = tuples[index];
 	if (tuple.count == 0) {
 		// Initialize candle.
+		tuple.tagId = tagIds().at(index);
+		tuple.tagName = values().at(index)->name();
 		tuple.open = value;
 		tuple.openTime = QDateTime::currentDateTimeUtc();
 	}
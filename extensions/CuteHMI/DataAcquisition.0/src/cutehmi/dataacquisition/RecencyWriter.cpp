@@ -9,6 +9,7 @@ RecencyWriter::RecencyWriter(QObject * parent):
 	AbstractWriter(parent),
 	m(new Members)
 {
+	setTableCollective(& m->dbCollective);
 	m->updateTimer.setSingleShot(true);
 	connect(this, & AbstractWriter::schemaChanged, this, & RecencyWriter::onSchemaChanged);
 }
@@ -122,19 +123,20 @@ void RecencyWriter::updateValues()
 	internal::RecencyTable<bool>::TuplesContainer boolTuples;
 	internal::RecencyTable<double>::TuplesContainer realTuples;
 
-	for (TagValueContainer::const_iterator it = values().begin(); it != values().end(); ++it) {
-		switch ((*it)->value().type()) {
+	for (int i = 0; i < values().count(); i++) {
+		TagValue * tag = values().at(i);
+		switch (tag->value().type()) {
 			case QVariant::Int:
-				intTuples[(*it)->name()] = internal::RecencyTable<int>::Tuple{(*it)->value().toInt(), QDateTime::currentDateTimeUtc()};
+				intTuples.append(internal::RecencyTable<int>::Tuple{tagIds().at(i), tag->name(), tag->value().toInt(), QDateTime::currentDateTimeUtc()});
 				break;
 			case QVariant::Bool:
-				boolTuples[(*it)->name()] = internal::RecencyTable<bool>::Tuple{(*it)->value().toBool(), QDateTime::currentDateTimeUtc()};
+				boolTuples.append(internal::RecencyTable<bool>::Tuple{tagIds().at(i), tag->name(), tag->value().toBool(), QDateTime::currentDateTimeUtc()});
 				break;
 			case QVariant::Double:
-				realTuples[(*it)->name()] = internal::RecencyTable<double>::Tuple{(*it)->value().toDouble(), QDateTime::currentDateTimeUtc()};
+				realTuples.append(internal::RecencyTable<double>::Tuple{tagIds().at(i), tag->name(), tag->value().toDouble(), QDateTime::currentDateTimeUtc()});
 				break;
 			default:
-				CUTEHMI_CRITICAL("Unsupported type ('" << (*it)->value().typeName() << "') provided as a 'value' of 'TagValue' object.");
+				CUTEHMI_CRITICAL("Unsupported type ('" << tag->value().typeName() << "') provided as a 'value' of 'TagValue' object.");
 		}
 	}
 
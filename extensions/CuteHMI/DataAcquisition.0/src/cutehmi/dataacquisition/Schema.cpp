@@ -4,15 +4,24 @@
 #include "../../../cutehmi.dirs.hpp"
 
 #include <QFile>
+#include <QDateTime>
 #include <QSqlRecord>
 
 namespace cutehmi {
 namespace dataacquisition {
 
+constexpr Schema::PartitionPeriod Schema::INITIAL_PARTITION_PERIOD;
+constexpr int Schema::INITIAL_PARTITIONS_AHEAD;
+constexpr int Schema::INITIAL_PARTITION_RETENTION;
+constexpr int Schema::INITIAL_MAINTENANCE_INTERVAL;
+constexpr int Schema::MAX_SQLITE_ARCHIVES;
+
 Schema::Schema(QObject * parent):
 	DataObject(parent),
 	m(new Members)
 {
+	connect(& m->maintenanceTimer, & QTimer::timeout, this, & Schema::maintain);
+	connect(this, & Schema::validated, this, & Schema::onValidated);
 }
 
 QString Schema::name() const
@@ -41,6 +50,96 @@ void Schema::setUser(const QString & user)
 	}
 }
 
+Schema::PartitionPeriod Schema::partitionPeriod() const
+{
+	return m->partitionPeriod;
+}
+
+void Schema::setPartitionPeriod(PartitionPeriod partitionPeriod)
+{
+	if (m->partitionPeriod != partitionPeriod) {
+		m->partitionPeriod = partitionPeriod;
+		emit partitionPeriodChanged();
+	}
+}
+
+int Schema::partitionsAhead() const
+{
+	return m->partitionsAhead;
+}
+
+void Schema::setPartitionsAhead(int partitionsAhead)
+{
+	CUTEHMI_ASSERT(partitionsAhead >= 0, "Value of 'partitionsAhead' property should be non-negative.");
+
+	if (m->partitionsAhead != partitionsAhead) {
+		m->partitionsAhead = partitionsAhead;
+		emit partitionsAheadChanged();
+	}
+}
+
+int Schema::partitionRetention() const
+{
+	return m->partitionRetention;
+}
+
+void Schema::setPartitionRetention(int partitionRetention)
+{
+	CUTEHMI_ASSERT(partitionRetention >= 0, "Value of 'partitionRetention' property should be non-negative.");
+
+	if (m->partitionRetention != partitionRetention) {
+		m->partitionRetention = partitionRetention;
+		emit partitionRetentionChanged();
+	}
+}
+
+int Schema::maintenanceInterval() const
+{
+	return m->maintenanceInterval;
+}
+
+void Schema::setMaintenanceInterval(int maintenanceInterval)
+{
+	CUTEHMI_ASSERT(maintenanceInterval >= 0, "Value of 'maintenanceInterval' property should be non-negative.");
+
+	if (m->maintenanceInterval != maintenanceInterval) {
+		m->maintenanceInterval = maintenanceInterval;
+		if (m->maintenanceTimer.isActive()) {
+			if (maintenanceInterval > 0)
+				m->maintenanceTimer.start(maintenanceInterval);
+			else
+				m->maintenanceTimer.stop();
+		}
+		emit maintenanceIntervalChanged();
+	}
+}
+
+QDate Schema::PeriodStart(const QDate & date, PartitionPeriod period)
+{
+	switch (period) {
+		case DAY:
+			return date;
+		case WEEK:
+			return date.addDays(1 - date.dayOfWeek());
+		case MONTH:
+			return QDate(date.year(), date.month(), 1);
+	}
+	return date;
+}
+
+QDate Schema::AddPeriods(const QDate & date, PartitionPeriod period, int count)
+{
+	switch (period) {
+		case DAY:
+			return date.addDays(count);
+		case WEEK:
+			return date.addDays(7 * count);
+		case MONTH:
+			return date.addMonths(count);
+	}
+	return date;
+}
+
 void Schema::create()
 {
 	worker([this](QSqlDatabase & db) {
@@ -77,6 +176,9 @@ void Schema::create()
 				pushError(query.lastError());
 				query.finish();
 			}
+
+			if (!error && !maintainPartitions(db))
+				warning = true;
 		} else if (db.driverName() == "QSQLITE") {
 			QSqlQuery query(db);
 			try {
@@ -96,6 +198,9 @@ void Schema::create()
 			} catch (const Exception & e) {
 				CUTEHMI_CRITICAL(e.what());
 			}
+
+			if (!error && !maintainPartitions(db))
+				warning = true;
 		} else
 			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
 
@@ -150,6 +255,21 @@ void Schema::drop()
 			} catch (const Exception & e) {
 				CUTEHMI_CRITICAL(e.what());
 			}
+
+			// Archive tables are created by maintenance job, so they are not listed in the script.
+			CUTEHMI_DEBUG("Dropping archive tables...");
+			QStringList archives;
+			query.exec(QString("SELECT name FROM sqlite_master WHERE type = 'table' AND name GLOB '%1.*_p[0-9]*'").arg(name()));
+			pushError(query.lastError());
+			while (query.next())
+				archives.append(query.value(0).toString());
+			query.finish();
+			for (auto && archive : archives) {
+				if (!query.exec(QString("DROP TABLE IF EXISTS [%1]").arg(archive)))
+					warning = true;
+				pushError(query.lastError());
+				query.finish();
+			}
 		} else
 			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
 
@@ -209,6 +329,25 @@ void Schema::validate()
 	})->work();
 }
 
+void Schema::maintain()
+{
+	worker([this](QSqlDatabase & db) {
+		CUTEHMI_DEBUG("Maintaining partitions...");
+
+		if (!maintainPartitions(db))
+			CUTEHMI_WARNING("Maintenance of '" << name() << "' schema partitions wasn't clean.");
+	})->work();
+}
+
+void Schema::onValidated(bool result)
+{
+	// Maintenance job is started once schema has been found valid, which typically happens when writers are being started.
+	if (result && maintenanceInterval() > 0 && !m->maintenanceTimer.isActive()) {
+		maintain();
+		m->maintenanceTimer.start(maintenanceInterval());
+	}
+}
+
 bool Schema::validatePostgresTable(const QString & tableName, QSqlQuery & query)
 {
 	bool result = true;
@@ -254,6 +393,243 @@ bool Schema::validateSqliteTable(const QString & tableName, QSqlQuery & query)
 	return result;
 }
 
+bool Schema::maintainPartitions(QSqlDatabase & db)
+{
+	bool result = true;
+
+	if (db.driverName() == "QPSQL") {
+		result &= maintainPostgresTable("history_int", "open_time", db);
+		result &= maintainPostgresTable("history_bool", "open_time", db);
+		result &= maintainPostgresTable("history_real", "open_time", db);
+
+		result &= maintainPostgresTable("event_int", "time", db);
+		result &= maintainPostgresTable("event_bool", "time", db);
+		result &= maintainPostgresTable("event_real", "time", db);
+	} else if (db.driverName() == "QSQLITE") {
+		result &= maintainSqliteTable("history_int", "open_time", db);
+		result &= maintainSqliteTable("history_bool", "open_time", db);
+		result &= maintainSqliteTable("history_real", "open_time", db);
+
+		result &= maintainSqliteTable("event_int", "time", db);
+		result &= maintainSqliteTable("event_bool", "time", db);
+		result &= maintainSqliteTable("event_real", "time", db);
+	} else {
+		emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
+		result = false;
+	}
+
+	return result;
+}
+
+bool Schema::maintainPostgresTable(const QString & tableName, const QString & timeColumn, QSqlDatabase & db)
+{
+	auto boundary = [](const QDate & date) {
+		return date.toString(Qt::ISODate) + " 00:00:00+00";
+	};
+
+	bool result = true;
+	QSqlQuery query(db);
+
+	// Tables created by versions of the extension, which did not use partitioning, can not have partitions attached. Such tables
+	// are left as they are until the schema is recreated; warning is issued only once, so that it does not flood the log.
+	query.exec(QString("SELECT EXISTS (SELECT 1 FROM pg_partitioned_table WHERE partrelid = to_regclass('%1.%2'))").arg(name()).arg(tableName));
+	pushError(query.lastError());
+	bool partitioned = query.first() && query.value(0).toBool();
+	query.finish();
+	{
+		QMutexLocker locker(& m->unpartitionedTablesMutex);
+		QString qualifiedName = name() + "." + tableName;
+		if (partitioned)
+			m->unpartitionedTables.remove(qualifiedName);
+		else {
+			if (!m->unpartitionedTables.contains(qualifiedName)) {
+				CUTEHMI_WARNING("Table '" << qualifiedName << "' is not partitioned. Skipping partition maintenance of this table. Recreate the schema to enable partitioning.");
+				m->unpartitionedTables.insert(qualifiedName);
+			}
+			return result;
+		}
+	}
+
+	QDate current = PeriodStart(QDateTime::currentDateTimeUtc().date(), partitionPeriod());
+
+	for (int i = 0; i <= partitionsAhead(); i++) {
+		QDate start = AddPeriods(current, partitionPeriod(), i);
+		QDate end = AddPeriods(start, partitionPeriod(), 1);
+		QString partition = partitionName(tableName, start);
+
+		query.exec(QString("SELECT to_regclass('%1.%2') IS NOT NULL").arg(name()).arg(partition));
+		pushError(query.lastError());
+		bool exists = query.first() && query.value(0).toBool();
+		query.finish();
+		if (exists)
+			continue;
+
+		CUTEHMI_DEBUG("Creating '" << partition << "' partition...");
+
+		// Rows, which have landed in default partition, must be moved to the new partition, otherwise it could not be attached.
+		const char * createPartitionQuery = R"SQL(
+			CREATE TABLE %1.%3 (LIKE %1.%2 INCLUDING DEFAULTS INCLUDING CONSTRAINTS);
+			INSERT INTO %1.%3 SELECT * FROM %1.%2_default WHERE %4 >= '%5' AND %4 < '%6';
+			DELETE FROM %1.%2_default WHERE %4 >= '%5' AND %4 < '%6';
+			ALTER TABLE %1.%2 ATTACH PARTITION %1.%3 FOR VALUES FROM ('%5') TO ('%6');
+		)SQL";
+
+		if (!query.exec(QString(createPartitionQuery).arg(name(), tableName, partition, timeColumn, boundary(start), boundary(end))))
+			result = false;
+		pushError(query.lastError());
+		query.finish();
+	}
+
+	if (partitionRetention() > 0) {
+		QDate cutoff = AddPeriods(current, partitionPeriod(), -partitionRetention());
+
+		const char * partitionsQuery = R"SQL(
+			SELECT pg_class.relname FROM pg_inherits JOIN pg_class ON pg_inherits.inhrelid = pg_class.oid
+			WHERE pg_inherits.inhparent = '%1.%2'::regclass;
+		)SQL";
+
+		QStringList expired;
+		query.exec(QString(partitionsQuery).arg(name()).arg(tableName));
+		pushError(query.lastError());
+		while (query.next()) {
+			QDate start = partitionStart(tableName, query.value(0).toString());
+			if (start.isValid() && AddPeriods(start, partitionPeriod(), 1) <= cutoff)
+				expired.append(query.value(0).toString());
+		}
+		query.finish();
+
+		for (auto && partition : expired) {
+			CUTEHMI_DEBUG("Dropping '" << partition << "' partition...");
+
+			if (!query.exec(QString("DROP TABLE %1.%2").arg(name()).arg(partition)))
+				result = false;
+			pushError(query.lastError());
+			query.finish();
+		}
+	}
+
+	return result;
+}
+
+bool Schema::maintainSqliteTable(const QString & tableName, const QString & timeColumn, QSqlDatabase & db)
+{
+	// Times are stored as ISO 8601 strings in UTC, so they can be compared lexicographically.
+	auto boundary = [](const QDate & date) {
+		return date.toString(Qt::ISODate) + "T00:00:00";
+	};
+
+	bool result = true;
+	QSqlQuery query(db);
+	QDate current = PeriodStart(QDateTime::currentDateTimeUtc().date(), partitionPeriod());
+
+	// Move rows older than current period to archive tables, one period at a time.
+	forever {
+		query.exec(QString("SELECT MIN(%3) FROM [%1.%2] WHERE %3 < '%4'").arg(name(), tableName, timeColumn, boundary(current)));
+		pushError(query.lastError());
+		QDateTime oldest = query.first() ? QDateTime::fromString(query.value(0).toString(), Qt::ISODate) : QDateTime();
+		query.finish();
+		if (!oldest.isValid())
+			break;
+
+		QDate start = PeriodStart(oldest.toUTC().date(), partitionPeriod());
+		QDate end = AddPeriods(start, partitionPeriod(), 1);
+		QString partition = partitionName(tableName, start);
+
+		CUTEHMI_DEBUG("Moving rows to '" << partition << "' archive table...");
+
+		const char * archiveQueries[] = {
+			"CREATE TABLE IF NOT EXISTS [%1.%3] AS SELECT * FROM [%1.%2] WHERE 0",
+			"CREATE INDEX IF NOT EXISTS [%1.index_%3_tag_id_%4] ON [%1.%3] (tag_id, %4)",
+			"INSERT INTO [%1.%3] SELECT * FROM [%1.%2] WHERE %4 >= '%5' AND %4 < '%6'",
+			"DELETE FROM [%1.%2] WHERE %4 >= '%5' AND %4 < '%6'"
+		};
+
+		int deleted = 0;	// Amount of rows affected by the last query, which is the DELETE statement.
+		bool moved = db.transaction();
+		for (auto && archiveQuery : archiveQueries) {
+			if (!moved)
+				break;
+			moved = query.exec(QString(archiveQuery).arg(name(), tableName, partition, timeColumn, boundary(start), boundary(end)));
+			pushError(query.lastError());
+			deleted = query.numRowsAffected();
+			query.finish();
+		}
+
+		if (moved)
+			moved = db.commit();
+		if (!moved) {
+			pushError(db.lastError());
+			db.rollback();
+			result = false;
+			break;
+		}
+
+		// Times, which are not stored in UTC (e.g. with zone offset), may compare below the boundary and yet fall outside of the
+		// period range. Such rows would be selected over and over again, so the loop has to give up on them.
+		if (deleted <= 0) {
+			CUTEHMI_WARNING("Could not move rows older than '" << oldest.toString(Qt::ISODate) << "' from '" << tableName << "' table to archive tables. Times are expected to be stored in UTC.");
+			break;
+		}
+	}
+
+	QStringList archives;
+	query.exec(QString("SELECT name FROM sqlite_master WHERE type = 'table' AND name GLOB '%1.%2_p[0-9]*' ORDER BY name").arg(name()).arg(tableName));
+	pushError(query.lastError());
+	while (query.next())
+		archives.append(query.value(0).toString().mid(name().length() + 1));
+	query.finish();
+
+	if (partitionRetention() > 0) {
+		QDate cutoff = AddPeriods(current, partitionPeriod(), -partitionRetention());
+		for (auto archive = archives.begin(); archive != archives.end(); ) {
+			QDate start = partitionStart(tableName, *archive);
+			if (start.isValid() && AddPeriods(start, partitionPeriod(), 1) <= cutoff) {
+				CUTEHMI_DEBUG("Dropping '" << *archive << "' archive table...");
+
+				if (!query.exec(QString("DROP TABLE IF EXISTS [%1.%2]").arg(name()).arg(*archive)))
+					result = false;
+				pushError(query.lastError());
+				query.finish();
+				archive = archives.erase(archive);
+			} else
+				++archive;
+		}
+	}
+
+	// SQLite limits amount of terms in compound select, so only the most recent archives can be exposed through the view.
+	if (archives.count() > MAX_SQLITE_ARCHIVES) {
+		CUTEHMI_WARNING("Only " << MAX_SQLITE_ARCHIVES << " most recent archive tables of '" << tableName << "' table are exposed through '" << tableName << "_all' view. Consider setting partition retention.");
+		archives = archives.mid(archives.count() - MAX_SQLITE_ARCHIVES);
+	}
+
+	QString viewQuery = QString("CREATE VIEW [%1.%2_all] AS SELECT * FROM [%1.%2]").arg(name()).arg(tableName);
+	for (auto && archive : archives)
+		viewQuery.append(QString(" UNION ALL SELECT * FROM [%1.%2]").arg(name()).arg(archive));
+
+	for (auto && statement : {QString("DROP VIEW IF EXISTS [%1.%2_all]").arg(name()).arg(tableName), viewQuery}) {
+		if (!query.exec(statement))
+			result = false;
+		pushError(query.lastError());
+		query.finish();
+	}
+
+	return result;
+}
+
+QString Schema::partitionName(const QString & tableName, const QDate & start) const
+{
+	return tableName + "_p" + start.toString("yyyyMMdd");
+}
+
+QDate Schema::partitionStart(const QString & tableName, const QString & partitionName) const
+{
+	QString prefix = tableName + "_p";
+	if (!partitionName.startsWith(prefix))
+		return QDate();
+
+	return QDate::fromString(partitionName.mid(prefix.length()), "yyyyMMdd");
+}
+
 QString Schema::readScript(const QString & dbms, const QString & scriptName) const
 {
 	QFile file(QString(CUTEHMI_DIRS_TOOL_RELATIVE_PATH) + "/" + SQL_SCRIPTS_SUBDIR + "/" + dbms + "/" + scriptName);
@@ -0,0 +1,455 @@
+#include <cutehmi/dataacquisition/internal/BulkLoader.hpp>
+
+#include <QSqlDriver>
+#include <QSqlQuery>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+
+#ifdef CUTEHMI_DATAACQUISITION_LIBPQ
+#include <libpq-fe.h>
+#endif
+
+namespace cutehmi {
+namespace dataacquisition {
+namespace internal {
+
+constexpr int BulkLoader::MAX_PARAMETERS;
+constexpr int BulkLoader::MAX_ROWS;
+constexpr int BulkLoader::COPY_BUFFER_SIZE;
+
+BulkLoader::BulkLoader(QSqlDatabase & db, const QString & schemaName, const QString & tableName, const QStringList & columns):
+	m(new Members{db, schemaName, tableName, columns, {}, {}})
+{
+}
+
+void BulkLoader::setConflictTarget(const QStringList & columns)
+{
+	m->conflictTarget = columns;
+}
+
+bool BulkLoader::load(const QList<QVariantList> & values, Method method)
+{
+	CUTEHMI_ASSERT(values.count() == m->columns.count(), "amount of value lists must match amount of columns");
+
+	m->lastError = QSqlError();
+
+	int rows = values.isEmpty() ? 0 : values.first().count();
+	if (rows == 0)
+		return true;
+
+	method = resolve(method);
+
+	QElapsedTimer timer;
+	timer.start();
+
+	bool result;
+	switch (method) {
+		case COPY_BINARY:
+			result = loadCopy(values, true);
+			break;
+		case COPY_TEXT:
+			result = loadCopy(values, false);
+			break;
+		case BATCH:
+			result = loadBatch(values);
+			break;
+		default:
+			result = loadValues(values);
+	}
+
+	CUTEHMI_DEBUG("Loaded " << rows << " rows into '" << m->tableName << "' table using " << MethodName(method) << " method in " << timer.nsecsElapsed() / 1000 << " us.");
+
+	return result;
+}
+
+QSqlError BulkLoader::lastError() const
+{
+	return m->lastError;
+}
+
+BulkLoader::Method BulkLoader::DefaultMethod()
+{
+	static const Method Result = []() {
+		QByteArray name = qgetenv("CUTEHMI_DATAACQUISITION_BULK_METHOD");
+		if (name.isEmpty() || name == "auto")
+			return AUTO;
+		if (name == "copy-binary")
+			return COPY_BINARY;
+		if (name == "copy-text")
+			return COPY_TEXT;
+		if (name == "values")
+			return VALUES;
+		if (name == "batch")
+			return BATCH;
+
+		CUTEHMI_WARNING("Unrecognized bulk loading method '" << name << "'; using default method.");
+		return AUTO;
+	}();
+
+	return Result;
+}
+
+bool BulkLoader::CopySupported()
+{
+#ifdef CUTEHMI_DATAACQUISITION_LIBPQ
+	return true;
+#else
+	return false;
+#endif
+}
+
+BulkLoader::Method BulkLoader::resolve(Method method) const
+{
+	if (method == BATCH || method == VALUES)
+		return method;
+
+	if (m->db.driverName() == "QPSQL" && CopySupported()) {
+		QVariant handle = m->db.driver()->handle();
+		if (handle.isValid() && qstrcmp(handle.typeName(), "PGconn*") == 0)
+			return method == AUTO ? COPY_BINARY : method;
+	}
+
+	if (method != AUTO)
+		CUTEHMI_DEBUG("COPY protocol is not available for '" << m->db.driverName() << "' connection; falling back to multi-row VALUES.");
+
+	return VALUES;
+}
+
+bool BulkLoader::loadCopy(const QList<QVariantList> & values, bool binary)
+{
+#ifdef CUTEHMI_DATAACQUISITION_LIBPQ
+	PGconn * connection = *static_cast<PGconn * const *>(m->db.driver()->handle().constData());
+
+	auto fail = [this, connection](const QString & driverText) {
+		setError(QSqlError(driverText, QString::fromUtf8(PQerrorMessage(connection)), QSqlError::StatementError));
+		m->db.rollback();
+		return false;
+	};
+
+	auto exec = [connection](const QString & statement) {
+		PGresult * pgResult = PQexec(connection, statement.toUtf8().constData());
+		bool result = PQresultStatus(pgResult) == PGRES_COMMAND_OK;
+		PQclear(pgResult);
+		return result;
+	};
+
+	if (!m->db.transaction()) {
+		setError(m->db.lastError());
+		return false;
+	}
+
+	// Upsert can not be performed with COPY directly, so rows are copied into temporary table and then merged into target table.
+	QString copyTable = qualifiedTableName();
+	if (!m->conflictTarget.isEmpty()) {
+		copyTable = QString("cutehmi_bulk_%1").arg(m->tableName);
+		if (!exec(QString("CREATE TEMPORARY TABLE %1 ON COMMIT DROP AS SELECT %2 FROM %3 WITH NO DATA").arg(copyTable).arg(columnList()).arg(qualifiedTableName())))
+			return fail(QStringLiteral("Could not create temporary table for COPY."));
+	}
+
+	PGresult * pgResult = PQexec(connection, QString("COPY %1 (%2) FROM STDIN%3").arg(copyTable).arg(columnList()).arg(binary ? " WITH (FORMAT binary)" : "").toUtf8().constData());
+	ExecStatusType status = PQresultStatus(pgResult);
+	PQclear(pgResult);
+	if (status != PGRES_COPY_IN)
+		return fail(QStringLiteral("Could not start COPY."));
+
+	QByteArray buffer;
+	buffer.reserve(COPY_BUFFER_SIZE + 1024);
+
+	if (binary) {
+		// Signature, flags field and header extension length.
+		buffer.append("PGCOPY\n\377\r\n\0", 11);
+		buffer.append(QByteArray(8, '\0'));
+	}
+
+	int columns = values.count();
+	int rows = values.first().count();
+	for (int row = 0; row < rows; row++) {
+		if (binary) {
+			qint16 fieldCount = qToBigEndian(static_cast<qint16>(columns));
+			buffer.append(reinterpret_cast<const char *>(& fieldCount), sizeof(fieldCount));
+			for (int column = 0; column < columns; column++)
+				AppendCopyBinary(buffer, values.at(column).at(row));
+		} else {
+			for (int column = 0; column < columns; column++) {
+				if (column > 0)
+					buffer.append('\t');
+				buffer.append(CopyText(values.at(column).at(row)));
+			}
+			buffer.append('\n');
+		}
+
+		if (buffer.size() >= COPY_BUFFER_SIZE) {
+			if (PQputCopyData(connection, buffer.constData(), buffer.size()) != 1) {
+				PQputCopyEnd(connection, "Could not send COPY data.");
+				PQclear(PQgetResult(connection));
+				return fail(QStringLiteral("Could not send COPY data."));
+			}
+			buffer.clear();
+		}
+	}
+
+	if (binary) {
+		qint16 trailer = qToBigEndian(static_cast<qint16>(-1));
+		buffer.append(reinterpret_cast<const char *>(& trailer), sizeof(trailer));
+	}
+
+	if (PQputCopyData(connection, buffer.constData(), buffer.size()) != 1 || PQputCopyEnd(connection, nullptr) != 1)
+		return fail(QStringLiteral("Could not send COPY data."));
+
+	bool copied = true;
+	while ((pgResult = PQgetResult(connection)) != nullptr) {
+		if (PQresultStatus(pgResult) != PGRES_COMMAND_OK)
+			copied = false;
+		PQclear(pgResult);
+	}
+	if (!copied)
+		return fail(QStringLiteral("COPY has failed."));
+
+	if (!m->conflictTarget.isEmpty())
+		if (!exec(QString("INSERT INTO %1 (%2) SELECT %2 FROM %3%4").arg(qualifiedTableName()).arg(columnList()).arg(copyTable).arg(conflictClause())))
+			return fail(QStringLiteral("Could not merge copied rows."));
+
+	if (!m->db.commit()) {
+		setError(m->db.lastError());
+		m->db.rollback();
+		return false;
+	}
+
+	return true;
+#else
+	Q_UNUSED(binary)
+
+	return loadValues(values);
+#endif
+}
+
+bool BulkLoader::loadValues(const QList<QVariantList> & values)
+{
+	int rows = values.first().count();
+	int chunk = qMin(MAX_ROWS, MAX_PARAMETERS / m->columns.count());
+
+	// Without explicit transaction SQLite would commit (and sync) each statement separately.
+	bool transaction = m->db.transaction();
+
+	bool result = true;
+	for (int first = 0; first < rows && result; first += chunk)
+		result = execValues(values, first, qMin(chunk, rows - first));
+
+	if (transaction) {
+		if (!result)
+			m->db.rollback();
+		else if (!m->db.commit()) {
+			setError(m->db.lastError());
+			m->db.rollback();
+			result = false;
+		}
+	}
+
+	return result;
+}
+
+bool BulkLoader::loadBatch(const QList<QVariantList> & values)
+{
+	QStringList placeholders;
+	for (int column = 0; column < m->columns.count(); column++)
+		placeholders.append("?");
+
+	bool transaction = m->db.transaction();
+
+	QSqlQuery query(m->db);
+	query.prepare(QString("INSERT INTO %1 (%2) VALUES (%3)%4").arg(qualifiedTableName()).arg(columnList()).arg(placeholders.join(", ")).arg(conflictClause()));
+	for (auto && columnValues : values)
+		query.addBindValue(columnValues);
+	bool result = query.execBatch();
+	if (!result)
+		setError(query.lastError());
+	query.finish();
+
+	if (transaction) {
+		if (!result)
+			m->db.rollback();
+		else if (!m->db.commit()) {
+			setError(m->db.lastError());
+			m->db.rollback();
+			result = false;
+		}
+	}
+
+	return result;
+}
+
+bool BulkLoader::execValues(const QList<QVariantList> & values, int first, int count)
+{
+	QStringList placeholders;
+	for (int column = 0; column < m->columns.count(); column++)
+		placeholders.append("?");
+	QString row = QString("(%1)").arg(placeholders.join(", "));
+
+	QString rowsString;
+	rowsString.reserve((row.length() + 2) * count);
+	for (int i = 0; i < count; i++) {
+		if (i > 0)
+			rowsString.append(", ");
+		rowsString.append(row);
+	}
+
+	QSqlQuery query(m->db);
+	query.prepare(QString("INSERT INTO %1 (%2) VALUES %3%4").arg(qualifiedTableName()).arg(columnList()).arg(rowsString).arg(conflictClause()));
+	for (int i = first; i < first + count; i++)
+		for (auto && columnValues : values)
+			query.addBindValue(columnValues.at(i));
+
+	bool result = query.exec();
+	if (!result)
+		setError(query.lastError());
+	query.finish();
+
+	return result;
+}
+
+QString BulkLoader::qualifiedTableName() const
+{
+	if (m->db.driverName() == "QSQLITE")
+		return QString("[%1.%2]").arg(m->schemaName).arg(m->tableName);
+	return QString("%1.%2").arg(m->schemaName).arg(m->tableName);
+}
+
+QString BulkLoader::columnList() const
+{
+	return m->columns.join(", ");
+}
+
+QString BulkLoader::conflictClause() const
+{
+	if (m->conflictTarget.isEmpty())
+		return QString();
+
+	QStringList assignments;
+	for (auto && column : m->columns)
+		if (!m->conflictTarget.contains(column))
+			assignments.append(QString("%1 = excluded.%1").arg(column));
+
+	if (assignments.isEmpty())
+		return QString(" ON CONFLICT (%1) DO NOTHING").arg(m->conflictTarget.join(", "));
+
+	return QString(" ON CONFLICT (%1) DO UPDATE SET %2").arg(m->conflictTarget.join(", ")).arg(assignments.join(", "));
+}
+
+void BulkLoader::setError(const QSqlError & error)
+{
+	m->lastError = error;
+}
+
+QByteArray BulkLoader::CopyText(const QVariant & value)
+{
+	if (value.isNull())
+		return QByteArrayLiteral("\\N");
+
+	switch (static_cast<QMetaType::Type>(value.type())) {
+		case QMetaType::Bool:
+			return value.toBool() ? QByteArrayLiteral("t") : QByteArrayLiteral("f");
+		case QMetaType::Int:
+		case QMetaType::LongLong:
+			return QByteArray::number(value.toLongLong());
+		case QMetaType::Double: {
+			double number = value.toDouble();
+			if (std::isnan(number))
+				return QByteArrayLiteral("NaN");
+			if (std::isinf(number))
+				return number > 0.0 ? QByteArrayLiteral("Infinity") : QByteArrayLiteral("-Infinity");
+			return QByteArray::number(number, 'g', 17);
+		}
+		case QMetaType::QDateTime:
+			return value.toDateTime().toUTC().toString(Qt::ISODateWithMs).toUtf8();
+		default: {
+			QByteArray result;
+			for (char c : value.toString().toUtf8()) {
+				switch (c) {
+					case '\\':
+						result.append("\\\\");
+						break;
+					case '\t':
+						result.append("\\t");
+						break;
+					case '\n':
+						result.append("\\n");
+						break;
+					case '\r':
+						result.append("\\r");
+						break;
+					default:
+						result.append(c);
+				}
+			}
+			return result;
+		}
+	}
+}
+
+void BulkLoader::AppendCopyBinary(QByteArray & buffer, const QVariant & value)
+{
+	auto append = [& buffer](auto field) {
+		qint32 length = qToBigEndian(static_cast<qint32>(sizeof(field)));
+		field = qToBigEndian(field);
+		buffer.append(reinterpret_cast<const char *>(& length), sizeof(length));
+		buffer.append(reinterpret_cast<const char *>(& field), sizeof(field));
+	};
+
+	if (value.isNull()) {
+		qint32 length = qToBigEndian(static_cast<qint32>(-1));
+		buffer.append(reinterpret_cast<const char *>(& length), sizeof(length));
+		return;
+	}
+
+	// Binary format must match column types exactly (bool, integer, double precision and timestamptz respectively).
+	switch (static_cast<QMetaType::Type>(value.type())) {
+		case QMetaType::Bool:
+			append(static_cast<quint8>(value.toBool()));
+			break;
+		case QMetaType::Double: {
+			double number = value.toDouble();
+			quint64 bits;
+			std::memcpy(& bits, & number, sizeof(bits));
+			append(bits);
+			break;
+		}
+		case QMetaType::QDateTime: {
+			// PostgreSQL timestamps are expressed in microseconds since 2000-01-01 00:00:00 UTC.
+			static constexpr qint64 POSTGRES_EPOCH = Q_INT64_C(946684800000);
+			append(static_cast<qint64>((value.toDateTime().toMSecsSinceEpoch() - POSTGRES_EPOCH) * 1000));
+			break;
+		}
+		default:
+			append(static_cast<qint32>(value.toInt()));
+	}
+}
+
+const char * BulkLoader::MethodName(Method method)
+{
+	switch (method) {
+		case COPY_BINARY:
+			return "binary COPY";
+		case COPY_TEXT:
+			return "text COPY";
+		case VALUES:
+			return "multi-row VALUES";
+		case BATCH:
+			return "batch";
+		default:
+			return "auto";
+	}
+}
+
+}
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
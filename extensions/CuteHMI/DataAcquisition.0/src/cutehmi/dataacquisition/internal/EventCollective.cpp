@@ -1,5 +1,4 @@
 #include <cutehmi/dataacquisition/internal/EventCollective.hpp>
-#include <cutehmi/dataacquisition/TagValue.hpp>
 
 namespace cutehmi {
 namespace dataacquisition {
@@ -10,38 +9,46 @@ EventCollective::EventCollective():
 {
 }
 
-void EventCollective::insert(const TagValue & tag)
+void EventCollective::insert(const EventsContainer & events)
 {
-	switch (tag.value().type()) {
-		case QVariant::Int:
-			insertIntoTable<int>(tag, m->eventInt);
-			break;
-		case QVariant::Bool:
-			insertIntoTable<bool>(tag, m->eventBool);
-			break;
-		case QVariant::Double:
-			insertIntoTable<double>(tag, m->eventReal);
-			break;
-		default:
-			CUTEHMI_CRITICAL("Unsupported type ('" << tag.value().typeName() << "') provided as a 'value' of 'TagValue' object.");
+	EventTable<int>::TuplesContainer intTuples;
+	EventTable<bool>::TuplesContainer boolTuples;
+	EventTable<double>::TuplesContainer realTuples;
+
+	for (EventsContainer::const_iterator it = events.begin(); it != events.end(); ++it) {
+		switch (it->value.type()) {
+			case QVariant::Int:
+				intTuples.append(EventTable<int>::Tuple{it->tagId, it->tagName, it->value.toInt(), it->time});
+				break;
+			case QVariant::Bool:
+				boolTuples.append(EventTable<bool>::Tuple{it->tagId, it->tagName, it->value.toBool(), it->time});
+				break;
+			case QVariant::Double:
+				realTuples.append(EventTable<double>::Tuple{it->tagId, it->tagName, it->value.toDouble(), it->time});
+				break;
+			default:
+				CUTEHMI_CRITICAL("Unsupported type ('" << it->value.typeName() << "') provided as a 'value' of 'TagValue' object.");
+		}
 	}
+
+	if (!intTuples.isEmpty())
+		insertIntoTable<int>(intTuples, m->eventInt);
+	if (!boolTuples.isEmpty())
+		insertIntoTable<bool>(boolTuples, m->eventBool);
+	if (!realTuples.isEmpty())
+		insertIntoTable<double>(realTuples, m->eventReal);
 }
 
 void EventCollective::updateSchema(Schema * schema)
 {
-	m->tagCache.reset(new TagCache(schema));
-	m->eventInt.reset(new EventTable<int>(m->tagCache.get(), schema));
-	m->eventBool.reset(new EventTable<bool>(m->tagCache.get(), schema));
-	m->eventReal.reset(new EventTable<double>(m->tagCache.get(), schema));
+	m->eventInt.reset(new EventTable<int>(tagCache(), schema));
+	m->eventBool.reset(new EventTable<bool>(tagCache(), schema));
+	m->eventReal.reset(new EventTable<double>(tagCache(), schema));
 
-	connect(m->tagCache.get(), & DataObject::errored, this, & EventCollective::errored);
 	connect(m->eventInt.get(), & DataObject::errored, this, & EventCollective::errored);
 	connect(m->eventBool.get(), & DataObject::errored, this, & EventCollective::errored);
 	connect(m->eventReal.get(), & DataObject::errored, this, & EventCollective::errored);
 
-	connect(m->tagCache.get(), & DataObject::busyChanged, this, [this, tag = m->tagCache.get()]() {
-		accountInsertBusy(tag->busy());
-	});
 	connect(m->eventInt.get(), & DataObject::busyChanged, this, [this, eventInt = m->eventInt.get()] {
 		accountInsertBusy(eventInt->busy());
 	});
@@ -54,12 +61,10 @@ void EventCollective::updateSchema(Schema * schema)
 }
 
 template<typename T>
-void EventCollective::insertIntoTable(const TagValue & tag, std::unique_ptr<EventTable<T>> & table)
+void EventCollective::insertIntoTable(const typename EventTable<T>::TuplesContainer & tuples, std::unique_ptr<EventTable<T>> & table)
 {
-	typedef typename EventTable<T>::Tuple Tuple;
-
 	if (table)
-		table->insert(tag.name(), Tuple{tag.value().value<T>(), QDateTime::currentDateTimeUtc()});
+		table->insert(tuples);
 	else
 		CUTEHMI_CRITICAL("Can not insert into '" << TableNameTraits<T>::Affixed("event") << "' table, because table object is not available.");
 }
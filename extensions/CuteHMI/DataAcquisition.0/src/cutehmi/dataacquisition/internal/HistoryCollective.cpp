@@ -26,19 +26,14 @@ void HistoryCollective::insert(const HistoryTable<double>::TuplesContainer & tup
 
 void HistoryCollective::updateSchema(Schema * schema)
 {
-	m->tagCache.reset(new TagCache(schema));
-	m->historyInt.reset(new HistoryTable<int>(m->tagCache.get(), schema));
-	m->historyBool.reset(new HistoryTable<bool>(m->tagCache.get(), schema));
-	m->historyReal.reset(new HistoryTable<double>(m->tagCache.get(), schema));
+	m->historyInt.reset(new HistoryTable<int>(tagCache(), schema));
+	m->historyBool.reset(new HistoryTable<bool>(tagCache(), schema));
+	m->historyReal.reset(new HistoryTable<double>(tagCache(), schema));
 
-	connect(m->tagCache.get(), & DataObject::errored, this, & TableCollective::errored);
 	connect(m->historyInt.get(), & DataObject::errored, this, & TableCollective::errored);
 	connect(m->historyBool.get(), & DataObject::errored, this, & TableCollective::errored);
 	connect(m->historyReal.get(), & DataObject::errored, this, & TableCollective::errored);
 
-	connect(m->tagCache.get(), & DataObject::busyChanged, this, [this, tag = m->tagCache.get()]() {
-		accountInsertBusy(tag->busy());
-	});
 	connect(m->historyInt.get(), & DataObject::busyChanged, this, [this, historyInt = m->historyInt.get()] {
 		accountInsertBusy(historyInt->busy());
 	});
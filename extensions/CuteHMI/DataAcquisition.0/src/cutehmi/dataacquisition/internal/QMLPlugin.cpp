@@ -7,6 +7,8 @@
 #include <cutehmi/dataacquisition/HistoryWriter.hpp>
 #include <cutehmi/dataacquisition/EventWriter.hpp>
 #include <cutehmi/dataacquisition/RecencyWriter.hpp>
+#include <cutehmi/dataacquisition/HistoryReader.hpp>
+#include <cutehmi/dataacquisition/HistoryModel.hpp>
 
 #include <QtQml>
 
@@ -26,6 +28,8 @@ void QMLPlugin::registerTypes(const char * uri)
 	qmlRegisterType<HistoryWriter>(uri, CUTEHMI_DATAACQUISITION_MAJOR, 0, "HistoryWriter");
 	qmlRegisterType<RecencyWriter>(uri, CUTEHMI_DATAACQUISITION_MAJOR, 0, "RecencyWriter");
 	qmlRegisterType<EventWriter>(uri, CUTEHMI_DATAACQUISITION_MAJOR, 0, "EventWriter");
+	qmlRegisterType<HistoryReader>(uri, CUTEHMI_DATAACQUISITION_MAJOR, 0, "HistoryReader");
+	qmlRegisterType<HistoryModel>(uri, CUTEHMI_DATAACQUISITION_MAJOR, 0, "HistoryModel");
 }
 
 }
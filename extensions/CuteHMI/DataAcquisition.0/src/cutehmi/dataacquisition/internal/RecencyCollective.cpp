@@ -26,19 +26,14 @@ void RecencyCollective::update(const RecencyTable<double>::TuplesContainer & tup
 
 void RecencyCollective::updateSchema(Schema * schema)
 {
-	m->tagCache.reset(new TagCache(schema));
-	m->recencyInt.reset(new RecencyTable<int>(m->tagCache.get(), schema));
-	m->recencyBool.reset(new RecencyTable<bool>(m->tagCache.get(), schema));
-	m->recencyReal.reset(new RecencyTable<double>(m->tagCache.get(), schema));
+	m->recencyInt.reset(new RecencyTable<int>(tagCache(), schema));
+	m->recencyBool.reset(new RecencyTable<bool>(tagCache(), schema));
+	m->recencyReal.reset(new RecencyTable<double>(tagCache(), schema));
 
-	connect(m->tagCache.get(), & DataObject::errored, this, & TableCollective::errored);
 	connect(m->recencyInt.get(), & DataObject::errored, this, & TableCollective::errored);
 	connect(m->recencyBool.get(), & DataObject::errored, this, & TableCollective::errored);
 	connect(m->recencyReal.get(), & DataObject::errored, this, & TableCollective::errored);
 
-	connect(m->tagCache.get(), & DataObject::busyChanged, this, [this, tag = m->tagCache.get()]() {
-		accountInsertBusy(tag->busy());
-	});
 	connect(m->recencyInt.get(), & DataObject::busyChanged, this, [this, recencyInt = m->recencyInt.get()] {
 		accountInsertBusy(recencyInt->busy());
 	});
@@ -19,6 +19,13 @@ void TableCollective::setSchema(Schema * schema)
 	if (m->schema)
 		m->schema->disconnect(this);
 
+	m->tagCache.reset(new TagCache(schema));
+	connect(m->tagCache.get(), & DataObject::errored, this, & TableCollective::errored);
+	connect(m->tagCache.get(), & DataObject::busyChanged, this, [this, tag = m->tagCache.get()]() {
+		accountInsertBusy(tag->busy());
+	});
+	connect(m->tagCache.get(), & TagCache::resolved, this, & TableCollective::tagsResolved);
+
 	updateSchema(schema);
 
 	m->schema = schema;
@@ -29,12 +36,25 @@ void TableCollective::setSchema(Schema * schema)
 	});
 }
 
+void TableCollective::resolveTags(const QStringList & names)
+{
+	if (m->tagCache)
+		m->tagCache->resolve(names);
+	else
+		CUTEHMI_CRITICAL("Can not resolve tags, because tag cache is not available.");
+}
+
 void TableCollective::confirmWorkersFinished()
 {
 	if (m->insertsBusy == 0)
 		emit workersFinished();
 }
 
+TagCache * TableCollective::tagCache() const
+{
+	return m->tagCache.get();
+}
+
 void TableCollective::accountInsertBusy(bool busy)
 {
 	if (busy)
@@ -1,4 +1,5 @@
 #include <cutehmi/dataacquisition/internal/TagCache.hpp>
+#include <cutehmi/dataacquisition/internal/BulkLoader.hpp>
 
 #include <QSqlRecord>
 #include <QSqlResult>
@@ -13,93 +14,123 @@ TagCache::TagCache(Schema * schema, QObject * parent):
 {
 }
 
-int TagCache::getId(const QString & name, QSqlDatabase & db)
+void TagCache::resolve(const QStringList & names)
 {
-	TagIdContainter::const_iterator tag;
-	TagIdContainter::const_iterator tagIdsEnd;
-	bool tagIdsEmpty;
+	worker([this, names](QSqlDatabase & db) {
+		getIds(names, db);
+	})->work();
+}
 
-	// Access to m->tagIds is a critical section.
-	{
-		QReadLocker locker(& m->tagIdsLock);
-		tag = m->tagIds.find(name);
-		tagIdsEnd = m->tagIds.end();
-		tagIdsEmpty = m->tagIds.empty();
-	}
+TagCache::IdsContainer TagCache::getIds(const QStringList & names, QSqlDatabase & db)
+{
+	IdsContainer ids(names.count(), 0);
+	QStringList missing = lookup(names, ids);
+
+	if (!missing.isEmpty()) {
+		bool tagIdsEmpty;
+
+		// Access to m->tagIds is a critical section.
+		{
+			QReadLocker locker(& m->tagIdsLock);
+			tagIdsEmpty = m->tagIds.empty();
+		}
 
-	if (tag == tagIdsEnd) {
 		// If tag ids map is empty update it from database.
 		if (tagIdsEmpty) {
 			update(db);
-			{
-				QReadLocker locker(& m->tagIdsLock);
-				tag = m->tagIds.find(name);
-				tagIdsEnd = m->tagIds.end();
-			}
+			missing = lookup(names, ids);
 		}
 
-		// If tag wasn't found it probably does not exist in database, so insert it.
-		if (tag == tagIdsEnd) {
-			insert(name, db);
-			{
-				QReadLocker locker(& m->tagIdsLock);
-				tag = m->tagIds.find(name);
-				tagIdsEnd = m->tagIds.end();
-			}
-
-			// If insert query fails, then some other thread might have inserted it.
-			if (tag == tagIdsEnd) {
-				update(db);
-				{
-					QReadLocker locker(& m->tagIdsLock);
-					tag = m->tagIds.find(name);
-				}
-			}
+		// Tags, which weren't found probably do not exist in database, so insert them all at once. Some other thread might have
+		// inserted some of them in the meantime, so conflicts are ignored and ids are selected afterwards.
+		if (!missing.isEmpty()) {
+			missing.removeDuplicates();
+			insert(missing, db);
+			select(missing, db);
+			missing = lookup(names, ids);
 		}
 
 		processErrors();
 	}
 
-	return tag.value();
+	emit resolved(names, ids);
+
+	return ids;
 }
 
-void TagCache::insert(const QString & name, QSqlDatabase & db)
+QVariantList TagCache::completeIds(const QVariantList & ids, const QStringList & names, QSqlDatabase & db)
 {
-	if (db.driverName() == "QPSQL") {
-		QSqlQuery query(db);
-		CUTEHMI_DEBUG("Inserting '" << name << "' tag...");
+	QStringList unresolvedNames;
+	QVector<int> unresolvedIndices;
+	for (int i = 0; i < ids.count(); i++)
+		if (ids.at(i).toInt() == 0) {
+			unresolvedNames.append(names.at(i));
+			unresolvedIndices.append(i);
+		}
 
-		query.prepare(QString("INSERT INTO %1.tag (name) VALUES (:name) RETURNING id").arg(schema()->name()));
-		query.bindValue(":name", name);
-		query.exec();
-		int idIndex = query.record().indexOf("id");
+	if (unresolvedNames.isEmpty())
+		return ids;
 
-		if (query.first()) {
-			QWriteLocker locker(& m->tagIdsLock);
-			m->tagIds[name] = query.value(idIndex).toInt();
-		}
-		pushError(query.lastError());
-	} else if (db.driverName() == "QSQLITE") {
+	QVariantList result = ids;
+	IdsContainer resolvedIds = getIds(unresolvedNames, db);
+	for (int i = 0; i < unresolvedIndices.count(); i++)
+		result[unresolvedIndices.at(i)] = resolvedIds.at(i);
+
+	return result;
+}
+
+void TagCache::insert(const QStringList & names, QSqlDatabase & db)
+{
+	for (int first = 0; first < names.count(); first += BulkLoader::MAX_PARAMETERS) {
+		QStringList chunk = names.mid(first, BulkLoader::MAX_PARAMETERS);
 		QSqlQuery query(db);
-		CUTEHMI_DEBUG("Inserting '" << name << "' tag...");
+		CUTEHMI_DEBUG("Inserting " << chunk.count() << " tags...");
+
+		if (db.driverName() == "QPSQL")
+			query.prepare(QString("INSERT INTO %1.tag (name) VALUES %2 ON CONFLICT (name) DO NOTHING").arg(schema()->name()).arg(Placeholders(chunk.count(), "(?)")));
+		else if (db.driverName() == "QSQLITE")
+			query.prepare(QString("INSERT OR IGNORE INTO [%1.tag] (name) VALUES %2").arg(schema()->name()).arg(Placeholders(chunk.count(), "(?)")));
+		else {
+			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
+			return;
+		}
 
-		query.prepare(QString("INSERT INTO [%1.tag] (name) VALUES (:name);").arg(schema()->name()));
-		query.bindValue(":name", name);
+		for (QStringList::const_iterator name = chunk.begin(); name != chunk.end(); ++name)
+			query.addBindValue(*name);
 		query.exec();
-		query.finish();
+		pushError(query.lastError());
+	}
+}
 
+void TagCache::select(const QStringList & names, QSqlDatabase & db)
+{
+	for (int first = 0; first < names.count(); first += BulkLoader::MAX_PARAMETERS) {
+		QStringList chunk = names.mid(first, BulkLoader::MAX_PARAMETERS);
+		QSqlQuery query(db);
+		CUTEHMI_DEBUG("Selecting " << chunk.count() << " tags...");
+
+		if (db.driverName() == "QPSQL")
+			query.prepare(QString("SELECT id, name FROM %1.tag WHERE name IN (%2)").arg(schema()->name()).arg(Placeholders(chunk.count(), "?")));
+		else if (db.driverName() == "QSQLITE")
+			query.prepare(QString("SELECT id, name FROM [%1.tag] WHERE name IN (%2)").arg(schema()->name()).arg(Placeholders(chunk.count(), "?")));
+		else {
+			emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
+			return;
+		}
 
-		query.prepare(QString("SELECT * FROM [%1.tag] WHERE name = :name").arg(schema()->name()));
-		query.bindValue(":name", name);
+		for (QStringList::const_iterator name = chunk.begin(); name != chunk.end(); ++name)
+			query.addBindValue(*name);
 		query.exec();
 		int idIndex = query.record().indexOf("id");
-		if (query.first()) {
+		int nameIndex = query.record().indexOf("name");
+		{
 			QWriteLocker locker(& m->tagIdsLock);
-			m->tagIds[name] = query.value(idIndex).toInt();
+
+			while (query.next())
+				m->tagIds[query.value(nameIndex).toString()] = query.value(idIndex).toInt();
 		}
 		pushError(query.lastError());
-	} else
-		emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
+	}
 }
 
 void TagCache::update(QSqlDatabase & db)
@@ -139,6 +170,35 @@ void TagCache::update(QSqlDatabase & db)
 		emit errored(CUTEHMI_ERROR(tr("Driver '%1' is not supported.").arg(db.driverName())));
 }
 
+QStringList TagCache::lookup(const QStringList & names, IdsContainer & ids) const
+{
+	QStringList missing;
+
+	// Access to m->tagIds is a critical section.
+	QReadLocker locker(& m->tagIdsLock);
+	for (int i = 0; i < names.count(); i++) {
+		if (ids.at(i) != 0)
+			continue;
+
+		TagIdContainter::const_iterator tag = m->tagIds.constFind(names.at(i));
+		if (tag != m->tagIds.constEnd())
+			ids[i] = tag.value();
+		else
+			missing.append(names.at(i));
+	}
+
+	return missing;
+}
+
+QString TagCache::Placeholders(int count, const QString & format)
+{
+	QStringList placeholders;
+	placeholders.reserve(count);
+	for (int i = 0; i < count; i++)
+		placeholders.append(format);
+	return placeholders.join(", ");
+}
+
 }
 }
 }
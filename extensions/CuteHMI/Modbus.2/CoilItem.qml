@@ -23,6 +23,7 @@ Item {
 	property alias device: controller.device
 	property alias address: controller.address
 	property alias busy: controller.busy
+	property alias pollInterval: controller.pollInterval
 	property alias readOnWrite: controller.readOnWrite
 	property alias writeMode: controller.writeMode
 	property alias writeDelay: controller.writeDelay
@@ -26,6 +26,7 @@ Item {
 	property alias encoding: controller.encoding
 	property alias valueScale: controller.valueScale
 	property alias busy: controller.busy
+	property alias pollInterval: controller.pollInterval
 	property alias readOnWrite: controller.readOnWrite
 	property alias writeMode: controller.writeMode
 	property alias writeDelay: controller.writeDelay
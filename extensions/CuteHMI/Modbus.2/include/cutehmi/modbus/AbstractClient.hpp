@@ -7,6 +7,9 @@
 
 #include <cutehmi/services/PollingTimer.hpp>
 
+#include <QSet>
+#include <QElapsedTimer>
+
 namespace cutehmi {
 namespace modbus {
 
@@ -21,12 +24,81 @@ class CUTEHMI_MODBUS_API AbstractClient:
 		Q_OBJECT
 
 	public:
+		/**
+		 * Health of a device. Determines how eagerly device is polled.
+		 */
+		enum Health {
+			HEALTHY,		///< Device answers requests. Polling proceeds normally.
+			BACKING_OFF,	///< Device has recently failed to answer. Polling cycles are postponed with exponential backoff.
+			UNREACHABLE		///< Circuit breaker is open. Device is considered dead and each polling cycle is reduced to a single probe request.
+		};
+		Q_ENUM(Health)
+
+		static constexpr int INITIAL_MAX_IN_FLIGHT = 1;
+		static constexpr Health INITIAL_HEALTH = HEALTHY;
+		static constexpr int INITIAL_FAILURE_THRESHOLD = 3;
+		static constexpr int INITIAL_BACKOFF_INTERVAL = 1000;
+		static constexpr int INITIAL_MAX_BACKOFF_INTERVAL = 60000;
+
 		Q_PROPERTY(cutehmi::services::PollingTimer * pollingTimer READ pollingTimer CONSTANT)
 
+		/**
+		 * Maximal number of polling requests, which can be awaiting replies at the same time. Value of 1 means that polling is
+		 * performed in stop-and-wait manner. Greater values allow polling requests to be pipelined, which is useful with Modbus TCP
+		 * servers and gateways that accept multiple outstanding transactions.
+		 *
+		 * @note Clients, which communicate over serial line (RTUClient) always poll with a window of 1.
+		 */
+		Q_PROPERTY(int maxInFlight READ maxInFlight WRITE setMaxInFlight NOTIFY maxInFlightChanged)
+
+		/**
+		 * Health of a device. Each request, which times out, counts as a failure, while any response (including Modbus
+		 * exception) proves that device is alive and restores its health. After a failure remaining requests of a polling cycle
+		 * are skipped and subsequent cycles are postponed until backoff interval elapses. Interval doubles with each consecutive
+		 * failure. Once amount of consecutive failures reaches failure threshold, circuit breaker opens and device becomes
+		 * unreachable. Requests issued outside of polling (e.g. writes) are not held back, so they can also revive the device.
+		 * Timeouts do not break the client; only loss of connection does. Health is restored whenever client (re)connects.
+		 */
+		Q_PROPERTY(Health health READ health NOTIFY healthChanged)
+
+		/**
+		 * Failure threshold. Amount of consecutive failures, after which device is considered unreachable.
+		 */
+		Q_PROPERTY(int failureThreshold READ failureThreshold WRITE setFailureThreshold NOTIFY failureThresholdChanged)
+
+		/**
+		 * Backoff interval [ms]. Time for which polling is postponed after the first failure. Zero disables the backoff.
+		 */
+		Q_PROPERTY(int backoffInterval READ backoffInterval WRITE setBackoffInterval NOTIFY backoffIntervalChanged)
+
+		/**
+		 * Maximal backoff interval [ms]. Upper bound of exponentially growing backoff interval. This is also the longest time
+		 * between probe requests sent to an unreachable device.
+		 */
+		Q_PROPERTY(int maxBackoffInterval READ maxBackoffInterval WRITE setMaxBackoffInterval NOTIFY maxBackoffIntervalChanged)
+
 		const services::PollingTimer * pollingTimer() const;
 
 		services::PollingTimer * pollingTimer();
 
+		int maxInFlight() const;
+
+		void setMaxInFlight(int maxInFlight);
+
+		Health health() const;
+
+		int failureThreshold() const;
+
+		void setFailureThreshold(int failureThreshold);
+
+		int backoffInterval() const;
+
+		void setBackoffInterval(int backoffInterval);
+
+		int maxBackoffInterval() const;
+
+		void setMaxBackoffInterval(int maxBackoffInterval);
+
 		std::unique_ptr<ServiceStatuses> configureStarting(QState * starting) override;
 
 		std::unique_ptr<ServiceStatuses> configureStarted(QState * active, const QState * idling, const QState * yielding) override;
@@ -49,13 +121,34 @@ class CUTEHMI_MODBUS_API AbstractClient:
 
 		std::unique_ptr<QAbstractTransition> transitionToIdling() const override;
 
+	signals:
+		void maxInFlightChanged();
+
+		void healthChanged();
+
+		void failureThresholdChanged();
+
+		void backoffIntervalChanged();
+
+		void maxBackoffIntervalChanged();
+
 	protected:
 		AbstractClient(QObject * parent = nullptr);
 
 		void handleRequest(const QJsonObject & request) override;
 
+		/**
+		 * Get polling window. Polling window is an effective number of polling requests, which are allowed to be in flight.
+		 * @return polling window. Default implementation returns maxInFlight().
+		 */
+		virtual int pollingWindow() const;
+
+		void handleDataRequest(const internal::DataRequest & request) override;
+
 		void handleReply(QUuid requestId, QJsonObject reply) override;
 
+		void handleDataReply(QUuid requestId, cutehmi::modbus::internal::DataReply reply) override;
+
 	protected slots:
 		virtual void onStateChanged();
 
@@ -63,21 +156,54 @@ class CUTEHMI_MODBUS_API AbstractClient:
 
 		void pollingTask();
 
+		void resetHealth();
+
 	CUTEHMI_PROTECTED_SIGNALS:
 		void requestReceived(QJsonObject request);
 
+		void dataRequestReceived(cutehmi::modbus::internal::DataRequest request);
+
 		void pollingFinished();
 
 		void pollingTaskFinished();
 
 	private:
+		void setHealth(Health health);
+
+		void recordSuccess();
+
+		void recordFailure();
+
+		void recordReply(bool success, int error);
+
+		bool backingOff() const;
+
 		struct Members {
 			internal::PollingIterator pollingIterator;
 			services::PollingTimer pollingTimer;
+			QSet<QUuid> pollingRequests;
+			int maxInFlight;
+			Health health;
+			int failureThreshold;
+			int backoffInterval;
+			int maxBackoffInterval;
+			int failures;	///< Amount of consecutive failures.
+			qint64 backoffDeadline;	///< Time measured by health clock, until which polling is postponed.
+			bool probeSent;	///< Whether unreachable device has been probed within current polling cycle.
+			QElapsedTimer healthClock;
 
 			Members(AbstractDevice * device):
-				pollingIterator(device)
+				pollingIterator(device),
+				maxInFlight(INITIAL_MAX_IN_FLIGHT),
+				health(INITIAL_HEALTH),
+				failureThreshold(INITIAL_FAILURE_THRESHOLD),
+				backoffInterval(INITIAL_BACKOFF_INTERVAL),
+				maxBackoffInterval(INITIAL_MAX_BACKOFF_INTERVAL),
+				failures(0),
+				backoffDeadline(0),
+				probeSent(false)
 			{
+				healthClock.start();
 			}
 		};
 
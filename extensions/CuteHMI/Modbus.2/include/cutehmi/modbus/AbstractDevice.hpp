@@ -3,11 +3,14 @@
 
 #include "internal/common.hpp"
 #include "internal/RegisterTraits.hpp"
+#include "internal/DataRequest.hpp"
+#include "internal/DataReply.hpp"
 #include "InputRegister.hpp"
 #include "internal/HoldingRegister.hpp"
 #include "internal/InputRegister.hpp"
 #include "DiscreteInput.hpp"
 #include "Coil.hpp"
+#include "DeviceMetrics.hpp"
 
 #include <cutehmi/InplaceError.hpp>
 #include <cutehmi/services/Serviceable.hpp>
@@ -18,7 +21,14 @@
 #include <QJsonArray>
 #include <QQmlListProperty>
 #include <QModbusPdu>
-#include <QLinkedList>
+#include <QHash>
+#include <QQueue>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QMultiMap>
+#include <QMap>
+#include <QVector>
+#include <QPointer>
 
 namespace cutehmi {
 namespace modbus {
@@ -27,6 +37,8 @@ namespace internal {
 class IterableTasks;
 }
 
+class AbstractRegisterController;
+
 /**
  * Abstract Modbus device.
  */
@@ -39,6 +51,7 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 		friend class test_AbstractDevice;
 		friend class test_AbstractServer;
 		friend class internal::IterableTasks;
+		friend class AbstractRegisterController;
 
 	public:
 		enum State {
@@ -188,7 +201,12 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 		static constexpr int INITIAL_MAX_WRITE_HOLDING_REGISTERS = 16;	// Max RTU: 123, Max TCP: 121
 		static constexpr int INITIAL_MAX_READ_INPUT_REGISTERS = 16;		// Max RTU: 125, Max TCP: 123
 		static constexpr int INITIAL_MAX_WRITE_INPUT_REGISTERS = 16;    // Max RTU: N/A, Max TCP: N/A
+		static constexpr int INITIAL_MAX_READ_GAP = MAX_ADDRESS;
 		static constexpr int INITIAL_MAX_REQUESTS = 1000;
+		static constexpr int INITIAL_REQUEST_TIMEOUT = 10000;
+		static constexpr int INITIAL_NOTIFICATION_INTERVAL = 0;
+		static constexpr int INITIAL_REGISTER_DEADBAND = 0;
+		static constexpr bool INITIAL_DEDICATED_THREAD = false;
 		static constexpr State INITIAL_STATE = CLOSED;
 		static constexpr bool INITIAL_READY = false;
 
@@ -212,8 +230,63 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 
 		Q_PROPERTY(int maxWriteInputRegisters READ maxWriteInputRegisters WRITE setMaxWriteInputRegisters NOTIFY maxWriteInputRegistersChanged)
 
+		/**
+		 * Maximal read gap. Amount of unused coils, discrete inputs or registers that may be read in between two polled ones, so that
+		 * they can be fetched with a single request instead of two. Reading unused addresses costs bandwidth and some servers reply
+		 * with an exception if they are asked for an address that they do not implement; in such cases this property should be set
+		 * to zero. Read requests are always limited by respective maxRead properties.
+		 */
+		Q_PROPERTY(int maxReadGap READ maxReadGap WRITE setMaxReadGap NOTIFY maxReadGapChanged)
+
 		Q_PROPERTY(int maxRequests READ maxRequests WRITE setMaxRequests NOTIFY maxRequestsChanged)
 
+		/**
+		 * Request timeout [ms]. Pending requests, which did not receive a reply within this time are removed from pending requests
+		 * queue and they are completed with an error. Setting this property to zero disables timeout.
+		 */
+		Q_PROPERTY(int requestTimeout READ requestTimeout WRITE setRequestTimeout NOTIFY requestTimeoutChanged)
+
+		/**
+		 * Notification interval [ms]. Determines how register controllers are notified about values read from the device. If set
+		 * to zero, controllers are notified immediately as each reply is processed. Otherwise notifications are accumulated and
+		 * delivered in a single batch once per given interval; controllers receive at most one notification per batch and those,
+		 * whose values did not change, are not signalled at all. Value of 16 corresponds roughly to a single frame of GUI refreshed
+		 * at 60 Hz. Replies to requests issued by controllers themselves (writes and read-on-write verification) are always
+		 * delivered immediately.
+		 */
+		Q_PROPERTY(int notificationInterval READ notificationInterval WRITE setNotificationInterval NOTIFY notificationIntervalChanged)
+
+		/**
+		 * Register deadband. Absolute deadband applied to holding and input registers read from the device, expressed in raw
+		 * register units. Cached value of a register is replaced only if new value differs from it by more than the deadband,
+		 * thus jitter is filtered out before any controller gets notified. Registers, which belong to multi-register values are
+		 * always updated, since their words are meaningful only together. First successful read of a register is always accepted,
+		 * regardless of the deadband. Setting this property to zero disables the deadband.
+		 *
+		 * Device does not know, whether a register holds signed or unsigned value, so the change is computed from raw unsigned
+		 * words. Change of a signed value is then measured correctly unless it crosses zero, in which case it appears to be large
+		 * and register is always updated. Thus deadband may let through some changes, which it would filter out if encoding was
+		 * known, but it never holds back a change, which exceeds it. For the same reason there is no relative deadband at this
+		 * level; magnitude of a value is known only to register controllers, which provide Register16Controller::relativeDeadband.
+		 */
+		Q_PROPERTY(int registerDeadband READ registerDeadband WRITE setRegisterDeadband NOTIFY registerDeadbandChanged)
+
+		/**
+		 * Dedicated thread. By default device backend runs on one of the threads of shared IOThreadPool, along with backends of other
+		 * devices. If this property is set to @p true, backend is pinned to a thread of its own, which is not shared with other
+		 * devices. This may be useful for devices, which need to be isolated from the others (e.g. because of strict latency
+		 * requirements or because they block for a noticeable time).
+		 *
+		 * @note Devices, which do not own a backend (e.g. TCPGatewayClient) ignore this property.
+		 */
+		Q_PROPERTY(bool dedicatedThread READ dedicatedThread WRITE setDedicatedThread NOTIFY dedicatedThreadChanged)
+
+		/**
+		 * Transaction metrics. Each completed request is recorded along with its latency, which is measured from the moment the
+		 * request has been issued until its reply has been handled, thus it includes time spent in queues.
+		 */
+		Q_PROPERTY(cutehmi::modbus::DeviceMetrics * metrics READ metrics CONSTANT)
+
 		State state() const;
 
 		/**
@@ -254,10 +327,34 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 
 		void setMaxWriteInputRegisters(int maxWriteInputRegisters);
 
+		int maxReadGap() const;
+
+		void setMaxReadGap(int maxReadGap);
+
 		int maxRequests() const;
 
 		void setMaxRequests(int maxRequests);
 
+		int requestTimeout() const;
+
+		void setRequestTimeout(int requestTimeout);
+
+		int notificationInterval() const;
+
+		void setNotificationInterval(int notificationInterval);
+
+		int registerDeadband() const;
+
+		void setRegisterDeadband(int registerDeadband);
+
+		bool dedicatedThread() const;
+
+		void setDedicatedThread(bool dedicatedThread);
+
+		DeviceMetrics * metrics();
+
+		const DeviceMetrics * metrics() const;
+
 		Coil * coilAt(quint16 address);
 
 		DiscreteInput * discreteInputAt(quint16 address);
@@ -520,6 +617,10 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 		 * @param requestId request id. If not @p nullptr, function will set pointee to generated request id before handling the
 		 * request.
 		 *
+		 * @remark This function serves as a facade for QML. Requests of functions, which read or write coils, discrete inputs,
+		 * holding registers and input registers are translated into data requests (see requestData()) before they are passed to
+		 * a backend and their replies are translated back into JSON.
+		 *
 		 * @internal QJsonObject has been picked as a data structure that represents requests. Several are reasons for this.
 		 *		- QJsonObject is implicitly shared, so it can be passed by value through signals/slots mechanism.
 		 *		- It naturally fits into QML.
@@ -528,6 +629,31 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 		 */
 		Q_INVOKABLE void request(Function function, QJsonObject payload, QUuid * requestId = nullptr);
 
+		/**
+		 * Data request. Binary counterpart of request() function, restricted to functions, which read or write coils, discrete
+		 * inputs, holding registers and input registers. Data requests bypass JSON marshalling, which makes them suitable for hot
+		 * paths, such as polling and register controllers. Upon completion dataRequestCompleted() signal is emitted instead of
+		 * requestCompleted().
+		 * @param request data request. Function fills in its @a id and @a timestamp fields.
+		 * @param requestId request id. If not @p nullptr, function will set pointee to generated request id before handling the
+		 * request.
+		 */
+		void requestData(internal::DataRequest request, QUuid * requestId = nullptr);
+
+		/**
+		 * Queue data write. Single-value write request is put on a write queue instead of being passed to a backend right away.
+		 * Queue is flushed once control returns to the event loop. Queued writes to adjacent addresses of the same data table are
+		 * then merged into a single write multiple request, up to the limit imposed by respective maxWrite property (setting it to
+		 * 1 disables merging). Repeated writes to the same address are collapsed, so that only the most recent value is written.
+		 * Regardless of merging, completion of each queued write is reported separately, exactly as if it was issued with
+		 * requestData().
+		 * @param request single-value write data request (FUNCTION_WRITE_COIL, FUNCTION_WRITE_DISCRETE_INPUT,
+		 * FUNCTION_WRITE_HOLDING_REGISTER or FUNCTION_WRITE_INPUT_REGISTER). Function fills in its @a id and @a timestamp fields.
+		 * @param requestId request id. If not @p nullptr, function will set pointee to generated request id before handling the
+		 * request.
+		 */
+		void queueDataWrite(internal::DataRequest request, QUuid * requestId = nullptr);
+
 	public slots:
 		virtual void open() = 0;
 
@@ -556,10 +682,30 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 
 		void maxWriteInputRegistersChanged();
 
+		void maxReadGapChanged();
+
 		void maxRequestsChanged();
 
+		void requestTimeoutChanged();
+
+		void notificationIntervalChanged();
+
+		void registerDeadbandChanged();
+
+		void dedicatedThreadChanged();
+
 		void requestCompleted(QJsonObject request, QJsonObject reply);
 
+		/**
+		 * Data request completed. This signal is emitted upon completion of a request issued with requestData() function.
+		 *
+		 * @note Register controllers are not connected to this signal. Instead device notifies them directly, selecting only those
+		 * controllers, which are interested in a range of addresses covered by the request.
+		 * @param request data request.
+		 * @param reply data reply.
+		 */
+		void dataRequestCompleted(const cutehmi::modbus::internal::DataRequest & request, const cutehmi::modbus::internal::DataReply & reply);
+
 	protected:
 		typedef typename internal::RegisterTraits<internal::Coil>::Container CoilDataContainer;
 		typedef typename internal::RegisterTraits<internal::DiscreteInput>::Container DiscreteInputDataContainer;
@@ -588,6 +734,17 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 		 */
 		virtual void handleRequest(const QJsonObject & request) = 0;
 
+		/**
+		 * Handle data request.
+		 *
+		 * This function acts as data request handler, that derived class must implement. It is a binary counterpart of
+		 * handleRequest(). Functions, which read or write coils, discrete inputs, holding registers and input registers are always
+		 * passed to this handler, regardless of whether they were issued with requestData() or through JSON request() facade. Once
+		 * request completes derived class is expected to call handleDataReply() function.
+		 * @param request data request.
+		 */
+		virtual void handleDataRequest(const internal::DataRequest & request) = 0;
+
 		const CoilDataContainer & coilData() const;
 
 		CoilDataContainer & coilData();
@@ -608,6 +765,21 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 
 		QJsonObject takePendingRequest(QUuid requestId);
 
+		/**
+		 * Take pending data request.
+		 * @param requestId request id.
+		 * @param request data request, which is going to be filled with the data of pending request.
+		 * @return @p true if pending data request has been found and removed from the queue, @p false otherwise.
+		 */
+		bool takePendingDataRequest(QUuid requestId, internal::DataRequest & request);
+
+		/**
+		 * Check whether data request is pending.
+		 * @param requestId request id.
+		 * @return @p true if data request is awaiting a reply, @p false otherwise.
+		 */
+		bool dataRequestPending(QUuid requestId) const;
+
 	protected slots:
 		/**
 		 * Reply handler.
@@ -616,6 +788,14 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 		 */
 		virtual void handleReply(QUuid requestId, QJsonObject reply);
 
+		/**
+		 * Data reply handler. If data reply corresponds to a request issued through JSON facade, it is translated into JSON reply
+		 * and passed to handleReply().
+		 * @param requestId request id.
+		 * @param reply reply data.
+		 */
+		virtual void handleDataReply(QUuid requestId, cutehmi::modbus::internal::DataReply reply);
+
 		void setState(State state);
 
 		void setReady(bool ready);
@@ -630,7 +810,50 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 		void started();
 
 	private:
-		typedef QLinkedList<QJsonObject> PendingRequestsContainer;
+		typedef QHash<QUuid, QJsonObject> PendingRequestsContainer;
+		typedef QHash<QUuid, internal::DataRequest> PendingDataRequestsContainer;
+		typedef QQueue<QPair<qint64, QUuid>> PendingRequestsTimeline;	// Pairs of timestamps and request ids in order of issuing.
+
+		struct ControllerSubscription
+		{
+			AbstractRegisterController * controller;
+			quint16 amount;
+		};
+
+		typedef QMultiMap<quint16, ControllerSubscription> ControllersIndex;	// Controller subscriptions keyed by their starting addresses.
+		typedef QHash<int, ControllersIndex> ControllersIndices;	// Controllers indices keyed by read function of a data table.
+
+		struct BatchedNotification
+		{
+			QPointer<AbstractRegisterController> controller;
+			bool success;
+		};
+
+		typedef QHash<AbstractRegisterController *, BatchedNotification> BatchedNotificationsContainer;
+
+		struct QueuedWrite
+		{
+			quint16 value;
+			QVector<QUuid> requestIds;	// Ids of all the requests, which have been collapsed into this write.
+		};
+
+		typedef QMap<quint16, QueuedWrite> WriteQueue;	// Queued writes keyed by their addresses.
+		typedef QHash<int, WriteQueue> WriteQueuesContainer;	// Write queues keyed by single-value write function.
+		typedef QHash<QUuid, QVector<QUuid>> MergedWritesContainer;	// Ids of queued writes keyed by id of a request, into which they have been merged.
+
+		static Function DataTableReadFunction(Function function);
+
+		static Function WriteMultipleFunction(Function function);
+
+		static bool IsDataFunction(Function function);
+
+		static internal::DataRequest DataRequestFromPayload(Function function, const QJsonObject & payload);
+
+		static QJsonObject DataReplyToJson(Function function, const internal::DataReply & reply);
+
+		static QString DataReplyErrorString(const internal::DataReply & reply);
+
+		static QJsonObject ErrorReply(const QString & error);
 
 		static void ValidatePayloadAddressKey(const QJsonObject & json, const QString & key = "address");
 
@@ -664,6 +887,65 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 
 		bool validateReply(const QJsonObject & request, const QJsonObject & reply);
 
+		bool validateDataRequest(const internal::DataRequest & request);
+
+		int pendingRequestsCount() const;
+
+		void trackPendingRequest(qint64 timestamp, QUuid requestId);
+
+		void releasePendingRequests();
+
+		void schedulePendingRequestsSweep();
+
+		void sweepPendingRequests();
+
+		/**
+		 * Subscribe register controller. Subscribed controller will be notified about completion of data requests, which cover
+		 * any of its addresses.
+		 * @param controller controller.
+		 * @param function read function of a data table, to which controller is attached.
+		 * @param address starting address.
+		 * @param amount amount of addresses occupied by controller.
+		 */
+		void subscribeController(AbstractRegisterController * controller, Function function, quint16 address, quint16 amount);
+
+		/**
+		 * Unsubscribe register controller.
+		 * @param controller controller.
+		 * @param function read function of a data table, which has been passed to subscribeController().
+		 * @param address starting address, which has been passed to subscribeController().
+		 */
+		void unsubscribeController(AbstractRegisterController * controller, Function function, quint16 address);
+
+		/**
+		 * Report failed data reply. Timeouts are reported as warnings, since they are accounted by clients in their health;
+		 * other failures are emitted through errored() signal.
+		 * @param requestId request id.
+		 * @param reply failed reply.
+		 */
+		void reportDataReplyFailure(QUuid requestId, const internal::DataReply & reply);
+
+		void updateDataTables(const internal::DataRequest & request, const internal::DataReply & reply);
+
+		template <typename CONTAINER>
+		void updateRegisters(CONTAINER & container, quint16 address, int amount, const internal::DataBuffer & values);
+
+		void notifyControllers(const internal::DataRequest & request, const internal::DataReply & reply);
+
+		void deliverBatchedNotifications();
+
+		int maxWriteAmount(Function function) const;
+
+		void flushWriteQueues();
+
+		void submitQueuedWrites(Function function, WriteQueue::const_iterator first, WriteQueue::const_iterator last, quint16 amount);
+
+		/**
+		 * Fail merged writes. Writes, which have been merged from queued writes and are still awaiting replies, are failed along
+		 * with their constituents. Called once device gets closed, since replies are not going to arrive anymore.
+		 */
+		void failMergedWrites();
+
 		struct Members
 		{
 			State state;
@@ -676,12 +958,29 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 			int maxWriteHoldingRegisters;
 			int maxReadInputRegisters;
 			int maxWriteInputRegisters;
+			int maxReadGap;
 			int maxRequests;
+			int requestTimeout;
+			int notificationInterval;
+			int registerDeadband;
+			bool dedicatedThread;
 			InputRegisterDataContainer inputRegisters;
 			HoldingRegisterDataContainer holdingRegisters;
 			DiscreteInputDataContainer discreteInputs;
 			CoilDataContainer coils;
 			PendingRequestsContainer pendingRequests;
+			PendingDataRequestsContainer pendingDataRequests;
+			PendingRequestsTimeline pendingTimeline;
+			QTimer sweepTimer;
+			ControllersIndices controllers;
+			quint16 maxControllerAmount;
+			BatchedNotificationsContainer batchedNotifications;
+			QTimer notificationTimer;
+			WriteQueuesContainer writeQueues;
+			MergedWritesContainer mergedWrites;
+			QTimer writeQueueTimer;
+			DeviceMetrics metrics;
+			QElapsedTimer clock;	///< Monotonic clock used to measure latencies of data requests.
 
 			Members():
 				state(INITIAL_STATE),
@@ -694,8 +993,18 @@ class CUTEHMI_MODBUS_API AbstractDevice:
 				maxWriteHoldingRegisters(INITIAL_MAX_WRITE_HOLDING_REGISTERS),
 				maxReadInputRegisters(INITIAL_MAX_READ_INPUT_REGISTERS),
 				maxWriteInputRegisters(INITIAL_MAX_WRITE_INPUT_REGISTERS),
-				maxRequests(INITIAL_MAX_REQUESTS)
+				maxReadGap(INITIAL_MAX_READ_GAP),
+				maxRequests(INITIAL_MAX_REQUESTS),
+				requestTimeout(INITIAL_REQUEST_TIMEOUT),
+				notificationInterval(INITIAL_NOTIFICATION_INTERVAL),
+				registerDeadband(INITIAL_REGISTER_DEADBAND),
+				dedicatedThread(INITIAL_DEDICATED_THREAD),
+				maxControllerAmount(1)
 			{
+				sweepTimer.setSingleShot(true);
+				notificationTimer.setSingleShot(true);
+				writeQueueTimer.setSingleShot(true);
+				clock.start();
 			}
 		};
 
@@ -20,6 +20,8 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 		Q_OBJECT
 		Q_INTERFACES(QQmlParserStatus)
 
+		friend class AbstractDevice;
+
 	public:
 		/**
 		 * Write mode enum.
@@ -38,6 +40,7 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 		static constexpr bool INITIAL_BUSY = true;
 		static constexpr bool INITIAL_READ_ON_WRITE = true;
 		static constexpr bool INITIAL_ENABLED = true;
+		static constexpr int INITIAL_POLL_INTERVAL = 0;
 
 		/**
 		  Device associated with controller.
@@ -76,6 +79,14 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 		  */
 		Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
 
+		/**
+		  Poll interval [ms]. Registers with distinct poll intervals form scan groups, which are polled by a client, each on its own
+		  cadence. Value of 0 means that register is polled in each polling cycle of a client. Since polling is performed in
+		  polling cycles, effective interval is rounded up to a multiple of client's polling timer interval. If register is shared
+		  by multiple controllers, then the shortest interval is used.
+		  */
+		Q_PROPERTY(int pollInterval READ pollInterval WRITE setPollInterval NOTIFY pollIntervalChanged)
+
 		AbstractRegisterController(QObject * parent = nullptr);
 
 		AbstractDevice * device() const;
@@ -104,6 +115,10 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 
 		void setEnabled(bool enabled);
 
+		int pollInterval() const;
+
+		void setPollInterval(int pollInterval);
+
 	signals:
 		void deviceChanged();
 
@@ -119,11 +134,28 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 
 		void enabledChanged();
 
+		void pollIntervalChanged();
+
 	protected:
 		virtual void requestReadRegisters(quint16 address, quint16 amount, QUuid * requestId) const = 0;
 
 		virtual quint16 bytes() const = 0;
 
+		/**
+		 * Get read function. Read function identifies data table (coils, discrete inputs, holding registers or input registers),
+		 * to which controller is attached.
+		 * @return function, which is used to read registers.
+		 */
+		virtual AbstractDevice::Function readRegistersFunction() const = 0;
+
+		/**
+		 * Check whether controller awaits completion of particular request.
+		 * @param requestId request id.
+		 * @return @p true if request with given id has been issued by the controller and controller awaits its completion, @p
+		 * false otherwise.
+		 */
+		virtual bool awaitsRequest(const QUuid & requestId) const = 0;
+
 		virtual void onDeviceDestroyed() = 0;
 
 		void classBegin() override;
@@ -132,12 +164,30 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 
 		void setBusy(bool busy);
 
+		/**
+		 * Update subscription. Controller is subscribed to the device for a range of addresses determined by address() and
+		 * bytes(). This function should be called whenever the amount returned by bytes() changes.
+		 */
+		void updateSubscription();
+
 	protected slots:
-		virtual void onRequestCompleted(QJsonObject request, QJsonObject reply) = 0;
+		virtual void onDataRequestCompleted(const cutehmi::modbus::internal::DataRequest & request, const cutehmi::modbus::internal::DataReply & reply) = 0;
+
+		/**
+		 * Registers read handler. This handler is called instead of onDataRequestCompleted(), when device delivers notifications
+		 * in batches (see AbstractDevice::notificationInterval). It is called at most once per batch, regardless of how many
+		 * read requests covering controller's address have completed in the meantime.
+		 * @param success status of the most recent read request.
+		 */
+		virtual void onRegistersRead(bool success) = 0;
 
 	private:
 		bool deviceReady() const;
 
+		void subscribe();
+
+		void unsubscribe();
+
 		struct Members
 		{
 			AbstractDevice * device;
@@ -147,7 +197,11 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 			WriteMode writeMode;
 			int writeDelay;
 			bool enabled;
+			int pollInterval;
 			bool deferRequestRead;
+			bool subscribed;
+			AbstractDevice::Function subscribedFunction;
+			quint16 subscribedAddress;
 
 			Members():
 				device(nullptr),
@@ -157,7 +211,11 @@ class CUTEHMI_MODBUS_API AbstractRegisterController:
 				writeMode(INITIAL_WRITE_MODE),
 				writeDelay(INITIAL_WRITE_DELAY),
 				enabled(INITIAL_ENABLED),
-				deferRequestRead(false)
+				pollInterval(INITIAL_POLL_INTERVAL),
+				deferRequestRead(false),
+				subscribed(false),
+				subscribedFunction(AbstractDevice::FUNCTION_INVALID),
+				subscribedAddress(0)
 			{
 			}
 		};
@@ -56,6 +56,8 @@ class CUTEHMI_MODBUS_API AbstractServer:
 
 		void handleRequest(const QJsonObject & request) override;
 
+		void handleDataRequest(const internal::DataRequest & request) override;
+
 	protected slots:
 		virtual void handleCoilsWritten(quint16 address, quint16 amount);
 
@@ -70,6 +72,8 @@ class CUTEHMI_MODBUS_API AbstractServer:
 	CUTEHMI_PROTECTED_SIGNALS:
 		void requestReceived(QJsonObject request);
 
+		void dataRequestReceived(cutehmi::modbus::internal::DataRequest request);
+
 	private:
 		struct Members {
 			bool busy = INITIAL_BUSY;
@@ -0,0 +1,268 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_DEVICEMETRICS_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_DEVICEMETRICS_HPP
+
+#include "internal/common.hpp"
+
+#include <QObject>
+#include <QAtomicInteger>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <array>
+
+namespace cutehmi {
+namespace modbus {
+
+/**
+ * Transaction metrics of a device. Metrics are recorded for each completed request and they are kept separately for each function
+ * code. Each function code has its own set of counters and latency histogram.
+ *
+ * Histograms are log-linear (in the spirit of HdrHistogram). Latencies are expressed in microseconds and each power of two is
+ * split into 2^SUB_BUCKET_BITS equal buckets, which bounds relative error of reported percentiles by 1/2^SUB_BUCKET_BITS. Recording
+ * a sample is a matter of a few atomic increments, so metrics are always enabled.
+ *
+ * Counters are 32 bit wide, because 64 bit atomics are not available on all platforms. They wrap around once they reach their
+ * maximal value, thus consumers should rely on differences between subsequent readings rather than absolute values.
+ *
+ * Properties provide an overview of all function codes. They are refreshed every @ref updateInterval and values, which refer to
+ * rates and latencies, are computed over the last interval. C++ API provides cumulative values for particular function codes.
+ *
+ * @threadsafe Functions record(), counters(), exceptionCodeCount() and latencyPercentile() can be called from any thread.
+ */
+class CUTEHMI_MODBUS_API DeviceMetrics:
+	public QObject
+{
+		Q_OBJECT
+
+	public:
+		static constexpr int ALL_FUNCTIONS = -1;	///< Pseudo function code, which denotes all function codes.
+		static constexpr int SUB_BUCKET_BITS = 3;	///< Amount of bits, which determine resolution of histogram buckets.
+		static constexpr int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;	///< Amount of buckets per power of two.
+		static constexpr int MAX_LATENCY_BITS = 27;	///< Latencies are clamped to 2^MAX_LATENCY_BITS - 1 microseconds (above 2 minutes).
+		static constexpr int BUCKET_COUNT = (MAX_LATENCY_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;	///< Amount of histogram buckets.
+		static constexpr int EXCEPTION_CODE_COUNT = 256;	///< Amount of exception codes, which can be counted.
+
+		static constexpr int INITIAL_UPDATE_INTERVAL = 1000;
+
+		/**
+		 * Update interval [ms]. Determines how often properties are refreshed. Zero disables refreshing.
+		 */
+		Q_PROPERTY(int updateInterval READ updateInterval WRITE setUpdateInterval NOTIFY updateIntervalChanged)
+
+		/**
+		 * Amount of completed requests.
+		 */
+		Q_PROPERTY(unsigned int requestCount READ requestCount NOTIFY updated)
+
+		/**
+		 * Amount of failed requests. Timeouts and Modbus exceptions count as failures as well.
+		 */
+		Q_PROPERTY(unsigned int errorCount READ errorCount NOTIFY updated)
+
+		/**
+		 * Amount of requests, which have timed out.
+		 */
+		Q_PROPERTY(unsigned int timeoutCount READ timeoutCount NOTIFY updated)
+
+		/**
+		 * Amount of requests, which have been answered with Modbus exception.
+		 */
+		Q_PROPERTY(unsigned int exceptionCount READ exceptionCount NOTIFY updated)
+
+		/**
+		 * Request rate [1/s] during last update interval.
+		 */
+		Q_PROPERTY(qreal requestRate READ requestRate NOTIFY updated)
+
+		/**
+		 * Error rate [1/s] during last update interval.
+		 */
+		Q_PROPERTY(qreal errorRate READ errorRate NOTIFY updated)
+
+		/**
+		 * Median latency [ms] during last update interval.
+		 */
+		Q_PROPERTY(qreal latencyP50 READ latencyP50 NOTIFY updated)
+
+		/**
+		 * 90th percentile of latency [ms] during last update interval.
+		 */
+		Q_PROPERTY(qreal latencyP90 READ latencyP90 NOTIFY updated)
+
+		/**
+		 * 99th percentile of latency [ms] during last update interval.
+		 */
+		Q_PROPERTY(qreal latencyP99 READ latencyP99 NOTIFY updated)
+
+		/**
+		 * Maximal latency [ms] during last update interval.
+		 */
+		Q_PROPERTY(qreal latencyMax READ latencyMax NOTIFY updated)
+
+		/**
+		 * Counters of a function code.
+		 */
+		struct Counters
+		{
+			quint32 requests = 0;	///< Amount of completed requests.
+			quint32 errors = 0;		///< Amount of failed requests.
+			quint32 timeouts = 0;	///< Amount of requests, which have timed out.
+			quint32 exceptions = 0;	///< Amount of requests, which have been answered with Modbus exception.
+		};
+
+		DeviceMetrics(QObject * parent = nullptr);
+
+		int updateInterval() const;
+
+		void setUpdateInterval(int updateInterval);
+
+		unsigned int requestCount() const;
+
+		unsigned int errorCount() const;
+
+		unsigned int timeoutCount() const;
+
+		unsigned int exceptionCount() const;
+
+		qreal requestRate() const;
+
+		qreal errorRate() const;
+
+		qreal latencyP50() const;
+
+		qreal latencyP90() const;
+
+		qreal latencyP99() const;
+
+		qreal latencyMax() const;
+
+		/**
+		 * Record completed request.
+		 * @param function function code. One of AbstractDevice::Function enum values.
+		 * @param latency time elapsed between issuing the request and its completion [us].
+		 * @param success whether request has succeeded.
+		 * @param error error code. One of QModbusDevice::Error enum values.
+		 * @param exceptionCode Modbus exception code, applicable if @a error is QModbusDevice::ProtocolError.
+		 */
+		void record(int function, qint64 latency, bool success, int error = 0, int exceptionCode = 0);
+
+		/**
+		 * Get counters.
+		 * @param function function code or ALL_FUNCTIONS.
+		 * @return cumulative counters of given function code.
+		 */
+		Counters counters(int function = ALL_FUNCTIONS) const;
+
+		/**
+		 * Get amount of Modbus exceptions with given code.
+		 * @param exceptionCode exception code.
+		 * @return amount of requests, which have been answered with given exception code.
+		 */
+		Q_INVOKABLE unsigned int exceptionCodeCount(int exceptionCode) const;
+
+		/**
+		 * Get latency percentile.
+		 * @param percentile percentile in range [0, 100].
+		 * @param function function code or ALL_FUNCTIONS.
+		 * @return cumulative latency percentile [ms] of given function code or zero if no requests have been recorded. Value is
+		 * reported as the highest latency, which falls into the same histogram bucket as the exact percentile.
+		 */
+		Q_INVOKABLE qreal latencyPercentile(qreal percentile, int function = ALL_FUNCTIONS) const;
+
+		/**
+		 * Map latency to histogram bucket.
+		 * @param latency latency [us].
+		 * @return index of histogram bucket.
+		 */
+		static int BucketIndex(qint64 latency);
+
+		/**
+		 * Get highest latency, which falls into histogram bucket.
+		 * @param index index of histogram bucket.
+		 * @return highest latency of given bucket [us].
+		 */
+		static qint64 BucketUpperBound(int index);
+
+	public slots:
+		/**
+		 * Reset metrics. All the counters and histograms are zeroed.
+		 */
+		void reset();
+
+	signals:
+		void updateIntervalChanged();
+
+		void updated();
+
+	private slots:
+		void update();
+
+	private:
+		typedef std::array<quint32, BUCKET_COUNT> Histogram;
+
+		struct FunctionMetrics
+		{
+			QAtomicInteger<quint32> requests;
+			QAtomicInteger<quint32> errors;
+			QAtomicInteger<quint32> timeouts;
+			QAtomicInteger<quint32> exceptions;
+			std::array<QAtomicInteger<quint32>, BUCKET_COUNT> histogram;
+		};
+
+		/**
+		 * Map function code to a slot, which holds its metrics. Less common function codes share the last slot.
+		 * @param function function code.
+		 * @return slot index.
+		 */
+		static int FunctionSlot(int function);
+
+		static qint64 Percentile(const Histogram & histogram, quint32 total, qreal percentile);
+
+		void sumHistograms(Histogram & histogram, int function) const;
+
+		static constexpr int FUNCTION_SLOT_COUNT = 15;
+
+		struct Members
+		{
+			int updateInterval;
+			std::array<FunctionMetrics, FUNCTION_SLOT_COUNT> functions;
+			std::array<QAtomicInteger<quint32>, EXCEPTION_CODE_COUNT> exceptionCodes;
+			QTimer updateTimer;
+			QElapsedTimer updateClock;
+			Counters counters;		///< Counters as of last update.
+			Histogram histogram;	///< Histogram of all function codes as of last update.
+			qreal requestRate;
+			qreal errorRate;
+			qreal latencyP50;
+			qreal latencyP90;
+			qreal latencyP99;
+			qreal latencyMax;
+
+			Members():
+				updateInterval(INITIAL_UPDATE_INTERVAL),
+				functions(),
+				exceptionCodes(),
+				histogram(),
+				requestRate(0.0),
+				errorRate(0.0),
+				latencyP50(0.0),
+				latencyP90(0.0),
+				latencyP99(0.0),
+				latencyMax(0.0)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
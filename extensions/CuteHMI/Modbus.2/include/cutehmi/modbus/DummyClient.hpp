@@ -5,6 +5,7 @@
 #include "internal/DummyClientConfig.hpp"
 #include "internal/DummyClientBackend.hpp"
 #include "internal/PollingIterator.hpp"
+#include "internal/BackendThread.hpp"
 #include "AbstractClient.hpp"
 
 #include <cutehmi/services/PollingTimer.hpp>
@@ -68,10 +69,11 @@ class CUTEHMI_MODBUS_API DummyClient:
 		struct Members {
 			internal::DummyClientConfig config;
 			internal::DummyClientBackend backend;
-			QThread thread;
+			internal::BackendThread thread;
 
 			Members():
-				backend(& config)
+				backend(& config),
+				thread(& backend)
 			{
 			}
 		};
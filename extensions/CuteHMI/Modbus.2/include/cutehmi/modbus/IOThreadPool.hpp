@@ -0,0 +1,130 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_IOTHREADPOOL_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_IOTHREADPOOL_HPP
+
+#include "internal/common.hpp"
+
+#include <cutehmi/Singleton.hpp>
+
+#include <QObject>
+#include <QThread>
+#include <QVector>
+#include <QSet>
+
+namespace cutehmi {
+namespace modbus {
+
+namespace internal {
+class BackendThread;
+}
+
+/**
+ * I/O thread pool. Thread pool is a singleton, which provides event loop threads for device backends. Instead of running each
+ * backend on a thread of its own, backends are distributed among a limited number of shared threads. Each thread runs an event
+ * loop, which serves all the backends assigned to it.
+ *
+ * Shared threads are started on demand, as backends are assigned to them, until @ref maxThreadCount limit is reached. After that
+ * each newly created backend is assigned to the least loaded thread. Backend stays on its thread for its whole lifetime (affinity),
+ * unless device is pinned to a dedicated thread with AbstractDevice::dedicatedThread property.
+ *
+ * @note Pool is not thread-safe. It should be used only from the thread in which devices are created (typically main thread).
+ */
+class CUTEHMI_MODBUS_API IOThreadPool:
+	public QObject,
+	public Singleton<IOThreadPool>
+{
+		Q_OBJECT
+
+		friend class Singleton<IOThreadPool>;
+		friend class internal::BackendThread;
+
+	public:
+		static constexpr int INITIAL_MAX_THREAD_COUNT = 0;
+
+		/**
+		 * Maximal number of shared threads. Value of zero means that QThread::idealThreadCount() threads are used. Changing this
+		 * property does not affect backends, which have already been assigned to threads.
+		 */
+		Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount NOTIFY maxThreadCountChanged)
+
+		/**
+		 * Number of shared threads, which have been started.
+		 */
+		Q_PROPERTY(int threadCount READ threadCount NOTIFY threadCountChanged)
+
+		/**
+		 * Number of dedicated threads, which have been started for devices pinned to their own threads.
+		 */
+		Q_PROPERTY(int dedicatedThreadCount READ dedicatedThreadCount NOTIFY dedicatedThreadCountChanged)
+
+		int maxThreadCount() const;
+
+		void setMaxThreadCount(int maxThreadCount);
+
+		int threadCount() const;
+
+		int dedicatedThreadCount() const;
+
+	signals:
+		void maxThreadCountChanged();
+
+		void threadCountChanged();
+
+		void dedicatedThreadCountChanged();
+
+	protected:
+		explicit IOThreadPool(QObject * parent = nullptr);
+
+		~IOThreadPool() override;
+
+		/**
+		 * Acquire thread.
+		 * @param dedicated whether dedicated thread should be started instead of assigning one of the shared threads.
+		 * @return running thread.
+		 */
+		QThread * acquire(bool dedicated);
+
+		/**
+		 * Release thread acquired with acquire() function. Dedicated threads are stopped and destroyed. Shared threads remain
+		 * running, but their load is decreased.
+		 * @param thread thread to release.
+		 */
+		void release(QThread * thread);
+
+	private:
+		struct SharedThread
+		{
+			QThread * thread;
+			int load;	// Number of backends assigned to the thread.
+		};
+
+		typedef QVector<SharedThread> SharedThreadsContainer;
+		typedef QSet<QThread *> DedicatedThreadsContainer;
+
+		int effectiveMaxThreadCount() const;
+
+		static void Stop(QThread * thread);
+
+		struct Members {
+			int maxThreadCount;
+			SharedThreadsContainer sharedThreads;
+			DedicatedThreadsContainer dedicatedThreads;
+
+			Members():
+				maxThreadCount(INITIAL_MAX_THREAD_COUNT)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
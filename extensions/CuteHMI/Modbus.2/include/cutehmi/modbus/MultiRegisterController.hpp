@@ -0,0 +1,278 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_MULTIREGISTERCONTROLLER_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_MULTIREGISTERCONTROLLER_HPP
+
+#include "internal/common.hpp"
+#include "internal/RegisterControllerMixin.hpp"
+#include "Register16.hpp"
+#include "AbstractRegisterController.hpp"
+
+#include <QBasicTimer>
+#include <QElapsedTimer>
+
+#include <array>
+
+namespace cutehmi {
+namespace modbus {
+
+/**
+ * Register controller for values stored in multiple consecutive 16 bit registers. Controller handles 32 bit and 64 bit integers as
+ * well as single and double precision floating point numbers. Order of bytes within each register and order of registers within
+ * a value are configurable, since devices do not agree on them. Value is decoded directly from cached registers and registers are
+ * polled as one unit, so that words of a value are always fetched with a single request. Writes are performed with a single
+ * write multiple request for the same reason.
+ */
+class CUTEHMI_MODBUS_API MultiRegisterController:
+	public AbstractRegisterController,
+	protected internal::RegisterControllerMixin<MultiRegisterController>
+{
+		Q_OBJECT
+
+		friend class internal::RegisterControllerMixin<MultiRegisterController>;
+		typedef internal::RegisterControllerMixin<MultiRegisterController> Mixin;
+
+	public:
+		enum Encoding {
+			INT32,		///< 32 bit signed integer stored in two registers.
+			UINT32,		///< 32 bit unsigned integer stored in two registers.
+			FLOAT32,	///< IEEE 754 single precision floating point number stored in two registers.
+			INT64,		///< 64 bit signed integer stored in four registers. Values beyond 2^53 lose precision, when converted to qreal.
+			UINT64,		///< 64 bit unsigned integer stored in four registers. Values beyond 2^53 lose precision, when converted to qreal.
+			FLOAT64		///< IEEE 754 double precision floating point number stored in four registers.
+		};
+		Q_ENUM(Encoding)
+
+		enum ByteOrder {
+			HIGH_BYTE_FIRST,	///< Most significant byte is stored first within a register, as mandated by Modbus specification.
+			LOW_BYTE_FIRST		///< Least significant byte is stored first within a register.
+		};
+		Q_ENUM(ByteOrder)
+
+		enum WordOrder {
+			HIGH_WORD_FIRST,	///< Register at the lowest address holds the most significant word.
+			LOW_WORD_FIRST		///< Register at the lowest address holds the least significant word.
+		};
+		Q_ENUM(WordOrder)
+
+		static constexpr int MAX_REGISTERS = 4;	///< Maximal amount of registers occupied by a value.
+
+		static constexpr qreal INITIAL_VALUE = 0.0;
+		static constexpr qreal INITIAL_VALUE_SCALE = 1.0;
+		static constexpr Encoding INITIAL_ENCODING = FLOAT32;
+		static constexpr ByteOrder INITIAL_BYTE_ORDER = HIGH_BYTE_FIRST;
+		static constexpr WordOrder INITIAL_WORD_ORDER = HIGH_WORD_FIRST;
+		static constexpr qreal INITIAL_DEADBAND = 0.0;
+		static constexpr qreal INITIAL_RELATIVE_DEADBAND = 0.0;
+		static constexpr int INITIAL_MIN_UPDATE_INTERVAL = 0;
+
+		Q_PROPERTY(qreal value READ value WRITE setValue NOTIFY valueChanged)
+		Q_PROPERTY(qreal valueScale READ valueScale WRITE setValueScale NOTIFY valueScaleChanged)
+		Q_PROPERTY(Encoding encoding READ encoding WRITE setEncoding NOTIFY encodingChanged)
+		Q_PROPERTY(ByteOrder byteOrder READ byteOrder WRITE setByteOrder NOTIFY byteOrderChanged)
+		Q_PROPERTY(WordOrder wordOrder READ wordOrder WRITE setWordOrder NOTIFY wordOrderChanged)
+
+		/**
+		  Deadband in units of scaled value. Zero disables the deadband.
+		  @see Register16Controller::deadband.
+		  */
+		Q_PROPERTY(qreal deadband READ deadband WRITE setDeadband NOTIFY deadbandChanged)
+
+		/**
+		  Relative deadband [%]. Zero disables the deadband.
+		  @see Register16Controller::relativeDeadband.
+		  */
+		Q_PROPERTY(qreal relativeDeadband READ relativeDeadband WRITE setRelativeDeadband NOTIFY relativeDeadbandChanged)
+
+		/**
+		  Minimal update interval [ms]. Zero disables rate limiting.
+		  @see Register16Controller::minUpdateInterval.
+		  */
+		Q_PROPERTY(int minUpdateInterval READ minUpdateInterval WRITE setMinUpdateInterval NOTIFY minUpdateIntervalChanged)
+
+		MultiRegisterController(QObject * parent = nullptr);
+
+		~MultiRegisterController() override;
+
+		qreal value() const;
+
+		void setValue(qreal value);
+
+		qreal valueScale() const;
+
+		void setValueScale(qreal valueScale);
+
+		Encoding encoding() const;
+
+		void setEncoding(Encoding encoding);
+
+		ByteOrder byteOrder() const;
+
+		void setByteOrder(ByteOrder byteOrder);
+
+		WordOrder wordOrder() const;
+
+		void setWordOrder(WordOrder wordOrder);
+
+		qreal deadband() const;
+
+		void setDeadband(qreal deadband);
+
+		qreal relativeDeadband() const;
+
+		void setRelativeDeadband(qreal relativeDeadband);
+
+		int minUpdateInterval() const;
+
+		void setMinUpdateInterval(int minUpdateInterval);
+
+		/**
+		 * Get amount of registers occupied by a value of given encoding.
+		 * @param encoding encoding.
+		 * @return amount of registers.
+		 */
+		static int RegisterCount(Encoding encoding);
+
+		/**
+		 * Decode value.
+		 * @param words registers, in order of their addresses. Amount of registers must match the encoding.
+		 * @param encoding encoding.
+		 * @param byteOrder byte order.
+		 * @param wordOrder word order.
+		 * @return decoded value.
+		 */
+		static qreal Decode(const quint16 * words, Encoding encoding, ByteOrder byteOrder, WordOrder wordOrder);
+
+		/**
+		 * Encode value.
+		 * @param value value to be encoded. It is rounded to the nearest integer in case of integer encodings.
+		 * @param encoding encoding.
+		 * @param byteOrder byte order.
+		 * @param wordOrder word order.
+		 * @param words registers, in order of their addresses, to which encoded value is going to be stored. Amount of registers
+		 * must match the encoding.
+		 */
+		static void Encode(qreal value, Encoding encoding, ByteOrder byteOrder, WordOrder wordOrder, quint16 * words);
+
+	public slots:
+		void writeValue();
+
+	signals:
+		void valueChanged();
+
+		void valueUpdated();
+
+		void valueScaleChanged();
+
+		void encodingChanged();
+
+		void byteOrderChanged();
+
+		void wordOrderChanged();
+
+		void deadbandChanged();
+
+		void relativeDeadbandChanged();
+
+		void minUpdateIntervalChanged();
+
+		void valueWritten();
+
+		void valueFailed();
+
+		void valueMismatch();
+
+	protected:
+		virtual AbstractDevice::Function writeRegisterFunction() const = 0;
+
+		virtual void requestWriteRegisters(quint16 address, quint16 amount, const internal::DataBuffer & values, QUuid * requestId) const = 0;
+
+		virtual Register16 * registerAt(quint16 address) const = 0;
+
+		void timerEvent(QTimerEvent * event) override;
+
+		quint16 bytes() const override;
+
+		void onDeviceDestroyed() override;
+
+		bool awaitsRequest(const QUuid & requestId) const override;
+
+	protected slots:
+		void onDataRequestCompleted(const internal::DataRequest & request, const internal::DataReply & reply) override;
+
+		void onRegistersRead(bool success) override;
+
+		void resetRegister();
+
+	private:
+		static bool ValidateEncoding(qreal value, Encoding encoding);
+
+		void updateValue();
+
+		void updateValue(const internal::DataBuffer & values);
+
+		void updateValue(const quint16 * words);
+
+		void updateFilteredValue();
+
+		qreal registerValue() const;
+
+		void requestWrite(qreal value);
+
+		bool verifyRegisterValue() const;
+
+		bool registerValueChanged() const;
+
+		struct Members
+		{
+			qreal value;
+			qreal valueScale;
+			Encoding encoding;
+			ByteOrder byteOrder;
+			WordOrder wordOrder;
+			qreal deadband;
+			qreal relativeDeadband;
+			int minUpdateInterval;
+			bool postponedWritePending;
+			bool adjustingValue;
+			qreal requestedValue;
+			std::array<Register16 *, MAX_REGISTERS> registers;
+			int registerCount;	///< Amount of registers, which have been set up, or 0 if registers are not available.
+			int registerPollInterval;	///< Poll interval with which registers have been awaken or -1 if they have not been awaken.
+			std::array<quint16, MAX_REGISTERS> writtenWords;	///< Registers, which have been requested to be written most recently.
+			QUuid requestId;
+			QBasicTimer writeTimer;
+			QBasicTimer updateTimer;
+			QElapsedTimer updateClock;
+
+			Members():
+				value(INITIAL_VALUE),
+				valueScale(INITIAL_VALUE_SCALE),
+				encoding(INITIAL_ENCODING),
+				byteOrder(INITIAL_BYTE_ORDER),
+				wordOrder(INITIAL_WORD_ORDER),
+				deadband(INITIAL_DEADBAND),
+				relativeDeadband(INITIAL_RELATIVE_DEADBAND),
+				minUpdateInterval(INITIAL_MIN_UPDATE_INTERVAL),
+				postponedWritePending(false),
+				adjustingValue(false),
+				requestedValue(0.0),
+				registers(),
+				registerCount(0),
+				registerPollInterval(-1),
+				writtenWords()
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
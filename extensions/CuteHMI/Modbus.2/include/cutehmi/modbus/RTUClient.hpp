@@ -2,7 +2,8 @@
 #define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_RTUCLIENT_HPP
 
 #include "AbstractClient.hpp"
-#include "internal/QtRTUClientBackend.hpp"
+#include "internal/NativeRTUClientBackend.hpp"
+#include "internal/BackendThread.hpp"
 
 #include <QThread>
 
@@ -80,14 +81,18 @@ class CUTEHMI_MODBUS_API RTUClient:
 
 		void slaveAddressChanged();
 
+	protected:
+		int pollingWindow() const override;
+
 	private:
 		struct Members {
 			internal::RTUClientConfig config;
-			internal::QtRTUClientBackend backend;
-			QThread thread;
+			internal::NativeRTUClientBackend backend;
+			internal::BackendThread thread;
 
 			Members():
-				backend(& config)
+				backend(& config),
+				thread(& backend)
 			{
 			}
 		};
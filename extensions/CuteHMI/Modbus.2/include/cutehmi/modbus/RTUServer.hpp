@@ -4,6 +4,7 @@
 #include "AbstractServer.hpp"
 #include "internal/RegisterTraits.hpp"
 #include "internal/QtRTUServerBackend.hpp"
+#include "internal/BackendThread.hpp"
 
 #include <cutehmi/macros.hpp>
 
@@ -96,13 +97,14 @@ class CUTEHMI_MODBUS_API RTUServer:
 		{
 			internal::RTUServerConfig config;
 			internal::QtRTUServerBackend backend;
-			QThread thread;
+			internal::BackendThread thread;
 
 			Members(internal::QtRTUServer::CoilDataContainer * coilData,
 					internal::QtRTUServer::DiscreteInputDataContainer * discreteInputData,
 					internal::QtRTUServer::HoldingRegisterDataContainer * holdingRegisterData,
 					internal::QtRTUServer::InputRegisterDataContainer * inputRegisterData):
-				backend(& config, coilData, discreteInputData, holdingRegisterData, inputRegisterData)
+				backend(& config, coilData, discreteInputData, holdingRegisterData, inputRegisterData),
+				thread(& backend)
 			{
 			}
 		};
@@ -4,6 +4,8 @@
 #include "internal/common.hpp"
 
 #include <QAtomicInteger>
+#include <QMutex>
+#include <QMap>
 
 namespace cutehmi {
 namespace modbus {
@@ -22,23 +24,69 @@ class CUTEHMI_MODBUS_API Register1
 
 		bool value() const;
 
-		void rest();
+		/**
+		 * Put register to rest. This function should be called once for each call to awake(), using the same poll interval.
+		 * @param pollInterval poll interval, which has been passed to awake().
+		 *
+		 * @threadsafe
+		 */
+		void rest(int pollInterval = 0);
 
-		void awake();
+		/**
+		 * Awake register. Register remains wakeful as long as there is at least one awakening, which has not been put to rest.
+		 * @param pollInterval requested poll interval [ms]. Value of 0 means that register should be polled in each polling
+		 * cycle. If register has been awaken multiple times with different intervals, then the shortest one becomes effective.
+		 *
+		 * @threadsafe
+		 */
+		void awake(int pollInterval = 0);
 
 		bool wakeful() const;
 
+		/**
+		 * Get effective poll interval.
+		 * @return the shortest of poll intervals requested by awakenings of the register or 0 if register is not wakeful.
+		 *
+		 * @threadsafe
+		 */
+		int pollInterval() const;
+
 	protected:
 		void setValue(bool value);
 
+		/**
+		 * Set generation counter. Counter is incremented each time register becomes wakeful, goes to rest or changes its effective
+		 * poll interval. Data containers share single counter among all of their values, so that polling planners can
+		 * detect changes in a set of addresses, which need to be polled, without scanning containers.
+		 * @param generation generation counter or @p nullptr.
+		 */
+		void setGeneration(QAtomicInt * generation);
+
 	private:
 		struct Members
 		{
 			QAtomicInteger<quint16> value;
 			QAtomicInt awaken;
+			QAtomicInt pollInterval;
+			QMutex pollIntervalsMutex;
+			QMap<int, int> pollIntervals;	///< Number of awakenings per poll interval.
+			QAtomicInt * generation;	///< Generation counter of a data container.
+
+			Members(bool p_value):
+				value(p_value),
+				awaken(0),
+				pollInterval(0),
+				generation(nullptr)
+			{
+			}
 		};
 
-		MPtr<Members> m;
+		static void UpdatePollInterval(Members & members);
+
+		static void IncrementGeneration(Members & members);
+
+		// Members are kept inline rather than behind MPtr, so that registers can be stored contiguously by data containers.
+		Members m;
 };
 
 }
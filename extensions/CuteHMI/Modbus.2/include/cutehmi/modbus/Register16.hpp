@@ -4,6 +4,8 @@
 #include "internal/common.hpp"
 
 #include <QAtomicInteger>
+#include <QMutex>
+#include <QMap>
 
 namespace cutehmi {
 namespace modbus {
@@ -22,23 +24,98 @@ class CUTEHMI_MODBUS_API Register16
 
 		quint16 value() const;
 
-		void rest();
+		/**
+		 * Check whether register holds a valid value. Register becomes valid once its value has been set for the first time (e.g.
+		 * read from or successfully written to the device). Until then value() returns the initial value passed to constructor.
+		 * @return @p true if value has been set, @p false otherwise.
+		 *
+		 * @threadsafe
+		 */
+		bool valid() const;
+
+		/**
+		 * Put register to rest. This function should be called once for each call to awake(), using the same poll interval and
+		 * span.
+		 * @param pollInterval poll interval, which has been passed to awake().
+		 * @param span span, which has been passed to awake().
+		 *
+		 * @threadsafe
+		 */
+		void rest(int pollInterval = 0, int span = 1);
 
-		void awake();
+		/**
+		 * Awake register. Register remains wakeful as long as there is at least one awakening, which has not been put to rest.
+		 * @param pollInterval requested poll interval [ms]. Value of 0 means that register should be polled in each polling
+		 * cycle. If register has been awaken multiple times with different intervals, then the shortest one becomes effective.
+		 * @param span amount of consecutive registers, starting with this one, which must be read with a single request. This
+		 * allows values stored in multiple registers to be polled as one unit. If register has been awaken multiple times with
+		 * different spans, then the largest one becomes effective.
+		 *
+		 * @threadsafe
+		 */
+		void awake(int pollInterval = 0, int span = 1);
 
 		bool wakeful() const;
 
+		/**
+		 * Get effective span.
+		 * @return the largest of spans requested by awakenings of the register or 1 if register is not wakeful.
+		 *
+		 * @threadsafe
+		 */
+		int span() const;
+
+		/**
+		 * Get effective poll interval.
+		 * @return the shortest of poll intervals requested by awakenings of the register or 0 if register is not wakeful.
+		 *
+		 * @threadsafe
+		 */
+		int pollInterval() const;
+
 	protected:
 		void setValue(quint16 value);
 
+		/**
+		 * Set generation counter. Counter is incremented each time register becomes wakeful, goes to rest or changes its effective
+		 * poll interval or span. Data containers share single counter among all of their values, so that polling planners can
+		 * detect changes in a set of addresses, which need to be polled, without scanning containers.
+		 * @param generation generation counter or @p nullptr.
+		 */
+		void setGeneration(QAtomicInt * generation);
+
 	private:
 		struct Members
 		{
 			QAtomicInteger<quint16> value;
+			QAtomicInt valid;
 			QAtomicInt awaken;
+			QAtomicInt pollInterval;
+			QAtomicInt span;
+			QMutex pollIntervalsMutex;	///< Guards both, poll intervals and spans.
+			QMap<int, int> pollIntervals;	///< Number of awakenings per poll interval.
+			QMap<int, int> spans;	///< Number of awakenings per span.
+			QAtomicInt * generation;	///< Generation counter of a data container.
+
+			Members(quint16 p_value):
+				value(p_value),
+				valid(0),
+				awaken(0),
+				pollInterval(0),
+				span(1),
+				generation(nullptr)
+			{
+			}
 		};
 
-		MPtr<Members> m;
+		static void UpdatePollInterval(Members & members);
+
+		static void UpdateSpan(Members & members);
+
+		static void IncrementGeneration(Members & members);
+
+		// Members are kept inline rather than behind MPtr, so that registers can be stored contiguously by data containers.
+		Members m;
 };
 
 }
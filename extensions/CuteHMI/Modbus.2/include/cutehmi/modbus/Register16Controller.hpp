@@ -7,6 +7,7 @@
 #include "AbstractRegisterController.hpp"
 
 #include <QBasicTimer>
+#include <QElapsedTimer>
 
 namespace cutehmi {
 namespace modbus {
@@ -33,11 +34,33 @@ class CUTEHMI_MODBUS_API Register16Controller:
 		static constexpr qreal INITIAL_VALUE = 0.0;
 		static constexpr qreal INITIAL_VALUE_SCALE = 1.0;
 		static constexpr Encoding INITIAL_ENCODING = UINT16;
+		static constexpr qreal INITIAL_DEADBAND = 0.0;
+		static constexpr qreal INITIAL_RELATIVE_DEADBAND = 0.0;
+		static constexpr int INITIAL_MIN_UPDATE_INTERVAL = 0;
 
 		Q_PROPERTY(qreal value READ value WRITE setValue NOTIFY valueChanged)
 		Q_PROPERTY(qreal valueScale READ valueScale WRITE setValueScale NOTIFY valueScaleChanged)
 		Q_PROPERTY(Encoding encoding READ encoding WRITE setEncoding NOTIFY encodingChanged)
 
+		/**
+		  Deadband. Values read from the register, which differ from current value by no more than the deadband, are discarded
+		  without emitting any signal. Deadband is expressed in units of scaled value. Zero disables the deadband.
+		  */
+		Q_PROPERTY(qreal deadband READ deadband WRITE setDeadband NOTIFY deadbandChanged)
+
+		/**
+		  Relative deadband [%]. Works like deadband, but it is expressed as a percentage of current value. Zero disables the
+		  deadband.
+		  */
+		Q_PROPERTY(qreal relativeDeadband READ relativeDeadband WRITE setRelativeDeadband NOTIFY relativeDeadbandChanged)
+
+		/**
+		  Minimal update interval [ms]. Limits rate at which values read from the register are reported. Value, which arrives
+		  sooner than given interval after previous update, is held back and the most recent one is reported once the interval
+		  elapses. Zero disables rate limiting. Values written by the controller are never delayed.
+		  */
+		Q_PROPERTY(int minUpdateInterval READ minUpdateInterval WRITE setMinUpdateInterval NOTIFY minUpdateIntervalChanged)
+
 		Register16Controller(QObject * parent = nullptr);
 
 		~Register16Controller() override;
@@ -54,6 +77,18 @@ class CUTEHMI_MODBUS_API Register16Controller:
 
 		void setEncoding(Encoding encoding);
 
+		qreal deadband() const;
+
+		void setDeadband(qreal deadband);
+
+		qreal relativeDeadband() const;
+
+		void setRelativeDeadband(qreal relativeDeadband);
+
+		int minUpdateInterval() const;
+
+		void setMinUpdateInterval(int minUpdateInterval);
+
 	public slots:
 		void writeValue();
 
@@ -66,6 +101,12 @@ class CUTEHMI_MODBUS_API Register16Controller:
 
 		void encodingChanged();
 
+		void deadbandChanged();
+
+		void relativeDeadbandChanged();
+
+		void minUpdateIntervalChanged();
+
 		void valueWritten();
 
 		void valueFailed();
@@ -73,8 +114,6 @@ class CUTEHMI_MODBUS_API Register16Controller:
 		void valueMismatch();
 
 	protected:
-		virtual AbstractDevice::Function readRegistersFunction() const = 0;
-
 		virtual AbstractDevice::Function writeRegisterFunction() const = 0;
 
 		virtual void requestWriteRegister(quint16 address, quint16 value, QUuid * requestId) const = 0;
@@ -87,8 +126,12 @@ class CUTEHMI_MODBUS_API Register16Controller:
 
 		void onDeviceDestroyed() override;
 
+		bool awaitsRequest(const QUuid & requestId) const override;
+
 	protected slots:
-		void onRequestCompleted(QJsonObject request, QJsonObject reply) override;
+		void onDataRequestCompleted(const internal::DataRequest & request, const internal::DataReply & reply) override;
+
+		void onRegistersRead(bool success) override;
 
 		void resetRegister();
 
@@ -97,7 +140,9 @@ class CUTEHMI_MODBUS_API Register16Controller:
 
 		void updateValue(quint16 value);
 
-		void updateValue(const QJsonValue & value);
+		void updateValue(const internal::DataBuffer & values);
+
+		void updateFilteredValue();
 
 		static qreal Decode(quint16 value, Encoding encoding);
 
@@ -109,27 +154,39 @@ class CUTEHMI_MODBUS_API Register16Controller:
 
 		bool verifyRegisterValue() const;
 
+		bool registerValueChanged() const;
+
 	private:
 		struct Members
 		{
 			qreal value;
 			qreal valueScale;
 			Encoding encoding;
+			qreal deadband;
+			qreal relativeDeadband;
+			int minUpdateInterval;
 			bool postponedWritePending;
 			bool adjustingValue;
 			qreal requestedValue;
 			Register16 * register16;
+			int registerPollInterval;	///< Poll interval with which register has been awaken or -1 if it has not been awaken.
 			QUuid requestId;
 			QBasicTimer writeTimer;
+			QBasicTimer updateTimer;	///< Holds back values, which arrive before minimal update interval elapses.
+			QElapsedTimer updateClock;	///< Measures time since last update passed through the filter.
 
 			Members():
 				value(INITIAL_VALUE),
 				valueScale(INITIAL_VALUE_SCALE),
 				encoding(INITIAL_ENCODING),
+				deadband(INITIAL_DEADBAND),
+				relativeDeadband(INITIAL_RELATIVE_DEADBAND),
+				minUpdateInterval(INITIAL_MIN_UPDATE_INTERVAL),
 				postponedWritePending(false),
 				adjustingValue(false),
 				requestedValue(0.0),
-				register16(nullptr)
+				register16(nullptr),
+				registerPollInterval(-1)
 			{
 			}
 		};
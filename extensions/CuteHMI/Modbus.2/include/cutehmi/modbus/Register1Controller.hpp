@@ -55,8 +55,6 @@ class CUTEHMI_MODBUS_API Register1Controller:
 	protected:
 		virtual Register1 * registerAt(quint16 address) const = 0;
 
-		virtual AbstractDevice::Function readRegistersFunction() const = 0;
-
 		virtual AbstractDevice::Function writeRegisterFunction() const = 0;
 
 		virtual void requestWriteRegister(quint16 address, bool value, QUuid * requestId) const = 0;
@@ -67,8 +65,12 @@ class CUTEHMI_MODBUS_API Register1Controller:
 
 		void onDeviceDestroyed() override;
 
+		bool awaitsRequest(const QUuid & requestId) const override;
+
 	protected slots:
-		void onRequestCompleted(QJsonObject request, QJsonObject reply) override;
+		void onDataRequestCompleted(const internal::DataRequest & request, const internal::DataReply & reply) override;
+
+		void onRegistersRead(bool success) override;
 
 		void resetRegister();
 
@@ -77,12 +79,16 @@ class CUTEHMI_MODBUS_API Register1Controller:
 
 		void updateValue(bool value);
 
-		void updateValue(const QJsonValue & value);
+		void updateValue(const internal::DataBuffer & values);
+
+		void updateFilteredValue();
 
 		void requestWrite(bool value);
 
 		bool verifyRegisterValue() const;
 
+		bool registerValueChanged() const;
+
 	private:
 		struct Members {
 			bool value;
@@ -90,6 +96,7 @@ class CUTEHMI_MODBUS_API Register1Controller:
 			bool adjustingValue;
 			bool requestedValue;
 			Register1 * register1;
+			int registerPollInterval;	///< Poll interval with which register has been awaken or -1 if it has not been awaken.
 			QUuid requestId;
 			QBasicTimer writeTimer;
 
@@ -98,7 +105,8 @@ class CUTEHMI_MODBUS_API Register1Controller:
 				postponedWritePending(false),
 				adjustingValue(false),
 				requestedValue(0.0),
-				register1(nullptr)
+				register1(nullptr),
+				registerPollInterval(-1)
 			{
 			}
 		};
@@ -2,7 +2,8 @@
 #define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_TCPCLIENT_HPP
 
 #include "AbstractClient.hpp"
-#include "internal/QtTCPClientBackend.hpp"
+#include "internal/NativeTCPClientBackend.hpp"
+#include "internal/BackendThread.hpp"
 
 #include <QThread>
 
@@ -59,11 +60,12 @@ class CUTEHMI_MODBUS_API TCPClient:
 	private:
 		struct Members {
 			internal::TCPClientConfig config;
-			internal::QtTCPClientBackend backend;
-			QThread thread;
+			internal::NativeTCPClientBackend backend;
+			internal::BackendThread thread;
 
 			Members():
-				backend(& config)
+				backend(& config),
+				thread(& backend)
 			{
 			}
 		};
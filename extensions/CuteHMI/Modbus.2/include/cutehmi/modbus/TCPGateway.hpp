@@ -0,0 +1,170 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_TCPGATEWAY_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_TCPGATEWAY_HPP
+
+#include "AbstractDevice.hpp"
+#include "internal/NativeTCPGatewayBackend.hpp"
+#include "internal/BackendThread.hpp"
+
+#include <QThread>
+#include <QList>
+#include <QHash>
+#include <QQueue>
+
+namespace cutehmi {
+namespace modbus {
+
+class TCPGatewayClient;
+
+/**
+ * Modbus TCP gateway. Gateway maintains single connection to a Modbus TCP server (typically a TCP to RTU gateway), which is
+ * shared by multiple TCPGatewayClient objects. Each client addresses its own unit and keeps its own register tables, while the
+ * gateway schedules transactions of all clients on a common connection.
+ *
+ * Transactions are scheduled in a round-robin manner, taking one transaction from each client in turn, so that a single busy
+ * unit can not starve the others. At most maxInFlight transactions are awaiting replies at the same time.
+ *
+ * Connection is opened when first client is opened and it is closed when last client is closed.
+ */
+class CUTEHMI_MODBUS_API TCPGateway:
+	public QObject
+{
+		Q_OBJECT
+
+		friend class TCPGatewayClient;
+
+	public:
+		static const char * INITIAL_HOST;
+		static constexpr int INITIAL_PORT = internal::TCPClientConfig::INITIAL_PORT;
+		static constexpr int INITIAL_MAX_IN_FLIGHT = 1;
+		static constexpr bool INITIAL_DEDICATED_THREAD = false;
+
+		Q_PROPERTY(QString host READ host WRITE setHost NOTIFY hostChanged)
+		Q_PROPERTY(int port READ port WRITE setPort NOTIFY portChanged)
+
+		/**
+		 * Maximal number of transactions, which can be awaiting replies at the same time on a shared connection. Clients
+		 * submitting transactions beyond this limit are queued by the gateway.
+		 */
+		Q_PROPERTY(int maxInFlight READ maxInFlight WRITE setMaxInFlight NOTIFY maxInFlightChanged)
+
+		Q_PROPERTY(cutehmi::modbus::AbstractDevice::State state READ state NOTIFY stateChanged)
+
+		/**
+		 * Dedicated thread. Analogous to AbstractDevice::dedicatedThread property.
+		 */
+		Q_PROPERTY(bool dedicatedThread READ dedicatedThread WRITE setDedicatedThread NOTIFY dedicatedThreadChanged)
+
+		TCPGateway(QObject * parent = nullptr);
+
+		~TCPGateway() override;
+
+		QString host() const;
+
+		void setHost(const QString & host);
+
+		int port() const;
+
+		void setPort(int port);
+
+		int maxInFlight() const;
+
+		void setMaxInFlight(int maxInFlight);
+
+		AbstractDevice::State state() const;
+
+		bool dedicatedThread() const;
+
+		void setDedicatedThread(bool dedicatedThread);
+
+	signals:
+		void hostChanged();
+
+		void portChanged();
+
+		void maxInFlightChanged();
+
+		void stateChanged();
+
+		void dedicatedThreadChanged();
+
+	CUTEHMI_PROTECTED_SIGNALS:
+		void unitRequestReceived(int unit, QJsonObject request);
+
+		void unitDataRequestReceived(int unit, cutehmi::modbus::internal::DataRequest request);
+
+	private slots:
+		void onBackendStateChanged(cutehmi::modbus::AbstractDevice::State state);
+
+		void onBackendOpened();
+
+		void onBackendClosed();
+
+		void onBackendErrored(cutehmi::InplaceError error);
+
+		void onBackendReplied(QUuid requestId, QJsonObject reply);
+
+		void onBackendDataReplied(QUuid requestId, cutehmi::modbus::internal::DataReply reply);
+
+	private:
+		struct Transaction
+		{
+			bool data;
+			QJsonObject request;
+			internal::DataRequest dataRequest;
+		};
+
+		typedef QQueue<Transaction> TransactionsQueue;
+		typedef QHash<TCPGatewayClient *, TransactionsQueue> TransactionsQueues;
+		typedef QHash<QUuid, TCPGatewayClient *> InFlightContainer;	// Clients awaiting replies keyed by request ids.
+
+		void attach(TCPGatewayClient * client);
+
+		void detach(TCPGatewayClient * client);
+
+		void submit(TCPGatewayClient * client, const QJsonObject & request);
+
+		void submit(TCPGatewayClient * client, const internal::DataRequest & request);
+
+		/**
+		 * Abort transaction. Client is replied with ReplyAbortedError.
+		 * @param client client, which has submitted the transaction.
+		 * @param transaction transaction to be aborted.
+		 */
+		void abort(TCPGatewayClient * client, const Transaction & transaction);
+
+		void dispatch();
+
+		struct Members {
+			internal::TCPClientConfig config;
+			internal::NativeTCPGatewayBackend backend;
+			internal::BackendThread thread;
+			AbstractDevice::State state;
+			int maxInFlight;
+			QList<TCPGatewayClient *> clients;
+			TransactionsQueues queues;
+			InFlightContainer inFlight;
+			int nextClient;
+
+			Members():
+				backend(& config),
+				thread(& backend),
+				state(AbstractDevice::CLOSED),
+				maxInFlight(INITIAL_MAX_IN_FLIGHT),
+				nextClient(0)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,103 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_TCPGATEWAYCLIENT_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_TCPGATEWAYCLIENT_HPP
+
+#include "AbstractClient.hpp"
+#include "TCPGateway.hpp"
+
+#include <QPointer>
+
+namespace cutehmi {
+namespace modbus {
+
+/**
+ * Modbus TCP gateway client. Client communicates with a single unit behind Modbus TCP gateway. Unlike TCPClient it does not
+ * maintain its own connection nor its own thread. Instead it submits its requests to TCPGateway, which multiplexes requests of
+ * all its clients over a shared connection.
+ */
+class CUTEHMI_MODBUS_API TCPGatewayClient:
+	public AbstractClient
+{
+		Q_OBJECT
+
+		friend class TCPGateway;
+
+	public:
+		static constexpr int MIN_SLAVE_ADDRESS = internal::TCPClientConfig::MIN_SLAVE_ADDRESS;
+		static constexpr int MAX_SLAVE_ADDRESS = internal::TCPClientConfig::MAX_SLAVE_ADDRESS;
+		static constexpr int INITIAL_SLAVE_ADDRESS = internal::TCPClientConfig::INITIAL_SLAVE_ADDRESS;
+
+		/**
+		 * Gateway, which is used to communicate with a unit.
+		 */
+		Q_PROPERTY(cutehmi::modbus::TCPGateway * gateway READ gateway WRITE setGateway NOTIFY gatewayChanged)
+
+		/**
+		 * Slave address (unit identifier) of a unit behind the gateway.
+		 */
+		Q_PROPERTY(int slaveAddress READ slaveAddress WRITE setSlaveAddress NOTIFY slaveAddressChanged)
+
+		TCPGatewayClient(QObject * parent = nullptr);
+
+		~TCPGatewayClient() override;
+
+		TCPGateway * gateway() const;
+
+		void setGateway(TCPGateway * gateway);
+
+		int slaveAddress() const;
+
+		void setSlaveAddress(int slaveAddress);
+
+	public slots:
+		void open() override;
+
+		void close() override;
+
+	signals:
+		void gatewayChanged();
+
+		void slaveAddressChanged();
+
+	protected:
+		void handleRequest(const QJsonObject & request) override;
+
+		void handleDataRequest(const internal::DataRequest & request) override;
+
+	private:
+		void onGatewayStateChanged(AbstractDevice::State state);
+
+		void onGatewayOpened();
+
+		void onGatewayClosed();
+
+		void onGatewayErrored(const InplaceError & error);
+
+		void onGatewayReplied(QUuid requestId, const QJsonObject & reply);
+
+		void onGatewayDataReplied(QUuid requestId, const internal::DataReply & reply);
+
+		struct Members {
+			QPointer<TCPGateway> gateway;
+			int slaveAddress;
+			bool attached;
+
+			Members():
+				slaveAddress(INITIAL_SLAVE_ADDRESS),
+				attached(false)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
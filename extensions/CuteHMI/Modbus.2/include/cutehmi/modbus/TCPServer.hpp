@@ -4,6 +4,7 @@
 #include "AbstractServer.hpp"
 #include "internal/RegisterTraits.hpp"
 #include "internal/QtTCPServerBackend.hpp"
+#include "internal/BackendThread.hpp"
 
 #include <cutehmi/macros.hpp>
 
@@ -73,13 +74,14 @@ class CUTEHMI_MODBUS_API TCPServer:
 		{
 			internal::TCPServerConfig config;
 			internal::QtTCPServerBackend backend;
-			QThread thread;
+			internal::BackendThread thread;
 
 			Members(internal::QtTCPServer::CoilDataContainer * coilData,
 					internal::QtTCPServer::DiscreteInputDataContainer * discreteInputData,
 					internal::QtTCPServer::HoldingRegisterDataContainer * holdingRegisterData,
 					internal::QtTCPServer::InputRegisterDataContainer * inputRegisterData):
-				backend(& config, coilData, discreteInputData, holdingRegisterData, inputRegisterData)
+				backend(& config, coilData, discreteInputData, holdingRegisterData, inputRegisterData),
+				thread(& backend)
 			{
 			}
 		};
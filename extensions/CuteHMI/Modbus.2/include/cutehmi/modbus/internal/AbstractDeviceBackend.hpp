@@ -3,6 +3,8 @@
 
 #include "common.hpp"
 #include "RegisterTraits.hpp"
+#include "DataRequest.hpp"
+#include "DataReply.hpp"
 
 #include <cutehmi/InplaceError.hpp>
 #include <cutehmi/modbus/AbstractClient.hpp>
@@ -28,9 +30,13 @@ class CUTEHMI_MODBUS_PRIVATE AbstractDeviceBackend:
 	public slots:
 		virtual void processRequest(QJsonObject request);
 
+		virtual void processDataRequest(cutehmi::modbus::internal::DataRequest request);
+
 	signals:
 		void replied(QUuid requestId, QJsonObject reply);
 
+		void dataReplied(QUuid requestId, cutehmi::modbus::internal::DataReply reply);
+
 		void errored(cutehmi::InplaceError error);
 
 		void stateChanged(cutehmi::modbus::AbstractDevice::State state);
@@ -42,7 +48,28 @@ class CUTEHMI_MODBUS_PRIVATE AbstractDeviceBackend:
 	protected:
 		explicit AbstractDeviceBackend(QObject * parent = nullptr);
 
-		virtual bool proceedRequest(QUuid requestId) = 0;
+		/**
+		 * Check whether backend is able to proceed with the request. If this function returns @p false, backend replies with an
+		 * error on its own.
+		 * @return @p true if request can be processed, @p false otherwise.
+		 */
+		virtual bool proceedRequest() = 0;
+
+		/**
+		 * Convert bits stored in a data buffer to a vector of values, which can be passed to write functions.
+		 * @param buffer data buffer.
+		 * @param amount amount of bits to convert.
+		 * @return vector of values.
+		 */
+		static QVector<quint16> BitsToVector(const DataBuffer & buffer, int amount);
+
+		/**
+		 * Convert words stored in a data buffer to a vector of values, which can be passed to write functions.
+		 * @param buffer data buffer.
+		 * @param amount amount of words to convert.
+		 * @return vector of values.
+		 */
+		static QVector<quint16> WordsToVector(const DataBuffer & buffer, int amount);
 
 		virtual void readCoils(QUuid requestId, quint16 startAddress, quint16 endAddress);
 
@@ -96,6 +123,8 @@ class CUTEHMI_MODBUS_PRIVATE AbstractDeviceBackend:
 	private:
 		void replyIllegalFunction(QUuid requestId);
 
+		void replyIllegalDataFunction(QUuid requestId);
+
 		const char * humanFunctionName(AbstractDevice::Function) const;
 };
 
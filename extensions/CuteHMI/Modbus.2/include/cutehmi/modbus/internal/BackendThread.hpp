@@ -0,0 +1,65 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_BACKENDTHREAD_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_BACKENDTHREAD_HPP
+
+#include "common.hpp"
+
+#include <QObject>
+#include <QThread>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+/**
+ * Backend thread. Assigns device backend to a thread acquired from IOThreadPool and moves it back to the owner thread upon
+ * destruction. Backend must provide ensureClosed() slot, which is invoked before backend leaves its thread.
+ *
+ * @warning Backend must outlive backend thread object.
+ */
+class CUTEHMI_MODBUS_PRIVATE BackendThread
+{
+	public:
+		/**
+		 * Constructor.
+		 * @param backend backend to be assigned to a thread. Backend must not have a parent.
+		 * @param dedicated whether backend should be pinned to a dedicated thread.
+		 */
+		explicit BackendThread(QObject * backend, bool dedicated = false);
+
+		~BackendThread();
+
+		QThread * thread() const;
+
+		bool dedicated() const;
+
+		/**
+		 * Set whether backend should run on a dedicated thread. Backend is moved between threads accordingly.
+		 * @param dedicated if @p true backend is moved to a dedicated thread, otherwise it is moved to one of shared threads.
+		 */
+		void setDedicated(bool dedicated);
+
+	private:
+		static void MoveToThread(QObject * object, QThread * thread);
+
+		struct Members
+		{
+			QObject * backend;
+			QThread * owner;
+			QThread * thread;
+			bool dedicated;
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -25,6 +25,8 @@ class CUTEHMI_MODBUS_API Coil:
 		explicit Coil(bool value = false);
 
 		using Parent::setValue;
+
+		using Parent::setGeneration;
 };
 
 }
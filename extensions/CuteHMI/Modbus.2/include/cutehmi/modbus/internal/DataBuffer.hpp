@@ -0,0 +1,74 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_DATABUFFER_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_DATABUFFER_HPP
+
+#include "common.hpp"
+
+#include <array>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+/**
+ * Data buffer. Fixed-size storage for values carried by binary requests and replies. Buffer does not allocate any memory on its
+ * own, so it can be copied around (also through queued signal-slot connections) without touching the heap. Registers occupy one
+ * word each, while coils and discrete inputs are packed, so that single word stores sixteen of them (least significant bit of a
+ * word corresponds to the lowest address).
+ */
+class CUTEHMI_MODBUS_PRIVATE DataBuffer
+{
+	public:
+		/**
+		 * Capacity of the buffer in words. It is large enough to hold any amount of registers or bits that fits into a single Modbus
+		 * message (see @ref cutehmi-modbus-AbstractDevice-query_limits "query limits").
+		 */
+		static constexpr int WORD_CAPACITY = 128;
+
+		/**
+		 * Capacity of the buffer in bits.
+		 */
+		static constexpr int BIT_CAPACITY = WORD_CAPACITY * 16;
+
+		/**
+		 * Get word.
+		 * @param index word index. Must be less than WORD_CAPACITY.
+		 * @return word stored at given index.
+		 */
+		quint16 word(int index) const;
+
+		/**
+		 * Set word.
+		 * @param index word index. Must be less than WORD_CAPACITY.
+		 * @param value value to be stored.
+		 */
+		void setWord(int index, quint16 value);
+
+		/**
+		 * Get bit.
+		 * @param index bit index. Must be less than BIT_CAPACITY.
+		 * @return bit stored at given index.
+		 */
+		bool bit(int index) const;
+
+		/**
+		 * Set bit.
+		 * @param index bit index. Must be less than BIT_CAPACITY.
+		 * @param value value to be stored.
+		 */
+		void setBit(int index, bool value);
+
+	private:
+		std::array<quint16, WORD_CAPACITY> m_words {};
+};
+
+}
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
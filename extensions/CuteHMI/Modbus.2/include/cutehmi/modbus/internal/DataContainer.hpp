@@ -3,8 +3,9 @@
 
 #include "common.hpp"
 
-#include <QLinkedList>
-#include <QReadWriteLock>
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QtAlgorithms>
 
 #include <array>
 #include <algorithm>
@@ -15,31 +16,39 @@ namespace modbus {
 namespace internal {
 
 /**
- * Data container.
+ * Data container. Container stores values in pages, each holding PAGE_SIZE values in a contiguous block of memory. Pages are
+ * allocated on demand, so that memory usage scales with the amount of values actually in use rather than with the size of the
+ * address space. Each page keeps a presence bitmap, which tells which of its values have been requested. Keys can be efficiently
+ * iterated in ascending order by scanning presence bitmaps.
+ *
+ * Pointers to values remain valid until free() is called.
+ *
+ * Container does not use locks. Pages are published with atomic pointers and presence bits are set atomically, so readers always
+ * observe either an absent value or a fully constructed one. Since pages are never moved nor deleted while container is in use
+ * (only free() deletes them), readers do not need to defer reclamation with any grace periods or epochs.
+ *
+ * Container keeps generation counter, which is shared by all of its values (see Register16::setGeneration() and
+ * Register1::setGeneration()). Values increment it, whenever they need to be polled differently, so that each container tracks
+ * changes of its own values independently of other containers.
  */
 template <typename T, std::size_t N = 65536>
 class DataContainer
 {
-		typedef std::array<T *, N> InternalContainer;
-		friend class KeysIterator;
-
 	public:
 		typedef T value_type;
 		typedef T & reference;
 		typedef const T & const_reference;
 		typedef T * pointer;
 		typedef const T * const_pointer;
-		// <Qt-Qt_5_11_2_Reference_Documentation-Qt_Core-Container_Classes-The_Container_Classes-QLinkedList_iterator_semantics.principle>
-		// "Iterators pointing to an item in a QLinkedList remain valid as long as the item exists, whereas iterators to a QList can
-		//	become invalid after any insertion or removal."
-		typedef QLinkedList<std::size_t> KeysContainer;
-		// </Qt-Qt_5_11_2_Reference_Documentation-Qt_Core-Container_Classes-The_Container_Classes-QLinkedList_iterator_semantics.principle>
+		typedef std::size_t key_type;
 
 		static constexpr std::size_t ADDRESS_SPACE = N;
+		static constexpr std::size_t PAGE_SIZE = 256;
+		static constexpr std::size_t PAGE_COUNT = (N + PAGE_SIZE - 1) / PAGE_SIZE;
 
 		/**
-		 * Keys iterator. This is read-only, thread-safe version of keys container iterator. It shares lock with data container, so
-		 * that it won't enter iterating function while items are being inserted or removed and vice versa.
+		 * Keys iterator. This is read-only, thread-safe keys iterator. Iterator walks through keys in ascending order. Keys inserted
+		 * during iteration are visited if they are greater than the last key returned by next().
 		 */
 		class KeysIterator
 		{
@@ -48,17 +57,21 @@ class DataContainer
 
 				bool hasNext() const;
 
-				KeysContainer::value_type next();
-
-				KeysContainer::value_type previous();
+				key_type next();
 
 			private:
-				mutable QReadWriteLock * m_lock;
-				QLinkedListIterator<KeysContainer::value_type> m_it;
+				const DataContainer<T, N> * m_container;
+				key_type m_position;
 		};
 
 		DataContainer();
 
+		~DataContainer();
+
+		DataContainer(const DataContainer & other) = delete;
+
+		DataContainer & operator =(const DataContainer & other) = delete;
+
 		/**
 		 * Get container size.
 		 * @return container size.
@@ -103,199 +116,290 @@ class DataContainer
 		T * value(std::size_t i);
 
 		/**
-		 * Insert value.
-		 * @param i index.
-		 * @param value value to be inserted.
-		 *
-		 * @remark Even tho' this function inserts a value, key iterators remain valid after a call to this function.
+		 * Visit range of values. Values, which do not exist are inserted into the container. Function resolves each page only once,
+		 * so it should be preferred over consecutive calls to value(), when accessing a range of values.
+		 * @param first index of first value.
+		 * @param amount amount of values.
+		 * @param visitor function object, which will be called for each value with the value reference and its offset from @a
+		 * first as parameters.
 		 *
 		 * @threadsafe
 		 */
-		void insert(std::size_t i, T * value);
+		template <typename VISITOR>
+		void visit(std::size_t first, std::size_t amount, VISITOR visitor);
 
 		/**
-		 * Clear container. Sets all elements to nullptr. No deletion is performed.
+		 * Visit values, which exist within given range. Unlike visit(), this function does not insert any values, nor it allocates
+		 * any pages. Pages, which have not been allocated are skipped at once.
+		 * @param first index of first value.
+		 * @param amount amount of values.
+		 * @param visitor function object, which will be called for each existing value with the value reference and its offset from
+		 * @a first as parameters.
 		 *
-		 * @remark This function is thread-safe although it invalidates all iterators.
+		 * @threadsafe
+		 */
+		template <typename VISITOR>
+		void visitPresent(std::size_t first, std::size_t amount, VISITOR visitor) const;
+
+		/**
+		 * Get generation. Generation is incremented each time any of the values becomes wakeful, goes to rest or changes the way it
+		 * is polled.
+		 * @return current generation.
 		 *
 		 * @threadsafe
 		 */
-		void clear();
+		int generation() const;
 
 		/**
-		 * Delete container contents. Function deletes all non-null elements and sets all elements to nullptr.
+		 * Delete container contents. Function deletes all the pages.
 		 *
-		 * @remark This function is thread-safe although it invalidates all iterators.
+		 * @warning This function invalidates all pointers to values. It must not be called concurrently with any other function.
+		 */
+		void free();
+
+	protected:
+		typedef quint32 PresenceWord;	// 32 bit words, because 64 bit atomics are not available on all platforms.
+
+		static constexpr std::size_t PRESENCE_WORD_BITS = sizeof(PresenceWord) * 8;
+
+		struct Page
+		{
+			std::array<T, PAGE_SIZE> values;
+			std::array<QAtomicInteger<PresenceWord>, PAGE_SIZE / PRESENCE_WORD_BITS> presence;
+
+			Page():
+				values(),
+				presence()
+			{
+			}
+
+			bool present(std::size_t offset) const;
+
+			void setPresent(std::size_t offset);
+		};
+
+		static_assert(PAGE_SIZE % PRESENCE_WORD_BITS == 0, "page size must be a multiple of presence word size");
+
+		/**
+		 * Find first key, which is equal to or greater than given index.
+		 * @param i index.
+		 * @return found key or ADDRESS_SPACE if there are no more keys.
 		 *
 		 * @threadsafe
 		 */
-		void free();
+		key_type findKey(std::size_t i) const;
 
 		/**
-		 * Get keys container.
-		 * @return keys container.
+		 * Get page, allocating it, if it does not exist.
+		 * @param pageIndex index of a page.
+		 * @return page.
 		 *
 		 * @threadsafe
 		 */
-		const KeysContainer & keys() const;
+		Page * allocatedPage(std::size_t pageIndex);
 
-	protected:
-		QReadWriteLock & lock() const;
+		std::array<QAtomicPointer<Page>, PAGE_COUNT> m_pages;
+		QAtomicInt m_generation;
+};
+
+template <typename T, std::size_t N>
+constexpr std::size_t DataContainer<T, N>::ADDRESS_SPACE;
 
-		void insertKey(std::size_t i);
+template <typename T, std::size_t N>
+constexpr std::size_t DataContainer<T, N>::PAGE_SIZE;
 
-		InternalContainer m_array;
-		KeysContainer m_keys;
-		mutable QReadWriteLock m_lock;
-};
+template <typename T, std::size_t N>
+constexpr std::size_t DataContainer<T, N>::PAGE_COUNT;
+
+template <typename T, std::size_t N>
+constexpr std::size_t DataContainer<T, N>::PRESENCE_WORD_BITS;
 
 template <typename T, std::size_t N>
 DataContainer<T, N>::KeysIterator::KeysIterator(const DataContainer<T, N> * container):
-	m_lock(& container->lock()),
-	m_it(container->keys())
+	m_container(container),
+	m_position(0)
 {
 }
 
 template <typename T, std::size_t N>
 bool DataContainer<T, N>::KeysIterator::hasNext() const
 {
-	QReadLocker locker(m_lock);
-
-	return m_it.hasNext();
+	return m_container->findKey(m_position) < ADDRESS_SPACE;
 }
 
 template <typename T, std::size_t N>
-typename DataContainer<T, N>::KeysContainer::value_type DataContainer<T, N>::KeysIterator::next()
+typename DataContainer<T, N>::key_type DataContainer<T, N>::KeysIterator::next()
 {
-	QReadLocker locker(m_lock);
-
-	return m_it.next();
+	key_type result = m_container->findKey(m_position);
+	CUTEHMI_ASSERT(result < ADDRESS_SPACE, "there is no next key");
+	m_position = result + 1;
+	return result;
 }
 
 template <typename T, std::size_t N>
-typename DataContainer<T, N>::KeysContainer::value_type DataContainer<T, N>::KeysIterator::previous()
+bool DataContainer<T, N>::Page::present(std::size_t offset) const
 {
-	QReadLocker locker(m_lock);
-
-	return m_it.previous();
+	return presence[offset / PRESENCE_WORD_BITS].loadAcquire() & (PresenceWord(1) << (offset % PRESENCE_WORD_BITS));
 }
 
 template <typename T, std::size_t N>
+void DataContainer<T, N>::Page::setPresent(std::size_t offset)
+{
+	PresenceWord bit = PresenceWord(1) << (offset % PRESENCE_WORD_BITS);
+	if (!(presence[offset / PRESENCE_WORD_BITS].loadAcquire() & bit))
+		presence[offset / PRESENCE_WORD_BITS].fetchAndOrRelease(bit);
+}
 
+template <typename T, std::size_t N>
 DataContainer<T, N>::DataContainer():
-	m_array()
+	m_pages(),
+	m_generation(0)
 {
 }
 
+template <typename T, std::size_t N>
+DataContainer<T, N>::~DataContainer()
+{
+	free();
+}
+
 template <typename T, std::size_t N>
 constexpr std::size_t DataContainer<T, N>::size() const noexcept
 {
-	// <cppreference.com-C++-Containers_library-Thread_safety-2.principle>
-	// "2. All const member functions can be called concurrently by different threads on the same container."
-	//	                                                                              -- https://en.cppreference.com/w/cpp/container
-	return m_array.size();
-	// </cppreference.com-C++-Containers_library-Thread_safety-2.principle>
+	return N;
 }
 
 template <typename T, std::size_t N>
 const T * DataContainer<T, N>::at(std::size_t i) const
 {
-	QReadLocker locker(& m_lock);
+	CUTEHMI_ASSERT(i < N, "index out of container bounds");
 
-	return m_array.at(i);
+	const Page * page = m_pages[i / PAGE_SIZE].loadAcquire();
+	if (page && page->present(i % PAGE_SIZE))
+		return & page->values[i % PAGE_SIZE];
+	return nullptr;
 }
 
 template <typename T, std::size_t N>
 T * DataContainer<T, N>::at(std::size_t i)
 {
-	QReadLocker locker(& m_lock);
-
-	return m_array.at(i);
+	return const_cast<T *>(static_cast<const DataContainer<T, N> &>(*this).at(i));
 }
 
 template <typename T, std::size_t N>
 T * DataContainer<T, N>::value(std::size_t i)
 {
-	T * result;
-
-	{
-		QReadLocker readLocker(& m_lock);
-
-		result = m_array.at(i);
-	}
+	T * result = at(i);
 
 	if (result == nullptr) {
-		QWriteLocker writeLocker(& m_lock);
-
-		// In a meanwhile value may have been created from another thread, so perform a lookup again - this time it is serialized by write locker.
-		result = m_array.at(i);
-
-		if (result == nullptr) {
-			result = new T;
-			m_array[i] = result;
-			insertKey(i);
-		}
+		// In a meanwhile value may have been inserted from another thread, but setting presence bit is idempotent.
+		Page * page = allocatedPage(i / PAGE_SIZE);
+		page->setPresent(i % PAGE_SIZE);
+		result = & page->values[i % PAGE_SIZE];
 	}
 
 	return result;
 }
 
 template <typename T, std::size_t N>
-void DataContainer<T, N>::insert(std::size_t i, T * value)
+template <typename VISITOR>
+void DataContainer<T, N>::visit(std::size_t first, std::size_t amount, VISITOR visitor)
 {
-	QWriteLocker locker(& m_lock);
+	CUTEHMI_ASSERT(first + amount <= N, "range out of container bounds");
 
-	m_array[i] = value;
-	insertKey(i);
-}
+	std::size_t offset = 0;
+	while (offset < amount) {
+		std::size_t i = first + offset;
+		std::size_t pageIndex = i / PAGE_SIZE;
+		std::size_t pageOffset = i % PAGE_SIZE;
+		std::size_t pageAmount = std::min(PAGE_SIZE - pageOffset, amount - offset);
 
-template <typename T, std::size_t N>
-void DataContainer<T, N>::clear()
-{
-	QWriteLocker locker(& m_lock);
+		Page * page = allocatedPage(pageIndex);
+		for (std::size_t j = pageOffset; j < pageOffset + pageAmount; j++)
+			page->setPresent(j);
 
-	m_keys.clear();
+		T * values = & page->values[pageOffset];
+		for (std::size_t j = 0; j < pageAmount; j++)
+			visitor(values[j], offset + j);
 
-	std::fill(m_array.begin(), m_array.end(), nullptr);
+		offset += pageAmount;
+	}
 }
 
 template <typename T, std::size_t N>
-void DataContainer<T, N>::free()
+template <typename VISITOR>
+void DataContainer<T, N>::visitPresent(std::size_t first, std::size_t amount, VISITOR visitor) const
 {
-	QWriteLocker locker(& m_lock);
-
-	for (typename DataContainer<T, N>::KeysContainer::const_iterator it = keys().begin(); it != keys().end(); ++it)
-		delete m_array.at(*it);
-
-	m_keys.clear();
+	CUTEHMI_ASSERT(first + amount <= N, "range out of container bounds");
+
+	std::size_t offset = 0;
+	while (offset < amount) {
+		std::size_t i = first + offset;
+		std::size_t pageIndex = i / PAGE_SIZE;
+		std::size_t pageOffset = i % PAGE_SIZE;
+		std::size_t pageAmount = std::min(PAGE_SIZE - pageOffset, amount - offset);
+
+		const Page * page = m_pages[pageIndex].loadAcquire();
+		if (page)
+			for (std::size_t j = 0; j < pageAmount; j++)
+				if (page->present(pageOffset + j))
+					visitor(page->values[pageOffset + j], offset + j);
+
+		offset += pageAmount;
+	}
+}
 
-	std::fill(m_array.begin(), m_array.end(), nullptr);
+template <typename T, std::size_t N>
+int DataContainer<T, N>::generation() const
+{
+	return m_generation.loadAcquire();
 }
 
 template <typename T, std::size_t N>
-const typename DataContainer<T, N>::KeysContainer & DataContainer<T, N>::keys() const
+void DataContainer<T, N>::free()
 {
-	return m_keys;
+	for (auto it = m_pages.begin(); it != m_pages.end(); ++it)
+		delete it->fetchAndStoreAcquire(nullptr);
 }
 
 template <typename T, std::size_t N>
-QReadWriteLock & DataContainer<T, N>::lock() const
+typename DataContainer<T, N>::key_type DataContainer<T, N>::findKey(std::size_t i) const
 {
-	return m_lock;
+	for (std::size_t pageIndex = i / PAGE_SIZE; pageIndex < PAGE_COUNT; pageIndex++) {
+		const Page * page = m_pages[pageIndex].loadAcquire();
+		std::size_t pageOffset = (pageIndex == i / PAGE_SIZE) ? i % PAGE_SIZE : 0;
+		if (page == nullptr)
+			continue;
+
+		for (std::size_t wordIndex = pageOffset / PRESENCE_WORD_BITS; wordIndex < page->presence.size(); wordIndex++) {
+			PresenceWord word = page->presence[wordIndex].loadAcquire();
+			// Mask out bits preceding the index in the word, which contains it.
+			if (wordIndex == pageOffset / PRESENCE_WORD_BITS)
+				word &= ~PresenceWord(0) << (pageOffset % PRESENCE_WORD_BITS);
+			if (word) {
+				key_type result = pageIndex * PAGE_SIZE + wordIndex * PRESENCE_WORD_BITS + qCountTrailingZeroBits(word);
+				return result < N ? result : N;
+			}
+		}
+	}
+	return N;
 }
 
 template <typename T, std::size_t N>
-void DataContainer<T, N>::insertKey(std::size_t i)
+typename DataContainer<T, N>::Page * DataContainer<T, N>::allocatedPage(std::size_t pageIndex)
 {
-	KeysContainer::iterator it = m_keys.begin();
-	while (it != m_keys.end()) {
-		if (*it < i)
-			++it;
+	Page * page = m_pages[pageIndex].loadAcquire();
+	if (page == nullptr) {
+		// Page is fully constructed before it gets published. If another thread has published its page first, then use that one.
+		Page * newPage = new Page;
+		for (auto && value : newPage->values)
+			value.setGeneration(& m_generation);
+		if (m_pages[pageIndex].testAndSetOrdered(nullptr, newPage, page))
+			page = newPage;
 		else
-			break;
+			delete newPage;
 	}
-
-	m_keys.insert(it, i);
+	return page;
 }
 
 }
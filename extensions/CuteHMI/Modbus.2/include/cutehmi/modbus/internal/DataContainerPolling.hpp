@@ -2,13 +2,37 @@
 #define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_DATACONTAINERPOLLING_HPP
 
 #include "IterableTasks.hpp"
+#include "functions.hpp"
 
 #include <cutehmi/modbus/AbstractDevice.hpp>
 
+#include <QDeadlineTimer>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <vector>
+
 namespace cutehmi {
 namespace modbus {
 namespace internal {
 
+/**
+ * Data container polling. Polling is performed according to a read plan, which consists of blocks of addresses that can be read
+ * with a single request. Plan is built from sorted addresses of wakeful data, merging neighbouring addresses into a single block
+ * as long as block does not exceed maximal read amount and distance between them does not exceed maximal read gap (see
+ * AbstractDevice::maxReadGap). Greedy merging of sorted addresses yields minimal amount of blocks under these constraints. Plan is
+ * rebuilt only when set of wakeful addresses of the container (see DataContainer::generation()) or the constraints change.
+ *
+ * Registers may require to be read together with their neighbours (see Register16::span()), which is the case for values stored
+ * in multiple registers. Blocks are extended to cover such units entirely, so that their words are never split between two reads.
+ *
+ * Data with distinct poll intervals (see Register16::pollInterval() and Register1::pollInterval()) form scan groups. Blocks are
+ * planned separately for each scan group and each block is scheduled with its own deadline. Only blocks, which are due at the
+ * beginning of polling cycle are run during the cycle, in order of their deadlines. When plan is rebuilt, blocks, which have not
+ * changed, keep their deadlines, so that only new blocks are due at once and scan groups do not lose their cadence.
+ */
 template <class DERIVED, class DATA>
 class DataContainerPolling:
 	public IterableTasks
@@ -17,6 +41,19 @@ class DataContainerPolling:
 		typedef DATA Data;
 		typedef typename RegisterTraits<Data>::Container DataContainer;
 
+		/**
+		 * Read block.
+		 */
+		struct ReadBlock
+		{
+			quint16 address;	///< Starting address.
+			quint16 amount;		///< Amount of data to be read.
+			int pollInterval;	///< Poll interval of a scan group to which block belongs.
+			qint64 deadline;	///< Time at which block is due to be read, expressed in milliseconds of monotonic clock.
+		};
+
+		typedef std::vector<ReadBlock> ReadPlan;
+
 		DataContainerPolling(AbstractDevice * device, QUuid * requestId);
 
 		AbstractDevice * device() const;
@@ -25,21 +62,51 @@ class DataContainerPolling:
 
 		void reset() override;
 
+		qint64 nextDeadline() const override;
+
+		/**
+		 * Get read plan.
+		 * @return read plan.
+		 */
+		const ReadPlan & plan() const;
+
 		DERIVED & derived();
 
 		const DERIVED & derived() const;
 
 	private:
+		typedef std::vector<typename ReadPlan::size_type> DueBlocksContainer;
+
+		static int Span(const Register16 & data);
+
+		static int Span(const Register1 & data);
+
+		bool planOutdated() const;
+
+		void rebuildPlan();
+
+		void planScanGroup(int pollInterval, const std::vector<quint16> & addresses);
+
 		AbstractDevice * m_device;
 		QUuid * m_requestId;
-		typename DataContainer::KeysIterator m_it;
+		ReadPlan m_plan;
+		DueBlocksContainer m_due;
+		typename DueBlocksContainer::size_type m_next;
+		qint64 m_cycleStart;
+		int m_planGeneration;
+		int m_planMaxRead;
+		int m_planMaxReadGap;
 };
 
 template<class DERIVED, class DATA>
 DataContainerPolling<DERIVED, DATA>::DataContainerPolling(AbstractDevice * device, QUuid * requestId):
 	m_device(device),
 	m_requestId(requestId),
-	m_it(& derived().container())
+	m_next(0),
+	m_cycleStart(0),
+	m_planGeneration(0),
+	m_planMaxRead(-1),	// Negative value enforces plan to be built on first reset().
+	m_planMaxReadGap(-1)
 {
 }
 
@@ -52,46 +119,141 @@ AbstractDevice * DataContainerPolling<DERIVED, DATA>::device() const
 template<class DERIVED, class DATA>
 bool DataContainerPolling<DERIVED, DATA>::runNext()
 {
-	int maxRead = derived().maxRead();
-	quint16 startAddress = 0;
-	quint16 count = 0;
+	if (m_next >= m_due.size())
+		return false;
+
+	ReadBlock & block = m_plan[m_due[m_next++]];
+	derived().requestReadData(block.address, block.amount, m_requestId);
+
+	// Keep cadence of a scan group anchored to its deadlines, unless group has fallen behind, in which case start over from the
+	// current cycle rather than trying to catch up with a burst of requests.
+	block.deadline += block.pollInterval;
+	if (block.deadline <= m_cycleStart)
+		block.deadline = m_cycleStart + block.pollInterval;
+
+	return true;
+}
+
+template<class DERIVED, class DATA>
+void DataContainerPolling<DERIVED, DATA>::reset()
+{
+	// Plan is checked for changes only at the beginning of polling cycle, so that blocks do not shift during the cycle.
+	if (planOutdated())
+		rebuildPlan();
+
+	m_cycleStart = QDeadlineTimer::current().deadline();
+	m_due.clear();
+	for (typename ReadPlan::size_type i = 0; i < m_plan.size(); i++)
+		if (m_plan[i].deadline <= m_cycleStart)
+			m_due.push_back(i);
+	std::stable_sort(m_due.begin(), m_due.end(), [this](typename ReadPlan::size_type a, typename ReadPlan::size_type b) {
+		return m_plan[a].deadline < m_plan[b].deadline;
+	});
+	m_next = 0;
+}
+
+template<class DERIVED, class DATA>
+qint64 DataContainerPolling<DERIVED, DATA>::nextDeadline() const
+{
+	if (m_next >= m_due.size())
+		return std::numeric_limits<qint64>::max();
+
+	return m_plan[m_due[m_next]].deadline;
+}
+
+template<class DERIVED, class DATA>
+const typename DataContainerPolling<DERIVED, DATA>::ReadPlan & DataContainerPolling<DERIVED, DATA>::plan() const
+{
+	return m_plan;
+}
+
+template<class DERIVED, class DATA>
+bool DataContainerPolling<DERIVED, DATA>::planOutdated() const
+{
+	return (m_planGeneration != derived().container().generation())
+			|| (m_planMaxRead != derived().maxRead())
+			|| (m_planMaxReadGap != device()->maxReadGap());
+}
 
-	// Find address of next wakefull register, if any. Value of 'count' set to '1' indicates that such register has been found.
-	while (m_it.hasNext()) {
-		quint16 address = static_cast<quint16>(m_it.next());
+template<class DERIVED, class DATA>
+void DataContainerPolling<DERIVED, DATA>::rebuildPlan()
+{
+	// Generation has to be loaded before scanning, so that changes made during the scan will cause another rebuild.
+	m_planGeneration = derived().container().generation();
+	m_planMaxRead = derived().maxRead();
+	m_planMaxReadGap = device()->maxReadGap();
+
+	ReadPlan previousPlan;
+	previousPlan.swap(m_plan);
+	m_due.clear();
+	m_next = 0;
+
+	// Split sorted addresses into scan groups. Addresses remain sorted within each group.
+	std::map<int, std::vector<quint16>> scanGroups;
+	typename DataContainer::KeysIterator it(& derived().container());
+	while (it.hasNext()) {
+		quint16 address = static_cast<quint16>(it.next());
 		typename DataContainer::const_pointer data = derived().dataAt(address);
-		if (data && data->wakeful()) {
-			startAddress = address;
-			count = 1;
+		if (data && data->wakeful())
+			scanGroups[data->pollInterval()].push_back(address);
+	}
+
+	for (auto group = scanGroups.begin(); group != scanGroups.end(); ++group)
+		planScanGroup(group->first, group->second);
+
+	// Blocks, which have not changed, keep their deadlines. Both plans are sorted by poll intervals and addresses.
+	auto less = [](const ReadBlock & a, const ReadBlock & b) {
+		return std::make_tuple(a.pollInterval, a.address, a.amount) < std::make_tuple(b.pollInterval, b.address, b.amount);
+	};
+	typename ReadPlan::const_iterator previous = previousPlan.cbegin();
+	for (auto block = m_plan.begin(); block != m_plan.end(); ++block) {
+		previous = std::lower_bound(previous, previousPlan.cend(), *block, less);
+		if (previous == previousPlan.cend())
 			break;
-		}
+		if (!less(*block, *previous))
+			block->deadline = previous->deadline;
 	}
 
-	if (count) {
-		// Check if more registers can be read in the same request.
-		while (m_it.hasNext()) {
-			quint16 address = static_cast<quint16>(m_it.next());
-			if ((address - startAddress) < maxRead) {
-				typename DataContainer::const_pointer data = derived().dataAt(address);
-				if (data && data->wakeful())
-					count = address - startAddress + 1;
-			} else {
-				m_it.previous();
-				break;
-			}
-		}
+	CUTEHMI_DEBUG("Rebuilt read plan consisting of " << m_plan.size() << " blocks in " << scanGroups.size() << " scan groups.");
+}
 
-		derived().requestReadData(startAddress, count, m_requestId);
+template<class DERIVED, class DATA>
+void DataContainerPolling<DERIVED, DATA>::planScanGroup(int pollInterval, const std::vector<quint16> & addresses)
+{
+	// Blocks are planned as due immediately.
+	int maxRead = qMax(m_planMaxRead, 1);
+	int startAddress = -1;
+	int lastAddress = -1;
+	for (auto it = addresses.begin(); it != addresses.end(); ++it) {
+		int address = *it;
+		int unitEnd = qMin(address + Span(*derived().dataAt(static_cast<quint16>(address))) - 1, static_cast<int>(AbstractDevice::MAX_ADDRESS));
+		if (startAddress >= 0 && (qMax(lastAddress, unitEnd) - startAddress < maxRead) && (address - lastAddress - 1 <= m_planMaxReadGap))
+			lastAddress = qMax(lastAddress, unitEnd);
+		else {
+			if (startAddress >= 0)
+				m_plan.push_back(ReadBlock{static_cast<quint16>(startAddress), static_cast<quint16>(lastAddress - startAddress + 1), pollInterval, 0});
+			startAddress = address;
+			// Unit, which does not fit into maximal read amount on its own, has to be split anyways.
+			lastAddress = qMin(unitEnd, address + maxRead - 1);
+		}
+	}
+	if (startAddress >= 0)
+		m_plan.push_back(ReadBlock{static_cast<quint16>(startAddress), static_cast<quint16>(lastAddress - startAddress + 1), pollInterval, 0});
+}
 
-		return true;
-	} else
-		return false;
+template<class DERIVED, class DATA>
+int DataContainerPolling<DERIVED, DATA>::Span(const Register16 & data)
+{
+	return data.span();
 }
 
 template<class DERIVED, class DATA>
-void DataContainerPolling<DERIVED, DATA>::reset()
+int DataContainerPolling<DERIVED, DATA>::Span(const Register1 & data)
 {
-	m_it = typename DataContainer::KeysIterator(& derived().container());
+	Q_UNUSED(data)
+
+	// Coils and discrete inputs are never grouped into multi-address units.
+	return 1;
 }
 
 template<class DERIVED, class DATA>
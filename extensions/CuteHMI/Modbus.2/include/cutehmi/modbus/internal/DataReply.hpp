@@ -0,0 +1,38 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_DATAREPLY_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_DATAREPLY_HPP
+
+#include "common.hpp"
+#include "DataBuffer.hpp"
+
+#include <QMetaType>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+/**
+ * Data reply. Binary counterpart of a JSON reply object, which backends emit in response to DataRequest.
+ */
+struct CUTEHMI_MODBUS_PRIVATE DataReply
+{
+	bool success = false;	///< Indicates whether request has succeeded.
+	int error = 0;			///< Error code. One of QModbusDevice::Error enum values.
+	int exceptionCode = 0;	///< Modbus exception code, applicable if @a error is QModbusDevice::ProtocolError.
+	const char * errorString = nullptr;	///< Optional error description. Must point to a string literal, so that reply remains trivially copyable.
+	quint16 amount = 0;		///< Amount of values stored in @a values buffer. Zero means that reply does not carry values.
+	DataBuffer values;		///< Values read from a device.
+};
+
+}
+}
+}
+
+Q_DECLARE_METATYPE(cutehmi::modbus::internal::DataReply)
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
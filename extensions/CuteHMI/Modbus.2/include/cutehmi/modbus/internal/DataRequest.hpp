@@ -0,0 +1,73 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_DATAREQUEST_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_DATAREQUEST_HPP
+
+#include "common.hpp"
+#include "DataBuffer.hpp"
+
+#include <QUuid>
+#include <QMetaType>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+/**
+ * Data request. Binary counterpart of a JSON request object, restricted to functions, which read or write coils, discrete inputs,
+ * holding registers and input registers. Data requests are used internally by polling and register controllers, so that the hot
+ * path does not have to marshal requests and replies to and from JSON.
+ *
+ * For single-value write functions the value is stored in the first word of @a values buffer (or in its first bit, which is the
+ * same for coils and discrete inputs).
+ */
+struct CUTEHMI_MODBUS_PRIVATE DataRequest
+{
+	QUuid id;				///< Request id.
+	int function = 0;		///< Function code. One of AbstractDevice::Function enum values.
+	quint16 address = 0;	///< Starting address.
+	quint16 amount = 0;		///< Amount of coils, discrete inputs or registers.
+	qint64 timestamp = 0;	///< Time at which the request has been issued, expressed in milliseconds since epoch.
+	qint64 issued = 0;		///< Time at which the request has been issued, expressed in microseconds of device monotonic clock.
+	DataBuffer values;		///< Values to be written.
+
+	/**
+	 * Create read request.
+	 * @param function function code.
+	 * @param address starting address.
+	 * @param amount amount of coils, discrete inputs or registers to be read.
+	 * @return read request.
+	 */
+	static DataRequest Read(int function, quint16 address, quint16 amount);
+
+	/**
+	 * Create single-value write request.
+	 * @param function function code.
+	 * @param address address.
+	 * @param value value to be written.
+	 * @return write request.
+	 */
+	static DataRequest Write(int function, quint16 address, quint16 value);
+
+	/**
+	 * Create multiple-value write request.
+	 * @param function function code.
+	 * @param address starting address.
+	 * @param amount amount of coils, discrete inputs or registers to be written.
+	 * @param values values to be written.
+	 * @return write request.
+	 */
+	static DataRequest WriteMultiple(int function, quint16 address, quint16 amount, const DataBuffer & values);
+};
+
+}
+}
+}
+
+Q_DECLARE_METATYPE(cutehmi::modbus::internal::DataRequest)
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -25,6 +25,8 @@ class CUTEHMI_MODBUS_API DiscreteInput:
 		explicit DiscreteInput(bool value = 0);
 
 		using Parent::setValue;
+
+		using Parent::setGeneration;
 };
 
 }
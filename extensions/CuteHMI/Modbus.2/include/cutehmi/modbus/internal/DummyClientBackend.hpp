@@ -28,7 +28,7 @@ class CUTEHMI_MODBUS_PRIVATE DummyClientBackend:
 		void closed();
 
 	protected:
-		bool proceedRequest(QUuid requestId) override;
+		bool proceedRequest() override;
 
 		void readCoils(QUuid requestId, quint16 startAddress, quint16 endAddress) override;
 
@@ -25,6 +25,8 @@ class CUTEHMI_MODBUS_API HoldingRegister:
 		explicit HoldingRegister(quint16 value = 0);
 
 		using Parent::setValue;
+
+		using Parent::setGeneration;
 };
 
 }
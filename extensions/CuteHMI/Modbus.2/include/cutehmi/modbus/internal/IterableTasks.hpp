@@ -35,6 +35,13 @@ class CUTEHMI_MODBUS_PRIVATE IterableTasks:
 		 */
 		virtual void reset() = 0;
 
+		/**
+		 * Get deadline of next task.
+		 * @return time at which next task is due, expressed in milliseconds of monotonic clock (see QDeadlineTimer::deadline()), or
+		 * std::numeric_limits<qint64>::max() if there are no more tasks to run.
+		 */
+		virtual qint64 nextDeadline() const = 0;
+
 		const CoilDataContainer & coilData(const AbstractDevice * device) const;
 
 		const DiscreteInputDataContainer & discreteInputData(const AbstractDevice * device) const;
@@ -0,0 +1,235 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVECLIENTBACKEND_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVECLIENTBACKEND_HPP
+
+#include "common.hpp"
+#include "AbstractClientBackend.hpp"
+
+#include <array>
+#include <vector>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+/**
+ * Native client backend. This backend does not rely on Qt Serial Bus. It encodes requests and decodes
+ * responses on its own, operating on protocol data units (PDUs) stored in preallocated transaction slots, so that data requests
+ * are processed without heap allocations. Subclasses provide a transport, which frames PDUs (application data units) and moves
+ * them through the wire.
+ *
+ * Transactions are queued and subclass is notified about them with dispatch() function. Subclass takes transactions with
+ * takeTransaction() and finishes them either with completeTransaction() or failTransaction().
+ */
+class CUTEHMI_MODBUS_PRIVATE NativeClientBackend:
+	public AbstractClientBackend
+{
+		Q_OBJECT
+
+	public:
+		static constexpr int MAX_PDU_SIZE = 253;	///< Maximal size of Modbus PDU.
+		static constexpr int RESPONSE_TIMEOUT = 1000;	///< Response timeout [ms]. Initial value of adaptive response timeout.
+		static constexpr int MIN_RESPONSE_TIMEOUT = 200;	///< Lower bound of adaptive response timeout [ms]. Lower than one second recommended by RFC 6298, because Modbus slaves respond within tens of milliseconds, but still leaves a margin for latency spikes.
+		static constexpr int MAX_RESPONSE_TIMEOUT = 4000;	///< Upper bound of adaptive response timeout [ms]. Kept well below AbstractDevice::INITIAL_REQUEST_TIMEOUT.
+		static constexpr int INITIAL_QUEUE_CAPACITY = 16;	///< Initial capacity of transaction queue.
+
+	public slots:
+		virtual void ensureClosed() = 0;
+
+		void processDataRequest(cutehmi::modbus::internal::DataRequest request) override;
+
+	signals:
+		void opened();
+
+		void closed();
+
+	protected:
+		/**
+		 * Transaction.
+		 */
+		struct Transaction
+		{
+			QUuid requestId;		///< Request id.
+			quint8 unit = 0;		///< Unit identifier (slave address) captured when transaction has been queued.
+			int function = 0;		///< Function code. One of AbstractDevice::Function enum values.
+			bool data = false;		///< Whether transaction has been issued by data request.
+			quint16 amount = 0;		///< Amount of coils, discrete inputs or registers, which are expected in response.
+			int pduSize = 0;		///< Size of request PDU.
+			std::array<quint8, MAX_PDU_SIZE> pdu;	///< Request PDU.
+		};
+
+		explicit NativeClientBackend(QObject * parent = nullptr);
+
+		virtual int slaveAddress() const = 0;
+
+		/**
+		 * Dispatch transactions. This function is called whenever new transaction has been queued.
+		 */
+		virtual void dispatch() = 0;
+
+		/**
+		 * Take transaction from the queue.
+		 * @param transaction transaction slot, which is going to be filled with taken transaction.
+		 * @return @p true if transaction has been taken, @p false if queue is empty.
+		 */
+		bool takeTransaction(Transaction & transaction);
+
+		/**
+		 * Get amount of queued transactions.
+		 * @return amount of transactions waiting in the queue.
+		 */
+		int pendingTransactions() const;
+
+		/**
+		 * Complete transaction. Function decodes response PDU and emits reply.
+		 * @param transaction transaction.
+		 * @param pdu response PDU.
+		 * @param size size of response PDU.
+		 */
+		void completeTransaction(const Transaction & transaction, const quint8 * pdu, int size);
+
+		/**
+		 * Fail transaction. Function emits error reply.
+		 * @param transaction transaction.
+		 * @param error error code. One of QModbusDevice::Error enum values.
+		 * @param errorString error description. Must point to a string literal.
+		 */
+		void failTransaction(const Transaction & transaction, int error, const char * errorString);
+
+		/**
+		 * Get response timeout. Timeout adapts to round-trip times sampled for particular unit, so that requests sent to a slave,
+		 * which stopped responding, do not hold the line for longer than necessary. Timeout is computed as in TCP retransmission
+		 * timer (RFC 6298), that is as smoothed round-trip time plus four times its variation, bounded by MIN_RESPONSE_TIMEOUT and
+		 * MAX_RESPONSE_TIMEOUT. Until first round-trip time is sampled, RESPONSE_TIMEOUT is used. On fast and steady links timeout
+		 * shrinks towards MIN_RESPONSE_TIMEOUT, so that unresponsive slave is detected sooner; on slow or jittery ones it grows.
+		 * @param unit unit identifier.
+		 * @return response timeout [ms].
+		 */
+		int responseTimeout(quint8 unit) const;
+
+		/**
+		 * Sample round-trip time. Should be called whenever response has been received.
+		 * @param unit unit identifier.
+		 * @param roundTripTime time elapsed between sending the request and receiving the response [ms].
+		 */
+		void sampleRoundTripTime(quint8 unit, qint64 roundTripTime);
+
+		/**
+		 * Back off response timeout. Should be called whenever response has timed out. Timeout is doubled (up to MAX_RESPONSE_TIMEOUT)
+		 * until next round-trip time sample is taken.
+		 * @param unit unit identifier.
+		 */
+		void backOffResponseTimeout(quint8 unit);
+
+		/**
+		 * Fail all queued transactions.
+		 * @param error error code. One of QModbusDevice::Error enum values.
+		 * @param errorString error description. Must point to a string literal.
+		 */
+		void failPendingTransactions(int error, const char * errorString);
+
+		void readExceptionStatus(QUuid requestId) override;
+
+		void diagnostics(QUuid requestId, AbstractDevice::DiagnosticsSubfunction subfunction, quint16 data) override;
+
+		void fetchCommEventCounter(QUuid requestId) override;
+
+		void fetchCommEventLog(QUuid requestId) override;
+
+		void reportSlaveId(QUuid requestId) override;
+
+		void readFileRecord(QUuid requestId, quint8 byteCount, QJsonArray subrequests) override;
+
+		void writeFileRecord(QUuid requestId, quint8 byteCount, QJsonArray subrequests) override;
+
+		void maskWriteHoldingRegister(QUuid requestId, quint16 address, quint16 andMask, quint16 orMask) override;
+
+		void readWriteMultipleHoldingRegisters(QUuid requestId, quint16 readStartAddress, quint16 readEndAddress, quint16 writeAddress, const QVector<quint16> & values) override;
+
+		void readFIFOQueue(QUuid requestId, quint16 address) override;
+
+		/**
+		 * Write byte (octet) into destination byte array.
+		 * @param byte byte to be stored.
+		 * @param destination destination array. Array pointer will be modified to point to a location past the stored byte.
+		 */
+		static void PushByte(quint8 byte, quint8 *& destination);
+
+		/**
+		 * Write word (two octets) into destination byte array. Word is stored in destination array in big-endian order.
+		 * @param word word to be stored.
+		 * @param destination destination array. Array pointer will be modified to point to a location past the stored word.
+		 */
+		static void PushWord(quint16 word, quint8 *& destination);
+
+		/**
+		 * Read byte (octet) from a byte array.
+		 * @param source array to be read. Array pointer will be modified to point to a location past the read byte.
+		 * @return byte read from @a source.
+		 */
+		static quint8 PullByte(const quint8 *& source);
+
+		/**
+		 * Read word (two octets) from a byte array. Array is expected to be in big-endian order.
+		 * @param source array to be read. Array pointer will be modified to point to a location past the read word.
+		 * @return word read from @a source.
+		 */
+		static quint16 PullWord(const quint8 *& source);
+
+	private:
+		/**
+		 * Reserve transaction slot at the back of the queue. Queue grows only if it is full. Unit identifier is taken from
+		 * slaveAddress() at the time of reservation.
+		 * @param requestId request id.
+		 * @param function function code.
+		 * @param data whether transaction is issued by data request.
+		 * @return transaction slot. Slot remains valid until commitTransaction() or next call to reserveTransaction().
+		 */
+		Transaction & reserveTransaction(QUuid requestId, int function, bool data);
+
+		/**
+		 * Commit transaction slot obtained with reserveTransaction() and dispatch it.
+		 * @param pduEnd location past the last byte of request PDU written to the slot.
+		 */
+		void commitTransaction(const quint8 * pduEnd);
+
+		void completeDataTransaction(const Transaction & transaction, const quint8 * pdu, int size);
+
+		void completeJsonTransaction(const Transaction & transaction, const quint8 * pdu, int size);
+
+		void replyError(const Transaction & transaction, int error, int exceptionCode, const char * errorString);
+
+		struct RoundTripTime
+		{
+			qreal smoothed = 0.0;	///< Smoothed round-trip time [ms].
+			qreal variation = 0.0;	///< Round-trip time variation [ms].
+			int timeout = RESPONSE_TIMEOUT;	///< Current response timeout [ms].
+			bool sampled = false;	///< Whether round-trip time has been sampled at least once.
+		};
+
+		struct Members
+		{
+			std::vector<Transaction> queue;
+			std::size_t head = 0;
+			std::size_t count = 0;
+			std::array<RoundTripTime, 256> roundTripTimes;	///< Round-trip times indexed by unit identifier.
+
+			Members():
+				queue(INITIAL_QUEUE_CAPACITY)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,157 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVERTUCLIENTBACKEND_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVERTUCLIENTBACKEND_HPP
+
+#include "NativeClientBackend.hpp"
+#include "RTUClientConfig.hpp"
+
+#include <QSerialPort>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <array>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+/**
+ * Native Modbus RTU client backend. Backend frames PDUs by itself and writes them directly to a serial port. Frames are assembled
+ * in preallocated buffers and CRC is computed with a lookup table. Silent interval of 3.5 character times is derived from serial
+ * port settings and it is measured from the last byte seen on the line. Request is sent immediately, without returning to the
+ * event loop, only if the line has already been silent for that long, which is the case when request is issued while the line
+ * is idle. Response has just been received whenever next queued request is dispatched, so back-to-back requests always wait
+ * out the silent interval with a precise timer rather than by sleeping, so that threads shared with other backends are not
+ * blocked.
+ *
+ * Requests addressed to unit 0 are broadcast. Slaves do not respond to them, so instead of waiting for a response, backend
+ * completes such transaction once the request frame has been transmitted and BROADCAST_TURNAROUND_DELAY has elapsed, giving
+ * slaves time to process the request. Only write functions can be broadcast; other functions are failed.
+ */
+class CUTEHMI_MODBUS_PRIVATE NativeRTUClientBackend:
+	public NativeClientBackend
+{
+		Q_OBJECT
+
+	public:
+		static constexpr int MAX_ADU_SIZE = 256;	///< Maximal size of Modbus RTU frame.
+		static constexpr qint64 FIXED_SILENT_INTERVAL = 1750000;	///< Silent interval [ns] recommended for baud rates greater than 19200.
+		static constexpr int BROADCAST_TURNAROUND_DELAY = 100;	///< Turnaround delay [ms] after broadcast request. Lower bound of a range recommended by Modbus over serial line specification.
+
+		NativeRTUClientBackend(RTUClientConfig * config, QObject * parent = nullptr);
+
+		/**
+		 * Compute Modbus CRC-16.
+		 * @param data data.
+		 * @param size size of data.
+		 * @return CRC-16 of given data.
+		 */
+		static quint16 CRC16(const quint8 * data, int size);
+
+		/**
+		 * Compute silent interval (3.5 character times).
+		 * @param baudRate baud rate.
+		 * @param dataBits data bits.
+		 * @param parity parity.
+		 * @param stopBits stop bits.
+		 * @return silent interval expressed in nanoseconds.
+		 */
+		static qint64 SilentInterval(int baudRate, QSerialPort::DataBits dataBits, QSerialPort::Parity parity, QSerialPort::StopBits stopBits);
+
+		/**
+		 * Compute character time.
+		 * @param baudRate baud rate.
+		 * @param dataBits data bits.
+		 * @param parity parity.
+		 * @param stopBits stop bits.
+		 * @return time needed to transmit single character expressed in nanoseconds or zero if baud rate is invalid.
+		 */
+		static qint64 CharacterTime(int baudRate, QSerialPort::DataBits dataBits, QSerialPort::Parity parity, QSerialPort::StopBits stopBits);
+
+		/**
+		 * Determine size of response frame.
+		 * @param adu beginning of response frame.
+		 * @param size amount of bytes received so far.
+		 * @return expected size of response frame or zero if more bytes need to be received in order to determine it.
+		 */
+		static int ResponseSize(const quint8 * adu, int size);
+
+	public slots:
+		void ensureClosed() override;
+
+	protected:
+		int slaveAddress() const override;
+
+		void dispatch() override;
+
+		bool proceedRequest() override;
+
+	protected slots:
+		void open() override;
+
+		void close() override;
+
+	private slots:
+		void onReadyRead();
+
+		void onResponseTimeout();
+
+		void onBroadcastDelivered();
+
+		void onErrorOccurred(QSerialPort::SerialPortError error);
+
+	private:
+		void send();
+
+		static int ExpectedResponseSize(const Transaction & transaction);
+
+		static bool Broadcastable(const Transaction & transaction);
+
+		static std::array<quint16, 256> CRC16Table();
+
+		struct Members
+		{
+			RTUClientConfig * config;
+			QSerialPort * port;
+			QTimer * responseTimer;
+			QTimer * turnaroundTimer;
+			QTimer * broadcastTimer;
+			QElapsedTimer lineTimer;
+			QElapsedTimer requestTimer;	///< Measures round-trip time of current transaction.
+			qint64 silentInterval;
+			qint64 characterTime;
+			qint64 frameTime;	///< Time [ns] needed to transmit request and expected response of current transaction.
+			bool awaiting;
+			Transaction transaction;
+			int responseSize;
+			std::array<quint8, MAX_ADU_SIZE> request;
+			std::array<quint8, MAX_ADU_SIZE> response;
+
+			Members(RTUClientConfig * p_config, QObject * parent):
+				config(p_config),
+				port(new QSerialPort(parent)),
+				responseTimer(new QTimer(parent)),
+				turnaroundTimer(new QTimer(parent)),
+				broadcastTimer(new QTimer(parent)),
+				silentInterval(FIXED_SILENT_INTERVAL),
+				characterTime(0),
+				frameTime(0),
+				awaiting(false),
+				responseSize(0)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,118 @@
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVETCPCLIENTBACKEND_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVETCPCLIENTBACKEND_HPP
+
+#include "NativeClientBackend.hpp"
+#include "TCPClientConfig.hpp"
+
+#include <QTcpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <vector>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+/**
+ * Native Modbus TCP client backend. Backend prepends MBAP headers to PDUs on its own and multiplexes transactions over single
+ * connection by their transaction identifiers. Transaction identifiers are assigned from a ring, which also limits amount of
+ * transactions in flight. Requests queued within single event loop iteration are gathered in one buffer and written to the
+ * socket at once. Responses are parsed directly out of preallocated receive buffer.
+ */
+class CUTEHMI_MODBUS_PRIVATE NativeTCPClientBackend:
+	public NativeClientBackend
+{
+		Q_OBJECT
+
+	public:
+		static constexpr int MBAP_HEADER_SIZE = 7;	///< Size of MBAP header.
+		static constexpr int MAX_ADU_SIZE = MBAP_HEADER_SIZE + MAX_PDU_SIZE;	///< Maximal size of Modbus TCP frame.
+		static constexpr int IN_FLIGHT_CAPACITY = 256;	///< Maximal amount of transactions in flight. Must be a power of two.
+		static constexpr int SWEEP_INTERVAL = 100;	///< Interval [ms] at which transactions in flight are checked against response timeout.
+
+		NativeTCPClientBackend(TCPClientConfig * config, QObject * parent = nullptr);
+
+	public slots:
+		void ensureClosed() override;
+
+	protected:
+		int slaveAddress() const override;
+
+		void dispatch() override;
+
+		bool proceedRequest() override;
+
+	protected slots:
+		void open() override;
+
+		void close() override;
+
+	private slots:
+		void send();
+
+		void onReadyRead();
+
+		void onStateChanged(QAbstractSocket::SocketState state);
+
+		void onErrorOccurred(QAbstractSocket::SocketError error);
+
+		void sweepTimedOut();
+
+	private:
+		struct InFlight
+		{
+			bool busy = false;
+			quint16 transactionId = 0;
+			qint64 sent = 0;
+			qint64 deadline = 0;
+			Transaction transaction;
+		};
+
+		int parseResponses(const quint8 * data, int size);
+
+		void failInFlight(int error, const char * errorString);
+
+		struct Members
+		{
+			TCPClientConfig * config;
+			QTcpSocket * socket;
+			QTimer * sendTimer;
+			QTimer * sweepTimer;
+			QElapsedTimer clock;
+			quint16 nextTransactionId;
+			int inFlightCount;
+			std::vector<InFlight> inFlight;
+			std::vector<quint8> sendBuffer;
+			std::vector<quint8> receiveBuffer;
+			int receiveSize;
+
+			Members(TCPClientConfig * p_config, QObject * parent):
+				config(p_config),
+				socket(new QTcpSocket(parent)),
+				sendTimer(new QTimer(parent)),
+				sweepTimer(new QTimer(parent)),
+				nextTransactionId(0),
+				inFlightCount(0),
+				inFlight(IN_FLIGHT_CAPACITY),
+				sendBuffer(IN_FLIGHT_CAPACITY * MAX_ADU_SIZE),
+				receiveBuffer(IN_FLIGHT_CAPACITY * MAX_ADU_SIZE),
+				receiveSize(0)
+			{
+			}
+		};
+
+		MPtr<Members> m;
+};
+
+}
+}
+}
+
+#endif
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
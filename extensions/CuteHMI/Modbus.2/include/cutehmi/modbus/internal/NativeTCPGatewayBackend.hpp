@@ -1,38 +1,36 @@
-#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_QTRTUCLIENTBACKEND_HPP
-#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_QTRTUCLIENTBACKEND_HPP
+#ifndef H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVETCPGATEWAYBACKEND_HPP
+#define H_EXTENSIONS_CUTEHMI_MODBUS_2_INCLUDE_CUTEHMI_MODBUS_INTERNAL_NATIVETCPGATEWAYBACKEND_HPP
 
-#include "QtClientBackend.hpp"
-#include "RTUClientConfig.hpp"
+#include "NativeTCPClientBackend.hpp"
 
 namespace cutehmi {
 namespace modbus {
 namespace internal {
 
 /**
- * Modbus RTU client backend based on Qt Serial Bus.
+ * Native Modbus TCP gateway backend. Gateway backend shares single connection among multiple units. Unit identifier is passed
+ * along with each request, instead of being taken from configuration.
  */
-class CUTEHMI_MODBUS_PRIVATE QtRTUClientBackend:
-	public QtClientBackend
+class CUTEHMI_MODBUS_PRIVATE NativeTCPGatewayBackend:
+	public NativeTCPClientBackend
 {
 		Q_OBJECT
 
 	public:
-		QtRTUClientBackend(RTUClientConfig * config, QObject * parent = nullptr);
+		NativeTCPGatewayBackend(TCPClientConfig * config, QObject * parent = nullptr);
+
+	public slots:
+		void processUnitRequest(int unit, QJsonObject request);
+
+		void processUnitDataRequest(int unit, cutehmi::modbus::internal::DataRequest request);
 
 	protected:
 		int slaveAddress() const override;
 
-		void configureConnection() override;
-
 	private:
 		struct Members
 		{
-			RTUClientConfig * config;
-
-			Members(RTUClientConfig * p_config):
-				config(p_config)
-			{
-			}
+			int unit = TCPClientConfig::INITIAL_SLAVE_ADDRESS;	// Accessed only from backend thread.
 		};
 
 		MPtr<Members> m;
@@ -44,7 +42,7 @@ class CUTEHMI_MODBUS_PRIVATE QtRTUClientBackend:
 
 #endif
 
-//(c)C: Copyright © 2019, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
 //(c)C: This file is a part of CuteHMI.
 //(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
 //(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
@@ -13,6 +13,10 @@ class AbstractDevice;
 
 namespace internal {
 
+/**
+ * Polling iterator. Polling iterator runs polling tasks of all data containers. Among the tasks, which are due within a polling
+ * cycle, the one with the earliest deadline is run first.
+ */
 class CUTEHMI_MODBUS_PRIVATE PollingIterator:
 	public IterableTasks
 {
@@ -23,6 +27,8 @@ class CUTEHMI_MODBUS_PRIVATE PollingIterator:
 
 		void reset() override;
 
+		qint64 nextDeadline() const override;
+
 		QUuid & requestId();
 
 		const QUuid & requestId() const;
@@ -30,7 +36,6 @@ class CUTEHMI_MODBUS_PRIVATE PollingIterator:
 	private:
 		typedef std::vector<std::unique_ptr<internal::IterableTasks>> TasksCointainer;
 
-		TasksCointainer::iterator m_currentTask;
 		TasksCointainer m_tasks;
 		QUuid m_requestId;
 };
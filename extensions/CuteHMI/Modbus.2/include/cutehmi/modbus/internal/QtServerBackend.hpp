@@ -43,7 +43,7 @@ class CUTEHMI_MODBUS_PRIVATE QtServerBackend:
 
 		QModbusServer * qServer() const;
 
-		bool proceedRequest(QUuid requestId) override;
+		bool proceedRequest() override;
 
 		void readCoils(QUuid requestId, quint16 startAddress, quint16 endAddress) override;
 
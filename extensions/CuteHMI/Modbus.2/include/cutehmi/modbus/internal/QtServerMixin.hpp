@@ -6,6 +6,7 @@
 #include <QtGlobal>
 
 #include <QModbusDataUnitMap>
+#include <QVector>
 
 namespace cutehmi {
 namespace modbus {
@@ -22,6 +23,22 @@ class QtServerMixin
 		bool writeData(const QModbusDataUnit & newData);
 
 	private:
+		/**
+		 * Copy contiguous block of values from a container to data unit.
+		 * @param container data container.
+		 * @param newData data unit, which specifies the block and receives values.
+		 */
+		template <typename CONTAINER>
+		static void ReadBlock(const CONTAINER & container, QModbusDataUnit * newData);
+
+		/**
+		 * Copy contiguous block of values from data unit to a container.
+		 * @param container data container.
+		 * @param newData data unit, which specifies the block and provides values.
+		 */
+		template <typename CONTAINER>
+		static void WriteBlock(CONTAINER & container, const QModbusDataUnit & newData);
+
 		const DERIVED & derived() const;
 
 		DERIVED & derived();
@@ -40,107 +57,45 @@ bool QtServerMixin<DERIVED>::setMap(const QModbusDataUnitMap & map)
 template<typename DERIVED>
 bool QtServerMixin<DERIVED>::readData(QModbusDataUnit * newData) const
 {
-	//<CuteHMI.Modbus-6.unsolved target="Qt" cause="design">
-	// QModbusDataUnit::startAddress() returns `int` value. On systems, where `int` is 16 bit wide it will fail to cover whole
-	// Modbus address range (0 - 65535).
-	static_assert(std::numeric_limits<quint16>::max() <= static_cast<quint16>(std::numeric_limits<int>::max()), "can not safely use startAddress() function on this system");
-
 	switch (newData->registerType()) {
 		case QModbusDataUnit::Coils:
-			for (quint16 index = 0, address = static_cast<quint16>(newData->startAddress()); index < static_cast<quint16>(newData->valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-7.workaround target="Qt" cause="design">
-				// QModbusDataUnit::setValue() function accepts `int` type as its `index` parameter. It should be however safe to
-				// cast `quint16` to `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				newData->setValue(static_cast<int>(index), derived().m->coilData->value(address)->value());
-				//</CuteHMI.Modbus-7.workaround>
-			}
+			ReadBlock(*derived().m->coilData, newData);
 			break;
 		case QModbusDataUnit::DiscreteInputs:
-			for (quint16 index = 0, address = static_cast<quint16>(newData->startAddress()); index < static_cast<quint16>(newData->valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-7.workaround target="Qt" cause="design">
-				// QModbusDataUnit::setValue() function accepts `int` type as its `index` parameter. It should be however safe to
-				// cast `quint16` to `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				newData->setValue(static_cast<int>(index), derived().m->discreteInputData->value(address)->value());
-				//</CuteHMI.Modbus-7.workaround>
-			}
+			ReadBlock(*derived().m->discreteInputData, newData);
 			break;
 		case QModbusDataUnit::HoldingRegisters:
-			for (quint16 index = 0, address = static_cast<quint16>(newData->startAddress()); index < static_cast<quint16>(newData->valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-7.workaround target="Qt" cause="design">
-				// QModbusDataUnit::setValue() function accepts `int` type as its `index` parameter. It should be however safe to
-				// cast `quint16` to `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				newData->setValue(static_cast<int>(index), derived().m->holdingRegisterData->value(address)->value());
-				//</CuteHMI.Modbus-7.workaround>
-			}
+			ReadBlock(*derived().m->holdingRegisterData, newData);
 			break;
 		case QModbusDataUnit::InputRegisters:
-			for (quint16 index = 0, address = static_cast<quint16>(newData->startAddress()); index < static_cast<quint16>(newData->valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-7.workaround target="Qt" cause="design">
-				// QModbusDataUnit::setValue() function accepts `int` type as its `index` parameter. It should be however safe to
-				// cast `quint16` to `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				newData->setValue(static_cast<int>(index), derived().m->inputRegisterData->value(address)->value());
-				//</CuteHMI.Modbus-7.workaround>
-			}
+			ReadBlock(*derived().m->inputRegisterData, newData);
 			break;
 		default:
 			CUTEHMI_WARNING("Unrecognized register type '" << newData->registerType() << "'.");
 	}
 	return true;
-
-	//</CuteHMI.Modbus-6.unsolved>
 }
 
 template<typename DERIVED>
 bool QtServerMixin<DERIVED>::writeData(const QModbusDataUnit & newData)
 {
-	//<CuteHMI.Modbus-6.unsolved target="Qt" cause="design">
-	// QModbusDataUnit::startAddress() returns `int` value. On systems, where `int` is 16 bit wide it will fail to cover
-	// whole Modbus address range (0 - 65535).
-	static_assert(std::numeric_limits<quint16>::max() <= static_cast<quint16>(std::numeric_limits<int>::max()), "can not safely use startAddress() function on this system");
-
 	switch (newData.registerType()) {
 		case QModbusDataUnit::Coils:
-			for (quint16 index = 0, address = static_cast<quint16>(newData.startAddress()); index < static_cast<quint16>(newData.valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-3.workaround target="Qt" cause="design">
-				// QModbusDataUnit::value() function accepts `int` type as its `index` parameter. It should be however safe to cast `quint16` to
-				// `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				derived().m->coilData->value(address)->setValue(static_cast<bool>(newData.value(static_cast<int>(index))));
-				//</CuteHMI.Modbus-3.workaround>
-			}
+			WriteBlock(*derived().m->coilData, newData);
 			break;
 		case QModbusDataUnit::DiscreteInputs:
-			for (quint16 index = 0, address = static_cast<quint16>(newData.startAddress()); index < static_cast<quint16>(newData.valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-3.workaround target="Qt" cause="design">
-				// QModbusDataUnit::value() function accepts `int` type as its `index` parameter. It should be however safe to cast `quint16` to
-				// `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				derived().m->discreteInputData->value(address)->setValue(static_cast<bool>(newData.value(static_cast<int>(index))));
-				//</CuteHMI.Modbus-3.workaround>
-			}
+			WriteBlock(*derived().m->discreteInputData, newData);
 			break;
 		case QModbusDataUnit::HoldingRegisters:
-			for (quint16 index = 0, address = static_cast<quint16>(newData.startAddress()); index < static_cast<quint16>(newData.valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-3.workaround target="Qt" cause="design">
-				// QModbusDataUnit::value() function accepts `int` type as its `index` parameter. It should be however safe to cast `quint16` to
-				// `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				derived().m->holdingRegisterData->value(address)->setValue(newData.value(static_cast<int>(index)));
-				//</CuteHMI.Modbus-3.workaround>
-			}
+			WriteBlock(*derived().m->holdingRegisterData, newData);
 			break;
 		case QModbusDataUnit::InputRegisters:
-			for (quint16 index = 0, address = static_cast<quint16>(newData.startAddress()); index < static_cast<quint16>(newData.valueCount()); index++, address++)	{ // Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
-				//<CuteHMI.Modbus-3.workaround target="Qt" cause="design">
-				// QModbusDataUnit::value() function accepts `int` type as its `index` parameter. It should be however safe to cast `quint16` to
-				// `int` here, even if `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
-				derived().m->inputRegisterData->value(address)->setValue(newData.value(static_cast<int>(index)));
-				//</CuteHMI.Modbus-3.workaround>
-			}
+			WriteBlock(*derived().m->inputRegisterData, newData);
 			break;
 		default:
 			CUTEHMI_WARNING("Unrecognized register type '" << newData.registerType() << "'.");
 	}
 
-	//</CuteHMI.Modbus-6.unsolved>
-
 	//<CuteHMI.Modbus-5.unsolved target="Qt" cause="design">
 	// Signal QModbusServer::dataWritten() uses `int` for `address` type. On systems, where `int` is 16 bit wide it will fail to
 	// cover whole Modbus address range (0-65535).
@@ -158,6 +113,53 @@ bool QtServerMixin<DERIVED>::writeData(const QModbusDataUnit & newData)
 	return true;
 }
 
+template <typename DERIVED>
+template <typename CONTAINER>
+void QtServerMixin<DERIVED>::ReadBlock(const CONTAINER & container, QModbusDataUnit * newData)
+{
+	//<CuteHMI.Modbus-6.unsolved target="Qt" cause="design">
+	// QModbusDataUnit::startAddress() returns `int` value. On systems, where `int` is 16 bit wide it will fail to cover whole
+	// Modbus address range (0 - 65535).
+	static_assert(std::numeric_limits<quint16>::max() <= static_cast<quint16>(std::numeric_limits<int>::max()), "can not safely use startAddress() function on this system");
+
+	//<CuteHMI.Modbus-7.workaround target="Qt" cause="design">
+	// QModbusDataUnit uses `int` type for sizes and indices. It should be however safe to cast value count to `int` here, even if
+	// `int` is 16 bit wide, because of @ref cutehmi-modbus-AbstractDevice-query_limits.
+	QVector<quint16> values(static_cast<int>(newData->valueCount()));	// Values, which do not exist in the container are zeroes.
+	//</CuteHMI.Modbus-7.workaround>
+
+	// Block is copied into a local buffer and handed over to data unit at once, instead of calling QModbusDataUnit::setValue()
+	// for each address.
+	quint16 * valuesData = values.data();
+	// Note: `uint` returned by valueCount() is guaranteed to be at least 16 bit wide.
+	container.visitPresent(static_cast<quint16>(newData->startAddress()), newData->valueCount(), [valuesData](const auto & data, std::size_t index) {
+		valuesData[index] = data.value();
+	});
+	newData->setValues(values);
+
+	//</CuteHMI.Modbus-6.unsolved>
+}
+
+template <typename DERIVED>
+template <typename CONTAINER>
+void QtServerMixin<DERIVED>::WriteBlock(CONTAINER & container, const QModbusDataUnit & newData)
+{
+	//<CuteHMI.Modbus-6.unsolved target="Qt" cause="design">
+	// QModbusDataUnit::startAddress() returns `int` value. On systems, where `int` is 16 bit wide it will fail to cover
+	// whole Modbus address range (0 - 65535).
+	static_assert(std::numeric_limits<quint16>::max() <= static_cast<quint16>(std::numeric_limits<int>::max()), "can not safely use startAddress() function on this system");
+
+	// Value count may have been set independently from values vector, so the smaller of the two is taken.
+	const QVector<quint16> values = newData.values();
+	uint amount = qMin(newData.valueCount(), static_cast<uint>(values.count()));
+	const quint16 * valuesData = values.constData();
+	container.visit(static_cast<quint16>(newData.startAddress()), amount, [valuesData](auto & data, std::size_t index) {
+		data.setValue(static_cast<decltype(data.value())>(valuesData[index]));
+	});
+
+	//</CuteHMI.Modbus-6.unsolved>
+}
+
 template <typename DERIVED>
 const DERIVED & QtServerMixin<DERIVED>::derived() const
 {
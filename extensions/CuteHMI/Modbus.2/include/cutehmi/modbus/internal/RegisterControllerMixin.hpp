@@ -7,7 +7,6 @@
 #include "../AbstractDevice.hpp"
 
 #include <QBasicTimer>
-#include <QJsonObject>
 
 namespace cutehmi {
 namespace modbus {
@@ -27,10 +26,26 @@ class RegisterControllerMixin
 
 		void timerEvent(QTimerEvent * event);
 
-		void onRequestCompleted(QJsonObject request, QJsonObject reply);
+		void onDataRequestCompleted(const DataRequest & request, const DataReply & reply);
+
+		void onRegistersRead(bool success);
 
 		void clearPostponedWrite();
 
+		/**
+		 * Filter value read from the register. Value passes the filter if it changes by more than deadband and relative deadband
+		 * of the controller. Additionally, if minimal update interval is set, values arriving too early are held back by update
+		 * timer. Once the timer expires, derived class is expected to call updateFilteredValue() again.
+		 * @param value new value.
+		 * @return @p true if value should be updated, @p false otherwise.
+		 */
+		bool filterValue(ValueType value);
+
+		/**
+		 * Reset filter. Subsequent value passes the filter unconditionally.
+		 */
+		void resetFilter();
+
 	private:
 		const DERIVED & derived() const;
 
@@ -101,12 +116,12 @@ void RegisterControllerMixin<DERIVED>::timerEvent(QTimerEvent * event)
 }
 
 template<typename DERIVED>
-void RegisterControllerMixin<DERIVED>::onRequestCompleted(QJsonObject request, QJsonObject reply)
+void RegisterControllerMixin<DERIVED>::onDataRequestCompleted(const DataRequest & request, const DataReply & reply)
 {
-	AbstractDevice::Function function = static_cast<AbstractDevice::Function>(request.value("function").toInt());
-	QUuid requestId = QUuid::fromString(request.value("id").toString());
-	bool success = reply.value("success").toBool();
-	quint16 address = static_cast<quint16>(request.value("payload").toObject().value("address").toDouble());
+	AbstractDevice::Function function = static_cast<AbstractDevice::Function>(request.function);
+	const QUuid & requestId = request.id;
+	bool success = reply.success;
+	quint16 address = request.address;
 	if (function == derived().writeRegisterFunction()) {
 		if (requestId == derived().m->requestId) {
 			if (success) {
@@ -119,8 +134,7 @@ void RegisterControllerMixin<DERIVED>::onRequestCompleted(QJsonObject request, Q
 					emit derived().valueWritten();
 
 					// Without readOnWrite verification, written value acts as one, which is currently set in register.
-					/// @todo Consider removing this and updateValue(QJsonValue).
-					derived().updateValue(request.value("payload").toObject().value("value"));
+					derived().updateValue(request.values);
 
 					derived().m->requestId = nullptr;
 				}
@@ -134,8 +148,9 @@ void RegisterControllerMixin<DERIVED>::onRequestCompleted(QJsonObject request, Q
 			}
 		}
 	} else if (function == derived().readRegistersFunction()) {
-		quint16 endAddress = address + static_cast<quint16>(request.value("payload").toObject().value("amount").toDouble()) - 1;
-		if (static_cast<quint16>(derived().address()) >= address && static_cast<quint16>(derived().address()) <= endAddress) {
+		// Controller is updated only if all of its registers have been read by the request.
+		int endAddress = address + request.amount - 1;
+		if (static_cast<quint16>(derived().address()) >= address && static_cast<int>(derived().address()) + derived().bytes() - 1 <= endAddress) {
 			if (requestId == derived().m->requestId) {
 				// If requestId == m->requestId, then request must have been made by controller due to readOnWrite.
 
@@ -155,13 +170,28 @@ void RegisterControllerMixin<DERIVED>::onRequestCompleted(QJsonObject request, Q
 
 				derived().setBusy(!success || derived().m->postponedWritePending);
 
-				derived().updateValue();
+				derived().updateFilteredValue();
 			}
 		}
 	}
 	clearPostponedWrite();
 }
 
+template<typename DERIVED>
+void RegisterControllerMixin<DERIVED>::onRegistersRead(bool success)
+{
+	// Replies to controller's own requests are never batched, so this can only be a standard update. It is skipped if controller
+	// has issued a request in a meanwhile.
+	if (derived().m->requestId.isNull()) {
+		derived().setBusy(!success || derived().m->postponedWritePending);
+
+		// Unlike in onDataRequestCompleted(), controller is not signalled at all if its value has not changed.
+		if (derived().registerValueChanged())
+			derived().updateFilteredValue();
+	}
+	clearPostponedWrite();
+}
+
 template<typename DERIVED>
 void RegisterControllerMixin<DERIVED>::clearPostponedWrite()
 {
@@ -170,6 +200,40 @@ void RegisterControllerMixin<DERIVED>::clearPostponedWrite()
 	derived().m->postponedWritePending = false;
 }
 
+template<typename DERIVED>
+bool RegisterControllerMixin<DERIVED>::filterValue(ValueType value)
+{
+	typename DERIVED::Members & members = *derived().m;
+
+	qreal change = qAbs(value - members.value);
+	if ((members.deadband > 0.0 && change <= members.deadband)
+			|| (members.relativeDeadband > 0.0 && change <= qAbs(members.value) * members.relativeDeadband / 100.0)) {
+		// Value held back by update timer is not going to be delivered, once it has fallen back into deadband.
+		members.updateTimer.stop();
+		return false;
+	}
+
+	if (members.minUpdateInterval > 0 && members.updateClock.isValid()) {
+		qint64 remaining = members.minUpdateInterval - members.updateClock.elapsed();
+		if (remaining > 0) {
+			if (!members.updateTimer.isActive())
+				members.updateTimer.start(static_cast<int>(remaining), & derived());
+			return false;
+		}
+	}
+
+	members.updateTimer.stop();
+	members.updateClock.start();
+	return true;
+}
+
+template<typename DERIVED>
+void RegisterControllerMixin<DERIVED>::resetFilter()
+{
+	derived().m->updateTimer.stop();
+	derived().m->updateClock.invalidate();
+}
+
 template <typename DERIVED>
 const DERIVED & RegisterControllerMixin<DERIVED>::derived() const
 {
@@ -8,6 +8,7 @@ namespace modbus {
 
 class Register16Controller;
 class Register1Controller;
+class MultiRegisterController;
 
 namespace internal {
 
@@ -28,6 +29,12 @@ struct RegisterControllerTraits<Register1Controller>
 	typedef bool ValueType;
 };
 
+template <>
+struct RegisterControllerTraits<MultiRegisterController>
+{
+	typedef qreal ValueType;
+};
+
 }
 }
 }
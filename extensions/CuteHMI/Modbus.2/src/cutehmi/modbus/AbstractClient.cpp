@@ -1,8 +1,16 @@
 #include <cutehmi/modbus/AbstractClient.hpp>
 
+#include <QModbusDevice>
+
 namespace cutehmi {
 namespace modbus {
 
+constexpr int AbstractClient::INITIAL_MAX_IN_FLIGHT;
+constexpr AbstractClient::Health AbstractClient::INITIAL_HEALTH;
+constexpr int AbstractClient::INITIAL_FAILURE_THRESHOLD;
+constexpr int AbstractClient::INITIAL_BACKOFF_INTERVAL;
+constexpr int AbstractClient::INITIAL_MAX_BACKOFF_INTERVAL;
+
 const services::PollingTimer * AbstractClient::pollingTimer() const
 {
 	return & m->pollingTimer;
@@ -13,6 +21,83 @@ services::PollingTimer * AbstractClient::pollingTimer()
 	return & m->pollingTimer;
 }
 
+int AbstractClient::maxInFlight() const
+{
+	return m->maxInFlight;
+}
+
+void AbstractClient::setMaxInFlight(int maxInFlight)
+{
+	if (maxInFlight < 1) {
+		CUTEHMI_WARNING("Value of 'maxInFlight' must be greater than zero; ignoring value '" << maxInFlight << "'.");
+		return;
+	}
+
+	if (m->maxInFlight != maxInFlight) {
+		m->maxInFlight = maxInFlight;
+		emit maxInFlightChanged();
+	}
+}
+
+AbstractClient::Health AbstractClient::health() const
+{
+	return m->health;
+}
+
+int AbstractClient::failureThreshold() const
+{
+	return m->failureThreshold;
+}
+
+void AbstractClient::setFailureThreshold(int failureThreshold)
+{
+	if (failureThreshold < 1) {
+		CUTEHMI_WARNING("Value of 'failureThreshold' must be greater than zero; ignoring value '" << failureThreshold << "'.");
+		return;
+	}
+
+	if (m->failureThreshold != failureThreshold) {
+		m->failureThreshold = failureThreshold;
+		emit failureThresholdChanged();
+	}
+}
+
+int AbstractClient::backoffInterval() const
+{
+	return m->backoffInterval;
+}
+
+void AbstractClient::setBackoffInterval(int backoffInterval)
+{
+	if (backoffInterval < 0) {
+		CUTEHMI_WARNING("Value of 'backoffInterval' can not be negative; ignoring value '" << backoffInterval << "'.");
+		return;
+	}
+
+	if (m->backoffInterval != backoffInterval) {
+		m->backoffInterval = backoffInterval;
+		emit backoffIntervalChanged();
+	}
+}
+
+int AbstractClient::maxBackoffInterval() const
+{
+	return m->maxBackoffInterval;
+}
+
+void AbstractClient::setMaxBackoffInterval(int maxBackoffInterval)
+{
+	if (maxBackoffInterval < 0) {
+		CUTEHMI_WARNING("Value of 'maxBackoffInterval' can not be negative; ignoring value '" << maxBackoffInterval << "'.");
+		return;
+	}
+
+	if (m->maxBackoffInterval != maxBackoffInterval) {
+		m->maxBackoffInterval = maxBackoffInterval;
+		emit maxBackoffIntervalChanged();
+	}
+}
+
 std::unique_ptr<services::Serviceable::ServiceStatuses> AbstractClient::configureStarting(QState * starting)
 {
 	std::unique_ptr<services::Serviceable::ServiceStatuses> statuses = std::make_unique<services::Serviceable::ServiceStatuses>();
@@ -20,6 +105,7 @@ std::unique_ptr<services::Serviceable::ServiceStatuses> AbstractClient::configur
 	QState * connecting = new QState(starting);
 	starting->setInitialState(connecting);
 	statuses->insert(connecting, tr("Connecting"));
+	connect(connecting, & QState::entered, this, & AbstractClient::resetHealth);
 	connect(connecting, & QState::entered, this, & AbstractClient::open);
 
 	return statuses;
@@ -73,6 +159,7 @@ std::unique_ptr<services::Serviceable::ServiceStatuses> AbstractClient::configur
 
 std::unique_ptr<services::Serviceable::ServiceStatuses> AbstractClient::configureRepairing(QState * repairing)
 {
+	connect(repairing, & QState::entered, this, & AbstractClient::resetHealth);
 	connect(repairing, & QState::entered, this, & AbstractClient::open);
 
 	return nullptr;
@@ -122,11 +209,34 @@ void AbstractClient::handleRequest(const QJsonObject & request)
 	emit requestReceived(request);
 }
 
+int AbstractClient::pollingWindow() const
+{
+	return maxInFlight();
+}
+
+void AbstractClient::handleDataRequest(const internal::DataRequest & request)
+{
+	emit dataRequestReceived(request);
+}
+
 void AbstractClient::handleReply(QUuid requestId, QJsonObject reply)
 {
 	AbstractDevice::handleReply(requestId, reply);
 
-	if (requestId == m->pollingIterator.requestId())
+	recordReply(reply.value("success").toBool(), reply.value("errorCode").toInt());
+}
+
+void AbstractClient::handleDataReply(QUuid requestId, internal::DataReply reply)
+{
+	// Replies to requests issued through JSON facade are forwarded to handleReply(), which records them on its own.
+	bool forwarded = !pendingRequest(requestId).isEmpty();
+
+	AbstractDevice::handleDataReply(requestId, reply);
+
+	if (!forwarded)
+		recordReply(reply.success, reply.error);
+
+	if (m->pollingRequests.remove(requestId))
 		emit pollingTaskFinished();
 }
 
@@ -140,15 +250,97 @@ void AbstractClient::onStateChanged()
 
 void AbstractClient::poll()
 {
+	m->pollingRequests.clear();
 	m->pollingIterator.reset();
+	m->probeSent = false;
 }
 
 void AbstractClient::pollingTask()
 {
-	if (!m->pollingIterator.runNext())
+	// While device is backing off, remaining tasks of polling cycle are skipped. Requests in flight are still awaited though.
+	if (backingOff()) {
+		if (m->pollingRequests.isEmpty())
+			emit pollingFinished();
+		return;
+	}
+
+	// Fill polling window with requests. Unreachable device gets a single probe request per polling cycle.
+	int window = m->health == UNREACHABLE ? 1 : pollingWindow();
+	while (m->pollingRequests.count() < window) {
+		if (m->health == UNREACHABLE && m->probeSent)
+			break;
+
+		if (!m->pollingIterator.runNext())
+			break;
+
+		if (m->health == UNREACHABLE)
+			m->probeSent = true;
+
+		// Request may have been completed immediately (e.g. rejected), in which case there is nothing to wait for.
+		if (dataRequestPending(m->pollingIterator.requestId()))
+			m->pollingRequests.insert(m->pollingIterator.requestId());
+	}
+
+	// Window can remain empty only if polling iterator has run out of tasks.
+	if (m->pollingRequests.isEmpty())
 		emit pollingFinished();
 }
 
+void AbstractClient::resetHealth()
+{
+	m->failures = 0;
+	m->backoffDeadline = 0;
+	setHealth(HEALTHY);
+}
+
+void AbstractClient::setHealth(Health health)
+{
+	if (m->health != health) {
+		m->health = health;
+		emit healthChanged();
+	}
+}
+
+void AbstractClient::recordSuccess()
+{
+	if (m->failures > 0)
+		CUTEHMI_DEBUG("Device has responded after " << m->failures << " consecutive failures.");
+
+	m->failures = 0;
+	m->backoffDeadline = 0;
+	setHealth(HEALTHY);
+}
+
+void AbstractClient::recordFailure()
+{
+	m->failures++;
+
+	// Shift is capped, so that it does not overflow, while still exceeding any sensible maximal interval.
+	qint64 backoff = qMin(static_cast<qint64>(m->backoffInterval) << qMin(m->failures - 1, 30), static_cast<qint64>(m->maxBackoffInterval));
+	m->backoffDeadline = m->healthClock.elapsed() + backoff;
+
+	if (m->failures >= m->failureThreshold) {
+		if (m->health != UNREACHABLE)
+			CUTEHMI_WARNING("Device has failed to respond " << m->failures << " times in a row. Polling is reduced to probe requests.");
+		setHealth(UNREACHABLE);
+	} else
+		setHealth(BACKING_OFF);
+}
+
+void AbstractClient::recordReply(bool success, int error)
+{
+	// Any response, including Modbus exception, proves that device is alive.
+	if (success || error == QModbusDevice::ProtocolError)
+		recordSuccess();
+	else if (error == QModbusDevice::TimeoutError)
+		recordFailure();
+}
+
+bool AbstractClient::backingOff() const
+{
+	return m->health != HEALTHY && m->healthClock.elapsed() < m->backoffDeadline;
+}
+
 }
 }
 
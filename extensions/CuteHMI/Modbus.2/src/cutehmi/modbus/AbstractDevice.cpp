@@ -1,9 +1,15 @@
 #include <cutehmi/modbus/AbstractDevice.hpp>
 
 #include <cutehmi/modbus/Exception.hpp>
+#include <cutehmi/modbus/AbstractRegisterController.hpp>
 
 #include <QJsonArray>
 #include <QDateTime>
+#include <QModbusDevice>
+#include <QPointer>
+#include <QVarLengthArray>
+
+#include <iterator>
 
 namespace cutehmi {
 namespace modbus {
@@ -32,10 +38,18 @@ constexpr int AbstractDevice::INITIAL_MAX_READ_HOLDING_REGISTERS;
 constexpr int AbstractDevice::INITIAL_MAX_WRITE_HOLDING_REGISTERS;
 constexpr int AbstractDevice::INITIAL_MAX_READ_INPUT_REGISTERS;
 constexpr int AbstractDevice::INITIAL_MAX_WRITE_INPUT_REGISTERS;
+constexpr int AbstractDevice::INITIAL_MAX_READ_GAP;
 constexpr int AbstractDevice::INITIAL_MAX_REQUESTS;
+constexpr int AbstractDevice::INITIAL_REQUEST_TIMEOUT;
+constexpr int AbstractDevice::INITIAL_NOTIFICATION_INTERVAL;
+constexpr int AbstractDevice::INITIAL_REGISTER_DEADBAND;
+constexpr bool AbstractDevice::INITIAL_DEDICATED_THREAD;
 constexpr AbstractDevice::State AbstractDevice::INITIAL_STATE;
 constexpr bool AbstractDevice::INITIAL_READY;
 
+static_assert(internal::DataBuffer::BIT_CAPACITY >= AbstractDevice::MAX_READ_RTU_COILS, "data buffer must be able to store maximal amount of coils");
+static_assert(internal::DataBuffer::WORD_CAPACITY >= AbstractDevice::MAX_READ_RTU_HOLDING_REGISTERS, "data buffer must be able to store maximal amount of registers");
+
 AbstractDevice::State AbstractDevice::state() const
 {
 	return m->state;
@@ -150,6 +164,19 @@ void AbstractDevice::setMaxWriteInputRegisters(int maxWriteInputRegisters)
 	}
 }
 
+int AbstractDevice::maxReadGap() const
+{
+	return m->maxReadGap;
+}
+
+void AbstractDevice::setMaxReadGap(int maxReadGap)
+{
+	if (m->maxReadGap != maxReadGap) {
+		m->maxReadGap = maxReadGap;
+		emit maxReadGapChanged();
+	}
+}
+
 int AbstractDevice::maxRequests() const
 {
 	return m->maxRequests;
@@ -163,6 +190,84 @@ void AbstractDevice::setMaxRequests(int maxRequests)
 	}
 }
 
+int AbstractDevice::requestTimeout() const
+{
+	return m->requestTimeout;
+}
+
+void AbstractDevice::setRequestTimeout(int requestTimeout)
+{
+	if (m->requestTimeout != requestTimeout) {
+		m->requestTimeout = requestTimeout;
+		m->sweepTimer.stop();
+		if (m->requestTimeout <= 0)
+			m->pendingTimeline.clear();
+		schedulePendingRequestsSweep();
+		emit requestTimeoutChanged();
+	}
+}
+
+int AbstractDevice::notificationInterval() const
+{
+	return m->notificationInterval;
+}
+
+void AbstractDevice::setNotificationInterval(int notificationInterval)
+{
+	if (notificationInterval < 0) {
+		CUTEHMI_WARNING("Value of 'notificationInterval' can not be negative; ignoring value '" << notificationInterval << "'.");
+		return;
+	}
+
+	if (m->notificationInterval != notificationInterval) {
+		m->notificationInterval = notificationInterval;
+		// Deliver notifications, which have been batched so far, so that they are not held any longer than requested.
+		deliverBatchedNotifications();
+		emit notificationIntervalChanged();
+	}
+}
+
+int AbstractDevice::registerDeadband() const
+{
+	return m->registerDeadband;
+}
+
+void AbstractDevice::setRegisterDeadband(int registerDeadband)
+{
+	if (registerDeadband < 0) {
+		CUTEHMI_WARNING("Value of 'registerDeadband' can not be negative; ignoring value '" << registerDeadband << "'.");
+		return;
+	}
+
+	if (m->registerDeadband != registerDeadband) {
+		m->registerDeadband = registerDeadband;
+		emit registerDeadbandChanged();
+	}
+}
+
+bool AbstractDevice::dedicatedThread() const
+{
+	return m->dedicatedThread;
+}
+
+void AbstractDevice::setDedicatedThread(bool dedicatedThread)
+{
+	if (m->dedicatedThread != dedicatedThread) {
+		m->dedicatedThread = dedicatedThread;
+		emit dedicatedThreadChanged();
+	}
+}
+
+DeviceMetrics * AbstractDevice::metrics()
+{
+	return & m->metrics;
+}
+
+const DeviceMetrics * AbstractDevice::metrics() const
+{
+	return & m->metrics;
+}
+
 Coil * AbstractDevice::coilAt(quint16 address)
 {
 	return coilData().value(address);
@@ -375,34 +480,96 @@ void AbstractDevice::request(Function function, QJsonObject payload, QUuid * req
 {
 	QJsonObject request;
 
-	if (requestId != nullptr) {
-		*requestId = QUuid::createUuid();
-		request.insert("id", requestId->toString());
-	} else
-		request.insert("id", QUuid::createUuid().toString());
+	QUuid id = QUuid::createUuid();
+	if (requestId != nullptr)
+		*requestId = id;
+	request.insert("id", id.toString());
 
 	request.insert("function", function);
 
 	request.insert("payload", payload);
 
 	// QJsonValue is converting qint64 to IEEE 754 double, which can directly represent integers up to 2^53, but it should still last till year 285410...
-	request.insert("timestamp", QDateTime::currentMSecsSinceEpoch());
+	qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+	request.insert("timestamp", timestamp);
 
 	CUTEHMI_DEBUG("Received request '" << request << "'.");
 
-	m->pendingRequests.append(request);
-	if (m->pendingRequests.count() > maxRequests()) {
-		QJsonObject reply;
-		reply.insert("success", false);
-		reply.insert("error", tr("Request queue is full."));
-		handleReply(QUuid::fromString(request.value("id").toString()), reply);
-	} else if (validateRequest(request))
+	m->pendingRequests.insert(id, request);
+	trackPendingRequest(timestamp, id);
+	if (pendingRequestsCount() > maxRequests())
+		handleReply(id, ErrorReply(tr("Request queue is full.")));
+	else if (!validateRequest(request))
+		handleReply(id, ErrorReply(tr("Request is illformed.")));
+	else if (!IsDataFunction(function))
 		handleRequest(request);
 	else {
-		QJsonObject reply;
-		reply.insert("success", false);
-		reply.insert("error", tr("Request is illformed."));
-		handleReply(QUuid::fromString(request.value("id").toString()), reply);
+		// Functions, which read or write coils and registers are passed to the backend through binary path.
+		internal::DataRequest dataRequest = DataRequestFromPayload(function, payload);
+		dataRequest.id = id;
+		dataRequest.timestamp = timestamp;
+		dataRequest.issued = m->clock.nsecsElapsed() / 1000;
+		if (validateDataRequest(dataRequest))
+			handleDataRequest(dataRequest);
+		else
+			handleReply(id, ErrorReply(tr("Request is illformed.")));
+	}
+}
+
+void AbstractDevice::requestData(internal::DataRequest request, QUuid * requestId)
+{
+	request.id = QUuid::createUuid();
+	if (requestId != nullptr)
+		*requestId = request.id;
+	request.timestamp = QDateTime::currentMSecsSinceEpoch();
+	request.issued = m->clock.nsecsElapsed() / 1000;
+
+	m->pendingDataRequests.insert(request.id, request);
+	trackPendingRequest(request.timestamp, request.id);
+	if (pendingRequestsCount() > maxRequests()) {
+		internal::DataReply reply;
+		reply.errorString = QT_TR_NOOP("Request queue is full.");
+		handleDataReply(request.id, reply);
+	} else if (validateDataRequest(request))
+		handleDataRequest(request);
+	else {
+		internal::DataReply reply;
+		reply.errorString = QT_TR_NOOP("Request is illformed.");
+		handleDataReply(request.id, reply);
+	}
+}
+
+void AbstractDevice::queueDataWrite(internal::DataRequest request, QUuid * requestId)
+{
+	request.id = QUuid::createUuid();
+	if (requestId != nullptr)
+		*requestId = request.id;
+	request.timestamp = QDateTime::currentMSecsSinceEpoch();
+	request.issued = m->clock.nsecsElapsed() / 1000;
+
+	// Queued write is tracked as a pending request on its own right away, so that it is subject to request limits and timeouts.
+	m->pendingDataRequests.insert(request.id, request);
+	trackPendingRequest(request.timestamp, request.id);
+	if (pendingRequestsCount() > maxRequests()) {
+		internal::DataReply reply;
+		reply.errorString = QT_TR_NOOP("Request queue is full.");
+		handleDataReply(request.id, reply);
+	} else if (WriteMultipleFunction(static_cast<Function>(request.function)) == FUNCTION_INVALID) {
+		CUTEHMI_CRITICAL("Request '" << request.id << "' is illformed. Function code '" << request.function << "' is not a single-value write function.");
+		internal::DataReply reply;
+		reply.errorString = QT_TR_NOOP("Request is illformed.");
+		handleDataReply(request.id, reply);
+	} else if (!validateDataRequest(request)) {
+		internal::DataReply reply;
+		reply.errorString = QT_TR_NOOP("Request is illformed.");
+		handleDataReply(request.id, reply);
+	} else {
+		// Repeated writes to the same address are collapsed, so that only the most recent value is written.
+		QueuedWrite & write = m->writeQueues[request.function][request.address];
+		write.value = request.values.word(0);
+		write.requestIds.append(request.id);
+		if (!m->writeQueueTimer.isActive())
+			m->writeQueueTimer.start(0);
 	}
 }
 
@@ -411,6 +578,9 @@ AbstractDevice::AbstractDevice(QObject * parent):
 	m(new Members)
 {
 	connect(this, & AbstractDevice::errored, this, & AbstractDevice::handleError);
+	connect(& m->sweepTimer, & QTimer::timeout, this, & AbstractDevice::sweepPendingRequests);
+	connect(& m->notificationTimer, & QTimer::timeout, this, & AbstractDevice::deliverBatchedNotifications);
+	connect(& m->writeQueueTimer, & QTimer::timeout, this, & AbstractDevice::flushWriteQueues);
 }
 
 AbstractDevice::~AbstractDevice()
@@ -463,28 +633,38 @@ AbstractDevice::InputRegisterDataContainer & AbstractDevice::inputRegisterData()
 
 QJsonObject AbstractDevice::pendingRequest(QUuid requestId) const
 {
-	for (auto it = m->pendingRequests.begin(); it != m->pendingRequests.end(); ++it)
-		if (QUuid::fromString(it->value("id").toString()) == requestId)
-			return *it;
-	return QJsonObject();
+	return m->pendingRequests.value(requestId);
 }
 
 QJsonObject AbstractDevice::takePendingRequest(QUuid requestId)
 {
-	for (auto it = m->pendingRequests.begin(); it != m->pendingRequests.end(); ++it)
-		if (QUuid::fromString(it->value("id").toString()) == requestId) {
-			QJsonObject result = *it;
-			m->pendingRequests.erase(it);
-			return result;
-		}
-	return QJsonObject();
+	QJsonObject result = m->pendingRequests.take(requestId);
+	releasePendingRequests();
+	return result;
+}
+
+bool AbstractDevice::takePendingDataRequest(QUuid requestId, internal::DataRequest & request)
+{
+	auto it = m->pendingDataRequests.find(requestId);
+	if (it == m->pendingDataRequests.end())
+		return false;
+
+	request = *it;
+	m->pendingDataRequests.erase(it);
+	releasePendingRequests();
+	return true;
+}
+
+bool AbstractDevice::dataRequestPending(QUuid requestId) const
+{
+	return m->pendingDataRequests.contains(requestId);
 }
 
 void AbstractDevice::handleReply(QUuid requestId, QJsonObject reply)
 {
 	QJsonObject request = takePendingRequest(requestId);
 	if (request.isEmpty()) {
-		CUTEHMI_CRITICAL("Could not find a record in pending requests for the request '" << requestId << "'.");
+		CUTEHMI_WARNING("Could not find a record in pending requests for the request '" << requestId << "'. Request might have timed out.");
 		return;
 	}
 
@@ -494,6 +674,8 @@ void AbstractDevice::handleReply(QUuid requestId, QJsonObject reply)
 
 	reply.insert("elapsed", elapsedTime);
 
+	m->metrics.record(request.value("function").toInt(), elapsedTime * 1000, reply.value("success").toBool(), reply.value("errorCode").toInt(), reply.value("protocolErrorCode").toInt());
+
 	if (validateReply(request, reply)) {
 		if (!reply.value("success").toBool()) {
 			QString errorString = tr("Request '%1' has failed.").arg(requestId.toString());
@@ -501,7 +683,11 @@ void AbstractDevice::handleReply(QUuid requestId, QJsonObject reply)
 				errorString += " ";
 				errorString += reply.value("error").toString();
 			}
-			emit errored(CUTEHMI_ERROR(errorString));
+			// Timeouts are not fatal. Clients account them in their health instead of breaking the connection.
+			if (reply.value("errorCode").toInt() == QModbusDevice::TimeoutError)
+				CUTEHMI_WARNING(errorString);
+			else
+				emit errored(CUTEHMI_ERROR(errorString));
 		} else {
 			Function function = static_cast<Function>(request.value("function").toInt());
 			switch (function) {
@@ -607,10 +793,81 @@ void AbstractDevice::handleReply(QUuid requestId, QJsonObject reply)
 	}
 }
 
+void AbstractDevice::handleDataReply(QUuid requestId, internal::DataReply reply)
+{
+	// Reply to a request, which has been merged from queued writes, is fanned out to each of them.
+	MergedWritesContainer::iterator mergedIt = m->mergedWrites.find(requestId);
+	if (mergedIt != m->mergedWrites.end()) {
+		QVector<QUuid> requestIds = *mergedIt;
+		m->mergedWrites.erase(mergedIt);
+
+		if (!reply.success)
+			reportDataReplyFailure(requestId, reply);
+
+		for (auto && id : requestIds) {
+			internal::DataRequest request;
+			// Queued write may have already timed out.
+			if (takePendingDataRequest(id, request)) {
+				m->metrics.record(request.function, m->clock.nsecsElapsed() / 1000 - request.issued, reply.success, reply.error, reply.exceptionCode);
+				if (reply.success)
+					updateDataTables(request, reply);
+				notifyControllers(request, reply);
+				emit dataRequestCompleted(request, reply);
+			}
+		}
+		// All the constituents may have timed out already, in which case they did not release pending requests.
+		releasePendingRequests();
+		return;
+	}
+
+	internal::DataRequest request;
+	if (!takePendingDataRequest(requestId, request)) {
+		// Request may have been issued through JSON facade.
+		QJsonObject jsonRequest = pendingRequest(requestId);
+		if (jsonRequest.isEmpty())
+			CUTEHMI_WARNING("Could not find a record in pending requests for the request '" << requestId << "'. Request might have timed out.");
+		else {
+			Function function = static_cast<Function>(jsonRequest.value("function").toInt());
+			handleReply(requestId, DataReplyToJson(function, reply));
+
+			// Controllers do not listen to requestCompleted() signal, so they have to be notified just as with data requests.
+			request = DataRequestFromPayload(function, jsonRequest.value("payload").toObject());
+			request.id = requestId;
+			notifyControllers(request, reply);
+		}
+		return;
+	}
+
+	qint64 latency = m->clock.nsecsElapsed() / 1000 - request.issued;
+	m->metrics.record(request.function, latency, reply.success, reply.error, reply.exceptionCode);
+
+	CUTEHMI_DEBUG("Handling data reply to request '" << requestId << "', which took " << latency / 1000 << " [ms] to complete.");
+
+	if (!reply.success)
+		reportDataReplyFailure(requestId, reply);
+	else
+		updateDataTables(request, reply);
+	notifyControllers(request, reply);
+	emit dataRequestCompleted(request, reply);
+}
+
+void AbstractDevice::reportDataReplyFailure(QUuid requestId, const internal::DataReply & reply)
+{
+	QString errorString = tr("Request '%1' has failed. %2").arg(requestId.toString()).arg(DataReplyErrorString(reply));
+
+	// Timeouts are not fatal. Clients account them in their health instead of breaking the connection.
+	if (reply.error == QModbusDevice::TimeoutError)
+		CUTEHMI_WARNING(errorString);
+	else
+		emit errored(CUTEHMI_ERROR(errorString));
+}
+
 void AbstractDevice::setState(AbstractDevice::State state)
 {
 	if (m->state != state) {
 		m->state = state;
+		if (state == CLOSED)
+			failMergedWrites();
 		emit stateChanged();
 	}
 }
@@ -629,6 +886,177 @@ void AbstractDevice::handleError(InplaceError error)
 	emit broke();
 }
 
+bool AbstractDevice::IsDataFunction(Function function)
+{
+	switch (function) {
+		case FUNCTION_READ_COILS:
+		case FUNCTION_WRITE_COIL:
+		case FUNCTION_WRITE_MULTIPLE_COILS:
+		case FUNCTION_READ_DISCRETE_INPUTS:
+		case FUNCTION_WRITE_DISCRETE_INPUT:
+		case FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS:
+		case FUNCTION_READ_HOLDING_REGISTERS:
+		case FUNCTION_WRITE_HOLDING_REGISTER:
+		case FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+		case FUNCTION_READ_INPUT_REGISTERS:
+		case FUNCTION_WRITE_INPUT_REGISTER:
+		case FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS:
+			return true;
+		default:
+			return false;
+	}
+}
+
+AbstractDevice::Function AbstractDevice::DataTableReadFunction(Function function)
+{
+	switch (function) {
+		case FUNCTION_READ_COILS:
+		case FUNCTION_WRITE_COIL:
+		case FUNCTION_WRITE_MULTIPLE_COILS:
+			return FUNCTION_READ_COILS;
+		case FUNCTION_READ_DISCRETE_INPUTS:
+		case FUNCTION_WRITE_DISCRETE_INPUT:
+		case FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS:
+			return FUNCTION_READ_DISCRETE_INPUTS;
+		case FUNCTION_READ_HOLDING_REGISTERS:
+		case FUNCTION_WRITE_HOLDING_REGISTER:
+		case FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			return FUNCTION_READ_HOLDING_REGISTERS;
+		case FUNCTION_READ_INPUT_REGISTERS:
+		case FUNCTION_WRITE_INPUT_REGISTER:
+		case FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS:
+			return FUNCTION_READ_INPUT_REGISTERS;
+		default:
+			return FUNCTION_INVALID;
+	}
+}
+
+AbstractDevice::Function AbstractDevice::WriteMultipleFunction(Function function)
+{
+	switch (function) {
+		case FUNCTION_WRITE_COIL:
+			return FUNCTION_WRITE_MULTIPLE_COILS;
+		case FUNCTION_WRITE_DISCRETE_INPUT:
+			return FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS;
+		case FUNCTION_WRITE_HOLDING_REGISTER:
+			return FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS;
+		case FUNCTION_WRITE_INPUT_REGISTER:
+			return FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS;
+		default:
+			return FUNCTION_INVALID;
+	}
+}
+
+internal::DataRequest AbstractDevice::DataRequestFromPayload(Function function, const QJsonObject & payload)
+{
+	internal::DataRequest result;
+	result.function = function;
+	result.address = static_cast<quint16>(payload.value("address").toDouble());
+	switch (function) {
+		case FUNCTION_READ_COILS:
+		case FUNCTION_READ_DISCRETE_INPUTS:
+		case FUNCTION_READ_HOLDING_REGISTERS:
+		case FUNCTION_READ_INPUT_REGISTERS:
+			result.amount = static_cast<quint16>(payload.value("amount").toDouble());
+			break;
+		case FUNCTION_WRITE_COIL:
+		case FUNCTION_WRITE_DISCRETE_INPUT:
+			result.amount = 1;
+			result.values.setBit(0, payload.value("value").toBool());
+			break;
+		case FUNCTION_WRITE_HOLDING_REGISTER:
+		case FUNCTION_WRITE_INPUT_REGISTER:
+			result.amount = 1;
+			result.values.setWord(0, static_cast<quint16>(payload.value("value").toDouble()));
+			break;
+		case FUNCTION_WRITE_MULTIPLE_COILS:
+		case FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS: {
+			// Amount exceeding buffer capacity is going to be rejected by validateDataRequest().
+			QJsonArray values = payload.value("values").toArray();
+			result.amount = static_cast<quint16>(values.count());
+			for (int i = 0; i < qMin(values.count(), internal::DataBuffer::BIT_CAPACITY); i++)
+				result.values.setBit(i, values.at(i).toBool());
+			break;
+		}
+		case FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+		case FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS: {
+			// Amount exceeding buffer capacity is going to be rejected by validateDataRequest().
+			QJsonArray values = payload.value("values").toArray();
+			result.amount = static_cast<quint16>(values.count());
+			for (int i = 0; i < qMin(values.count(), internal::DataBuffer::WORD_CAPACITY); i++)
+				result.values.setWord(i, static_cast<quint16>(values.at(i).toDouble()));
+			break;
+		}
+		default:
+			CUTEHMI_CRITICAL("Function code '" << function << "' can not be represented by data request.");
+	}
+	return result;
+}
+
+QJsonObject AbstractDevice::DataReplyToJson(Function function, const internal::DataReply & reply)
+{
+	QJsonObject result;
+	result.insert("success", reply.success);
+	if (!reply.success) {
+		result.insert("error", DataReplyErrorString(reply));
+		if (reply.error != QModbusDevice::NoError)
+			result.insert("errorCode", reply.error);
+		if (reply.error == QModbusDevice::ProtocolError)
+			result.insert("protocolErrorCode", reply.exceptionCode);
+	} else if (reply.amount > 0) {
+		QJsonArray values;
+		switch (function) {
+			case FUNCTION_READ_COILS:
+			case FUNCTION_READ_DISCRETE_INPUTS:
+				for (int i = 0; i < reply.amount; i++)
+					values.append(reply.values.bit(i));
+				break;
+			case FUNCTION_READ_HOLDING_REGISTERS:
+			case FUNCTION_READ_INPUT_REGISTERS:
+				for (int i = 0; i < reply.amount; i++)
+					values.append(static_cast<double>(reply.values.word(i)));
+				break;
+			default:
+				break;
+		}
+		result.insert("values", values);
+	}
+	return result;
+}
+
+QString AbstractDevice::DataReplyErrorString(const internal::DataReply & reply)
+{
+	if (reply.errorString != nullptr)
+		return tr(reply.errorString);
+
+	switch (reply.error) {
+		case QModbusDevice::ReadError:
+			return tr("Read error.");
+		case QModbusDevice::WriteError:
+			return tr("Write error.");
+		case QModbusDevice::ConnectionError:
+			return tr("Connection error.");
+		case QModbusDevice::ConfigurationError:
+			return tr("Configuration error.");
+		case QModbusDevice::TimeoutError:
+			return tr("Response timeout.");
+		case QModbusDevice::ProtocolError:
+			return tr("Modbus protocol error (exception code: %1).").arg(reply.exceptionCode);
+		case QModbusDevice::ReplyAbortedError:
+			return tr("Reply aborted.");
+		default:
+			return tr("Unknown error.");
+	}
+}
+
+QJsonObject AbstractDevice::ErrorReply(const QString & error)
+{
+	QJsonObject reply;
+	reply.insert("success", false);
+	reply.insert("error", error);
+	return reply;
+}
+
 void AbstractDevice::ValidatePayloadAddressKey(const QJsonObject & json, const QString & key)
 {
 	ValidateNumberKey(json, key, "payload");
@@ -1084,6 +1512,337 @@ bool AbstractDevice::validateReply(const QJsonObject & request, const QJsonObjec
 	return true;
 }
 
+bool AbstractDevice::validateDataRequest(const internal::DataRequest & request)
+{
+	try {
+		int maxAmount;
+		switch (static_cast<Function>(request.function)) {
+			case FUNCTION_READ_COILS:
+				maxAmount = qMin(maxReadCoils(), internal::DataBuffer::BIT_CAPACITY);
+				break;
+			case FUNCTION_READ_DISCRETE_INPUTS:
+				maxAmount = qMin(maxReadDiscreteInputs(), internal::DataBuffer::BIT_CAPACITY);
+				break;
+			case FUNCTION_READ_HOLDING_REGISTERS:
+				maxAmount = qMin(maxReadHoldingRegisters(), internal::DataBuffer::WORD_CAPACITY);
+				break;
+			case FUNCTION_READ_INPUT_REGISTERS:
+				maxAmount = qMin(maxReadInputRegisters(), internal::DataBuffer::WORD_CAPACITY);
+				break;
+			case FUNCTION_WRITE_COIL:
+			case FUNCTION_WRITE_DISCRETE_INPUT:
+			case FUNCTION_WRITE_HOLDING_REGISTER:
+			case FUNCTION_WRITE_INPUT_REGISTER:
+				maxAmount = 1;
+				break;
+			case FUNCTION_WRITE_MULTIPLE_COILS:
+			case FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS:
+				maxAmount = internal::DataBuffer::BIT_CAPACITY;
+				break;
+			case FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			case FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS:
+				maxAmount = internal::DataBuffer::WORD_CAPACITY;
+				break;
+			default:
+				throw Exception(QString("Function code '%1' is not supported by data requests.").arg(request.function));
+		}
+
+		if (request.amount > maxAmount)
+			throw Exception(QString("Amount '%1' is outside of a range [0, %2].").arg(request.amount).arg(maxAmount));
+
+		if (static_cast<int>(request.address) + static_cast<int>(request.amount) > static_cast<int>(MAX_ADDRESS) + 1)
+			throw Exception(QString("Requested range exceeds Modbus address range [%1, %2].").arg(MIN_ADDRESS).arg(MAX_ADDRESS));
+	} catch (const Exception & e) {
+		CUTEHMI_CRITICAL("Request '" << request.id << "' is illformed. " << e.what());
+		return false;
+	}
+	return true;
+}
+
+int AbstractDevice::pendingRequestsCount() const
+{
+	return m->pendingRequests.count() + m->pendingDataRequests.count();
+}
+
+void AbstractDevice::trackPendingRequest(qint64 timestamp, QUuid requestId)
+{
+	if (m->requestTimeout <= 0)
+		return;
+
+	m->pendingTimeline.enqueue(qMakePair(timestamp, requestId));
+	schedulePendingRequestsSweep();
+}
+
+void AbstractDevice::releasePendingRequests()
+{
+	// Entries of completed requests are removed from the timeline lazily by sweepPendingRequests(), but once there are no pending
+	// requests whole timeline can be dropped at once.
+	if (m->pendingRequests.isEmpty() && m->pendingDataRequests.isEmpty() && m->mergedWrites.isEmpty()) {
+		m->pendingTimeline.clear();
+		m->sweepTimer.stop();
+	}
+}
+
+void AbstractDevice::schedulePendingRequestsSweep()
+{
+	// Timeline is ordered by timestamps, so it is enough to schedule sweep at the deadline of its head.
+	if (m->sweepTimer.isActive() || m->pendingTimeline.isEmpty() || m->requestTimeout <= 0)
+		return;
+
+	qint64 deadline = m->pendingTimeline.head().first + m->requestTimeout;
+	m->sweepTimer.start(static_cast<int>(qBound<qint64>(0, deadline - QDateTime::currentMSecsSinceEpoch(), m->requestTimeout)));
+}
+
+void AbstractDevice::sweepPendingRequests()
+{
+	qint64 now = QDateTime::currentMSecsSinceEpoch();
+	while (!m->pendingTimeline.isEmpty() && (m->requestTimeout > 0) && (m->pendingTimeline.head().first + m->requestTimeout <= now)) {
+		QUuid requestId = m->pendingTimeline.dequeue().second;
+		if (m->pendingDataRequests.contains(requestId)) {
+			CUTEHMI_WARNING("Request '" << requestId << "' has timed out.");
+			internal::DataReply reply;
+			reply.error = QModbusDevice::TimeoutError;
+			reply.errorString = QT_TR_NOOP("Request has timed out.");
+			handleDataReply(requestId, reply);
+		} else if (m->pendingRequests.contains(requestId)) {
+			CUTEHMI_WARNING("Request '" << requestId << "' has timed out.");
+			QJsonObject reply = ErrorReply(tr("Request has timed out."));
+			reply.insert("errorCode", QModbusDevice::TimeoutError);
+			handleReply(requestId, reply);
+		} else if (m->mergedWrites.contains(requestId)) {
+			// Timeout of merged write is fanned out to those of its constituents, which have not timed out on their own yet.
+			CUTEHMI_WARNING("Merged write '" << requestId << "' has timed out.");
+			internal::DataReply reply;
+			reply.error = QModbusDevice::TimeoutError;
+			reply.errorString = QT_TR_NOOP("Request has timed out.");
+			handleDataReply(requestId, reply);
+		}
+		// Otherwise request has been already completed.
+	}
+	schedulePendingRequestsSweep();
+}
+
+void AbstractDevice::subscribeController(AbstractRegisterController * controller, Function function, quint16 address, quint16 amount)
+{
+	m->controllers[function].insert(address, ControllerSubscription{controller, amount});
+	m->maxControllerAmount = qMax(m->maxControllerAmount, amount);
+}
+
+void AbstractDevice::unsubscribeController(AbstractRegisterController * controller, Function function, quint16 address)
+{
+	ControllersIndices::iterator indexIt = m->controllers.find(function);
+	if (indexIt == m->controllers.end())
+		return;
+
+	for (ControllersIndex::iterator it = indexIt->find(address); it != indexIt->end() && it.key() == address; ++it)
+		if (it->controller == controller) {
+			indexIt->erase(it);
+			break;
+		}
+
+	m->batchedNotifications.remove(controller);
+}
+
+void AbstractDevice::updateDataTables(const internal::DataRequest & request, const internal::DataReply & reply)
+{
+	// If reply contains values, write them down to data container, otherwise assume containers have been already updated.
+	int amount = qMin(static_cast<int>(reply.amount), static_cast<int>(request.amount));
+	switch (static_cast<Function>(request.function)) {
+		case FUNCTION_READ_COILS:
+			coilData().visit(request.address, static_cast<std::size_t>(amount), [& reply](auto & data, std::size_t i) {
+				data.setValue(reply.values.bit(static_cast<int>(i)));
+			});
+			break;
+		case FUNCTION_READ_DISCRETE_INPUTS:
+			discreteInputData().visit(request.address, static_cast<std::size_t>(amount), [& reply](auto & data, std::size_t i) {
+				data.setValue(reply.values.bit(static_cast<int>(i)));
+			});
+			break;
+		case FUNCTION_READ_HOLDING_REGISTERS:
+			updateRegisters(holdingRegisterData(), request.address, amount, reply.values);
+			break;
+		case FUNCTION_READ_INPUT_REGISTERS:
+			updateRegisters(inputRegisterData(), request.address, amount, reply.values);
+			break;
+		case FUNCTION_WRITE_HOLDING_REGISTER:
+		case FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			// Registers, which have been written successfully, are stored right away. Otherwise values within deadband of the previous
+			// ones would be filtered out by subsequent reads and cache would keep stale values.
+			if (m->registerDeadband > 0)
+				holdingRegisterData().visit(request.address, static_cast<std::size_t>(qMax(static_cast<int>(request.amount), 1)), [& request](auto & data, std::size_t i) {
+					data.setValue(request.values.word(static_cast<int>(i)));
+				});
+			break;
+		default:
+			break;
+	}
+}
+
+template <typename CONTAINER>
+void AbstractDevice::updateRegisters(CONTAINER & container, quint16 address, int amount, const internal::DataBuffer & values)
+{
+	int deadband = m->registerDeadband;
+	if (deadband == 0) {
+		container.visit(address, static_cast<std::size_t>(amount), [& values](auto & data, std::size_t i) {
+			data.setValue(values.word(static_cast<int>(i)));
+		});
+		return;
+	}
+
+	// Amount of remaining registers of a multi-register value, which are exempt from deadband.
+	int spanned = 0;
+	container.visit(address, static_cast<std::size_t>(amount), [& values, & spanned, deadband](auto & data, std::size_t i) {
+		quint16 value = values.word(static_cast<int>(i));
+		if (data.span() > 1)
+			spanned = qMax(spanned, data.span());
+		if (spanned > 0) {
+			spanned--;
+			data.setValue(value);
+			return;
+		}
+		// First successful read is always accepted, since there is no meaningful previous value to compare against.
+		if (!data.valid()) {
+			data.setValue(value);
+			return;
+		}
+		// Words are compared as unsigned, so signed values crossing zero always exceed the deadband (see registerDeadband).
+		if (qAbs(static_cast<int>(value) - static_cast<int>(data.value())) > deadband)
+			data.setValue(value);
+	});
+}
+
+void AbstractDevice::notifyControllers(const internal::DataRequest & request, const internal::DataReply & reply)
+{
+	ControllersIndices::const_iterator indexIt = m->controllers.constFind(DataTableReadFunction(static_cast<Function>(request.function)));
+	if (indexIt == m->controllers.constEnd())
+		return;
+
+	// Controllers may occupy multiple addresses, so controllers starting before the requested address may still overlap with it.
+	int firstAddress = request.address;
+	int lastAddress = request.address + qMax(static_cast<int>(request.amount), 1) - 1;
+	int lowerBound = qMax(0, firstAddress - m->maxControllerAmount + 1);
+
+	// Notified controllers may alter the index (e.g. by changing their address) or even get deleted, so they are collected first.
+	QVarLengthArray<QPointer<AbstractRegisterController>, 16> controllers;
+	for (ControllersIndex::const_iterator it = indexIt->lowerBound(static_cast<quint16>(lowerBound)); it != indexIt->constEnd() && it.key() <= lastAddress; ++it)
+		if (it.key() + it->amount - 1 >= firstAddress)
+			controllers.append(it->controller);
+
+	// Read replies can be batched, unless controller awaits the reply itself.
+	bool batch = (m->notificationInterval > 0) && (static_cast<Function>(request.function) == DataTableReadFunction(static_cast<Function>(request.function)));
+	for (auto it = controllers.begin(); it != controllers.end(); ++it) {
+		if (it->isNull())
+			continue;
+
+		if (batch && !(*it)->awaitsRequest(request.id)) {
+			m->batchedNotifications.insert(it->data(), BatchedNotification{*it, reply.success});
+			if (!m->notificationTimer.isActive())
+				m->notificationTimer.start(m->notificationInterval);
+		} else
+			(*it)->onDataRequestCompleted(request, reply);
+	}
+}
+
+void AbstractDevice::deliverBatchedNotifications()
+{
+	m->notificationTimer.stop();
+
+	BatchedNotificationsContainer notifications;
+	notifications.swap(m->batchedNotifications);
+	for (auto it = notifications.begin(); it != notifications.end(); ++it)
+		if (!it->controller.isNull())
+			it->controller->onRegistersRead(it->success);
+}
+
+int AbstractDevice::maxWriteAmount(Function function) const
+{
+	switch (function) {
+		case FUNCTION_WRITE_COIL:
+			return qMin(maxWriteCoils(), internal::DataBuffer::BIT_CAPACITY);
+		case FUNCTION_WRITE_DISCRETE_INPUT:
+			return qMin(maxWriteDiscreteInputs(), internal::DataBuffer::BIT_CAPACITY);
+		case FUNCTION_WRITE_HOLDING_REGISTER:
+			return qMin(maxWriteHoldingRegisters(), internal::DataBuffer::WORD_CAPACITY);
+		case FUNCTION_WRITE_INPUT_REGISTER:
+			return qMin(maxWriteInputRegisters(), internal::DataBuffer::WORD_CAPACITY);
+		default:
+			return 1;
+	}
+}
+
+void AbstractDevice::flushWriteQueues()
+{
+	// Handling a request may complete it synchronously and controllers may queue new writes in reaction. Queues are swapped, so
+	// that such writes are left for the subsequent flush.
+	WriteQueuesContainer queues;
+	queues.swap(m->writeQueues);
+
+	for (auto queueIt = queues.cbegin(); queueIt != queues.cend(); ++queueIt) {
+		Function function = static_cast<Function>(queueIt.key());
+		int maxAmount = qMax(maxWriteAmount(function), 1);
+		WriteQueue::const_iterator first = queueIt->cbegin();
+		while (first != queueIt->cend()) {
+			// Extend the run as long as addresses are adjacent.
+			WriteQueue::const_iterator last = first;
+			quint16 amount = 1;
+			for (WriteQueue::const_iterator next = std::next(first); next != queueIt->cend() && amount < maxAmount && next.key() == last.key() + 1; ++next) {
+				last = next;
+				amount++;
+			}
+			submitQueuedWrites(function, first, last, amount);
+			first = std::next(last);
+		}
+	}
+}
+
+void AbstractDevice::submitQueuedWrites(Function function, WriteQueue::const_iterator first, WriteQueue::const_iterator last, quint16 amount)
+{
+	// Write, which has not been merged nor collapsed with any other, is passed to the backend as it is.
+	if (amount == 1 && first->requestIds.count() == 1) {
+		PendingDataRequestsContainer::const_iterator pendingIt = m->pendingDataRequests.constFind(first->requestIds.first());
+		if (pendingIt != m->pendingDataRequests.constEnd())
+			handleDataRequest(*pendingIt);
+		return;
+	}
+
+	internal::DataRequest request;
+	if (amount == 1)
+		request = internal::DataRequest::Write(function, first.key(), first->value);
+	else {
+		Function readFunction = DataTableReadFunction(function);
+		bool bits = (readFunction == FUNCTION_READ_COILS) || (readFunction == FUNCTION_READ_DISCRETE_INPUTS);
+		request.function = WriteMultipleFunction(function);
+		request.address = first.key();
+		request.amount = amount;
+		int i = 0;
+		for (WriteQueue::const_iterator it = first; it != std::next(last); ++it, ++i)
+			if (bits)
+				request.values.setBit(i, it->value != 0);
+			else
+				request.values.setWord(i, it->value);
+	}
+	request.id = QUuid::createUuid();
+	request.timestamp = QDateTime::currentMSecsSinceEpoch();
+	request.issued = m->clock.nsecsElapsed() / 1000;
+
+	QVector<QUuid> & requestIds = m->mergedWrites[request.id];
+	for (WriteQueue::const_iterator it = first; it != std::next(last); ++it)
+		requestIds.append(it->requestIds);
+	// Merged write is tracked on its own, so that its entry expires even if backend never replies.
+	trackPendingRequest(request.timestamp, request.id);
+
+	handleDataRequest(request);
+}
+
+void AbstractDevice::failMergedWrites()
+{
+	internal::DataReply reply;
+	reply.error = QModbusDevice::ReplyAbortedError;
+	reply.errorString = QT_TR_NOOP("Reply aborted.");
+	for (auto && requestId : m->mergedWrites.keys())
+		handleDataReply(requestId, reply);
+}
+
 }
 }
 
@@ -11,6 +11,7 @@ constexpr bool AbstractRegisterController::INITIAL_READ_ON_WRITE;
 constexpr AbstractRegisterController::WriteMode AbstractRegisterController::INITIAL_WRITE_MODE;
 constexpr int AbstractRegisterController::INITIAL_WRITE_DELAY;
 constexpr bool AbstractRegisterController::INITIAL_ENABLED;
+constexpr int AbstractRegisterController::INITIAL_POLL_INTERVAL;
 
 AbstractRegisterController::AbstractRegisterController(QObject * parent):
 	QObject(parent),
@@ -26,16 +27,19 @@ AbstractDevice * AbstractRegisterController::device() const
 void AbstractRegisterController::setDevice(AbstractDevice * device)
 {
 	if (device != m->device) {
-		if (m->device != nullptr)
+		if (m->device != nullptr) {
+			unsubscribe();
 			m->device->disconnect(this);
+		}
 		m->device = device;
 		if (m->device != nullptr) {
-			connect(m->device, & AbstractDevice::requestCompleted, this, & AbstractRegisterController::onRequestCompleted);
+			subscribe();
 			connect(m->device, & AbstractDevice::readyChanged, this, [this]() {
 				if (!m->device->ready())
 					setBusy(true);
 			});
 			connect(m->device, & QObject::destroyed, this, [this]() {
+				m->subscribed = false;	// Subscriptions are gone along with the device.
 				onDeviceDestroyed();
 				setDevice(nullptr);
 			});
@@ -59,7 +63,9 @@ unsigned int AbstractRegisterController::address() const
 void AbstractRegisterController::setAddress(unsigned int address)
 {
 	if (m->address != address) {
+		unsubscribe();
 		m->address = address;
+		subscribe();
 		if (!m->deferRequestRead && deviceReady())
 			requestReadRegisters(static_cast<quint16>(address), bytes(), nullptr);
 		emit addressChanged();
@@ -123,6 +129,24 @@ void AbstractRegisterController::setEnabled(bool enabled)
 	}
 }
 
+int AbstractRegisterController::pollInterval() const
+{
+	return m->pollInterval;
+}
+
+void AbstractRegisterController::setPollInterval(int pollInterval)
+{
+	if (pollInterval < 0) {
+		CUTEHMI_WARNING("Value of 'pollInterval' can not be negative; ignoring value '" << pollInterval << "'.");
+		return;
+	}
+
+	if (m->pollInterval != pollInterval) {
+		m->pollInterval = pollInterval;
+		emit pollIntervalChanged();
+	}
+}
+
 void AbstractRegisterController::classBegin()
 {
 	m->deferRequestRead = true;
@@ -144,11 +168,37 @@ void AbstractRegisterController::setBusy(bool busy)
 	}
 }
 
+void AbstractRegisterController::updateSubscription()
+{
+	unsubscribe();
+	subscribe();
+}
+
 bool AbstractRegisterController::deviceReady() const
 {
 	return (m->device != nullptr) && m->device->ready();
 }
 
+void AbstractRegisterController::subscribe()
+{
+	if (m->device == nullptr || m->subscribed)
+		return;
+
+	m->subscribedFunction = readRegistersFunction();
+	m->subscribedAddress = static_cast<quint16>(address());
+	m->device->subscribeController(this, m->subscribedFunction, m->subscribedAddress, bytes());
+	m->subscribed = true;
+}
+
+void AbstractRegisterController::unsubscribe()
+{
+	if (m->device == nullptr || !m->subscribed)
+		return;
+
+	m->device->unsubscribeController(this, m->subscribedFunction, m->subscribedAddress);
+	m->subscribed = false;
+}
+
 }
 }
 
@@ -101,24 +101,29 @@ void AbstractServer::handleRequest(const QJsonObject & request)
 	emit requestReceived(request);
 }
 
+void AbstractServer::handleDataRequest(const internal::DataRequest & request)
+{
+	emit dataRequestReceived(request);
+}
+
 void AbstractServer::handleCoilsWritten(quint16 address, quint16 amount)
 {
-	requestReadCoils(address, amount);
+	requestData(internal::DataRequest::Read(FUNCTION_READ_COILS, address, amount));
 }
 
 void AbstractServer::handleDiscreteInputsWritten(quint16 address, quint16 amount)
 {
-	requestReadDiscreteInputs(address, amount);
+	requestData(internal::DataRequest::Read(FUNCTION_READ_DISCRETE_INPUTS, address, amount));
 }
 
 void AbstractServer::handleHoldingRegistersWritten(quint16 address, quint16 amount)
 {
-	requestReadHoldingRegisters(address, amount);
+	requestData(internal::DataRequest::Read(FUNCTION_READ_HOLDING_REGISTERS, address, amount));
 }
 
 void AbstractServer::handleInputRegistersWritten(quint16 address, quint16 amount)
 {
-	requestReadInputRegisters(address, amount);
+	requestData(internal::DataRequest::Read(FUNCTION_READ_INPUT_REGISTERS, address, amount));
 }
 
 void AbstractServer::updateBusy(bool busy)
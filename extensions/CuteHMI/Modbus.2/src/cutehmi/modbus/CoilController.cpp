@@ -19,14 +19,14 @@ void CoilController::requestReadRegisters(quint16 address, quint16 amount, QUuid
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestReadCoils(address, amount, requestId);
+	device()->requestData(internal::DataRequest::Read(AbstractDevice::FUNCTION_READ_COILS, address, amount), requestId);
 }
 
 void CoilController::requestWriteRegister(quint16 address, bool value, QUuid * requestId) const
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestWriteCoil(address, value, requestId);
+	device()->queueDataWrite(internal::DataRequest::Write(AbstractDevice::FUNCTION_WRITE_COIL, address, value), requestId);
 }
 
 AbstractDevice::Function CoilController::readRegistersFunction() const
@@ -0,0 +1,302 @@
+#include <cutehmi/modbus/DeviceMetrics.hpp>
+#include <cutehmi/modbus/AbstractDevice.hpp>
+
+#include <QModbusDevice>
+#include <QtAlgorithms>
+
+#include <cmath>
+
+namespace cutehmi {
+namespace modbus {
+
+constexpr int DeviceMetrics::ALL_FUNCTIONS;
+constexpr int DeviceMetrics::SUB_BUCKET_BITS;
+constexpr int DeviceMetrics::SUB_BUCKET_COUNT;
+constexpr int DeviceMetrics::MAX_LATENCY_BITS;
+constexpr int DeviceMetrics::BUCKET_COUNT;
+constexpr int DeviceMetrics::EXCEPTION_CODE_COUNT;
+constexpr int DeviceMetrics::INITIAL_UPDATE_INTERVAL;
+constexpr int DeviceMetrics::FUNCTION_SLOT_COUNT;
+
+DeviceMetrics::DeviceMetrics(QObject * parent):
+	QObject(parent),
+	m(new Members)
+{
+	connect(& m->updateTimer, & QTimer::timeout, this, & DeviceMetrics::update);
+	m->updateTimer.start(m->updateInterval);
+	m->updateClock.start();
+}
+
+int DeviceMetrics::updateInterval() const
+{
+	return m->updateInterval;
+}
+
+void DeviceMetrics::setUpdateInterval(int updateInterval)
+{
+	if (updateInterval < 0) {
+		CUTEHMI_WARNING("Value of 'updateInterval' can not be negative; ignoring value '" << updateInterval << "'.");
+		return;
+	}
+
+	if (m->updateInterval != updateInterval) {
+		m->updateInterval = updateInterval;
+		if (updateInterval > 0)
+			m->updateTimer.start(updateInterval);
+		else
+			m->updateTimer.stop();
+		emit updateIntervalChanged();
+	}
+}
+
+unsigned int DeviceMetrics::requestCount() const
+{
+	return m->counters.requests;
+}
+
+unsigned int DeviceMetrics::errorCount() const
+{
+	return m->counters.errors;
+}
+
+unsigned int DeviceMetrics::timeoutCount() const
+{
+	return m->counters.timeouts;
+}
+
+unsigned int DeviceMetrics::exceptionCount() const
+{
+	return m->counters.exceptions;
+}
+
+qreal DeviceMetrics::requestRate() const
+{
+	return m->requestRate;
+}
+
+qreal DeviceMetrics::errorRate() const
+{
+	return m->errorRate;
+}
+
+qreal DeviceMetrics::latencyP50() const
+{
+	return m->latencyP50;
+}
+
+qreal DeviceMetrics::latencyP90() const
+{
+	return m->latencyP90;
+}
+
+qreal DeviceMetrics::latencyP99() const
+{
+	return m->latencyP99;
+}
+
+qreal DeviceMetrics::latencyMax() const
+{
+	return m->latencyMax;
+}
+
+void DeviceMetrics::record(int function, qint64 latency, bool success, int error, int exceptionCode)
+{
+	FunctionMetrics & metrics = m->functions[static_cast<std::size_t>(FunctionSlot(function))];
+	metrics.requests.fetchAndAddRelaxed(1);
+	if (!success) {
+		metrics.errors.fetchAndAddRelaxed(1);
+		if (error == QModbusDevice::TimeoutError)
+			metrics.timeouts.fetchAndAddRelaxed(1);
+		else if (error == QModbusDevice::ProtocolError) {
+			metrics.exceptions.fetchAndAddRelaxed(1);
+			if (exceptionCode >= 0 && exceptionCode < EXCEPTION_CODE_COUNT)
+				m->exceptionCodes[static_cast<std::size_t>(exceptionCode)].fetchAndAddRelaxed(1);
+		}
+	}
+	metrics.histogram[static_cast<std::size_t>(BucketIndex(latency))].fetchAndAddRelaxed(1);
+}
+
+DeviceMetrics::Counters DeviceMetrics::counters(int function) const
+{
+	Counters result;
+	for (int slot = 0; slot < FUNCTION_SLOT_COUNT; slot++) {
+		if (function != ALL_FUNCTIONS && slot != FunctionSlot(function))
+			continue;
+
+		const FunctionMetrics & metrics = m->functions[static_cast<std::size_t>(slot)];
+		result.requests += metrics.requests.load();
+		result.errors += metrics.errors.load();
+		result.timeouts += metrics.timeouts.load();
+		result.exceptions += metrics.exceptions.load();
+	}
+	return result;
+}
+
+unsigned int DeviceMetrics::exceptionCodeCount(int exceptionCode) const
+{
+	if (exceptionCode < 0 || exceptionCode >= EXCEPTION_CODE_COUNT)
+		return 0;
+
+	return m->exceptionCodes[static_cast<std::size_t>(exceptionCode)].load();
+}
+
+qreal DeviceMetrics::latencyPercentile(qreal percentile, int function) const
+{
+	Histogram histogram;
+	sumHistograms(histogram, function);
+	quint32 total = 0;
+	for (auto && count : histogram)
+		total += count;
+	return static_cast<qreal>(Percentile(histogram, total, percentile)) / 1000.0;
+}
+
+int DeviceMetrics::BucketIndex(qint64 latency)
+{
+	quint64 value = static_cast<quint64>(qBound<qint64>(0, latency, (Q_INT64_C(1) << MAX_LATENCY_BITS) - 1));
+	if (value < static_cast<quint64>(SUB_BUCKET_COUNT))
+		return static_cast<int>(value);
+
+	int shift = 63 - static_cast<int>(qCountLeadingZeroBits(value)) - SUB_BUCKET_BITS;
+	return (shift + 1) * SUB_BUCKET_COUNT + static_cast<int>((value >> shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+qint64 DeviceMetrics::BucketUpperBound(int index)
+{
+	if (index < SUB_BUCKET_COUNT)
+		return index;
+
+	int shift = index / SUB_BUCKET_COUNT - 1;
+	qint64 lower = static_cast<qint64>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+	return lower + (Q_INT64_C(1) << shift) - 1;
+}
+
+void DeviceMetrics::reset()
+{
+	for (auto && metrics : m->functions) {
+		metrics.requests.store(0);
+		metrics.errors.store(0);
+		metrics.timeouts.store(0);
+		metrics.exceptions.store(0);
+		for (auto && bucket : metrics.histogram)
+			bucket.store(0);
+	}
+	for (auto && count : m->exceptionCodes)
+		count.store(0);
+	m->counters = Counters();
+	m->histogram.fill(0);
+	m->requestRate = 0.0;
+	m->errorRate = 0.0;
+	m->latencyP50 = 0.0;
+	m->latencyP90 = 0.0;
+	m->latencyP99 = 0.0;
+	m->latencyMax = 0.0;
+	m->updateClock.restart();
+	emit updated();
+}
+
+void DeviceMetrics::update()
+{
+	Counters counters = this->counters();
+	Histogram histogram;
+	sumHistograms(histogram, ALL_FUNCTIONS);
+
+	// Counters wrap around, but unsigned arithmetic keeps differences valid as long as they fit into 32 bits.
+	Histogram interval;
+	quint32 total = 0;
+	int last = -1;
+	for (std::size_t i = 0; i < interval.size(); i++) {
+		interval[i] = histogram[i] - m->histogram[i];
+		total += interval[i];
+		if (interval[i] != 0)
+			last = static_cast<int>(i);
+	}
+
+	qreal seconds = static_cast<qreal>(m->updateClock.restart()) / 1000.0;
+	if (seconds > 0.0) {
+		m->requestRate = static_cast<qreal>(counters.requests - m->counters.requests) / seconds;
+		m->errorRate = static_cast<qreal>(counters.errors - m->counters.errors) / seconds;
+	}
+	m->latencyP50 = static_cast<qreal>(Percentile(interval, total, 50.0)) / 1000.0;
+	m->latencyP90 = static_cast<qreal>(Percentile(interval, total, 90.0)) / 1000.0;
+	m->latencyP99 = static_cast<qreal>(Percentile(interval, total, 99.0)) / 1000.0;
+	m->latencyMax = last < 0 ? 0.0 : static_cast<qreal>(BucketUpperBound(last)) / 1000.0;
+
+	m->counters = counters;
+	m->histogram = histogram;
+
+	emit updated();
+}
+
+int DeviceMetrics::FunctionSlot(int function)
+{
+	switch (function) {
+		case AbstractDevice::FUNCTION_READ_COILS:
+			return 0;
+		case AbstractDevice::FUNCTION_WRITE_COIL:
+			return 1;
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_COILS:
+			return 2;
+		case AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS:
+			return 3;
+		case AbstractDevice::FUNCTION_WRITE_DISCRETE_INPUT:
+			return 4;
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS:
+			return 5;
+		case AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS:
+			return 6;
+		case AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER:
+			return 7;
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			return 8;
+		case AbstractDevice::FUNCTION_MASK_WRITE_HOLDING_REGISTER:
+			return 9;
+		case AbstractDevice::FUNCTION_READ_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			return 10;
+		case AbstractDevice::FUNCTION_READ_INPUT_REGISTERS:
+			return 11;
+		case AbstractDevice::FUNCTION_WRITE_INPUT_REGISTER:
+			return 12;
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS:
+			return 13;
+		default:
+			return FUNCTION_SLOT_COUNT - 1;
+	}
+}
+
+qint64 DeviceMetrics::Percentile(const Histogram & histogram, quint32 total, qreal percentile)
+{
+	if (total == 0)
+		return 0;
+
+	quint64 rank = static_cast<quint64>(std::ceil(static_cast<qreal>(total) * qBound(0.0, percentile, 100.0) / 100.0));
+	rank = qMax<quint64>(rank, 1);
+	quint64 count = 0;
+	for (std::size_t i = 0; i < histogram.size(); i++) {
+		count += histogram[i];
+		if (count >= rank)
+			return BucketUpperBound(static_cast<int>(i));
+	}
+	return BucketUpperBound(BUCKET_COUNT - 1);
+}
+
+void DeviceMetrics::sumHistograms(Histogram & histogram, int function) const
+{
+	histogram.fill(0);
+	for (int slot = 0; slot < FUNCTION_SLOT_COUNT; slot++) {
+		if (function != ALL_FUNCTIONS && slot != FunctionSlot(function))
+			continue;
+
+		const FunctionMetrics & metrics = m->functions[static_cast<std::size_t>(slot)];
+		for (std::size_t i = 0; i < histogram.size(); i++)
+			histogram[i] += metrics.histogram[i].load();
+	}
+}
+
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
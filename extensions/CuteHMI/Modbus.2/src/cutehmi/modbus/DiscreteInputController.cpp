@@ -19,14 +19,14 @@ void DiscreteInputController::requestReadRegisters(quint16 address, quint16 amou
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestReadDiscreteInputs(address, amount, requestId);
+	device()->requestData(internal::DataRequest::Read(AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS, address, amount), requestId);
 }
 
 void DiscreteInputController::requestWriteRegister(quint16 address, bool value, QUuid * requestId) const
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestWriteDiscreteInput(address, value, requestId);
+	device()->queueDataWrite(internal::DataRequest::Write(AbstractDevice::FUNCTION_WRITE_DISCRETE_INPUT, address, value), requestId);
 }
 
 AbstractDevice::Function DiscreteInputController::readRegistersFunction() const
@@ -15,14 +15,18 @@ DummyClient::DummyClient(QObject * parent):
 	AbstractClient(parent),
 	m(new Members)
 {
-	m->backend.moveToThread(& m->thread);
-
-	connect(& m->thread, & QThread::finished, & m->backend, & internal::DummyClientBackend::ensureClosed);
+	connect(this, & AbstractDevice::dedicatedThreadChanged, this, [this]() {
+		m->thread.setDedicated(dedicatedThread());
+	});
 
 	connect(this, & DummyClient::requestReceived, & m->backend, & internal::DummyClientBackend::processRequest);
 
+	connect(this, & DummyClient::dataRequestReceived, & m->backend, & internal::DummyClientBackend::processDataRequest);
+
 	connect(& m->backend, & internal::DummyClientBackend::replied, this, & DummyClient::handleReply);
 
+	connect(& m->backend, & internal::DummyClientBackend::dataReplied, this, & DummyClient::handleDataReply);
+
 	connect(& m->backend, & internal::DummyClientBackend::stateChanged, this, & DummyClient::setState);
 
 	connect(& m->backend, & internal::DummyClientBackend::closed, this, & DummyClient::stopped);
@@ -31,14 +35,10 @@ DummyClient::DummyClient(QObject * parent):
 
 	connect(& m->backend, & internal::DummyClientBackend::errored, this, & DummyClient::broke);
 	connect(& m->backend, & internal::DummyClientBackend::closed, this, & DummyClient::broke);
-
-	m->thread.start();
 }
 
 DummyClient::~DummyClient()
 {
-	m->thread.quit();
-	m->thread.wait();
 }
 
 int DummyClient::connectLatency() const
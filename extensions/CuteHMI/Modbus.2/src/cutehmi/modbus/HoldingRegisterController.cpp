@@ -19,14 +19,14 @@ void HoldingRegisterController::requestReadRegisters(quint16 address, quint16 am
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestReadHoldingRegisters(address, amount, requestId);
+	device()->requestData(internal::DataRequest::Read(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS, address, amount), requestId);
 }
 
 void HoldingRegisterController::requestWriteRegister(quint16 address, quint16 value, QUuid * requestId) const
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestWriteHoldingRegister(address, value, requestId);
+	device()->queueDataWrite(internal::DataRequest::Write(AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER, address, value), requestId);
 }
 
 AbstractDevice::Function HoldingRegisterController::readRegistersFunction() const
@@ -0,0 +1,121 @@
+#include <cutehmi/modbus/IOThreadPool.hpp>
+
+namespace cutehmi {
+namespace modbus {
+
+constexpr int IOThreadPool::INITIAL_MAX_THREAD_COUNT;
+
+int IOThreadPool::maxThreadCount() const
+{
+	return m->maxThreadCount;
+}
+
+void IOThreadPool::setMaxThreadCount(int maxThreadCount)
+{
+	if (maxThreadCount < 0) {
+		CUTEHMI_WARNING("Value of 'maxThreadCount' can not be negative; ignoring value '" << maxThreadCount << "'.");
+		return;
+	}
+
+	if (m->maxThreadCount != maxThreadCount) {
+		m->maxThreadCount = maxThreadCount;
+		emit maxThreadCountChanged();
+	}
+}
+
+int IOThreadPool::threadCount() const
+{
+	return m->sharedThreads.count();
+}
+
+int IOThreadPool::dedicatedThreadCount() const
+{
+	return m->dedicatedThreads.count();
+}
+
+IOThreadPool::IOThreadPool(QObject * parent):
+	QObject(parent),
+	m(new Members)
+{
+}
+
+IOThreadPool::~IOThreadPool()
+{
+	if (!m->dedicatedThreads.isEmpty())
+		CUTEHMI_WARNING("Destroying I/O thread pool, while " << m->dedicatedThreads.count() << " dedicated threads are still in use.");
+
+	for (auto thread : m->dedicatedThreads)
+		Stop(thread);
+	for (auto && sharedThread : m->sharedThreads)
+		Stop(sharedThread.thread);
+}
+
+QThread * IOThreadPool::acquire(bool dedicated)
+{
+	if (dedicated) {
+		QThread * thread = new QThread;
+		thread->setObjectName(QStringLiteral("cutehmi::modbus dedicated I/O thread"));
+		thread->start();
+		m->dedicatedThreads.insert(thread);
+		emit dedicatedThreadCountChanged();
+		return thread;
+	}
+
+	if (m->sharedThreads.count() < effectiveMaxThreadCount()) {
+		QThread * thread = new QThread;
+		thread->setObjectName(QStringLiteral("cutehmi::modbus I/O thread %1").arg(m->sharedThreads.count()));
+		thread->start();
+		m->sharedThreads.append(SharedThread{thread, 1});
+		emit threadCountChanged();
+		return thread;
+	}
+
+	// Pool is full, so pick the least loaded thread.
+	SharedThread * leastLoaded = & m->sharedThreads.first();
+	for (auto && sharedThread : m->sharedThreads)
+		if (sharedThread.load < leastLoaded->load)
+			leastLoaded = & sharedThread;
+	leastLoaded->load++;
+	return leastLoaded->thread;
+}
+
+void IOThreadPool::release(QThread * thread)
+{
+	if (m->dedicatedThreads.remove(thread)) {
+		Stop(thread);
+		emit dedicatedThreadCountChanged();
+		return;
+	}
+
+	for (auto && sharedThread : m->sharedThreads)
+		if (sharedThread.thread == thread) {
+			sharedThread.load--;
+			return;
+		}
+
+	CUTEHMI_WARNING("Attempting to release thread, which does not belong to I/O thread pool.");
+}
+
+int IOThreadPool::effectiveMaxThreadCount() const
+{
+	if (m->maxThreadCount > 0)
+		return m->maxThreadCount;
+
+	return qMax(1, QThread::idealThreadCount());
+}
+
+void IOThreadPool::Stop(QThread * thread)
+{
+	thread->quit();
+	thread->wait();
+	delete thread;
+}
+
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
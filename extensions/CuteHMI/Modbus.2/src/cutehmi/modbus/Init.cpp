@@ -1,5 +1,7 @@
 #include <cutehmi/modbus/Init.hpp>
 #include <cutehmi/modbus/AbstractDevice.hpp>
+#include <cutehmi/modbus/internal/DataRequest.hpp>
+#include <cutehmi/modbus/internal/DataReply.hpp>
 
 namespace cutehmi {
 namespace modbus {
@@ -8,6 +10,8 @@ Init::Init():
 	Initializer<Init>(
 			[]() {
 	qRegisterMetaType<cutehmi::modbus::AbstractDevice::State>();
+	qRegisterMetaType<cutehmi::modbus::internal::DataRequest>();
+	qRegisterMetaType<cutehmi::modbus::internal::DataReply>();
 }
 )
 {
@@ -0,0 +1,51 @@
+#include <cutehmi/modbus/InputMultiRegisterController.hpp>
+
+namespace cutehmi {
+namespace modbus {
+
+InputMultiRegisterController::InputMultiRegisterController(QObject * parent):
+	MultiRegisterController(parent)
+{
+}
+
+Register16 * InputMultiRegisterController::registerAt(quint16 address) const
+{
+	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
+
+	return device()->inputRegisterAt(address);
+}
+
+void InputMultiRegisterController::requestReadRegisters(quint16 address, quint16 amount, QUuid * requestId) const
+{
+	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
+
+	device()->requestData(internal::DataRequest::Read(AbstractDevice::FUNCTION_READ_INPUT_REGISTERS, address, amount), requestId);
+}
+
+void InputMultiRegisterController::requestWriteRegisters(quint16 address, quint16 amount, const internal::DataBuffer & values, QUuid * requestId) const
+{
+	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
+
+	// Registers are written with a single request, so that the value is never observed half-written by the device.
+	device()->requestData(internal::DataRequest::WriteMultiple(AbstractDevice::FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS, address, amount, values), requestId);
+}
+
+AbstractDevice::Function InputMultiRegisterController::readRegistersFunction() const
+{
+	return AbstractDevice::FUNCTION_READ_INPUT_REGISTERS;
+}
+
+AbstractDevice::Function InputMultiRegisterController::writeRegisterFunction() const
+{
+	return AbstractDevice::FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS;
+}
+
+}
+}
+
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -19,14 +19,14 @@ void InputRegisterController::requestReadRegisters(quint16 address, quint16 amou
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestReadInputRegisters(address, amount, requestId);
+	device()->requestData(internal::DataRequest::Read(AbstractDevice::FUNCTION_READ_INPUT_REGISTERS, address, amount), requestId);
 }
 
 void InputRegisterController::requestWriteRegister(quint16 address, quint16 value, QUuid * requestId) const
 {
 	CUTEHMI_ASSERT(device() != nullptr, "device() must not be nullptr when calling this function");
 
-	device()->requestWriteInputRegister(address, value, requestId);
+	device()->queueDataWrite(internal::DataRequest::Write(AbstractDevice::FUNCTION_WRITE_INPUT_REGISTER, address, value), requestId);
 }
 
 AbstractDevice::Function InputRegisterController::readRegistersFunction() const
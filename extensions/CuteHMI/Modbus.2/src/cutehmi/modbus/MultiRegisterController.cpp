@@ -0,0 +1,472 @@
+#include <cutehmi/modbus/MultiRegisterController.hpp>
+
+#include <QTimerEvent>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace cutehmi {
+namespace modbus {
+
+namespace {
+
+template <typename T, typename U>
+T BitCast(U source)
+{
+	static_assert(sizeof(T) == sizeof(U), "types must be of the same size");
+
+	T result;
+	std::memcpy(& result, & source, sizeof(result));
+	return result;
+}
+
+quint64 PackWords(const quint16 * words, int count, MultiRegisterController::ByteOrder byteOrder, MultiRegisterController::WordOrder wordOrder)
+{
+	quint64 result = 0;
+	for (int i = 0; i < count; i++) {
+		quint16 word = words[wordOrder == MultiRegisterController::HIGH_WORD_FIRST ? i : count - 1 - i];
+		result = result << 16 | (byteOrder == MultiRegisterController::HIGH_BYTE_FIRST ? word : qbswap(word));
+	}
+	return result;
+}
+
+void UnpackWords(quint64 raw, int count, MultiRegisterController::ByteOrder byteOrder, MultiRegisterController::WordOrder wordOrder, quint16 * words)
+{
+	for (int i = count - 1; i >= 0; i--) {
+		quint16 word = static_cast<quint16>(raw);
+		words[wordOrder == MultiRegisterController::HIGH_WORD_FIRST ? i : count - 1 - i] = byteOrder == MultiRegisterController::HIGH_BYTE_FIRST ? word : qbswap(word);
+		raw >>= 16;
+	}
+}
+
+}
+
+constexpr int MultiRegisterController::MAX_REGISTERS;
+constexpr qreal MultiRegisterController::INITIAL_VALUE;
+constexpr qreal MultiRegisterController::INITIAL_VALUE_SCALE;
+constexpr MultiRegisterController::Encoding MultiRegisterController::INITIAL_ENCODING;
+constexpr MultiRegisterController::ByteOrder MultiRegisterController::INITIAL_BYTE_ORDER;
+constexpr MultiRegisterController::WordOrder MultiRegisterController::INITIAL_WORD_ORDER;
+constexpr qreal MultiRegisterController::INITIAL_DEADBAND;
+constexpr qreal MultiRegisterController::INITIAL_RELATIVE_DEADBAND;
+constexpr int MultiRegisterController::INITIAL_MIN_UPDATE_INTERVAL;
+
+MultiRegisterController::MultiRegisterController(QObject * parent):
+	AbstractRegisterController(parent),
+	m(new Members)
+{
+	connect(this, & AbstractRegisterController::deviceChanged, this, & MultiRegisterController::resetRegister);
+	connect(this, & AbstractRegisterController::addressChanged, this, & MultiRegisterController::resetRegister);
+	connect(this, & AbstractRegisterController::enabledChanged, this, & MultiRegisterController::resetRegister);
+	connect(this, & AbstractRegisterController::pollIntervalChanged, this, & MultiRegisterController::resetRegister);
+}
+
+MultiRegisterController::~MultiRegisterController()
+{
+	setDevice(nullptr);
+}
+
+qreal MultiRegisterController::value() const
+{
+	return m->value;
+}
+
+void MultiRegisterController::setValue(qreal value)
+{
+	if (enabled())
+		Mixin::setValue(value);
+}
+
+qreal MultiRegisterController::valueScale() const
+{
+	return m->valueScale;
+}
+
+void MultiRegisterController::setValueScale(qreal valueScale)
+{
+	if (m->valueScale != valueScale) {
+		m->valueScale = valueScale;
+		emit valueScaleChanged();
+		updateValue();
+	}
+}
+
+MultiRegisterController::Encoding MultiRegisterController::encoding() const
+{
+	return m->encoding;
+}
+
+void MultiRegisterController::setEncoding(Encoding encoding)
+{
+	if (m->encoding != encoding) {
+		bool resize = RegisterCount(m->encoding) != RegisterCount(encoding);
+		m->encoding = encoding;
+		if (resize) {
+			// Controller occupies different amount of registers now.
+			updateSubscription();
+			resetRegister();
+		} else
+			updateValue();
+		emit encodingChanged();
+	}
+}
+
+MultiRegisterController::ByteOrder MultiRegisterController::byteOrder() const
+{
+	return m->byteOrder;
+}
+
+void MultiRegisterController::setByteOrder(ByteOrder byteOrder)
+{
+	if (m->byteOrder != byteOrder) {
+		m->byteOrder = byteOrder;
+		emit byteOrderChanged();
+		updateValue();
+	}
+}
+
+MultiRegisterController::WordOrder MultiRegisterController::wordOrder() const
+{
+	return m->wordOrder;
+}
+
+void MultiRegisterController::setWordOrder(WordOrder wordOrder)
+{
+	if (m->wordOrder != wordOrder) {
+		m->wordOrder = wordOrder;
+		emit wordOrderChanged();
+		updateValue();
+	}
+}
+
+qreal MultiRegisterController::deadband() const
+{
+	return m->deadband;
+}
+
+void MultiRegisterController::setDeadband(qreal deadband)
+{
+	if (deadband < 0.0) {
+		CUTEHMI_WARNING("Value of 'deadband' can not be negative; ignoring value '" << deadband << "'.");
+		return;
+	}
+
+	if (m->deadband != deadband) {
+		m->deadband = deadband;
+		emit deadbandChanged();
+	}
+}
+
+qreal MultiRegisterController::relativeDeadband() const
+{
+	return m->relativeDeadband;
+}
+
+void MultiRegisterController::setRelativeDeadband(qreal relativeDeadband)
+{
+	if (relativeDeadband < 0.0) {
+		CUTEHMI_WARNING("Value of 'relativeDeadband' can not be negative; ignoring value '" << relativeDeadband << "'.");
+		return;
+	}
+
+	if (m->relativeDeadband != relativeDeadband) {
+		m->relativeDeadband = relativeDeadband;
+		emit relativeDeadbandChanged();
+	}
+}
+
+int MultiRegisterController::minUpdateInterval() const
+{
+	return m->minUpdateInterval;
+}
+
+void MultiRegisterController::setMinUpdateInterval(int minUpdateInterval)
+{
+	if (minUpdateInterval < 0) {
+		CUTEHMI_WARNING("Value of 'minUpdateInterval' can not be negative; ignoring value '" << minUpdateInterval << "'.");
+		return;
+	}
+
+	if (m->minUpdateInterval != minUpdateInterval) {
+		m->minUpdateInterval = minUpdateInterval;
+		if (m->updateTimer.isActive()) {
+			Mixin::resetFilter();
+			updateFilteredValue();
+		}
+		emit minUpdateIntervalChanged();
+	}
+}
+
+int MultiRegisterController::RegisterCount(Encoding encoding)
+{
+	switch (encoding) {
+		case INT32:
+		case UINT32:
+		case FLOAT32:
+			return 2;
+		case INT64:
+		case UINT64:
+		case FLOAT64:
+			return 4;
+	}
+	return 0;
+}
+
+qreal MultiRegisterController::Decode(const quint16 * words, Encoding encoding, ByteOrder byteOrder, WordOrder wordOrder)
+{
+	CUTEHMI_ASSERT(RegisterCount(encoding) > 0, QString("unrecognized encoding ('%1')").arg(encoding).toLocal8Bit().constData());
+
+	quint64 raw = PackWords(words, RegisterCount(encoding), byteOrder, wordOrder);
+	switch (encoding) {
+		case INT32:
+			return BitCast<qint32>(static_cast<quint32>(raw));
+		case UINT32:
+			return static_cast<quint32>(raw);
+		case FLOAT32:
+			return static_cast<qreal>(BitCast<float>(static_cast<quint32>(raw)));
+		case INT64:
+			return static_cast<qreal>(BitCast<qint64>(raw));
+		case UINT64:
+			return static_cast<qreal>(raw);
+		case FLOAT64:
+			return BitCast<double>(raw);
+	}
+	return std::numeric_limits<qreal>::quiet_NaN();
+}
+
+void MultiRegisterController::Encode(qreal value, Encoding encoding, ByteOrder byteOrder, WordOrder wordOrder, quint16 * words)
+{
+	CUTEHMI_ASSERT(RegisterCount(encoding) > 0, QString("unrecognized encoding ('%1')").arg(encoding).toLocal8Bit().constData());
+
+	quint64 raw = 0;
+	switch (encoding) {
+		case INT32:
+			raw = BitCast<quint32>(static_cast<qint32>(std::round(value)));
+			break;
+		case UINT32:
+			raw = static_cast<quint32>(std::round(value));
+			break;
+		case FLOAT32:
+			raw = BitCast<quint32>(static_cast<float>(value));
+			break;
+		case INT64:
+			raw = BitCast<quint64>(static_cast<qint64>(std::round(value)));
+			break;
+		case UINT64:
+			raw = static_cast<quint64>(std::round(value));
+			break;
+		case FLOAT64:
+			raw = BitCast<quint64>(static_cast<double>(value));
+			break;
+	}
+	UnpackWords(raw, RegisterCount(encoding), byteOrder, wordOrder, words);
+}
+
+void MultiRegisterController::writeValue()
+{
+	if (enabled())
+		Mixin::writeValue();
+}
+
+void MultiRegisterController::timerEvent(QTimerEvent * event)
+{
+	if (event->timerId() == m->updateTimer.timerId()) {
+		m->updateTimer.stop();
+		if (enabled())
+			updateFilteredValue();
+	} else if (enabled())
+		Mixin::timerEvent(event);
+}
+
+quint16 MultiRegisterController::bytes() const
+{
+	return static_cast<quint16>(RegisterCount(m->encoding));
+}
+
+void MultiRegisterController::onDeviceDestroyed()
+{
+	// References to coils/registers become invalid *before* device object emits destroyed() signal.
+	m->registers.fill(nullptr);
+	m->registerCount = 0;
+	m->registerPollInterval = -1;
+}
+
+bool MultiRegisterController::awaitsRequest(const QUuid & requestId) const
+{
+	return !m->requestId.isNull() && (m->requestId == requestId);
+}
+
+void MultiRegisterController::onDataRequestCompleted(const internal::DataRequest & request, const internal::DataReply & reply)
+{
+	if (enabled())
+		Mixin::onDataRequestCompleted(request, reply);
+}
+
+void MultiRegisterController::onRegistersRead(bool success)
+{
+	if (enabled())
+		Mixin::onRegistersRead(success);
+}
+
+void MultiRegisterController::resetRegister()
+{
+	m->requestId = nullptr;	// Setting up new registers invalidates previous requests.
+	m->postponedWritePending = false;
+	m->adjustingValue = false;
+	Mixin::resetFilter();
+
+	// First register carries the span, which makes polling treat all the registers as one unit.
+	if (m->registerCount > 0 && m->registerPollInterval >= 0)
+		for (int i = 0; i < m->registerCount; i++)
+			m->registers[i]->rest(m->registerPollInterval, i == 0 ? m->registerCount : 1);
+	m->registerPollInterval = -1;
+	m->registers.fill(nullptr);
+	m->registerCount = 0;
+
+	if (device()) {
+		int count = RegisterCount(m->encoding);
+		if (address() + count - 1 > AbstractDevice::MAX_ADDRESS) {
+			CUTEHMI_WARNING("Value of " << count << " registers starting at address '" << address() << "' exceeds Modbus address range.");
+			setBusy(false);
+			return;
+		}
+
+		for (int i = 0; i < count; i++)
+			m->registers[i] = registerAt(static_cast<quint16>(address() + i));
+		m->registerCount = count;
+		if (enabled()) {
+			setBusy(true);
+			m->registerPollInterval = pollInterval();
+			for (int i = 0; i < m->registerCount; i++)
+				m->registers[i]->awake(m->registerPollInterval, i == 0 ? m->registerCount : 1);
+			updateValue();
+		} else
+			setBusy(false);
+	}
+}
+
+bool MultiRegisterController::ValidateEncoding(qreal value, Encoding encoding)
+{
+	CUTEHMI_ASSERT(RegisterCount(encoding) > 0, QString("unrecognized encoding ('%1')").arg(encoding).toLocal8Bit().constData());
+
+	// Upper limits of 64 bit integers can not be represented exactly, but powers of two, which bound them from above, can be.
+	static constexpr qreal INT64_LIMIT = 9223372036854775808.0;	// 2^63.
+	static constexpr qreal UINT64_LIMIT = 18446744073709551616.0;	// 2^64.
+
+	qreal rounded = std::round(value);
+	switch (encoding) {
+		case INT32:
+			return rounded <= std::numeric_limits<qint32>::max() && rounded >= std::numeric_limits<qint32>::min();
+		case UINT32:
+			return rounded <= std::numeric_limits<quint32>::max() && rounded >= std::numeric_limits<quint32>::min();
+		case FLOAT32:
+			return !std::isfinite(value) || std::abs(value) <= std::numeric_limits<float>::max();
+		case INT64:
+			return rounded < INT64_LIMIT && rounded >= -INT64_LIMIT;
+		case UINT64:
+			return rounded < UINT64_LIMIT && rounded >= 0.0;
+		case FLOAT64:
+			return true;
+	}
+	return false;
+}
+
+void MultiRegisterController::updateValue()
+{
+	if (m->registerCount == 0)
+		return;
+
+	std::array<quint16, MAX_REGISTERS> words;
+	for (int i = 0; i < m->registerCount; i++)
+		words[i] = m->registers[i]->value();
+	updateValue(words.data());
+}
+
+void MultiRegisterController::updateValue(const internal::DataBuffer & values)
+{
+	std::array<quint16, MAX_REGISTERS> words;
+	for (int i = 0; i < RegisterCount(m->encoding); i++)
+		words[i] = values.word(i);
+	updateValue(words.data());
+}
+
+void MultiRegisterController::updateValue(const quint16 * words)
+{
+	// Do not update value if user is adjusting it, because it could distract user.
+	if (m->adjustingValue)
+		return;
+
+	qreal newValue = m->valueScale * Decode(words, m->encoding, m->byteOrder, m->wordOrder);
+	if (m->value != newValue) {
+		m->value = newValue;
+		emit valueChanged();
+	} else if (m->value != m->requestedValue)
+		emit valueChanged();	// Trigger slots also in case of failed writes.
+
+	emit valueUpdated();
+}
+
+void MultiRegisterController::updateFilteredValue()
+{
+	if (m->registerCount == 0 || m->adjustingValue)
+		return;
+
+	if (Mixin::filterValue(registerValue()))
+		updateValue();
+}
+
+qreal MultiRegisterController::registerValue() const
+{
+	CUTEHMI_ASSERT(m->registerCount > 0, "registers must be available when calling this function");
+
+	std::array<quint16, MAX_REGISTERS> words;
+	for (int i = 0; i < m->registerCount; i++)
+		words[i] = m->registers[i]->value();
+	return m->valueScale * Decode(words.data(), m->encoding, m->byteOrder, m->wordOrder);
+}
+
+void MultiRegisterController::requestWrite(qreal value)
+{
+	qreal scaledValue = value / m->valueScale;
+	if (ValidateEncoding(scaledValue, m->encoding)) {
+		int count = RegisterCount(m->encoding);
+		Encode(scaledValue, m->encoding, m->byteOrder, m->wordOrder, m->writtenWords.data());
+		internal::DataBuffer values;
+		for (int i = 0; i < count; i++)
+			values.setWord(i, m->writtenWords[i]);
+
+		setBusy(true);
+		requestWriteRegisters(static_cast<quint16>(address()), static_cast<quint16>(count), values, & m->requestId);
+	} else {
+		CUTEHMI_CRITICAL("Can not represent requested value '" << scaledValue << "' using selected encoding '" << m->encoding << "'.");
+		emit valueFailed();
+	}
+}
+
+bool MultiRegisterController::verifyRegisterValue() const
+{
+	if (m->registerCount == 0)
+		return false;
+
+	// Raw registers are compared, so that precision lost by encoding does not cause false mismatches.
+	for (int i = 0; i < m->registerCount; i++)
+		if (m->registers[i]->value() != m->writtenWords[i])
+			return false;
+	return true;
+}
+
+bool MultiRegisterController::registerValueChanged() const
+{
+	return (m->registerCount > 0) && (registerValue() != m->value);
+}
+
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
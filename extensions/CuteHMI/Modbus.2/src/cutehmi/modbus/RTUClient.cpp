@@ -16,30 +16,30 @@ RTUClient::RTUClient(QObject * parent):
 	AbstractClient(parent),
 	m(new Members)
 {
-	m->backend.moveToThread(& m->thread);
+	connect(this, & AbstractDevice::dedicatedThreadChanged, this, [this]() {
+		m->thread.setDedicated(dedicatedThread());
+	});
 
-	connect(& m->thread, & QThread::finished, & m->backend, & internal::QtClientBackend::ensureClosed);
+	connect(this, & RTUClient::requestReceived, & m->backend, & internal::NativeRTUClientBackend::processRequest);
 
-	connect(this, & RTUClient::requestReceived, & m->backend, & internal::QtClientBackend::processRequest);
+	connect(this, & RTUClient::dataRequestReceived, & m->backend, & internal::NativeRTUClientBackend::processDataRequest);
 
-	connect(& m->backend, & internal::QtClientBackend::replied, this, & RTUClient::handleReply);
+	connect(& m->backend, & internal::NativeRTUClientBackend::replied, this, & RTUClient::handleReply);
 
-	connect(& m->backend, & internal::QtClientBackend::stateChanged, this, & RTUClient::setState);
+	connect(& m->backend, & internal::NativeRTUClientBackend::dataReplied, this, & RTUClient::handleDataReply);
 
-	connect(& m->backend, & internal::QtClientBackend::closed, this, & RTUClient::stopped);
+	connect(& m->backend, & internal::NativeRTUClientBackend::stateChanged, this, & RTUClient::setState);
 
-	connect(& m->backend, & internal::QtClientBackend::opened, this, & RTUClient::started);
+	connect(& m->backend, & internal::NativeRTUClientBackend::closed, this, & RTUClient::stopped);
 
-	connect(& m->backend, & internal::QtClientBackend::errored, this, & AbstractDevice::errored);
-	connect(& m->backend, & internal::QtClientBackend::closed, this, & RTUClient::broke);
+	connect(& m->backend, & internal::NativeRTUClientBackend::opened, this, & RTUClient::started);
 
-	m->thread.start();
+	connect(& m->backend, & internal::NativeRTUClientBackend::errored, this, & AbstractDevice::errored);
+	connect(& m->backend, & internal::NativeRTUClientBackend::closed, this, & RTUClient::broke);
 }
 
 RTUClient::~RTUClient()
 {
-	m->thread.quit();
-	m->thread.wait();
 }
 
 QString RTUClient::port() const
@@ -130,6 +130,12 @@ void RTUClient::close()
 	emit m->backend.closeRequested();
 }
 
+int RTUClient::pollingWindow() const
+{
+	// Serial line is half-duplex and only one transaction can be in progress at a time.
+	return 1;
+}
+
 }
 }
 
@@ -24,16 +24,20 @@ RTUServer::RTUServer(QObject * parent):
 	AbstractServer(parent),
 	m(new Members(& coilData(), & discreteInputData(), & holdingRegisterData(), & inputRegisterData()))
 {
-	m->backend.moveToThread(& m->thread);
-
-	connect(& m->thread, & QThread::finished, & m->backend, & internal::QtRTUServerBackend::ensureClosed);
+	connect(this, & AbstractDevice::dedicatedThreadChanged, this, [this]() {
+		m->thread.setDedicated(dedicatedThread());
+	});
 
 	connect(this, & RTUServer::requestReceived, & m->backend, & internal::QtRTUServerBackend::processRequest);
 
+	connect(this, & RTUServer::dataRequestReceived, & m->backend, & internal::QtRTUServerBackend::processDataRequest);
+
 	connect(& m->backend, & internal::AbstractServerBackend::busyUpdated, this, & RTUServer::updateBusy);
 
 	connect(& m->backend, & internal::AbstractServerBackend::replied, this, & RTUServer::handleReply);
 
+	connect(& m->backend, & internal::AbstractServerBackend::dataReplied, this, & RTUServer::handleDataReply);
+
 	connect(& m->backend, & internal::AbstractServerBackend::stateChanged, this, & RTUServer::setState);
 
 	connect(& m->backend, & internal::QtRTUServerBackend::closed, this, & RTUServer::stopped);
@@ -47,14 +51,10 @@ RTUServer::RTUServer(QObject * parent):
 	connect(& m->backend, & internal::QtRTUServerBackend::discreteInputsWritten, this, & RTUServer::handleDiscreteInputsWritten);
 	connect(& m->backend, & internal::QtRTUServerBackend::holdingRegistersWritten, this, & RTUServer::handleHoldingRegistersWritten);
 	connect(& m->backend, & internal::QtRTUServerBackend::inputRegistersWritten, this, & RTUServer::handleInputRegistersWritten);
-
-	m->thread.start();
 }
 
 RTUServer::~RTUServer()
 {
-	m->thread.quit();
-	m->thread.wait();
 }
 
 QString RTUServer::port() const
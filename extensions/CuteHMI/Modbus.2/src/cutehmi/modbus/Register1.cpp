@@ -4,33 +4,71 @@ namespace cutehmi {
 namespace modbus {
 
 Register1::Register1(bool value):
-	m(new Members{value, 0})
+	m(value)
 {
 }
 
 bool Register1::value() const
 {
-	return m->value.loadAcquire();
+	return m.value.loadAcquire();
 }
 
 void Register1::setValue(bool value)
 {
-	m->value.storeRelease(value);
+	m.value.storeRelease(value);
 }
 
-void Register1::rest()
+void Register1::setGeneration(QAtomicInt * generation)
 {
-	m->awaken.fetchAndSubRelaxed(1);
+	m.generation = generation;
 }
 
-void Register1::awake()
+void Register1::rest(int pollInterval)
 {
-	m->awaken.fetchAndAddRelaxed(1);
+	QMutexLocker locker(& m.pollIntervalsMutex);
+
+	QMap<int, int>::iterator it = m.pollIntervals.find(pollInterval);
+	CUTEHMI_ASSERT(it != m.pollIntervals.end(), "register has not been awaken with given poll interval");
+	if (--it.value() == 0)
+		m.pollIntervals.erase(it);
+	UpdatePollInterval(m);
+
+	if (m.awaken.fetchAndSubRelaxed(1) == 1)
+		IncrementGeneration(m);
+}
+
+void Register1::awake(int pollInterval)
+{
+	QMutexLocker locker(& m.pollIntervalsMutex);
+
+	m.pollIntervals[pollInterval]++;
+	UpdatePollInterval(m);
+
+	if (m.awaken.fetchAndAddRelaxed(1) == 0)
+		IncrementGeneration(m);
 }
 
 bool Register1::wakeful() const
 {
-	return m->awaken.load();
+	return m.awaken.load();
+}
+
+int Register1::pollInterval() const
+{
+	return m.pollInterval.load();
+}
+
+void Register1::UpdatePollInterval(Members & members)
+{
+	int pollInterval = members.pollIntervals.isEmpty() ? 0 : members.pollIntervals.firstKey();
+	if (members.pollInterval.fetchAndStoreRelaxed(pollInterval) != pollInterval)
+		IncrementGeneration(members);	// Change of poll interval affects read plans, just like change of wakefulness.
+}
+
+void Register1::IncrementGeneration(Members & members)
+{
+	if (members.generation)
+		members.generation->ref();
 }
 
 }
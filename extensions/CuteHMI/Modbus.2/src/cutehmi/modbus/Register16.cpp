@@ -4,33 +4,98 @@ namespace cutehmi {
 namespace modbus {
 
 Register16::Register16(quint16 value):
-	m(new Members{value, 0})
+	m(value)
 {
 }
 
 quint16 Register16::value() const
 {
-	return m->value.loadAcquire();
+	return m.value.loadAcquire();
+}
+
+bool Register16::valid() const
+{
+	return m.valid.loadAcquire();
 }
 
 void Register16::setValue(quint16 value)
 {
-	m->value.storeRelease(value);
+	m.value.storeRelease(value);
+	m.valid.storeRelease(1);
 }
 
-void Register16::rest()
+void Register16::setGeneration(QAtomicInt * generation)
 {
-	m->awaken.fetchAndSubRelaxed(1);
+	m.generation = generation;
+}
+
+void Register16::rest(int pollInterval, int span)
+{
+	QMutexLocker locker(& m.pollIntervalsMutex);
+
+	QMap<int, int>::iterator it = m.pollIntervals.find(pollInterval);
+	CUTEHMI_ASSERT(it != m.pollIntervals.end(), "register has not been awaken with given poll interval");
+	if (--it.value() == 0)
+		m.pollIntervals.erase(it);
+	UpdatePollInterval(m);
+
+	QMap<int, int>::iterator spanIt = m.spans.find(span);
+	CUTEHMI_ASSERT(spanIt != m.spans.end(), "register has not been awaken with given span");
+	if (--spanIt.value() == 0)
+		m.spans.erase(spanIt);
+	UpdateSpan(m);
+
+	if (m.awaken.fetchAndSubRelaxed(1) == 1)
+		IncrementGeneration(m);
 }
 
-void Register16::awake()
+void Register16::awake(int pollInterval, int span)
 {
-	m->awaken.fetchAndAddRelaxed(1);
+	QMutexLocker locker(& m.pollIntervalsMutex);
+
+	m.pollIntervals[pollInterval]++;
+	UpdatePollInterval(m);
+
+	m.spans[span]++;
+	UpdateSpan(m);
+
+	if (m.awaken.fetchAndAddRelaxed(1) == 0)
+		IncrementGeneration(m);
 }
 
 bool Register16::wakeful() const
 {
-	return m->awaken.load();
+	return m.awaken.load();
+}
+
+int Register16::pollInterval() const
+{
+	return m.pollInterval.load();
+}
+
+int Register16::span() const
+{
+	return m.span.load();
+}
+
+void Register16::UpdatePollInterval(Members & members)
+{
+	int pollInterval = members.pollIntervals.isEmpty() ? 0 : members.pollIntervals.firstKey();
+	if (members.pollInterval.fetchAndStoreRelaxed(pollInterval) != pollInterval)
+		IncrementGeneration(members);	// Change of poll interval affects read plans, just like change of wakefulness.
+}
+
+void Register16::UpdateSpan(Members & members)
+{
+	int span = members.spans.isEmpty() ? 1 : members.spans.lastKey();
+	if (members.span.fetchAndStoreRelaxed(span) != span)
+		IncrementGeneration(members);	// Change of span affects read plans as well.
+}
+
+void Register16::IncrementGeneration(Members & members)
+{
+	if (members.generation)
+		members.generation->ref();
 }
 
 }
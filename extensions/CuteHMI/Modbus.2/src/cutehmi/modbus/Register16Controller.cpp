@@ -8,6 +8,9 @@ namespace modbus {
 constexpr qreal Register16Controller::INITIAL_VALUE;
 constexpr qreal Register16Controller::INITIAL_VALUE_SCALE;
 constexpr Register16Controller::Encoding Register16Controller::INITIAL_ENCODING;
+constexpr qreal Register16Controller::INITIAL_DEADBAND;
+constexpr qreal Register16Controller::INITIAL_RELATIVE_DEADBAND;
+constexpr int Register16Controller::INITIAL_MIN_UPDATE_INTERVAL;
 
 Register16Controller::Register16Controller(QObject * parent):
 	AbstractRegisterController(parent),
@@ -16,6 +19,7 @@ Register16Controller::Register16Controller(QObject * parent):
 	connect(this, & AbstractRegisterController::deviceChanged, this, & Register16Controller::resetRegister);
 	connect(this, & AbstractRegisterController::addressChanged, this, & Register16Controller::resetRegister);
 	connect(this, & AbstractRegisterController::enabledChanged, this, & Register16Controller::resetRegister);
+	connect(this, & AbstractRegisterController::pollIntervalChanged, this, & Register16Controller::resetRegister);
 }
 
 Register16Controller::~Register16Controller()
@@ -62,6 +66,65 @@ void Register16Controller::setEncoding(Encoding encoding)
 	}
 }
 
+qreal Register16Controller::deadband() const
+{
+	return m->deadband;
+}
+
+void Register16Controller::setDeadband(qreal deadband)
+{
+	if (deadband < 0.0) {
+		CUTEHMI_WARNING("Value of 'deadband' can not be negative; ignoring value '" << deadband << "'.");
+		return;
+	}
+
+	if (m->deadband != deadband) {
+		m->deadband = deadband;
+		emit deadbandChanged();
+	}
+}
+
+qreal Register16Controller::relativeDeadband() const
+{
+	return m->relativeDeadband;
+}
+
+void Register16Controller::setRelativeDeadband(qreal relativeDeadband)
+{
+	if (relativeDeadband < 0.0) {
+		CUTEHMI_WARNING("Value of 'relativeDeadband' can not be negative; ignoring value '" << relativeDeadband << "'.");
+		return;
+	}
+
+	if (m->relativeDeadband != relativeDeadband) {
+		m->relativeDeadband = relativeDeadband;
+		emit relativeDeadbandChanged();
+	}
+}
+
+int Register16Controller::minUpdateInterval() const
+{
+	return m->minUpdateInterval;
+}
+
+void Register16Controller::setMinUpdateInterval(int minUpdateInterval)
+{
+	if (minUpdateInterval < 0) {
+		CUTEHMI_WARNING("Value of 'minUpdateInterval' can not be negative; ignoring value '" << minUpdateInterval << "'.");
+		return;
+	}
+
+	if (m->minUpdateInterval != minUpdateInterval) {
+		m->minUpdateInterval = minUpdateInterval;
+		// Value held back by previous interval is delivered right away.
+		if (m->updateTimer.isActive()) {
+			Mixin::resetFilter();
+			updateFilteredValue();
+		}
+		emit minUpdateIntervalChanged();
+	}
+}
+
 void Register16Controller::writeValue()
 {
 	if (enabled())
@@ -70,7 +133,11 @@ void Register16Controller::writeValue()
 
 void Register16Controller::timerEvent(QTimerEvent * event)
 {
-	if (enabled())
+	if (event->timerId() == m->updateTimer.timerId()) {
+		m->updateTimer.stop();
+		if (enabled())
+			updateFilteredValue();
+	} else if (enabled())
 		Mixin::timerEvent(event);
 }
 
@@ -83,6 +150,12 @@ void Register16Controller::onDeviceDestroyed()
 {
 	// References to coils/registers become invalid *before* device object emits destroyed() signal.
 	m->register16 = nullptr;
+	m->registerPollInterval = -1;
+}
+
+bool Register16Controller::awaitsRequest(const QUuid & requestId) const
+{
+	return !m->requestId.isNull() && (m->requestId == requestId);
 }
 
 void Register16Controller::updateValue()
@@ -109,15 +182,30 @@ void Register16Controller::updateValue(quint16 value)
 	emit valueUpdated();
 }
 
-void Register16Controller::updateValue(const QJsonValue & value)
+void Register16Controller::updateValue(const internal::DataBuffer & values)
 {
-	updateValue(static_cast<quint16>(value.toDouble()));
+	updateValue(values.word(0));
 }
 
-void Register16Controller::onRequestCompleted(QJsonObject request, QJsonObject reply)
+void Register16Controller::updateFilteredValue()
+{
+	if (m->register16 == nullptr || m->adjustingValue)
+		return;
+
+	if (Mixin::filterValue(m->valueScale * Decode(m->register16->value(), encoding())))
+		updateValue();
+}
+
+void Register16Controller::onDataRequestCompleted(const internal::DataRequest & request, const internal::DataReply & reply)
 {
 	if (enabled())
-		Mixin::onRequestCompleted(request, reply);
+		Mixin::onDataRequestCompleted(request, reply);
+}
+
+void Register16Controller::onRegistersRead(bool success)
+{
+	if (enabled())
+		Mixin::onRegistersRead(success);
 }
 
 void Register16Controller::resetRegister()
@@ -125,15 +213,18 @@ void Register16Controller::resetRegister()
 	m->requestId = nullptr;	// Setting up new register invalidates previous requests.
 	m->postponedWritePending = false;
 	m->adjustingValue = false;
+	Mixin::resetFilter();
 
-	if (m->register16)
-		m->register16->rest();
+	if (m->register16 && m->registerPollInterval >= 0)
+		m->register16->rest(m->registerPollInterval);
+	m->registerPollInterval = -1;
 
 	if (device()) {
 		m->register16 = registerAt(static_cast<quint16>(address()));
 		if (enabled()) {
 			setBusy(true);
-			m->register16->awake();
+			m->registerPollInterval = pollInterval();
+			m->register16->awake(m->registerPollInterval);
 			updateValue();
 		} else
 			setBusy(false);
@@ -203,6 +294,11 @@ bool Register16Controller::verifyRegisterValue() const
 	return Decode(m->register16->value(), encoding()) == m->value;
 }
 
+bool Register16Controller::registerValueChanged() const
+{
+	return (m->register16 != nullptr) && (m->valueScale * Decode(m->register16->value(), encoding()) != m->value);
+}
+
 }
 }
 
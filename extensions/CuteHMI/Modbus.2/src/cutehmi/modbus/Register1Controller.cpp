@@ -16,6 +16,7 @@ Register1Controller::Register1Controller(QObject * parent):
 	connect(this, & AbstractRegisterController::deviceChanged, this, & Register1Controller::resetRegister);
 	connect(this, & AbstractRegisterController::addressChanged, this, & Register1Controller::resetRegister);
 	connect(this, & AbstractRegisterController::enabledChanged, this, & Register1Controller::resetRegister);
+	connect(this, & AbstractRegisterController::pollIntervalChanged, this, & Register1Controller::resetRegister);
 }
 
 Register1Controller::~Register1Controller()
@@ -55,6 +56,12 @@ void Register1Controller::onDeviceDestroyed()
 {
 	// References to coils/registers become invalid *before* device object emits destroyed() signal.
 	m->register1 = nullptr;
+	m->registerPollInterval = -1;
+}
+
+bool Register1Controller::awaitsRequest(const QUuid & requestId) const
+{
+	return !m->requestId.isNull() && (m->requestId == requestId);
 }
 
 void Register1Controller::updateValue()
@@ -80,15 +87,27 @@ void Register1Controller::updateValue(bool value)
 	emit valueUpdated();
 }
 
-void Register1Controller::updateValue(const QJsonValue & value)
+void Register1Controller::updateValue(const internal::DataBuffer & values)
 {
-	updateValue(value.toBool());
+	updateValue(values.bit(0));
 }
 
-void Register1Controller::onRequestCompleted(QJsonObject request, QJsonObject reply)
+void Register1Controller::updateFilteredValue()
+{
+	// Binary values are not subject to deadband nor rate limiting.
+	updateValue();
+}
+
+void Register1Controller::onDataRequestCompleted(const internal::DataRequest & request, const internal::DataReply & reply)
 {
 	if (enabled())
-		Mixin::onRequestCompleted(request, reply);
+		Mixin::onDataRequestCompleted(request, reply);
+}
+
+void Register1Controller::onRegistersRead(bool success)
+{
+	if (enabled())
+		Mixin::onRegistersRead(success);
 }
 
 void Register1Controller::resetRegister()
@@ -97,14 +116,16 @@ void Register1Controller::resetRegister()
 	m->postponedWritePending = false;
 	m->adjustingValue = false;
 
-	if (m->register1)
-		m->register1->rest();
+	if (m->register1 && m->registerPollInterval >= 0)
+		m->register1->rest(m->registerPollInterval);
+	m->registerPollInterval = -1;
 
 	if (device()) {
 		m->register1 = registerAt(static_cast<quint16>(address()));
 		if (enabled()) {
 			setBusy(true);
-			m->register1->awake();
+			m->registerPollInterval = pollInterval();
+			m->register1->awake(m->registerPollInterval);
 			updateValue();
 		} else
 			setBusy(false);
@@ -125,6 +146,11 @@ bool Register1Controller::verifyRegisterValue() const
 	return m->register1->value() == m->value;
 }
 
+bool Register1Controller::registerValueChanged() const
+{
+	return (m->register1 != nullptr) && (m->register1->value() != m->value);
+}
+
 }
 }
 
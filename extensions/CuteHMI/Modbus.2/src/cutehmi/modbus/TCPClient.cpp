@@ -13,30 +13,30 @@ TCPClient::TCPClient(QObject * parent):
 	AbstractClient(parent),
 	m(new Members)
 {
-	m->backend.moveToThread(& m->thread);
+	connect(this, & AbstractDevice::dedicatedThreadChanged, this, [this]() {
+		m->thread.setDedicated(dedicatedThread());
+	});
 
-	connect(& m->thread, & QThread::finished, & m->backend, & internal::QtClientBackend::ensureClosed);
+	connect(this, & TCPClient::requestReceived, & m->backend, & internal::NativeTCPClientBackend::processRequest);
 
-	connect(this, & TCPClient::requestReceived, & m->backend, & internal::QtClientBackend::processRequest);
+	connect(this, & TCPClient::dataRequestReceived, & m->backend, & internal::NativeTCPClientBackend::processDataRequest);
 
-	connect(& m->backend, & internal::QtClientBackend::replied, this, & TCPClient::handleReply);
+	connect(& m->backend, & internal::NativeTCPClientBackend::replied, this, & TCPClient::handleReply);
 
-	connect(& m->backend, & internal::QtClientBackend::stateChanged, this, & TCPClient::setState);
+	connect(& m->backend, & internal::NativeTCPClientBackend::dataReplied, this, & TCPClient::handleDataReply);
 
-	connect(& m->backend, & internal::QtClientBackend::closed, this, & TCPClient::stopped);
+	connect(& m->backend, & internal::NativeTCPClientBackend::stateChanged, this, & TCPClient::setState);
 
-	connect(& m->backend, & internal::QtClientBackend::opened, this, & TCPClient::started);
+	connect(& m->backend, & internal::NativeTCPClientBackend::closed, this, & TCPClient::stopped);
 
-	connect(& m->backend, & internal::QtClientBackend::errored, this, & AbstractDevice::errored);
-	connect(& m->backend, & internal::QtClientBackend::closed, this, & TCPClient::broke);
+	connect(& m->backend, & internal::NativeTCPClientBackend::opened, this, & TCPClient::started);
 
-	m->thread.start();
+	connect(& m->backend, & internal::NativeTCPClientBackend::errored, this, & AbstractDevice::errored);
+	connect(& m->backend, & internal::NativeTCPClientBackend::closed, this, & TCPClient::broke);
 }
 
 TCPClient::~TCPClient()
 {
-	m->thread.quit();
-	m->thread.wait();
 }
 
 QString TCPClient::host() const
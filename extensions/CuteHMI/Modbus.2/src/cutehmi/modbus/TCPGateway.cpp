@@ -0,0 +1,272 @@
+#include <cutehmi/modbus/TCPGateway.hpp>
+#include <cutehmi/modbus/TCPGatewayClient.hpp>
+
+namespace cutehmi {
+namespace modbus {
+
+const char * TCPGateway::INITIAL_HOST = internal::TCPClientConfig::INITIAL_HOST;
+constexpr int TCPGateway::INITIAL_PORT;
+constexpr int TCPGateway::INITIAL_MAX_IN_FLIGHT;
+constexpr bool TCPGateway::INITIAL_DEDICATED_THREAD;
+
+TCPGateway::TCPGateway(QObject * parent):
+	QObject(parent),
+	m(new Members)
+{
+	connect(this, & TCPGateway::unitRequestReceived, & m->backend, & internal::NativeTCPGatewayBackend::processUnitRequest);
+
+	connect(this, & TCPGateway::unitDataRequestReceived, & m->backend, & internal::NativeTCPGatewayBackend::processUnitDataRequest);
+
+	connect(& m->backend, & internal::NativeTCPGatewayBackend::replied, this, & TCPGateway::onBackendReplied);
+
+	connect(& m->backend, & internal::NativeTCPGatewayBackend::dataReplied, this, & TCPGateway::onBackendDataReplied);
+
+	connect(& m->backend, & internal::NativeTCPGatewayBackend::stateChanged, this, & TCPGateway::onBackendStateChanged);
+
+	connect(& m->backend, & internal::NativeTCPGatewayBackend::opened, this, & TCPGateway::onBackendOpened);
+
+	connect(& m->backend, & internal::NativeTCPGatewayBackend::closed, this, & TCPGateway::onBackendClosed);
+
+	connect(& m->backend, & internal::NativeTCPGatewayBackend::errored, this, & TCPGateway::onBackendErrored);
+}
+
+TCPGateway::~TCPGateway()
+{
+	// Clients can not use the gateway anymore, so they are treated as if connection has been closed.
+	QList<TCPGatewayClient *> clients = m->clients;
+	m->clients.clear();
+	for (auto client : clients) {
+		client->m->attached = false;
+		client->m->gateway = nullptr;
+		client->onGatewayStateChanged(AbstractDevice::CLOSED);
+		client->onGatewayClosed();
+		emit client->gatewayChanged();
+	}
+}
+
+QString TCPGateway::host() const
+{
+	return m->config.host();
+}
+
+void TCPGateway::setHost(const QString & host)
+{
+	if (m->config.host() != host) {
+		m->config.setHost(host);
+		emit hostChanged();
+	}
+}
+
+int TCPGateway::port() const
+{
+	return m->config.port();
+}
+
+void TCPGateway::setPort(int port)
+{
+	if (m->config.port() != port) {
+		m->config.setPort(port);
+		emit portChanged();
+	}
+}
+
+int TCPGateway::maxInFlight() const
+{
+	return m->maxInFlight;
+}
+
+void TCPGateway::setMaxInFlight(int maxInFlight)
+{
+	if (maxInFlight < 1) {
+		CUTEHMI_WARNING("Value of 'maxInFlight' must be greater than zero; ignoring value '" << maxInFlight << "'.");
+		return;
+	}
+
+	if (m->maxInFlight != maxInFlight) {
+		m->maxInFlight = maxInFlight;
+		emit maxInFlightChanged();
+
+		dispatch();
+	}
+}
+
+AbstractDevice::State TCPGateway::state() const
+{
+	return m->state;
+}
+
+bool TCPGateway::dedicatedThread() const
+{
+	return m->thread.dedicated();
+}
+
+void TCPGateway::setDedicatedThread(bool dedicatedThread)
+{
+	if (m->thread.dedicated() != dedicatedThread) {
+		m->thread.setDedicated(dedicatedThread);
+		emit dedicatedThreadChanged();
+	}
+}
+
+void TCPGateway::onBackendStateChanged(AbstractDevice::State state)
+{
+	if (m->state != state) {
+		m->state = state;
+		for (auto client : m->clients)
+			client->onGatewayStateChanged(state);
+		emit stateChanged();
+	}
+}
+
+void TCPGateway::onBackendOpened()
+{
+	for (auto client : m->clients)
+		client->onGatewayOpened();
+}
+
+void TCPGateway::onBackendClosed()
+{
+	for (auto client : m->clients)
+		client->onGatewayClosed();
+}
+
+void TCPGateway::onBackendErrored(InplaceError error)
+{
+	for (auto client : m->clients)
+		client->onGatewayErrored(error);
+}
+
+void TCPGateway::onBackendReplied(QUuid requestId, QJsonObject reply)
+{
+	auto it = m->inFlight.find(requestId);
+	if (it != m->inFlight.end()) {
+		TCPGatewayClient * client = it.value();
+		m->inFlight.erase(it);
+		if (client)
+			client->onGatewayReplied(requestId, reply);
+	} else
+		CUTEHMI_WARNING("Could not find client awaiting reply to request '" << requestId << "'.");
+
+	dispatch();
+}
+
+void TCPGateway::onBackendDataReplied(QUuid requestId, internal::DataReply reply)
+{
+	auto it = m->inFlight.find(requestId);
+	if (it != m->inFlight.end()) {
+		TCPGatewayClient * client = it.value();
+		m->inFlight.erase(it);
+		if (client)
+			client->onGatewayDataReplied(requestId, reply);
+	} else
+		CUTEHMI_WARNING("Could not find client awaiting reply to request '" << requestId << "'.");
+
+	dispatch();
+}
+
+void TCPGateway::attach(TCPGatewayClient * client)
+{
+	if (!m->clients.contains(client))
+		m->clients.append(client);
+
+	switch (m->state) {
+		case AbstractDevice::OPENED:
+			client->onGatewayStateChanged(m->state);
+			client->onGatewayOpened();
+			break;
+		case AbstractDevice::CLOSED:
+			emit m->backend.openRequested();
+			break;
+		default:
+			// Client will follow state of the gateway once connection is opened or closed.
+			client->onGatewayStateChanged(m->state);
+	}
+}
+
+void TCPGateway::detach(TCPGatewayClient * client)
+{
+	int index = m->clients.indexOf(client);
+	if (index == -1)
+		return;
+
+	m->clients.removeAt(index);
+	if (m->nextClient > index)
+		m->nextClient--;
+	TransactionsQueue queue = m->queues.take(client);
+
+	// Replies to transactions, which are already in flight, are discarded, but they still occupy slots until they arrive.
+	for (auto it = m->inFlight.begin(); it != m->inFlight.end(); ++it)
+		if (it.value() == client)
+			it.value() = nullptr;
+
+	if (m->clients.isEmpty())
+		emit m->backend.closeRequested();
+
+	// Queued transactions are not going to be dispatched anymore, so they are failed right away, just like backend does with
+	// pending transactions, when connection is closed.
+	while (!queue.isEmpty())
+		abort(client, queue.dequeue());
+}
+
+void TCPGateway::submit(TCPGatewayClient * client, const QJsonObject & request)
+{
+	m->queues[client].enqueue(Transaction{false, request, internal::DataRequest()});
+	dispatch();
+}
+
+void TCPGateway::submit(TCPGatewayClient * client, const internal::DataRequest & request)
+{
+	m->queues[client].enqueue(Transaction{true, QJsonObject(), request});
+	dispatch();
+}
+
+void TCPGateway::abort(TCPGatewayClient * client, const Transaction & transaction)
+{
+	if (transaction.data) {
+		internal::DataReply reply;
+		reply.error = QModbusDevice::ReplyAbortedError;
+		reply.errorString = QT_TR_NOOP("Reply aborted.");
+		client->onGatewayDataReplied(transaction.dataRequest.id, reply);
+	} else {
+		QJsonObject reply;
+		reply.insert("error", tr("Reply aborted."));
+		reply.insert("errorCode", QModbusDevice::ReplyAbortedError);
+		reply.insert("success", false);
+		client->onGatewayReplied(QUuid::fromString(transaction.request.value("id").toString()), reply);
+	}
+}
+
+void TCPGateway::dispatch()
+{
+	int idleClients = 0;
+	while (m->inFlight.count() < m->maxInFlight && !m->clients.isEmpty() && idleClients < m->clients.count()) {
+		if (m->nextClient >= m->clients.count())
+			m->nextClient = 0;
+		TCPGatewayClient * client = m->clients.at(m->nextClient++);
+
+		auto queue = m->queues.find(client);
+		if (queue == m->queues.end() || queue->isEmpty()) {
+			idleClients++;
+			continue;
+		}
+		idleClients = 0;
+
+		Transaction transaction = queue->dequeue();
+		if (transaction.data) {
+			m->inFlight.insert(transaction.dataRequest.id, client);
+			emit unitDataRequestReceived(client->slaveAddress(), transaction.dataRequest);
+		} else {
+			m->inFlight.insert(QUuid::fromString(transaction.request.value("id").toString()), client);
+			emit unitRequestReceived(client->slaveAddress(), transaction.request);
+		}
+	}
+}
+
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,157 @@
+#include <cutehmi/modbus/TCPGatewayClient.hpp>
+
+namespace cutehmi {
+namespace modbus {
+
+constexpr int TCPGatewayClient::MIN_SLAVE_ADDRESS;
+constexpr int TCPGatewayClient::MAX_SLAVE_ADDRESS;
+constexpr int TCPGatewayClient::INITIAL_SLAVE_ADDRESS;
+
+TCPGatewayClient::TCPGatewayClient(QObject * parent):
+	AbstractClient(parent),
+	m(new Members)
+{
+}
+
+TCPGatewayClient::~TCPGatewayClient()
+{
+	if (m->attached && m->gateway) {
+		m->attached = false;
+		m->gateway->detach(this);
+	}
+}
+
+TCPGateway * TCPGatewayClient::gateway() const
+{
+	return m->gateway;
+}
+
+void TCPGatewayClient::setGateway(TCPGateway * gateway)
+{
+	if (m->gateway != gateway) {
+		if (m->attached) {
+			// Client is attached to the new gateway first, so that requests issued in reaction to aborted ones go there.
+			TCPGateway * previous = m->gateway;
+			m->gateway = gateway;
+			if (m->gateway)
+				m->gateway->attach(this);
+			if (previous)
+				previous->detach(this);
+			if (!m->gateway) {
+				m->attached = false;
+				setState(CLOSED);
+				emit broke();
+			}
+		} else
+			m->gateway = gateway;
+		emit gatewayChanged();
+	}
+}
+
+int TCPGatewayClient::slaveAddress() const
+{
+	return m->slaveAddress;
+}
+
+void TCPGatewayClient::setSlaveAddress(int slaveAddress)
+{
+	if (slaveAddress < MIN_SLAVE_ADDRESS || slaveAddress > MAX_SLAVE_ADDRESS) {
+		CUTEHMI_WARNING("Value of 'slaveAddress' must be in range [" << MIN_SLAVE_ADDRESS << ", " << MAX_SLAVE_ADDRESS << "]; ignoring value '" << slaveAddress << "'.");
+		return;
+	}
+
+	if (m->slaveAddress != slaveAddress) {
+		m->slaveAddress = slaveAddress;
+		emit slaveAddressChanged();
+	}
+}
+
+void TCPGatewayClient::open()
+{
+	if (m->gateway) {
+		m->attached = true;
+		m->gateway->attach(this);
+	} else {
+		CUTEHMI_WARNING("Can not open client without a gateway.");
+		emit errored(CUTEHMI_ERROR(tr("Gateway has not been set.")));
+		emit broke();
+	}
+}
+
+void TCPGatewayClient::close()
+{
+	// Client is marked as detached beforehand, so that requests issued in reaction to aborted ones are not submitted again.
+	bool attached = m->attached;
+	m->attached = false;
+	if (attached && m->gateway)
+		m->gateway->detach(this);
+
+	setState(CLOSED);
+	emit stopped();
+}
+
+void TCPGatewayClient::handleRequest(const QJsonObject & request)
+{
+	if (m->attached && m->gateway)
+		m->gateway->submit(this, request);
+	else {
+		QJsonObject reply;
+
+		reply.insert("success", false);
+		reply.insert("error", "Client not connected.");
+
+		handleReply(QUuid::fromString(request.value("id").toString()), reply);
+	}
+}
+
+void TCPGatewayClient::handleDataRequest(const internal::DataRequest & request)
+{
+	if (m->attached && m->gateway)
+		m->gateway->submit(this, request);
+	else {
+		internal::DataReply reply;
+		reply.errorString = "Client not connected.";
+
+		handleDataReply(request.id, reply);
+	}
+}
+
+void TCPGatewayClient::onGatewayStateChanged(AbstractDevice::State state)
+{
+	setState(state);
+}
+
+void TCPGatewayClient::onGatewayOpened()
+{
+	emit started();
+}
+
+void TCPGatewayClient::onGatewayClosed()
+{
+	emit stopped();
+	emit broke();
+}
+
+void TCPGatewayClient::onGatewayErrored(const InplaceError & error)
+{
+	emit errored(error);
+}
+
+void TCPGatewayClient::onGatewayReplied(QUuid requestId, const QJsonObject & reply)
+{
+	handleReply(requestId, reply);
+}
+
+void TCPGatewayClient::onGatewayDataReplied(QUuid requestId, const internal::DataReply & reply)
+{
+	handleDataReply(requestId, reply);
+}
+
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
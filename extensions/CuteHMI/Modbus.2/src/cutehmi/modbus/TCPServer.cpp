@@ -21,16 +21,20 @@ TCPServer::TCPServer(QObject * parent):
 	AbstractServer(parent),
 	m(new Members(& coilData(), & discreteInputData(), & holdingRegisterData(), & inputRegisterData()))
 {
-	m->backend.moveToThread(& m->thread);
-
-	connect(& m->thread, & QThread::finished, & m->backend, & internal::QtTCPServerBackend::ensureClosed);
+	connect(this, & AbstractDevice::dedicatedThreadChanged, this, [this]() {
+		m->thread.setDedicated(dedicatedThread());
+	});
 
 	connect(this, & TCPServer::requestReceived, & m->backend, & internal::QtTCPServerBackend::processRequest);
 
+	connect(this, & TCPServer::dataRequestReceived, & m->backend, & internal::QtTCPServerBackend::processDataRequest);
+
 	connect(& m->backend, & internal::AbstractServerBackend::busyUpdated, this, & TCPServer::updateBusy);
 
 	connect(& m->backend, & internal::AbstractServerBackend::replied, this, & TCPServer::handleReply);
 
+	connect(& m->backend, & internal::AbstractServerBackend::dataReplied, this, & TCPServer::handleDataReply);
+
 	connect(& m->backend, & internal::AbstractServerBackend::stateChanged, this, & TCPServer::setState);
 
 	connect(& m->backend, & internal::QtTCPServerBackend::closed, this, & TCPServer::stopped);
@@ -44,14 +48,10 @@ TCPServer::TCPServer(QObject * parent):
 	connect(& m->backend, & internal::QtTCPServerBackend::discreteInputsWritten, this, & TCPServer::handleDiscreteInputsWritten);
 	connect(& m->backend, & internal::QtTCPServerBackend::holdingRegistersWritten, this, & TCPServer::handleHoldingRegistersWritten);
 	connect(& m->backend, & internal::QtTCPServerBackend::inputRegistersWritten, this, & TCPServer::handleInputRegistersWritten);
-
-	m->thread.start();
 }
 
 TCPServer::~TCPServer()
 {
-	m->thread.quit();
-	m->thread.wait();
 }
 
 QString TCPServer::host() const
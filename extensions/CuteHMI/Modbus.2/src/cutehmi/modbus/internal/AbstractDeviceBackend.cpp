@@ -12,93 +12,9 @@ void AbstractDeviceBackend::processRequest(QJsonObject request)
 
 	AbstractDevice::Function function = static_cast<AbstractDevice::Function>(request.value("function").toInt());
 	QJsonObject payload = request.value("payload").toObject();
-	if (proceedRequest(requestId)) {
+	if (proceedRequest()) {
 		CUTEHMI_DEBUG("Processing " << humanFunctionName(function) << " request '" << request << "' ...");
 		switch (function) {
-			case AbstractDevice::FUNCTION_READ_COILS: {
-				quint16 startAddress = static_cast<quint16>(payload.value("address").toDouble());
-				quint16 endAddress = startAddress + static_cast<quint16>(payload.value("amount").toDouble()) - 1;
-				readCoils(requestId, startAddress, endAddress);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_COIL: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				bool value = payload.value("value").toBool();
-				writeCoil(requestId, address, value);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_COILS: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				QJsonArray valuesArray = payload.value("values").toArray();
-				QVector<quint16> values;
-				for (auto value = valuesArray.begin(); value != valuesArray.end(); ++value)
-					values.append(value->toBool());
-				writeMultipleCoils(requestId, address, values);
-				break;
-			}
-			case AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS: {
-				quint16 startAddress = static_cast<quint16>(payload.value("address").toDouble());
-				quint16 endAddress = startAddress + static_cast<quint16>(payload.value("amount").toDouble()) - 1;
-				readDiscreteInputs(requestId, startAddress, endAddress);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_DISCRETE_INPUT: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				bool value = payload.value("value").toBool();
-				writeDiscreteInput(requestId, address, value);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				QJsonArray valuesArray = payload.value("values").toArray();
-				QVector<quint16> values;
-				for (auto value = valuesArray.begin(); value != valuesArray.end(); ++value)
-					values.append(value->toBool());
-				writeMultipleDiscreteInputs(requestId, address, values);
-				break;
-			}
-			case AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS: {
-				quint16 startAddress = static_cast<quint16>(payload.value("address").toDouble());
-				quint16 endAddress = startAddress + static_cast<quint16>(payload.value("amount").toDouble()) - 1;
-				readHoldingRegisters(requestId, startAddress, endAddress);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				quint16 value = static_cast<quint16>(payload.value("value").toDouble());
-				writeHoldingRegister(requestId, address, value);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				QJsonArray valuesArray = payload.value("values").toArray();
-				QVector<quint16> values;
-				for (auto value = valuesArray.begin(); value != valuesArray.end(); ++value)
-					values.append(static_cast<quint16>(value->toDouble()));
-				writeMultipleHoldingRegisters(requestId, address, values);
-				break;
-			}
-			case AbstractDevice::FUNCTION_READ_INPUT_REGISTERS: {
-				quint16 startAddress = static_cast<quint16>(payload.value("address").toDouble());
-				quint16 endAddress = startAddress + static_cast<quint16>(payload.value("amount").toDouble()) - 1;
-				readInputRegisters(requestId, startAddress, endAddress);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_INPUT_REGISTER: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				quint16 value = static_cast<quint16>(payload.value("value").toDouble());
-				writeInputRegister(requestId, address, value);
-				break;
-			}
-			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS: {
-				quint16 address = static_cast<quint16>(payload.value("address").toDouble());
-				QJsonArray valuesArray = payload.value("values").toArray();
-				QVector<quint16> values;
-				for (auto value = valuesArray.begin(); value != valuesArray.end(); ++value)
-					values.append(static_cast<quint16>(value->toDouble()));
-				writeMultipleInputRegisters(requestId, address, values);
-				break;
-			}
 			case AbstractDevice::FUNCTION_READ_EXCEPTION_STATUS:
 				readExceptionStatus(requestId);
 				break;
@@ -158,8 +74,73 @@ void AbstractDeviceBackend::processRequest(QJsonObject request)
 			default:
 				CUTEHMI_CRITICAL("Unsupported function code '" << function << "'.");
 		}
-	} else
+	} else {
 		CUTEHMI_DEBUG("Device is not ready to process " << humanFunctionName(function) << " request '" << request << "'. ");
+
+		QJsonObject reply;
+
+		reply.insert("success", false);
+		reply.insert("error", "Client not connected.");
+
+		emit replied(requestId, reply);
+	}
+}
+
+void AbstractDeviceBackend::processDataRequest(DataRequest request)
+{
+	AbstractDevice::Function function = static_cast<AbstractDevice::Function>(request.function);
+	if (proceedRequest()) {
+		CUTEHMI_DEBUG("Processing " << humanFunctionName(function) << " data request '" << request.id << "' ...");
+		quint16 endAddress = request.address + request.amount - 1;
+		switch (function) {
+			case AbstractDevice::FUNCTION_READ_COILS:
+				readCoils(request.id, request.address, endAddress);
+				break;
+			case AbstractDevice::FUNCTION_WRITE_COIL:
+				writeCoil(request.id, request.address, request.values.bit(0));
+				break;
+			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_COILS:
+				writeMultipleCoils(request.id, request.address, BitsToVector(request.values, request.amount));
+				break;
+			case AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS:
+				readDiscreteInputs(request.id, request.address, endAddress);
+				break;
+			case AbstractDevice::FUNCTION_WRITE_DISCRETE_INPUT:
+				writeDiscreteInput(request.id, request.address, request.values.bit(0));
+				break;
+			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_DISCRETE_INPUTS:
+				writeMultipleDiscreteInputs(request.id, request.address, BitsToVector(request.values, request.amount));
+				break;
+			case AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS:
+				readHoldingRegisters(request.id, request.address, endAddress);
+				break;
+			case AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER:
+				writeHoldingRegister(request.id, request.address, request.values.word(0));
+				break;
+			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+				writeMultipleHoldingRegisters(request.id, request.address, WordsToVector(request.values, request.amount));
+				break;
+			case AbstractDevice::FUNCTION_READ_INPUT_REGISTERS:
+				readInputRegisters(request.id, request.address, endAddress);
+				break;
+			case AbstractDevice::FUNCTION_WRITE_INPUT_REGISTER:
+				writeInputRegister(request.id, request.address, request.values.word(0));
+				break;
+			case AbstractDevice::FUNCTION_WRITE_MULTIPLE_INPUT_REGISTERS:
+				writeMultipleInputRegisters(request.id, request.address, WordsToVector(request.values, request.amount));
+				break;
+			default:
+				CUTEHMI_CRITICAL("Function code '" << function << "' is not supported by data requests.");
+				replyIllegalDataFunction(request.id);
+		}
+	} else {
+		CUTEHMI_DEBUG("Device is not ready to process " << humanFunctionName(function) << " data request '" << request.id << "'. ");
+
+		DataReply reply;
+		reply.errorString = "Client not connected.";
+
+		emit dataReplied(request.id, reply);
+	}
 }
 
 AbstractDeviceBackend::AbstractDeviceBackend(QObject * parent):
@@ -169,12 +150,30 @@ AbstractDeviceBackend::AbstractDeviceBackend(QObject * parent):
 	connect(this, & AbstractDeviceBackend::closeRequested, this, & AbstractDeviceBackend::close);
 }
 
+QVector<quint16> AbstractDeviceBackend::BitsToVector(const DataBuffer & buffer, int amount)
+{
+	QVector<quint16> result;
+	result.reserve(amount);
+	for (int i = 0; i < amount; i++)
+		result.append(buffer.bit(i));
+	return result;
+}
+
+QVector<quint16> AbstractDeviceBackend::WordsToVector(const DataBuffer & buffer, int amount)
+{
+	QVector<quint16> result;
+	result.reserve(amount);
+	for (int i = 0; i < amount; i++)
+		result.append(buffer.word(i));
+	return result;
+}
+
 void AbstractDeviceBackend::readCoils(QUuid requestId, quint16 startAddress, quint16 endAddress)
 {
 	Q_UNUSED(startAddress)
 	Q_UNUSED(endAddress)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeCoil(QUuid requestId, quint16 address, bool value)
@@ -182,7 +181,7 @@ void AbstractDeviceBackend::writeCoil(QUuid requestId, quint16 address, bool val
 	Q_UNUSED(address)
 	Q_UNUSED(value)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeMultipleCoils(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
@@ -190,7 +189,7 @@ void AbstractDeviceBackend::writeMultipleCoils(QUuid requestId, quint16 startAdd
 	Q_UNUSED(startAddress)
 	Q_UNUSED(values)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::readDiscreteInputs(QUuid requestId, quint16 startAddress, quint16 endAddress)
@@ -198,7 +197,7 @@ void AbstractDeviceBackend::readDiscreteInputs(QUuid requestId, quint16 startAdd
 	Q_UNUSED(startAddress)
 	Q_UNUSED(endAddress)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeDiscreteInput(QUuid requestId, quint16 address, bool value)
@@ -206,7 +205,7 @@ void AbstractDeviceBackend::writeDiscreteInput(QUuid requestId, quint16 address,
 	Q_UNUSED(address)
 	Q_UNUSED(value)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeMultipleDiscreteInputs(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
@@ -214,7 +213,7 @@ void AbstractDeviceBackend::writeMultipleDiscreteInputs(QUuid requestId, quint16
 	Q_UNUSED(startAddress)
 	Q_UNUSED(values)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::readHoldingRegisters(QUuid requestId, quint16 startAddress, quint16 endAddress)
@@ -222,7 +221,7 @@ void AbstractDeviceBackend::readHoldingRegisters(QUuid requestId, quint16 startA
 	Q_UNUSED(startAddress)
 	Q_UNUSED(endAddress)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeHoldingRegister(QUuid requestId, quint16 address, quint16 value)
@@ -230,7 +229,7 @@ void AbstractDeviceBackend::writeHoldingRegister(QUuid requestId, quint16 addres
 	Q_UNUSED(address)
 	Q_UNUSED(value)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeMultipleHoldingRegisters(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
@@ -238,7 +237,7 @@ void AbstractDeviceBackend::writeMultipleHoldingRegisters(QUuid requestId, quint
 	Q_UNUSED(startAddress)
 	Q_UNUSED(values)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::readInputRegisters(QUuid requestId, quint16 startAddress, quint16 endAddress)
@@ -246,7 +245,7 @@ void AbstractDeviceBackend::readInputRegisters(QUuid requestId, quint16 startAdd
 	Q_UNUSED(startAddress)
 	Q_UNUSED(endAddress)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeInputRegister(QUuid requestId, quint16 address, quint16 value)
@@ -254,7 +253,7 @@ void AbstractDeviceBackend::writeInputRegister(QUuid requestId, quint16 address,
 	Q_UNUSED(address)
 	Q_UNUSED(value)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::writeMultipleInputRegisters(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
@@ -262,7 +261,7 @@ void AbstractDeviceBackend::writeMultipleInputRegisters(QUuid requestId, quint16
 	Q_UNUSED(startAddress)
 	Q_UNUSED(values)
 
-	replyIllegalFunction(requestId);
+	replyIllegalDataFunction(requestId);
 }
 
 void AbstractDeviceBackend::readExceptionStatus(QUuid requestId)
@@ -347,6 +346,16 @@ void AbstractDeviceBackend::replyIllegalFunction(QUuid requestId)
 	emit replied(requestId, reply);
 }
 
+void AbstractDeviceBackend::replyIllegalDataFunction(QUuid requestId)
+{
+	DataReply reply;
+
+	reply.error = QModbusDevice::ProtocolError;
+	reply.exceptionCode = QModbusPdu::IllegalFunction;
+
+	emit dataReplied(requestId, reply);
+}
+
 const char * AbstractDeviceBackend::humanFunctionName(AbstractDevice::Function function) const
 {
 	switch (function) {
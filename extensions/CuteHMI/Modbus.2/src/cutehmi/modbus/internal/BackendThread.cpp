@@ -0,0 +1,62 @@
+#include <cutehmi/modbus/internal/BackendThread.hpp>
+#include <cutehmi/modbus/IOThreadPool.hpp>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+BackendThread::BackendThread(QObject * backend, bool dedicated):
+	m(new Members{backend, backend->thread(), IOThreadPool::Instance().acquire(dedicated), dedicated})
+{
+	m->backend->moveToThread(m->thread);
+}
+
+BackendThread::~BackendThread()
+{
+	// Shared thread keeps running, so backend has to be closed from within its thread and handed back to the owner thread before
+	// it gets destroyed.
+	if (!QMetaObject::invokeMethod(m->backend, "ensureClosed", Qt::BlockingQueuedConnection))
+		CUTEHMI_CRITICAL("Could not invoke 'ensureClosed()' slot of backend.");
+	MoveToThread(m->backend, m->owner);
+
+	IOThreadPool::Instance().release(m->thread);
+}
+
+QThread * BackendThread::thread() const
+{
+	return m->thread;
+}
+
+bool BackendThread::dedicated() const
+{
+	return m->dedicated;
+}
+
+void BackendThread::setDedicated(bool dedicated)
+{
+	if (m->dedicated != dedicated) {
+		QThread * thread = IOThreadPool::Instance().acquire(dedicated);
+		MoveToThread(m->backend, thread);
+		IOThreadPool::Instance().release(m->thread);
+		m->thread = thread;
+		m->dedicated = dedicated;
+	}
+}
+
+void BackendThread::MoveToThread(QObject * object, QThread * thread)
+{
+	// Object can only be pushed to another thread from the thread it currently lives in.
+	QMetaObject::invokeMethod(object, [object, thread]() {
+		object->moveToThread(thread);
+	}, Qt::BlockingQueuedConnection);
+}
+
+}
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -23,7 +23,7 @@ const CoilPolling::Data * CoilPolling::dataAt(quint16 address) const
 
 void CoilPolling::requestReadData(quint16 address, quint16 amount, QUuid * requestId)
 {
-	device()->requestReadCoils(address, amount, requestId);
+	device()->requestData(DataRequest::Read(AbstractDevice::FUNCTION_READ_COILS, address, amount), requestId);
 }
 
 int CoilPolling::maxRead() const
@@ -0,0 +1,50 @@
+#include <cutehmi/modbus/internal/DataBuffer.hpp>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+constexpr int DataBuffer::WORD_CAPACITY;
+constexpr int DataBuffer::BIT_CAPACITY;
+
+quint16 DataBuffer::word(int index) const
+{
+	CUTEHMI_ASSERT(index >= 0 && index < WORD_CAPACITY, "index out of buffer bounds");
+
+	return m_words[static_cast<std::size_t>(index)];
+}
+
+void DataBuffer::setWord(int index, quint16 value)
+{
+	CUTEHMI_ASSERT(index >= 0 && index < WORD_CAPACITY, "index out of buffer bounds");
+
+	m_words[static_cast<std::size_t>(index)] = value;
+}
+
+bool DataBuffer::bit(int index) const
+{
+	CUTEHMI_ASSERT(index >= 0 && index < BIT_CAPACITY, "index out of buffer bounds");
+
+	return m_words[static_cast<std::size_t>(index / 16)] & (1u << (index % 16));
+}
+
+void DataBuffer::setBit(int index, bool value)
+{
+	CUTEHMI_ASSERT(index >= 0 && index < BIT_CAPACITY, "index out of buffer bounds");
+
+	quint16 & word = m_words[static_cast<std::size_t>(index / 16)];
+	if (value)
+		word |= static_cast<quint16>(1u << (index % 16));
+	else
+		word &= static_cast<quint16>(~(1u << (index % 16)));
+}
+
+}
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,44 @@
+#include <cutehmi/modbus/internal/DataRequest.hpp>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+DataRequest DataRequest::Read(int function, quint16 address, quint16 amount)
+{
+	DataRequest result;
+	result.function = function;
+	result.address = address;
+	result.amount = amount;
+	return result;
+}
+
+DataRequest DataRequest::Write(int function, quint16 address, quint16 value)
+{
+	DataRequest result;
+	result.function = function;
+	result.address = address;
+	result.amount = 1;
+	result.values.setWord(0, value);
+	return result;
+}
+
+DataRequest DataRequest::WriteMultiple(int function, quint16 address, quint16 amount, const DataBuffer & values)
+{
+	DataRequest result;
+	result.function = function;
+	result.address = address;
+	result.amount = amount;
+	result.values = values;
+	return result;
+}
+
+}
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
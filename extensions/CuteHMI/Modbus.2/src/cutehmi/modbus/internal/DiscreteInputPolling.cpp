@@ -23,7 +23,7 @@ const DiscreteInputPolling::Data * DiscreteInputPolling::dataAt(quint16 address)
 
 void DiscreteInputPolling::requestReadData(quint16 address, quint16 amount, QUuid * requestId)
 {
-	device()->requestReadDiscreteInputs(address, amount, requestId);
+	device()->requestData(DataRequest::Read(AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS, address, amount), requestId);
 }
 
 int DiscreteInputPolling::maxRead() const
@@ -1,7 +1,6 @@
 #include <cutehmi/modbus/internal/DummyClientBackend.hpp>
 
 #include <QThread>
-#include <QJsonArray>
 #include <QModbusDevice>
 
 namespace cutehmi {
@@ -28,122 +27,117 @@ void DummyClientBackend::ensureClosed()
 		disconnect();
 }
 
-bool DummyClientBackend::proceedRequest(QUuid requestId)
+bool DummyClientBackend::proceedRequest()
 {
 	// Normally client would forward the request to Modbus server and emit reply with received data. Dummy client has no remote side
 	// to ask, but it emulates the latency here.
 	QThread::msleep(static_cast<unsigned long>(m->config->latency()));	// Fake processing.
 
-	if (m->state != AbstractDevice::OPENED) {
-		QJsonObject reply;
-
-		reply.insert("success", false);
-		reply.insert("error", "Client not connected.");
-
-		emit replied(requestId, reply);
-
-		return false;
-	}
-
-	return true;
+	return m->state == AbstractDevice::OPENED;
 }
 
 void DummyClientBackend::readCoils(QUuid requestId, quint16 startAddress, quint16 endAddress)
 {
-	QJsonObject reply;
+	DataReply reply;
 
-	QJsonArray values;
-	for (quint16 address = startAddress; address <= endAddress; address++)
-		values.append(m->coils.value(address)->value());
-	reply.insert("values", values);
-	reply.insert("success", true);
+	int amount = endAddress - startAddress + 1;	// Amount is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
+	m->coils.visit(startAddress, static_cast<std::size_t>(amount), [& reply](const auto & data, std::size_t i) {
+		reply.values.setBit(static_cast<int>(i), data.value());
+	});
+	reply.amount = static_cast<quint16>(amount);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::writeCoil(QUuid requestId, quint16 address, bool value)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	m->coils.value(address)->setValue(value);
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::writeMultipleCoils(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
 {
-	QJsonObject reply;
+	DataReply reply;
 
-	quint16 endAddress = startAddress + static_cast<quint16>(values.size()) - 1;	// Size of @a values vector is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
-	for (quint16 address = startAddress; address <= endAddress; address++)
-		m->coils.value(address)->setValue(values.at(address));
+	// Size of @a values vector is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
+	m->coils.visit(startAddress, static_cast<std::size_t>(values.size()), [& values](auto & data, std::size_t i) {
+		data.setValue(values.at(static_cast<int>(i)));
+	});
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::readDiscreteInputs(QUuid requestId, quint16 startAddress, quint16 endAddress)
 {
-	QJsonObject reply;
+	DataReply reply;
 
-	QJsonArray values;
-	for (quint16 address = startAddress; address <= endAddress; address++)
-		values.append(m->discreteInputs.value(address)->value());
-	reply.insert("values", values);
-	reply.insert("success", true);
+	int amount = endAddress - startAddress + 1;	// Amount is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
+	m->discreteInputs.visit(startAddress, static_cast<std::size_t>(amount), [& reply](const auto & data, std::size_t i) {
+		reply.values.setBit(static_cast<int>(i), data.value());
+	});
+	reply.amount = static_cast<quint16>(amount);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::readHoldingRegisters(QUuid requestId, quint16 startAddress, quint16 endAddress)
 {
-	QJsonObject reply;
+	DataReply reply;
 
-	QJsonArray values;
-	for (quint16 address = startAddress; address <= endAddress; address++)
-		values.append(static_cast<double>(m->holdingRegisters.value(address)->value()));
-	reply.insert("values", values);
-	reply.insert("success", true);
+	int amount = endAddress - startAddress + 1;	// Amount is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
+	m->holdingRegisters.visit(startAddress, static_cast<std::size_t>(amount), [& reply](const auto & data, std::size_t i) {
+		reply.values.setWord(static_cast<int>(i), data.value());
+	});
+	reply.amount = static_cast<quint16>(amount);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::writeHoldingRegister(QUuid requestId, quint16 address, quint16 value)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	m->holdingRegisters.value(address)->setValue(value);
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::writeMultipleHoldingRegisters(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
 {
-	QJsonObject reply;
+	DataReply reply;
 
-	quint16 endAddress = startAddress + static_cast<quint16>(values.size()) - 1;	// Size of @a values vector is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
-	for (quint16 address = startAddress; address <= endAddress; address++)
-		m->holdingRegisters.value(address)->setValue(values.at(address));
+	// Size of @a values vector is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
+	m->holdingRegisters.visit(startAddress, static_cast<std::size_t>(values.size()), [& values](auto & data, std::size_t i) {
+		data.setValue(values.at(static_cast<int>(i)));
+	});
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::readInputRegisters(QUuid requestId, quint16 startAddress, quint16 endAddress)
 {
-	QJsonObject reply;
+	DataReply reply;
 
-	QJsonArray values;
-	for (quint16 address = startAddress; address <= endAddress; address++)
-		values.append(static_cast<double>(m->inputRegisters.value(address)->value()));
-	reply.insert("values", values);
-	reply.insert("success", true);
+	int amount = endAddress - startAddress + 1;	// Amount is limited by @ref cutehmi-modbus-AbstractDevice-query_limits.
+	m->inputRegisters.visit(startAddress, static_cast<std::size_t>(amount), [& reply](const auto & data, std::size_t i) {
+		reply.values.setWord(static_cast<int>(i), data.value());
+	});
+	reply.amount = static_cast<quint16>(amount);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void DummyClientBackend::open()
@@ -23,7 +23,7 @@ const HoldingRegisterPolling::Data * HoldingRegisterPolling::dataAt(quint16 addr
 
 void HoldingRegisterPolling::requestReadData(quint16 address, quint16 amount, QUuid * requestId)
 {
-	device()->requestReadHoldingRegisters(address, amount, requestId);
+	device()->requestData(DataRequest::Read(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS, address, amount), requestId);
 }
 
 int HoldingRegisterPolling::maxRead() const
@@ -23,7 +23,7 @@ const InputRegisterPolling::Data * InputRegisterPolling::dataAt(quint16 address)
 
 void InputRegisterPolling::requestReadData(quint16 address, quint16 amount, QUuid * requestId)
 {
-	device()->requestReadInputRegisters(address, amount, requestId);
+	device()->requestData(DataRequest::Read(AbstractDevice::FUNCTION_READ_INPUT_REGISTERS, address, amount), requestId);
 }
 
 int InputRegisterPolling::maxRead() const
@@ -0,0 +1,609 @@
+#include <cutehmi/modbus/internal/NativeClientBackend.hpp>
+
+#include <QModbusDevice>
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+constexpr int NativeClientBackend::MAX_PDU_SIZE;
+constexpr int NativeClientBackend::RESPONSE_TIMEOUT;
+constexpr int NativeClientBackend::MIN_RESPONSE_TIMEOUT;
+constexpr int NativeClientBackend::MAX_RESPONSE_TIMEOUT;
+constexpr int NativeClientBackend::INITIAL_QUEUE_CAPACITY;
+
+namespace {
+
+constexpr quint8 EXCEPTION_FLAG = 0x80;
+constexpr quint16 COIL_ON = 0xFF00;
+constexpr quint16 COIL_OFF = 0x0000;
+
+}
+
+void NativeClientBackend::processDataRequest(DataRequest request)
+{
+	if (!proceedRequest()) {
+		// Let base class reply with an error.
+		AbstractClientBackend::processDataRequest(request);
+		return;
+	}
+
+	Transaction & transaction = reserveTransaction(request.id, request.function, true);
+	quint8 * pdu = transaction.pdu.data();
+	switch (request.function) {
+		case AbstractDevice::FUNCTION_READ_COILS:
+		case AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS:
+		case AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS:
+		case AbstractDevice::FUNCTION_READ_INPUT_REGISTERS:
+			PushByte(static_cast<quint8>(request.function), pdu);
+			PushWord(request.address, pdu);
+			PushWord(request.amount, pdu);
+			transaction.amount = request.amount;
+			break;
+		case AbstractDevice::FUNCTION_WRITE_COIL:
+			PushByte(static_cast<quint8>(request.function), pdu);
+			PushWord(request.address, pdu);
+			PushWord(request.values.bit(0) ? COIL_ON : COIL_OFF, pdu);
+			break;
+		case AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER:
+			PushByte(static_cast<quint8>(request.function), pdu);
+			PushWord(request.address, pdu);
+			PushWord(request.values.word(0), pdu);
+			break;
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_COILS: {
+			int byteCount = (request.amount + 7) / 8;
+			if (6 + byteCount > MAX_PDU_SIZE) {
+				replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Request exceeds maximal PDU size."));
+				return;
+			}
+			PushByte(static_cast<quint8>(request.function), pdu);
+			PushWord(request.address, pdu);
+			PushWord(request.amount, pdu);
+			PushByte(static_cast<quint8>(byteCount), pdu);
+			// Bits are stored in data buffer in the same, least significant bit first order as in Modbus PDU.
+			for (int byte = 0; byte < byteCount; byte++)
+				PushByte(static_cast<quint8>(request.values.word(byte / 2) >> (byte % 2) * 8), pdu);
+			// Unused bits of the last byte must be zeroed.
+			if (request.amount % 8)
+				*(pdu - 1) &= static_cast<quint8>((1u << request.amount % 8) - 1);
+			break;
+		}
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS: {
+			int byteCount = request.amount * 2;
+			if (6 + byteCount > MAX_PDU_SIZE) {
+				replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Request exceeds maximal PDU size."));
+				return;
+			}
+			PushByte(static_cast<quint8>(request.function), pdu);
+			PushWord(request.address, pdu);
+			PushWord(request.amount, pdu);
+			PushByte(static_cast<quint8>(byteCount), pdu);
+			for (int i = 0; i < request.amount; i++)
+				PushWord(request.values.word(i), pdu);
+			break;
+		}
+		default:
+			// Functions, which can not be encoded natively, are handled by base class.
+			AbstractClientBackend::processDataRequest(request);
+			return;
+	}
+	commitTransaction(pdu);
+}
+
+NativeClientBackend::NativeClientBackend(QObject * parent):
+	AbstractClientBackend(parent),
+	m(new Members)
+{
+}
+
+bool NativeClientBackend::takeTransaction(Transaction & transaction)
+{
+	if (m->count == 0)
+		return false;
+
+	const Transaction & head = m->queue[m->head];
+	transaction.requestId = head.requestId;
+	transaction.unit = head.unit;
+	transaction.function = head.function;
+	transaction.data = head.data;
+	transaction.amount = head.amount;
+	transaction.pduSize = head.pduSize;
+	std::copy_n(head.pdu.begin(), head.pduSize, transaction.pdu.begin());
+
+	m->head = (m->head + 1) % m->queue.size();
+	m->count--;
+	return true;
+}
+
+int NativeClientBackend::pendingTransactions() const
+{
+	return static_cast<int>(m->count);
+}
+
+void NativeClientBackend::completeTransaction(const Transaction & transaction, const quint8 * pdu, int size)
+{
+	if (size < 1) {
+		replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Device response is incomplete."));
+		return;
+	}
+
+	if ((pdu[0] & ~EXCEPTION_FLAG) != transaction.pdu[0]) {
+		replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Device response does not match the request."));
+		return;
+	}
+
+	if (pdu[0] & EXCEPTION_FLAG) {
+		replyError(transaction, QModbusDevice::ProtocolError, size >= 2 ? pdu[1] : 0, nullptr);
+		return;
+	}
+
+	if (transaction.data)
+		completeDataTransaction(transaction, pdu, size);
+	else
+		completeJsonTransaction(transaction, pdu, size);
+}
+
+void NativeClientBackend::failTransaction(const Transaction & transaction, int error, const char * errorString)
+{
+	replyError(transaction, error, 0, errorString);
+}
+
+int NativeClientBackend::responseTimeout(quint8 unit) const
+{
+	return m->roundTripTimes[unit].timeout;
+}
+
+void NativeClientBackend::sampleRoundTripTime(quint8 unit, qint64 roundTripTime)
+{
+	// Gains as recommended by RFC 6298.
+	static constexpr qreal ALPHA = 1.0 / 8.0;
+	static constexpr qreal BETA = 1.0 / 4.0;
+
+	RoundTripTime & rtt = m->roundTripTimes[unit];
+	qreal sample = static_cast<qreal>(roundTripTime);
+	if (rtt.sampled) {
+		rtt.variation = (1.0 - BETA) * rtt.variation + BETA * qAbs(rtt.smoothed - sample);
+		rtt.smoothed = (1.0 - ALPHA) * rtt.smoothed + ALPHA * sample;
+	} else {
+		rtt.smoothed = sample;
+		rtt.variation = sample / 2.0;
+		rtt.sampled = true;
+	}
+	rtt.timeout = qBound(MIN_RESPONSE_TIMEOUT, static_cast<int>(std::ceil(rtt.smoothed + 4.0 * rtt.variation)), MAX_RESPONSE_TIMEOUT);
+}
+
+void NativeClientBackend::backOffResponseTimeout(quint8 unit)
+{
+	RoundTripTime & rtt = m->roundTripTimes[unit];
+	rtt.timeout = qMin(rtt.timeout * 2, MAX_RESPONSE_TIMEOUT);
+}
+
+void NativeClientBackend::failPendingTransactions(int error, const char * errorString)
+{
+	while (m->count > 0) {
+		const Transaction & head = m->queue[m->head];
+		m->head = (m->head + 1) % m->queue.size();
+		m->count--;
+		replyError(head, error, 0, errorString);
+	}
+}
+
+void NativeClientBackend::readExceptionStatus(QUuid requestId)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_READ_EXCEPTION_STATUS, false);
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_READ_EXCEPTION_STATUS, pdu);
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::diagnostics(QUuid requestId, AbstractDevice::DiagnosticsSubfunction subfunction, quint16 data)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_DIAGNOSTICS, false);
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_DIAGNOSTICS, pdu);
+	PushWord(static_cast<quint16>(subfunction), pdu);
+	PushWord(data, pdu);
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::fetchCommEventCounter(QUuid requestId)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_FETCH_COMM_EVENT_COUNTER, false);
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_FETCH_COMM_EVENT_COUNTER, pdu);
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::fetchCommEventLog(QUuid requestId)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_FETCH_COMM_EVENT_LOG, false);
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_FETCH_COMM_EVENT_LOG, pdu);
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::reportSlaveId(QUuid requestId)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_REPORT_SLAVE_ID, false);
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_REPORT_SLAVE_ID, pdu);
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::readFileRecord(QUuid requestId, quint8 byteCount, QJsonArray subrequests)
+{
+	static constexpr int SUBREQUEST_SIZE = 7;
+
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_READ_FILE_RECORD, false);
+	if (2 + subrequests.count() * SUBREQUEST_SIZE > MAX_PDU_SIZE) {
+		replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Request exceeds maximal PDU size."));
+		return;
+	}
+
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_READ_FILE_RECORD, pdu);
+	PushByte(byteCount, pdu);
+	for (int i = 0; i < subrequests.count(); i++) {
+		QJsonObject subrequest = subrequests.at(i).toObject();
+		PushByte(static_cast<quint8>(subrequest.value("referenceType").toDouble()), pdu);
+		PushWord(static_cast<quint16>(subrequest.value("file").toDouble()), pdu);
+		PushWord(static_cast<quint16>(subrequest.value("address").toDouble()), pdu);
+		PushWord(static_cast<quint16>(subrequest.value("amount").toDouble()), pdu);
+	}
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::writeFileRecord(QUuid requestId, quint8 byteCount, QJsonArray subrequests)
+{
+	static constexpr int SUBREQUEST_HEADER_SIZE = 7;
+
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_WRITE_FILE_RECORD, false);
+	int size = 2;
+	for (int i = 0; i < subrequests.count(); i++)
+		size += SUBREQUEST_HEADER_SIZE + subrequests.at(i).toObject().value("values").toArray().count() * 2;
+	if (size > MAX_PDU_SIZE) {
+		replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Request exceeds maximal PDU size."));
+		return;
+	}
+
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_WRITE_FILE_RECORD, pdu);
+	PushByte(byteCount, pdu);
+	for (int i = 0; i < subrequests.count(); i++) {
+		QJsonObject subrequest = subrequests.at(i).toObject();
+		QJsonArray values = subrequest.value("values").toArray();
+		PushByte(static_cast<quint8>(subrequest.value("referenceType").toDouble()), pdu);
+		PushWord(static_cast<quint16>(subrequest.value("file").toDouble()), pdu);
+		PushWord(static_cast<quint16>(subrequest.value("address").toDouble()), pdu);
+		PushWord(static_cast<quint16>(values.count()), pdu);
+		for (auto value = values.begin(); value != values.end(); ++value)
+			PushWord(static_cast<quint16>(value->toDouble()), pdu);
+	}
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::maskWriteHoldingRegister(QUuid requestId, quint16 address, quint16 andMask, quint16 orMask)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_MASK_WRITE_HOLDING_REGISTER, false);
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_MASK_WRITE_HOLDING_REGISTER, pdu);
+	PushWord(address, pdu);
+	PushWord(andMask, pdu);
+	PushWord(orMask, pdu);
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::readWriteMultipleHoldingRegisters(QUuid requestId, quint16 readStartAddress, quint16 readEndAddress, quint16 writeAddress, const QVector<quint16> & values)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_READ_WRITE_MULTIPLE_HOLDING_REGISTERS, false);
+	if (10 + values.count() * 2 > MAX_PDU_SIZE) {
+		replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Request exceeds maximal PDU size."));
+		return;
+	}
+
+	quint16 readAmount = readEndAddress - readStartAddress + 1;
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_READ_WRITE_MULTIPLE_HOLDING_REGISTERS, pdu);
+	PushWord(readStartAddress, pdu);
+	PushWord(readAmount, pdu);
+	PushWord(writeAddress, pdu);
+	PushWord(static_cast<quint16>(values.count()), pdu);
+	PushByte(static_cast<quint8>(values.count() * 2), pdu);
+	for (auto value = values.begin(); value != values.end(); ++value)
+		PushWord(*value, pdu);
+	transaction.amount = readAmount;
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::readFIFOQueue(QUuid requestId, quint16 address)
+{
+	Transaction & transaction = reserveTransaction(requestId, AbstractDevice::FUNCTION_READ_FIFO_QUEUE, false);
+	quint8 * pdu = transaction.pdu.data();
+	PushByte(AbstractDevice::FUNCTION_READ_FIFO_QUEUE, pdu);
+	PushWord(address, pdu);
+	commitTransaction(pdu);
+}
+
+void NativeClientBackend::PushByte(quint8 byte, quint8 *& destination)
+{
+	*destination = byte;
+	destination++;
+}
+
+void NativeClientBackend::PushWord(quint16 word, quint8 *& destination)
+{
+	*destination = static_cast<quint8>(word >> 8);
+	destination++;
+
+	*destination = static_cast<quint8>(word);
+	destination++;
+}
+
+quint8 NativeClientBackend::PullByte(const quint8 *& source)
+{
+	return *source++;
+}
+
+quint16 NativeClientBackend::PullWord(const quint8 *& source)
+{
+	quint16 result = static_cast<quint16>(source[0] << 8 | source[1]);
+	source += 2;
+	return result;
+}
+
+NativeClientBackend::Transaction & NativeClientBackend::reserveTransaction(QUuid requestId, int function, bool data)
+{
+	if (m->count == m->queue.size()) {
+		CUTEHMI_DEBUG("Growing transaction queue to " << m->queue.size() * 2 << " slots.");
+
+		std::vector<Transaction> grown(m->queue.size() * 2);
+		for (std::size_t i = 0; i < m->count; i++)
+			grown[i] = m->queue[(m->head + i) % m->queue.size()];
+		m->queue.swap(grown);
+		m->head = 0;
+	}
+
+	Transaction & result = m->queue[(m->head + m->count) % m->queue.size()];
+	result.requestId = requestId;
+	result.unit = static_cast<quint8>(slaveAddress());
+	result.function = function;
+	result.data = data;
+	result.amount = 0;
+	result.pduSize = 0;
+	return result;
+}
+
+void NativeClientBackend::commitTransaction(const quint8 * pduEnd)
+{
+	Transaction & transaction = m->queue[(m->head + m->count) % m->queue.size()];
+	transaction.pduSize = static_cast<int>(pduEnd - transaction.pdu.data());
+	m->count++;
+
+	dispatch();
+}
+
+void NativeClientBackend::completeDataTransaction(const Transaction & transaction, const quint8 * pdu, int size)
+{
+	DataReply reply;
+	const quint8 * data = pdu + 1;
+	switch (transaction.function) {
+		case AbstractDevice::FUNCTION_READ_COILS:
+		case AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS: {
+			int byteCount = size >= 2 ? PullByte(data) : 0;
+			int amount = qMin(static_cast<int>(transaction.amount), DataBuffer::BIT_CAPACITY);
+			if (size < 2 + byteCount || byteCount < (amount + 7) / 8) {
+				replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Device response is incomplete."));
+				return;
+			}
+			// Bits are stored in Modbus PDU in the same, least significant bit first order as in data buffer.
+			for (int word = 0; word < (amount + 15) / 16; word++) {
+				quint16 value = data[word * 2];
+				if (word * 2 + 1 < byteCount)
+					value |= static_cast<quint16>(data[word * 2 + 1] << 8);
+				reply.values.setWord(word, value);
+			}
+			reply.amount = static_cast<quint16>(amount);
+			break;
+		}
+		case AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS:
+		case AbstractDevice::FUNCTION_READ_INPUT_REGISTERS: {
+			int byteCount = size >= 2 ? PullByte(data) : 0;
+			int amount = qMin(static_cast<int>(transaction.amount), DataBuffer::WORD_CAPACITY);
+			if (size < 2 + byteCount || byteCount < amount * 2) {
+				replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Device response is incomplete."));
+				return;
+			}
+			for (int i = 0; i < amount; i++)
+				reply.values.setWord(i, PullWord(data));
+			reply.amount = static_cast<quint16>(amount);
+			break;
+		}
+		default:
+			// Write functions echo the request, which carries no information for the reply.
+			break;
+	}
+	reply.success = true;
+
+	emit dataReplied(transaction.requestId, reply);
+}
+
+void NativeClientBackend::completeJsonTransaction(const Transaction & transaction, const quint8 * pdu, int size)
+{
+	QJsonObject reply;
+	const quint8 * data = pdu + 1;
+	const quint8 * end = pdu + size;
+	bool complete = false;
+	switch (transaction.function) {
+		case AbstractDevice::FUNCTION_READ_EXCEPTION_STATUS:
+			if (end - data >= 1) {
+				reply.insert("exceptionStatus", static_cast<double>(PullByte(data)));
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_DIAGNOSTICS:
+			if (end - data >= 4) {
+				reply.insert("subfunction", static_cast<double>(PullWord(data)));
+				reply.insert("data", static_cast<double>(PullWord(data)));
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_FETCH_COMM_EVENT_COUNTER:
+			if (end - data >= 4) {
+				reply.insert("status", static_cast<double>(PullWord(data)));
+				reply.insert("eventCount", static_cast<double>(PullWord(data)));
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_FETCH_COMM_EVENT_LOG:
+			if (end - data >= 7 && end - data >= 1 + data[0]) {
+				quint8 byteCount = PullByte(data);
+				reply.insert("byteCount", static_cast<double>(byteCount));
+				reply.insert("status", static_cast<double>(PullWord(data)));
+				reply.insert("eventCount", static_cast<double>(PullWord(data)));
+				reply.insert("messageCount", static_cast<double>(PullWord(data)));
+				QJsonArray events;
+				for (int byte = 7; byte <= byteCount; byte++)
+					events.append(static_cast<double>(PullByte(data)));
+				reply.insert("events", events);
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_REPORT_SLAVE_ID:
+			if (end - data >= 3 && end - data >= 1 + data[0]) {
+				quint8 byteCount = PullByte(data);
+				reply.insert("byteCount", static_cast<double>(byteCount));
+				reply.insert("slaveId", static_cast<double>(PullByte(data)));
+				reply.insert("runIndicatorStatus", static_cast<double>(PullByte(data)));
+				QJsonArray additionalData;
+				for (int byte = 3; byte <= byteCount; byte++)
+					additionalData.append(static_cast<double>(PullByte(data)));
+				reply.insert("additionalData", additionalData);
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_READ_FILE_RECORD:
+			if (end - data >= 1 && end - data >= 1 + data[0]) {
+				quint8 byteCount = PullByte(data);
+				reply.insert("byteCount", static_cast<double>(byteCount));
+				const quint8 * recordsEnd = data + byteCount;
+				QJsonArray subresponses;
+				while (recordsEnd - data >= 2) {
+					QJsonObject subresponse;
+					quint8 subByteCount = PullByte(data);
+					subresponse.insert("byteCount", static_cast<double>(subByteCount));
+					subresponse.insert("referenceType", static_cast<double>(PullByte(data)));
+					QJsonArray values;
+					for (int subByte = 2; subByte <= subByteCount && recordsEnd - data >= 2; subByte += 2)
+						values.append(static_cast<double>(PullWord(data)));
+					subresponse.insert("values", values);
+					subresponses.append(subresponse);
+				}
+				reply.insert("subresponses", subresponses);
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_WRITE_FILE_RECORD:
+			if (end - data >= 1 && end - data >= 1 + data[0]) {
+				static constexpr int SUBRESPONSE_HEADER_SIZE = 7;
+
+				quint8 byteCount = PullByte(data);
+				reply.insert("byteCount", static_cast<double>(byteCount));
+				const quint8 * recordsEnd = data + byteCount;
+				QJsonArray subresponses;
+				while (recordsEnd - data >= SUBRESPONSE_HEADER_SIZE) {
+					QJsonObject subresponse;
+					subresponse.insert("referenceType", static_cast<double>(PullByte(data)));
+					subresponse.insert("file", static_cast<double>(PullWord(data)));
+					subresponse.insert("address", static_cast<double>(PullWord(data)));
+					quint16 amount = PullWord(data);
+					subresponse.insert("amount", static_cast<double>(amount));
+					QJsonArray values;
+					for (quint16 i = 0; i < amount && recordsEnd - data >= 2; i++)
+						values.append(static_cast<double>(PullWord(data)));
+					subresponse.insert("values", values);
+					subresponses.append(subresponse);
+				}
+				reply.insert("subresponses", subresponses);
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_MASK_WRITE_HOLDING_REGISTER:
+			if (end - data >= 6) {
+				reply.insert("address", static_cast<double>(PullWord(data)));
+				reply.insert("andMask", static_cast<double>(PullWord(data)));
+				reply.insert("orMask", static_cast<double>(PullWord(data)));
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_READ_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			if (end - data >= 1 && end - data >= 1 + data[0] && data[0] >= transaction.amount * 2) {
+				PullByte(data);
+				QJsonArray values;
+				for (int i = 0; i < transaction.amount; i++)
+					values.append(static_cast<double>(PullWord(data)));
+				reply.insert("values", values);
+				complete = true;
+			}
+			break;
+		case AbstractDevice::FUNCTION_READ_FIFO_QUEUE:
+			if (end - data >= 4) {
+				reply.insert("byteCount", static_cast<double>(PullWord(data)));
+				quint16 fifoCount = PullWord(data);
+				reply.insert("fifoCount", static_cast<double>(fifoCount));
+				QJsonArray registers;
+				for (quint16 reg = 0; reg < fifoCount && end - data >= 2; reg++)
+					registers.append(static_cast<double>(PullWord(data)));
+				reply.insert("registers", registers);
+				complete = true;
+			}
+			break;
+		default:
+			CUTEHMI_CRITICAL("Unsupported function code '" << transaction.function << "'.");
+	}
+
+	if (!complete) {
+		replyError(transaction, QModbusDevice::UnknownError, 0, QT_TR_NOOP("Device response is incomplete."));
+		return;
+	}
+	reply.insert("success", true);
+
+	emit replied(transaction.requestId, reply);
+}
+
+void NativeClientBackend::replyError(const Transaction & transaction, int error, int exceptionCode, const char * errorString)
+{
+	if (transaction.data) {
+		DataReply reply;
+		reply.error = error;
+		reply.exceptionCode = exceptionCode;
+		reply.errorString = errorString;
+
+		emit dataReplied(transaction.requestId, reply);
+	} else {
+		QJsonObject reply;
+		if (errorString != nullptr)
+			reply.insert("error", tr(errorString));
+		else
+			reply.insert("error", tr("Modbus protocol error (exception code: %1).").arg(exceptionCode));
+		reply.insert("errorCode", error);
+		if (error == QModbusDevice::ProtocolError)
+			reply.insert("protocolErrorCode", exceptionCode);
+		reply.insert("success", false);
+
+		emit replied(transaction.requestId, reply);
+	}
+}
+
+}
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
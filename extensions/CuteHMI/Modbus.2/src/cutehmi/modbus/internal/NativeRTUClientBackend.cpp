@@ -0,0 +1,365 @@
+#include <cutehmi/modbus/internal/NativeRTUClientBackend.hpp>
+
+#include <algorithm>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+constexpr int NativeRTUClientBackend::MAX_ADU_SIZE;
+constexpr qint64 NativeRTUClientBackend::FIXED_SILENT_INTERVAL;
+constexpr int NativeRTUClientBackend::BROADCAST_TURNAROUND_DELAY;
+
+NativeRTUClientBackend::NativeRTUClientBackend(RTUClientConfig * config, QObject * parent):
+	NativeClientBackend(parent),
+	m(new Members(config, this))
+{
+	m->responseTimer->setSingleShot(true);
+	m->responseTimer->setTimerType(Qt::PreciseTimer);
+	m->turnaroundTimer->setSingleShot(true);
+	m->turnaroundTimer->setTimerType(Qt::PreciseTimer);
+	m->broadcastTimer->setSingleShot(true);
+	m->broadcastTimer->setTimerType(Qt::PreciseTimer);
+
+	connect(m->port, & QSerialPort::readyRead, this, & NativeRTUClientBackend::onReadyRead);
+	connect(m->port, & QSerialPort::errorOccurred, this, & NativeRTUClientBackend::onErrorOccurred);
+	connect(m->responseTimer, & QTimer::timeout, this, & NativeRTUClientBackend::onResponseTimeout);
+	connect(m->turnaroundTimer, & QTimer::timeout, this, & NativeRTUClientBackend::dispatch);
+	connect(m->broadcastTimer, & QTimer::timeout, this, & NativeRTUClientBackend::onBroadcastDelivered);
+}
+
+quint16 NativeRTUClientBackend::CRC16(const quint8 * data, int size)
+{
+	static const std::array<quint16, 256> TABLE = CRC16Table();
+
+	quint16 crc = 0xFFFF;
+	for (int i = 0; i < size; i++)
+		crc = static_cast<quint16>(crc >> 8 ^ TABLE[(crc ^ data[i]) & 0xFF]);
+	return crc;
+}
+
+qint64 NativeRTUClientBackend::SilentInterval(int baudRate, QSerialPort::DataBits dataBits, QSerialPort::Parity parity, QSerialPort::StopBits stopBits)
+{
+	// Modbus over serial line specification recommends fixed value of 1.75 ms for baud rates greater than 19200.
+	if (baudRate <= 0 || baudRate > QSerialPort::Baud19200)
+		return FIXED_SILENT_INTERVAL;
+
+	int characterBits = 1 + dataBits + (parity == QSerialPort::NoParity ? 0 : 1) + (stopBits == QSerialPort::OneStop ? 1 : 2);
+	return Q_INT64_C(3500000000) * characterBits / baudRate;
+}
+
+qint64 NativeRTUClientBackend::CharacterTime(int baudRate, QSerialPort::DataBits dataBits, QSerialPort::Parity parity, QSerialPort::StopBits stopBits)
+{
+	if (baudRate <= 0)
+		return 0;
+
+	int characterBits = 1 + dataBits + (parity == QSerialPort::NoParity ? 0 : 1) + (stopBits == QSerialPort::OneStop ? 1 : 2);
+	return Q_INT64_C(1000000000) * characterBits / baudRate;
+}
+
+int NativeRTUClientBackend::ResponseSize(const quint8 * adu, int size)
+{
+	static constexpr quint8 EXCEPTION_FLAG = 0x80;
+	static constexpr int HEADER_SIZE = 2;	// Slave address and function code.
+	static constexpr int CRC_SIZE = 2;
+
+	if (size < HEADER_SIZE)
+		return 0;
+
+	quint8 function = adu[1];
+	if (function & EXCEPTION_FLAG)
+		return HEADER_SIZE + 1 + CRC_SIZE;
+
+	switch (function) {
+		case AbstractDevice::FUNCTION_READ_COILS:
+		case AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS:
+		case AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS:
+		case AbstractDevice::FUNCTION_READ_INPUT_REGISTERS:
+		case AbstractDevice::FUNCTION_FETCH_COMM_EVENT_LOG:
+		case AbstractDevice::FUNCTION_REPORT_SLAVE_ID:
+		case AbstractDevice::FUNCTION_READ_FILE_RECORD:
+		case AbstractDevice::FUNCTION_WRITE_FILE_RECORD:
+		case AbstractDevice::FUNCTION_READ_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			return size < HEADER_SIZE + 1 ? 0 : HEADER_SIZE + 1 + adu[2] + CRC_SIZE;
+		case AbstractDevice::FUNCTION_WRITE_COIL:
+		case AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER:
+		case AbstractDevice::FUNCTION_DIAGNOSTICS:
+		case AbstractDevice::FUNCTION_FETCH_COMM_EVENT_COUNTER:
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_COILS:
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			return HEADER_SIZE + 4 + CRC_SIZE;
+		case AbstractDevice::FUNCTION_READ_EXCEPTION_STATUS:
+			return HEADER_SIZE + 1 + CRC_SIZE;
+		case AbstractDevice::FUNCTION_MASK_WRITE_HOLDING_REGISTER:
+			return HEADER_SIZE + 6 + CRC_SIZE;
+		case AbstractDevice::FUNCTION_READ_FIFO_QUEUE:
+			return size < HEADER_SIZE + 2 ? 0 : HEADER_SIZE + 2 + (adu[2] << 8 | adu[3]) + CRC_SIZE;
+		default:
+			// Unrecognized function code. Whatever has been received is going to be rejected anyways.
+			return size;
+	}
+}
+
+void NativeRTUClientBackend::ensureClosed()
+{
+	if (m->port->isOpen())
+		close();
+}
+
+int NativeRTUClientBackend::slaveAddress() const
+{
+	return m->config->slaveAddress();
+}
+
+void NativeRTUClientBackend::dispatch()
+{
+	if (m->awaiting || m->turnaroundTimer->isActive() || m->broadcastTimer->isActive() || !m->port->isOpen() || pendingTransactions() == 0)
+		return;
+
+	qint64 remaining = m->silentInterval - m->lineTimer.nsecsElapsed();
+	if (remaining > 0) {
+		// Sleeping would stall other backends sharing the thread, so silent interval is waited out in the event loop.
+		m->turnaroundTimer->start(static_cast<int>((remaining + 999999) / 1000000));
+		return;
+	}
+
+	takeTransaction(m->transaction);
+	send();
+}
+
+bool NativeRTUClientBackend::proceedRequest()
+{
+	return m->port->isOpen();
+}
+
+void NativeRTUClientBackend::open()
+{
+	if (m->port->isOpen()) {
+		CUTEHMI_DEBUG("Ignoring request - already connected.");
+		return;
+	}
+
+	emit stateChanged(AbstractDevice::OPENING);
+
+	m->port->setPortName(m->config->port());
+	m->port->setBaudRate(m->config->baudRate());
+	m->port->setParity(m->config->parity());
+	m->port->setDataBits(m->config->dataBits());
+	m->port->setStopBits(m->config->stopBits());
+	m->silentInterval = SilentInterval(m->config->baudRate(), m->config->dataBits(), m->config->parity(), m->config->stopBits());
+	m->characterTime = CharacterTime(m->config->baudRate(), m->config->dataBits(), m->config->parity(), m->config->stopBits());
+
+	CUTEHMI_DEBUG("Client configured on '" << m->config->port()	<< "', " << m->config->baudRate()
+			<< ", " << m->config->parity()
+			<< ", " << m->config->dataBits()
+			<< ", " << m->config->stopBits()
+			<< ", silent interval " << m->silentInterval << " ns.");
+
+	// If port fails to open, error is going to be reported by onErrorOccurred().
+	if (m->port->open(QIODevice::ReadWrite)) {
+		m->responseSize = 0;
+		m->lineTimer.start();
+		emit stateChanged(AbstractDevice::OPENED);
+		emit opened();
+	} else {
+		emit stateChanged(AbstractDevice::CLOSED);
+		emit closed();
+	}
+}
+
+void NativeRTUClientBackend::close()
+{
+	if (!m->port->isOpen()) {
+		CUTEHMI_DEBUG("Ignoring request - already disconnected.");
+		return;
+	}
+
+	emit stateChanged(AbstractDevice::CLOSING);
+
+	m->responseTimer->stop();
+	m->turnaroundTimer->stop();
+	if (m->awaiting || m->broadcastTimer->isActive()) {
+		m->awaiting = false;
+		m->broadcastTimer->stop();
+		failTransaction(m->transaction, QModbusDevice::ReplyAbortedError, QT_TR_NOOP("Reply aborted."));
+	}
+	failPendingTransactions(QModbusDevice::ReplyAbortedError, QT_TR_NOOP("Reply aborted."));
+	m->port->close();
+
+	emit stateChanged(AbstractDevice::CLOSED);
+	emit closed();
+}
+
+void NativeRTUClientBackend::onReadyRead()
+{
+	// Silent interval is measured from the last byte seen on the line.
+	m->lineTimer.restart();
+
+	if (!m->awaiting) {
+		// Discard unsolicited bytes.
+		while (m->port->read(reinterpret_cast<char *>(m->response.data()), MAX_ADU_SIZE) > 0) {
+		}
+		return;
+	}
+
+	qint64 count = m->port->read(reinterpret_cast<char *>(m->response.data()) + m->responseSize, MAX_ADU_SIZE - m->responseSize);
+	if (count <= 0)
+		return;
+	m->responseSize += static_cast<int>(count);
+
+	int size = qMin(ResponseSize(m->response.data(), m->responseSize), MAX_ADU_SIZE);
+	if (size == 0 || m->responseSize < size)
+		return;
+
+	m->responseTimer->stop();
+	m->awaiting = false;
+	m->responseSize = 0;
+
+	const quint8 * adu = m->response.data();
+	if (size < 4 || CRC16(adu, size - 2) != (adu[size - 2] | adu[size - 1] << 8))
+		failTransaction(m->transaction, QModbusDevice::UnknownError, QT_TR_NOOP("Response CRC mismatch."));
+	else if (adu[0] != m->request[0])
+		failTransaction(m->transaction, QModbusDevice::UnknownError, QT_TR_NOOP("Response has been sent by unexpected slave."));
+	else {
+		// Time spent on the wire depends on frame sizes, so only the time taken by slave to respond is sampled.
+		sampleRoundTripTime(m->transaction.unit, qMax(Q_INT64_C(0), m->requestTimer.nsecsElapsed() - m->frameTime) / 1000000);
+		completeTransaction(m->transaction, adu + 1, size - 3);	// Slave address and CRC are not part of PDU.
+	}
+
+	// Last byte of the response has just been received, so dispatch() is going to wait out the silent interval with a timer.
+	dispatch();
+}
+
+void NativeRTUClientBackend::onResponseTimeout()
+{
+	m->awaiting = false;
+	m->responseSize = 0;
+	m->lineTimer.restart();
+
+	backOffResponseTimeout(m->transaction.unit);
+	failTransaction(m->transaction, QModbusDevice::TimeoutError, QT_TR_NOOP("Response timeout."));
+
+	dispatch();
+}
+
+void NativeRTUClientBackend::onBroadcastDelivered()
+{
+	m->lineTimer.restart();
+
+	// Slaves do not respond to broadcast, so write functions are completed with the echo of request, which is what they would
+	// have responded with.
+	completeTransaction(m->transaction, m->transaction.pdu.data(), m->transaction.pduSize);
+
+	dispatch();
+}
+
+void NativeRTUClientBackend::onErrorOccurred(QSerialPort::SerialPortError error)
+{
+	if (error == QSerialPort::NoError)
+		return;
+
+	emit errored(CUTEHMI_ERROR(m->port->errorString()));
+
+	if (error == QSerialPort::ResourceError && m->port->isOpen())
+		close();
+}
+
+void NativeRTUClientBackend::send()
+{
+	quint8 * adu = m->request.data();
+	*adu++ = m->transaction.unit;
+	adu = std::copy_n(m->transaction.pdu.begin(), m->transaction.pduSize, adu);
+	quint16 crc = CRC16(m->request.data(), static_cast<int>(adu - m->request.data()));
+	// Contrary to other fields, CRC is sent low-order byte first.
+	*adu++ = static_cast<quint8>(crc);
+	*adu++ = static_cast<quint8>(crc >> 8);
+
+	int requestSize = static_cast<int>(adu - m->request.data());
+
+	if (m->transaction.unit == 0) {
+		if (!Broadcastable(m->transaction)) {
+			failTransaction(m->transaction, QModbusDevice::UnknownError, QT_TR_NOOP("Only write functions can be broadcast."));
+			dispatch();
+			return;
+		}
+
+		// Round-trip time is not sampled and response timer is not armed, because slaves do not respond to broadcast.
+		m->port->write(reinterpret_cast<const char *>(m->request.data()), requestSize);
+		m->port->flush();
+		m->broadcastTimer->start(static_cast<int>((m->characterTime * requestSize + 999999) / 1000000) + BROADCAST_TURNAROUND_DELAY);
+		return;
+	}
+
+	m->frameTime = m->characterTime * (requestSize + ExpectedResponseSize(m->transaction));
+
+	m->awaiting = true;
+	m->responseSize = 0;
+	m->port->write(reinterpret_cast<const char *>(m->request.data()), requestSize);
+	m->port->flush();
+	m->lineTimer.restart();
+	m->requestTimer.start();
+	m->responseTimer->start(responseTimeout(m->transaction.unit) + static_cast<int>((m->frameTime + 999999) / 1000000));
+}
+
+int NativeRTUClientBackend::ExpectedResponseSize(const Transaction & transaction)
+{
+	static constexpr int HEADER_SIZE = 3;	// Slave address, function code and byte count.
+	static constexpr int CRC_SIZE = 2;
+
+	switch (transaction.function) {
+		case AbstractDevice::FUNCTION_READ_COILS:
+		case AbstractDevice::FUNCTION_READ_DISCRETE_INPUTS:
+			return HEADER_SIZE + (transaction.amount + 7) / 8 + CRC_SIZE;
+		case AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS:
+		case AbstractDevice::FUNCTION_READ_INPUT_REGISTERS:
+		case AbstractDevice::FUNCTION_READ_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			return HEADER_SIZE + transaction.amount * 2 + CRC_SIZE;
+		case AbstractDevice::FUNCTION_WRITE_COIL:
+		case AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER:
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_COILS:
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+			return 8;
+		default:
+			// Size of response can not be predicted, so the worst case is assumed.
+			return MAX_ADU_SIZE;
+	}
+}
+
+bool NativeRTUClientBackend::Broadcastable(const Transaction & transaction)
+{
+	switch (transaction.function) {
+		case AbstractDevice::FUNCTION_WRITE_COIL:
+		case AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER:
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_COILS:
+		case AbstractDevice::FUNCTION_WRITE_MULTIPLE_HOLDING_REGISTERS:
+		case AbstractDevice::FUNCTION_WRITE_FILE_RECORD:
+		case AbstractDevice::FUNCTION_MASK_WRITE_HOLDING_REGISTER:
+			return true;
+		default:
+			return false;
+	}
+}
+
+std::array<quint16, 256> NativeRTUClientBackend::CRC16Table()
+{
+	static constexpr quint16 POLYNOMIAL = 0xA001;	// Reversed 0x8005.
+
+	std::array<quint16, 256> result;
+	for (std::size_t i = 0; i < result.size(); i++) {
+		quint16 crc = static_cast<quint16>(i);
+		for (int bit = 0; bit < 8; bit++)
+			crc = crc & 1 ? static_cast<quint16>(crc >> 1 ^ POLYNOMIAL) : static_cast<quint16>(crc >> 1);
+		result[i] = crc;
+	}
+	return result;
+}
+
+}
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,250 @@
+#include <cutehmi/modbus/internal/NativeTCPClientBackend.hpp>
+
+#include <QModbusDevice>
+
+#include <algorithm>
+#include <cstring>
+
+namespace cutehmi {
+namespace modbus {
+namespace internal {
+
+constexpr int NativeTCPClientBackend::MBAP_HEADER_SIZE;
+constexpr int NativeTCPClientBackend::MAX_ADU_SIZE;
+constexpr int NativeTCPClientBackend::IN_FLIGHT_CAPACITY;
+constexpr int NativeTCPClientBackend::SWEEP_INTERVAL;
+
+NativeTCPClientBackend::NativeTCPClientBackend(TCPClientConfig * config, QObject * parent):
+	NativeClientBackend(parent),
+	m(new Members(config, this))
+{
+	static_assert((IN_FLIGHT_CAPACITY & (IN_FLIGHT_CAPACITY - 1)) == 0, "IN_FLIGHT_CAPACITY must be a power of two");
+
+	m->sendTimer->setSingleShot(true);
+	m->sendTimer->setInterval(0);
+	m->sweepTimer->setInterval(SWEEP_INTERVAL);
+	m->clock.start();
+
+	connect(m->socket, & QTcpSocket::readyRead, this, & NativeTCPClientBackend::onReadyRead);
+	connect(m->socket, & QTcpSocket::stateChanged, this, & NativeTCPClientBackend::onStateChanged);
+	connect(m->socket, QOverload<QAbstractSocket::SocketError>::of(& QAbstractSocket::error), this, & NativeTCPClientBackend::onErrorOccurred);
+	connect(m->sendTimer, & QTimer::timeout, this, & NativeTCPClientBackend::send);
+	connect(m->sweepTimer, & QTimer::timeout, this, & NativeTCPClientBackend::sweepTimedOut);
+}
+
+void NativeTCPClientBackend::ensureClosed()
+{
+	// Abort closes the socket synchronously, which is required when backend is about to be destroyed.
+	if (m->socket->state() != QAbstractSocket::UnconnectedState)
+		m->socket->abort();
+}
+
+int NativeTCPClientBackend::slaveAddress() const
+{
+	return m->config->slaveAddress();
+}
+
+void NativeTCPClientBackend::dispatch()
+{
+	// Defer sending until control returns to event loop, so that requests queued in the meantime are gathered into one write.
+	if (!m->sendTimer->isActive())
+		m->sendTimer->start();
+}
+
+bool NativeTCPClientBackend::proceedRequest()
+{
+	return m->socket->state() == QAbstractSocket::ConnectedState;
+}
+
+void NativeTCPClientBackend::open()
+{
+	if (m->socket->state() == QAbstractSocket::ConnectedState)
+		CUTEHMI_DEBUG("Ignoring request - already connected.");
+	else if (m->socket->state() == QAbstractSocket::HostLookupState || m->socket->state() == QAbstractSocket::ConnectingState)
+		CUTEHMI_DEBUG("Ignoring request - client is already trying to connect to the server.");
+	else if (m->socket->state() == QAbstractSocket::ClosingState) {
+		CUTEHMI_WARNING("Request ignored - client is currently proceeding with disconnect operation, which prevents it from initiating a connection to the server.");
+		emit errored(CUTEHMI_ERROR(tr("Client is currently proceeding with disconnect operation.")));
+	} else {
+		CUTEHMI_DEBUG("Client configured on '" << m->config->host() << ":" << m->config->port() << "'.");
+
+		m->socket->connectToHost(m->config->host(), static_cast<quint16>(m->config->port()));
+	}
+}
+
+void NativeTCPClientBackend::close()
+{
+	if (m->socket->state() == QAbstractSocket::UnconnectedState)
+		CUTEHMI_DEBUG("Ignoring request - already disconnected.");
+	else if (m->socket->state() == QAbstractSocket::ClosingState)
+		CUTEHMI_DEBUG("Ignoring request - client is already trying to disconnect.");
+	else
+		m->socket->disconnectFromHost();
+}
+
+void NativeTCPClientBackend::send()
+{
+	if (m->socket->state() != QAbstractSocket::ConnectedState)
+		return;
+
+	quint8 * begin = m->sendBuffer.data();
+	quint8 * adu = begin;
+	while (m->inFlightCount < IN_FLIGHT_CAPACITY && pendingTransactions() > 0) {
+		InFlight & slot = m->inFlight[m->nextTransactionId & (IN_FLIGHT_CAPACITY - 1)];
+		// Ring of transaction identifiers has caught up with a transaction, which is still waiting for response.
+		if (slot.busy)
+			break;
+
+		takeTransaction(slot.transaction);
+		slot.busy = true;
+		slot.transactionId = m->nextTransactionId++;
+		slot.sent = m->clock.elapsed();
+		slot.deadline = slot.sent + responseTimeout(slot.transaction.unit);
+		m->inFlightCount++;
+
+		PushWord(slot.transactionId, adu);
+		PushWord(0, adu);	// Protocol identifier.
+		PushWord(static_cast<quint16>(slot.transaction.pduSize + 1), adu);	// Length field counts unit identifier and PDU.
+		PushByte(slot.transaction.unit, adu);
+		adu = std::copy_n(slot.transaction.pdu.begin(), slot.transaction.pduSize, adu);
+	}
+
+	if (adu != begin) {
+		m->socket->write(reinterpret_cast<const char *>(begin), adu - begin);
+		m->socket->flush();
+
+		if (!m->sweepTimer->isActive())
+			m->sweepTimer->start();
+	}
+}
+
+void NativeTCPClientBackend::onReadyRead()
+{
+	quint8 * buffer = m->receiveBuffer.data();
+	qint64 count;
+	while ((count = m->socket->read(reinterpret_cast<char *>(buffer) + m->receiveSize, static_cast<qint64>(m->receiveBuffer.size()) - m->receiveSize)) > 0) {
+		m->receiveSize += static_cast<int>(count);
+
+		int parsed = parseResponses(buffer, m->receiveSize);
+		if (parsed < 0) {
+			emit errored(CUTEHMI_ERROR(tr("Received malformed MBAP header. Dropping the connection.")));
+			m->socket->abort();
+			return;
+		}
+
+		// Move incomplete frame to the beginning of the buffer.
+		m->receiveSize -= parsed;
+		if (parsed > 0 && m->receiveSize > 0)
+			std::memmove(buffer, buffer + parsed, static_cast<std::size_t>(m->receiveSize));
+	}
+
+	// Slots freed by responses can be reused right away.
+	if (pendingTransactions() > 0)
+		send();
+}
+
+void NativeTCPClientBackend::onStateChanged(QAbstractSocket::SocketState state)
+{
+	CUTEHMI_DEBUG("Client state changed to: '" << state << "'.");
+
+	switch (state) {
+		case QAbstractSocket::HostLookupState:
+		case QAbstractSocket::ConnectingState:
+			emit stateChanged(AbstractDevice::OPENING);
+			break;
+		case QAbstractSocket::ConnectedState:
+			m->socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+			m->receiveSize = 0;
+			emit stateChanged(AbstractDevice::OPENED);
+			emit opened();
+			break;
+		case QAbstractSocket::ClosingState:
+			emit stateChanged(AbstractDevice::CLOSING);
+			break;
+		case QAbstractSocket::UnconnectedState:
+			m->sendTimer->stop();
+			failInFlight(QModbusDevice::ReplyAbortedError, QT_TR_NOOP("Reply aborted."));
+			failPendingTransactions(QModbusDevice::ReplyAbortedError, QT_TR_NOOP("Reply aborted."));
+			emit stateChanged(AbstractDevice::CLOSED);
+			emit closed();
+			break;
+		default:
+			break;
+	}
+}
+
+void NativeTCPClientBackend::onErrorOccurred(QAbstractSocket::SocketError error)
+{
+	Q_UNUSED(error)
+
+	emit errored(CUTEHMI_ERROR(m->socket->errorString()));
+}
+
+void NativeTCPClientBackend::sweepTimedOut()
+{
+	qint64 now = m->clock.elapsed();
+	for (auto && slot : m->inFlight)
+		if (slot.busy && slot.deadline <= now) {
+			slot.busy = false;
+			m->inFlightCount--;
+			backOffResponseTimeout(slot.transaction.unit);
+			failTransaction(slot.transaction, QModbusDevice::TimeoutError, QT_TR_NOOP("Response timeout."));
+		}
+
+	if (m->inFlightCount == 0)
+		m->sweepTimer->stop();
+
+	if (pendingTransactions() > 0)
+		send();
+}
+
+int NativeTCPClientBackend::parseResponses(const quint8 * data, int size)
+{
+	int offset = 0;
+	while (size - offset >= MBAP_HEADER_SIZE) {
+		const quint8 * cursor = data + offset;
+		quint16 transactionId = PullWord(cursor);
+		quint16 protocolId = PullWord(cursor);
+		quint16 length = PullWord(cursor);
+		PullByte(cursor);	// Unit identifier is not verified, because some gateways do not echo it.
+		if (protocolId != 0 || length < 2 || length > MAX_PDU_SIZE + 1)
+			return -1;
+
+		int frameSize = MBAP_HEADER_SIZE - 1 + length;
+		if (size - offset < frameSize)
+			break;
+
+		InFlight & slot = m->inFlight[transactionId & (IN_FLIGHT_CAPACITY - 1)];
+		if (slot.busy && slot.transactionId == transactionId) {
+			slot.busy = false;
+			m->inFlightCount--;
+			sampleRoundTripTime(slot.transaction.unit, m->clock.elapsed() - slot.sent);
+			completeTransaction(slot.transaction, cursor, length - 1);
+		} else
+			CUTEHMI_WARNING("Discarding response with unexpected transaction identifier '" << transactionId << "'.");
+
+		offset += frameSize;
+	}
+	return offset;
+}
+
+void NativeTCPClientBackend::failInFlight(int error, const char * errorString)
+{
+	for (auto && slot : m->inFlight)
+		if (slot.busy) {
+			slot.busy = false;
+			failTransaction(slot.transaction, error, errorString);
+		}
+	m->inFlightCount = 0;
+	m->sweepTimer->stop();
+}
+
+}
+}
+}
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
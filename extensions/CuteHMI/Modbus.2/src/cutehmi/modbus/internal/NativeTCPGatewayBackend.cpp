@@ -1,35 +1,38 @@
-#include <cutehmi/modbus/internal/QtTCPClientBackend.hpp>
-
-#include <QModbusTcpClient>
+#include <cutehmi/modbus/internal/NativeTCPGatewayBackend.hpp>
 
 namespace cutehmi {
 namespace modbus {
 namespace internal {
 
-QtTCPClientBackend::QtTCPClientBackend(TCPClientConfig * config, QObject * parent):
-	QtClientBackend(std::make_unique<QModbusTcpClient>(), parent),
-	m(new Members(config))
+NativeTCPGatewayBackend::NativeTCPGatewayBackend(TCPClientConfig * config, QObject * parent):
+	NativeTCPClientBackend(config, parent),
+	m(new Members)
 {
 }
 
-int QtTCPClientBackend::slaveAddress() const
+void NativeTCPGatewayBackend::processUnitRequest(int unit, QJsonObject request)
 {
-	return m->config->slaveAddress();
+	// Unit is consumed synchronously, as transactions capture slaveAddress() at the moment they are queued.
+	m->unit = unit;
+	processRequest(request);
 }
 
-void QtTCPClientBackend::configureConnection()
+void NativeTCPGatewayBackend::processUnitDataRequest(int unit, DataRequest request)
 {
-	qClient()->setConnectionParameter(QModbusDevice::NetworkAddressParameter, m->config->host());
-	qClient()->setConnectionParameter(QModbusDevice::NetworkPortParameter, m->config->port());
+	m->unit = unit;
+	processDataRequest(request);
+}
 
-	CUTEHMI_DEBUG("Client configured on '" << m->config->host() << ":" << m->config->port() << "'.");
+int NativeTCPGatewayBackend::slaveAddress() const
+{
+	return m->unit;
 }
 
 }
 }
 }
 
-//(c)C: Copyright © 2019, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
 //(c)C: This file is a part of CuteHMI.
 //(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
 //(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
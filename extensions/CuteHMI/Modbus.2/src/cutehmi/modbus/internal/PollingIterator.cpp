@@ -6,6 +6,8 @@
 #include <cutehmi/modbus/internal/DiscreteInputPolling.hpp>
 #include <cutehmi/modbus/internal/InputRegisterPolling.hpp>
 
+#include <limits>
+
 namespace cutehmi {
 namespace modbus {
 namespace internal {
@@ -17,27 +19,41 @@ PollingIterator::PollingIterator(AbstractDevice * device):
 	m_tasks.emplace_back(std::unique_ptr<internal::IterableTasks>(new internal::DiscreteInputPolling(device, & m_requestId)));
 	m_tasks.emplace_back(std::unique_ptr<internal::IterableTasks>(new internal::HoldingRegisterPolling(device, & m_requestId)));
 	m_tasks.emplace_back(std::unique_ptr<internal::IterableTasks>(new internal::InputRegisterPolling(device, & m_requestId)));
-	m_currentTask = m_tasks.begin();
 }
 
 bool PollingIterator::runNext()
 {
-	while (m_currentTask != m_tasks.end()) {
-		if ((*m_currentTask)->runNext())
-			return true;
-		++m_currentTask;
+	TasksCointainer::iterator earliestTask = m_tasks.end();
+	qint64 earliestDeadline = std::numeric_limits<qint64>::max();
+	for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+		qint64 deadline = (*it)->nextDeadline();
+		if (deadline < earliestDeadline) {
+			earliestDeadline = deadline;
+			earliestTask = it;
+		}
 	}
-	return false;
+
+	if (earliestTask == m_tasks.end())
+		return false;
+
+	return (*earliestTask)->runNext();
 }
 
 void PollingIterator::reset()
 {
 	m_requestId = nullptr;
-	m_currentTask = m_tasks.begin();
 	for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it)
 		(*it)->reset();
 }
 
+qint64 PollingIterator::nextDeadline() const
+{
+	qint64 result = std::numeric_limits<qint64>::max();
+	for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it)
+		result = qMin(result, (*it)->nextDeadline());
+	return result;
+}
+
 QUuid & PollingIterator::requestId()
 {
 	return m_requestId;
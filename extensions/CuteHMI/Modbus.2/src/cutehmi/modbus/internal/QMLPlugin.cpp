@@ -2,6 +2,8 @@
 
 #include <cutehmi/modbus/TCPServer.hpp>
 #include <cutehmi/modbus/TCPClient.hpp>
+#include <cutehmi/modbus/TCPGateway.hpp>
+#include <cutehmi/modbus/TCPGatewayClient.hpp>
 #include <cutehmi/modbus/RTUClient.hpp>
 #include <cutehmi/modbus/RTUServer.hpp>
 #include <cutehmi/modbus/DummyClient.hpp>
@@ -9,6 +11,9 @@
 #include <cutehmi/modbus/HoldingRegisterController.hpp>
 #include <cutehmi/modbus/DiscreteInputController.hpp>
 #include <cutehmi/modbus/InputRegisterController.hpp>
+#include <cutehmi/modbus/HoldingMultiRegisterController.hpp>
+#include <cutehmi/modbus/InputMultiRegisterController.hpp>
+#include <cutehmi/modbus/IOThreadPool.hpp>
 
 #include <QtQml>
 
@@ -48,6 +53,21 @@ class DiscreteInputController: public cutehmi::modbus::DiscreteInputController {
  */
 class InputRegisterController: public cutehmi::modbus::InputRegisterController {};
 
+/**
+ * Exposes cutehmi::modbus::MultiRegisterController to QML.
+ */
+class MultiRegisterController: public cutehmi::modbus::MultiRegisterController {};
+
+/**
+ * Exposes cutehmi::modbus::HoldingMultiRegisterController to QML.
+ */
+class HoldingMultiRegisterController: public cutehmi::modbus::HoldingMultiRegisterController {};
+
+/**
+ * Exposes cutehmi::modbus::InputMultiRegisterController to QML.
+ */
+class InputMultiRegisterController: public cutehmi::modbus::InputMultiRegisterController {};
+
 /**
  * Exposes cutehmi::modbus::AbstractDevice to QML.
  */
@@ -73,6 +93,16 @@ class DummyClient: public cutehmi::modbus::DummyClient {};
  */
 class TCPClient: public cutehmi::modbus::TCPClient {};
 
+/**
+ * Exposes cutehmi::modbus::TCPGateway to QML.
+ */
+class TCPGateway: public cutehmi::modbus::TCPGateway {};
+
+/**
+ * Exposes cutehmi::modbus::TCPGatewayClient to QML.
+ */
+class TCPGatewayClient: public cutehmi::modbus::TCPGatewayClient {};
+
 /**
  * Exposes cutehmi::modbus::TCPServer to QML.
  */
@@ -88,6 +118,11 @@ class RTUClient: public cutehmi::modbus::RTUClient {};
  */
 class RTUServer: public cutehmi::modbus::RTUServer {};
 
+/**
+ * Exposes cutehmi::modbus::IOThreadPool to QML.
+ */
+class IOThreadPool: public cutehmi::modbus::IOThreadPool {};
+
 }
 }
 
@@ -109,16 +144,33 @@ void QMLPlugin::registerTypes(const char * uri)
 	qmlRegisterType<cutehmi::modbus::HoldingRegisterController>(uri, CUTEHMI_MODBUS_MAJOR, 0, "HoldingRegisterController");
 	qmlRegisterType<cutehmi::modbus::DiscreteInputController>(uri, CUTEHMI_MODBUS_MAJOR, 0, "DiscreteInputController");
 	qmlRegisterType<cutehmi::modbus::InputRegisterController>(uri, CUTEHMI_MODBUS_MAJOR, 0, "InputRegisterController");
+	qmlRegisterUncreatableType<cutehmi::modbus::MultiRegisterController>(uri, CUTEHMI_MODBUS_MAJOR, 0, "MultiRegisterController", "Class 'cutehmi::modbus::MultiRegisterController' is abstract and it can not be instantiated from QML.");
+	qmlRegisterType<cutehmi::modbus::HoldingMultiRegisterController>(uri, CUTEHMI_MODBUS_MAJOR, 0, "HoldingMultiRegisterController");
+	qmlRegisterType<cutehmi::modbus::InputMultiRegisterController>(uri, CUTEHMI_MODBUS_MAJOR, 0, "InputMultiRegisterController");
 
 	qmlRegisterUncreatableType<cutehmi::modbus::AbstractDevice>(uri, CUTEHMI_MODBUS_MAJOR, 0, "AbstractDevice", "Class 'cutehmi::modbus::AbstractDevice' is abstract and its instance can not be created from QML.");
 	qmlRegisterUncreatableType<cutehmi::modbus::AbstractClient>(uri, CUTEHMI_MODBUS_MAJOR, 0, "AbstractClient", "Class 'cutehmi::modbus::AbstractClient' is abstract and its instance can not be created from QML.");
 	qmlRegisterUncreatableType<cutehmi::modbus::AbstractServer>(uri, CUTEHMI_MODBUS_MAJOR, 0, "AbstractServer", "Class 'cutehmi::modbus::AbstractServer' is abstract and its instance can not be created from QML.");
+	qmlRegisterUncreatableType<cutehmi::modbus::DeviceMetrics>(uri, CUTEHMI_MODBUS_MAJOR, 0, "DeviceMetrics", "Class 'cutehmi::modbus::DeviceMetrics' instances are provided by devices and they can not be created from QML.");
 
 	qmlRegisterType<cutehmi::modbus::DummyClient>(uri, CUTEHMI_MODBUS_MAJOR, 0, "DummyClient");
 	qmlRegisterType<cutehmi::modbus::TCPClient>(uri, CUTEHMI_MODBUS_MAJOR, 0, "TCPClient");
+	qmlRegisterType<cutehmi::modbus::TCPGateway>(uri, CUTEHMI_MODBUS_MAJOR, 0, "TCPGateway");
+	qmlRegisterType<cutehmi::modbus::TCPGatewayClient>(uri, CUTEHMI_MODBUS_MAJOR, 0, "TCPGatewayClient");
 	qmlRegisterType<cutehmi::modbus::TCPServer>(uri, CUTEHMI_MODBUS_MAJOR, 0, "TCPServer");
 	qmlRegisterType<cutehmi::modbus::RTUClient>(uri, CUTEHMI_MODBUS_MAJOR, 0, "RTUClient");
 	qmlRegisterType<cutehmi::modbus::RTUServer>(uri, CUTEHMI_MODBUS_MAJOR, 0, "RTUServer");
+
+	qmlRegisterSingletonType<cutehmi::modbus::IOThreadPool>(uri, CUTEHMI_MODBUS_MAJOR, 0, "IOThreadPool", IOThreadPoolProvider);
+}
+
+QObject * QMLPlugin::IOThreadPoolProvider(QQmlEngine * engine, QJSEngine * scriptEngine)
+{
+	Q_UNUSED(scriptEngine)
+
+	cutehmi::modbus::IOThreadPool * ioThreadPool = & cutehmi::modbus::IOThreadPool::Instance();
+	engine->setObjectOwnership(ioThreadPool, QQmlEngine::CppOwnership);
+	return ioThreadPool;
 }
 
 }
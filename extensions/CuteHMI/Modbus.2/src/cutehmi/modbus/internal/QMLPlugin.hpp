@@ -3,6 +3,8 @@
 
 #include <QQmlExtensionPlugin>
 
+class QJSEngine;
+
 namespace cutehmi {
 namespace modbus {
 namespace internal {
@@ -15,6 +17,9 @@ class QMLPlugin:
 
 	public:
 		void registerTypes(const char * uri) override;
+
+	private:
+		static QObject * IOThreadPoolProvider(QQmlEngine * engine, QJSEngine * scriptEngine);
 };
 
 }
@@ -27,10 +27,8 @@ QModbusServer * QtServerBackend::qServer() const
 	return m->qServer;
 }
 
-bool QtServerBackend::proceedRequest(QUuid requestId)
+bool QtServerBackend::proceedRequest()
 {
-	Q_UNUSED(requestId)
-
 	return true;
 }
 
@@ -42,7 +40,7 @@ void QtServerBackend::readCoils(QUuid requestId, quint16 startAddress, quint16 e
 
 void QtServerBackend::writeCoil(QUuid requestId, quint16 address, bool value)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-2.workaround target="Qt" cause="design">
 	// QModbusServer::setData() uses 'quint16' as 'address' parameter, which makes it impossible to cover extended address
@@ -57,14 +55,14 @@ void QtServerBackend::writeCoil(QUuid requestId, quint16 address, bool value)
 	//</CuteHMI.Modbus-4.unsolved>
 
 	//</CuteHMI.Modbus-2.workaround>
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::writeMultipleCoils(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-4.unsolved target="Qt" cause="design">
 	// QModbusDataUnit uses `int` for address type. On systems, where `int` is 16 bit wide it will fail to cover whole Modbus
@@ -73,9 +71,9 @@ void QtServerBackend::writeMultipleCoils(QUuid requestId, quint16 startAddress,
 	m->qServer->setData(QModbusDataUnit(QModbusDataUnit::Coils, startAddress, values));
 	//</CuteHMI.Modbus-4.unsolved>
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::readDiscreteInputs(QUuid requestId, quint16 startAddress, quint16 endAddress)
@@ -86,7 +84,7 @@ void QtServerBackend::readDiscreteInputs(QUuid requestId, quint16 startAddress,
 
 void QtServerBackend::writeDiscreteInput(QUuid requestId, quint16 address, bool value)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-2.workaround target="Qt" cause="design">
 	// QModbusServer::setData() uses 'quint16' as 'address' parameter, which makes it impossible to cover extended address
@@ -101,14 +99,14 @@ void QtServerBackend::writeDiscreteInput(QUuid requestId, quint16 address, bool
 	//</CuteHMI.Modbus-4.unsolved>
 
 	//</CuteHMI.Modbus-2.workaround>
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::writeMultipleDiscreteInputs(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-4.unsolved target="Qt" cause="design">
 	// QModbusDataUnit uses `int` for address type. On systems, where `int` is 16 bit wide it will fail to cover whole Modbus
@@ -117,9 +115,9 @@ void QtServerBackend::writeMultipleDiscreteInputs(QUuid requestId, quint16 start
 	m->qServer->setData(QModbusDataUnit(QModbusDataUnit::DiscreteInputs, startAddress, values));
 	//</CuteHMI.Modbus-4.unsolved>
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::readHoldingRegisters(QUuid requestId, quint16 startAddress, quint16 endAddress)
@@ -130,7 +128,7 @@ void QtServerBackend::readHoldingRegisters(QUuid requestId, quint16 startAddress
 
 void QtServerBackend::writeHoldingRegister(QUuid requestId, quint16 address, quint16 value)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-2.workaround target="Qt" cause="design">
 	// QModbusServer::setData() uses 'quint16' as 'address' parameter, which makes it impossible to cover extended address
@@ -145,14 +143,14 @@ void QtServerBackend::writeHoldingRegister(QUuid requestId, quint16 address, qui
 	//</CuteHMI.Modbus-4.unsolved>
 
 	//</CuteHMI.Modbus-2.workaround>
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::writeMultipleHoldingRegisters(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-4.unsolved target="Qt" cause="design">
 	// QModbusDataUnit uses `int` for address type. On systems, where `int` is 16 bit wide it will fail to cover whole Modbus
@@ -161,9 +159,9 @@ void QtServerBackend::writeMultipleHoldingRegisters(QUuid requestId, quint16 sta
 	m->qServer->setData(QModbusDataUnit(QModbusDataUnit::HoldingRegisters, startAddress, values));
 	//</CuteHMI.Modbus-4.unsolved>
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::readInputRegisters(QUuid requestId, quint16 startAddress, quint16 endAddress)
@@ -174,7 +172,7 @@ void QtServerBackend::readInputRegisters(QUuid requestId, quint16 startAddress,
 
 void QtServerBackend::writeInputRegister(QUuid requestId, quint16 address, quint16 value)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-2.workaround target="Qt" cause="design">
 	// QModbusServer::setData() uses 'quint16' as 'address' parameter, which makes it impossible to cover extended address
@@ -189,14 +187,14 @@ void QtServerBackend::writeInputRegister(QUuid requestId, quint16 address, quint
 	//</CuteHMI.Modbus-4.unsolved>
 
 	//</CuteHMI.Modbus-2.workaround>
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::writeMultipleInputRegisters(QUuid requestId, quint16 startAddress, const QVector<quint16> & values)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	//<CuteHMI.Modbus-4.unsolved target="Qt" cause="design">
 	// QModbusDataUnit uses `int` for address type. On systems, where `int` is 16 bit wide it will fail to cover whole Modbus
@@ -205,9 +203,9 @@ void QtServerBackend::writeMultipleInputRegisters(QUuid requestId, quint16 start
 	m->qServer->setData(QModbusDataUnit(QModbusDataUnit::InputRegisters, startAddress, values));
 	//</CuteHMI.Modbus-4.unsolved>
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::open()
@@ -266,24 +264,24 @@ void QtServerBackend::setBusy(bool busy)
 
 void QtServerBackend::readDataUnitInt(QUuid requestId, QModbusDataUnit & unit)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	m->qServer->data(& unit);
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::readDataUnitBool(QUuid requestId, QModbusDataUnit & unit)
 {
-	QJsonObject reply;
+	DataReply reply;
 
 	m->qServer->data(& unit);
 
-	reply.insert("success", true);
+	reply.success = true;
 
-	emit replied(requestId, reply);
+	emit dataReplied(requestId, reply);
 }
 
 void QtServerBackend::onDataWritten(QModbusDataUnit::RegisterType table, int address, int size)
@@ -0,0 +1,284 @@
+#include <cutehmi/modbus/TCPClient.hpp>
+#include <cutehmi/modbus/TCPServer.hpp>
+#include <cutehmi/modbus/DummyClient.hpp>
+#include <cutehmi/modbus/HoldingRegisterController.hpp>
+
+#include <QtTest/QtTest>
+#include <QTcpServer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace cutehmi {
+namespace modbus {
+
+namespace {
+
+/**
+ * Polling driver. Driver runs polling cycles of a client in the same way as the state machine of a service does, except that it
+ * does not wait for polling timer, so that cycles are run back to back.
+ */
+template <class CLIENT>
+class PollingDriver:
+	public CLIENT
+{
+	public:
+		/**
+		 * Run single polling cycle.
+		 * @return @p true if cycle has finished within a timeout, @p false otherwise.
+		 */
+		bool runPollingCycle()
+		{
+			QEventLoop loop;
+			QTimer timeout;
+			timeout.setSingleShot(true);
+			QObject::connect(& timeout, & QTimer::timeout, & loop, [& loop]() {
+				loop.exit(1);
+			});
+			QObject::connect(this, & PollingDriver::pollingFinished, & loop, & QEventLoop::quit, Qt::QueuedConnection);
+			QMetaObject::Connection taskConnection = QObject::connect(this, & PollingDriver::pollingTaskFinished, this, [this]() {
+				this->pollingTask();
+			}, Qt::QueuedConnection);
+
+			this->poll();
+			this->pollingTask();
+			timeout.start(CYCLE_TIMEOUT);
+			int result = loop.exec();
+
+			QObject::disconnect(taskConnection);
+			return result == 0;
+		}
+
+	private:
+		static constexpr int CYCLE_TIMEOUT = 10000;
+};
+
+}
+
+/**
+ * Polling benchmark. Benchmark polls holding register controllers of a client with back to back polling cycles and measures
+ * request rate, end-to-end latency and CPU time per request for various numbers of controllers, registers per request and
+ * in-flight depths. TCPClient is driven against a local TCPServer, which runs in the same process, thus CPU time includes server
+ * side. DummyClient rows measure client side overhead alone.
+ *
+ * Results are logged as compact JSON objects (one per data row). If CUTEHMI_MODBUS_BENCHMARK_OUTPUT environment variable is set,
+ * they are also collected into a JSON array and written to a file given by the variable. Amount of requests issued per data row
+ * can be adjusted with CUTEHMI_MODBUS_BENCHMARK_REQUESTS environment variable.
+ *
+ * Benchmark is not built by default. Set @p buildBenchmarks project property to build it.
+ */
+class benchmark_Polling:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void initTestCase();
+
+		void cleanupTestCase();
+
+		void tcpClient_data();
+
+		void tcpClient();
+
+		void dummyClient_data();
+
+		void dummyClient();
+
+	private:
+		static constexpr int DEFAULT_REQUESTS = 2000;
+
+		void pollingData();
+
+		template <class CLIENT>
+		void measure(PollingDriver<CLIENT> & client);
+
+		int m_requests = DEFAULT_REQUESTS;
+		QJsonArray m_results;
+};
+
+void benchmark_Polling::initTestCase()
+{
+	bool ok;
+	int requests = qEnvironmentVariableIntValue("CUTEHMI_MODBUS_BENCHMARK_REQUESTS", & ok);
+	if (ok && requests > 0)
+		m_requests = requests;
+}
+
+void benchmark_Polling::cleanupTestCase()
+{
+	QString fileName = qEnvironmentVariable("CUTEHMI_MODBUS_BENCHMARK_OUTPUT");
+	if (fileName.isEmpty())
+		return;
+
+	QFile file(fileName);
+	if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		file.write(QJsonDocument(m_results).toJson());
+		qInfo() << "Benchmark results have been written to" << QFileInfo(file).absoluteFilePath();
+	} else
+		qWarning() << "Could not write benchmark results to" << fileName;
+}
+
+void benchmark_Polling::pollingData()
+{
+	QTest::addColumn<int>("controllers");
+	QTest::addColumn<int>("maxRead");
+	QTest::addColumn<int>("inFlight");
+
+	for (int controllers : {16, 256, 2048})
+		for (int maxRead : {1, 16, 123})
+			for (int inFlight : {1, 4, 16}) {
+				// Skip rows, in which polling cycle would be too long to fit reasonable amount of cycles in request budget.
+				if (controllers / maxRead > 256)
+					continue;
+				QTest::addRow("controllers=%d maxRead=%d inFlight=%d", controllers, maxRead, inFlight) << controllers << maxRead << inFlight;
+			}
+}
+
+void benchmark_Polling::tcpClient_data()
+{
+	pollingData();
+}
+
+void benchmark_Polling::tcpClient()
+{
+	QFETCH(int, controllers);
+	QFETCH(int, maxRead);
+	QFETCH(int, inFlight);
+
+	// Find free port.
+	QTcpServer portProbe;
+	QVERIFY(portProbe.listen(QHostAddress::LocalHost));
+	int port = portProbe.serverPort();
+	portProbe.close();
+
+	TCPServer server;
+	server.setHost("127.0.0.1");
+	server.setPort(port);
+	QSignalSpy serverStartedSpy(& server, & AbstractDevice::started);
+	server.open();
+	QVERIFY(serverStartedSpy.count() == 1 || serverStartedSpy.wait());
+
+	PollingDriver<TCPClient> client;
+	client.setHost("127.0.0.1");
+	client.setPort(port);
+	client.setMaxReadHoldingRegisters(maxRead);
+	client.setMaxInFlight(inFlight);
+	// Each controller issues initial read as soon as client becomes ready.
+	client.setMaxRequests(qMax(AbstractDevice::INITIAL_MAX_REQUESTS, 2 * controllers));
+
+	std::vector<std::unique_ptr<HoldingRegisterController>> registerControllers;
+	for (int i = 0; i < controllers; i++) {
+		registerControllers.emplace_back(new HoldingRegisterController);
+		registerControllers.back()->setAddress(static_cast<unsigned int>(i));
+		registerControllers.back()->setDevice(& client);
+	}
+
+	QSignalSpy clientStartedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(clientStartedSpy.count() == 1 || clientStartedSpy.wait());
+
+	measure(client);
+
+	client.close();
+	server.close();
+}
+
+void benchmark_Polling::dummyClient_data()
+{
+	pollingData();
+}
+
+void benchmark_Polling::dummyClient()
+{
+	QFETCH(int, controllers);
+	QFETCH(int, maxRead);
+	QFETCH(int, inFlight);
+
+	PollingDriver<DummyClient> client;
+	client.setLatency(0);
+	client.setConnectLatency(0);
+	client.setMaxReadHoldingRegisters(maxRead);
+	client.setMaxInFlight(inFlight);
+	// Each controller issues initial read as soon as client becomes ready.
+	client.setMaxRequests(qMax(AbstractDevice::INITIAL_MAX_REQUESTS, 2 * controllers));
+
+	std::vector<std::unique_ptr<HoldingRegisterController>> registerControllers;
+	for (int i = 0; i < controllers; i++) {
+		registerControllers.emplace_back(new HoldingRegisterController);
+		registerControllers.back()->setAddress(static_cast<unsigned int>(i));
+		registerControllers.back()->setDevice(& client);
+	}
+
+	QSignalSpy clientStartedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(clientStartedSpy.count() == 1 || clientStartedSpy.wait());
+
+	measure(client);
+
+	client.close();
+}
+
+template <class CLIENT>
+void benchmark_Polling::measure(PollingDriver<CLIENT> & client)
+{
+	QFETCH(int, controllers);
+	QFETCH(int, maxRead);
+	QFETCH(int, inFlight);
+
+	// Warm up, so that initial reads issued by controllers do not interfere with measurements and polling plan gets built.
+	QVERIFY(client.runPollingCycle());
+	QVERIFY(client.runPollingCycle());
+	client.metrics()->reset();
+
+	QElapsedTimer wallClock;
+	wallClock.start();
+	std::clock_t cpuStart = std::clock();
+	int cycles = 0;
+	while (client.metrics()->counters().requests < static_cast<quint32>(m_requests)) {
+		QVERIFY(client.runPollingCycle());
+		cycles++;
+	}
+	std::clock_t cpuEnd = std::clock();
+	qint64 wallTime = wallClock.nsecsElapsed();
+
+	DeviceMetrics::Counters counters = client.metrics()->counters();
+	QCOMPARE(counters.errors, 0u);
+
+	qreal seconds = static_cast<qreal>(wallTime) / 1.0e9;
+	qreal cpuSeconds = static_cast<qreal>(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+	QJsonObject result;
+	result.insert("benchmark", QTest::currentTestFunction());
+	result.insert("row", QTest::currentDataTag());
+	result.insert("controllers", controllers);
+	result.insert("maxRead", maxRead);
+	result.insert("inFlight", inFlight);
+	result.insert("cycles", cycles);
+	result.insert("requests", static_cast<qint64>(counters.requests));
+	result.insert("requestsPerSecond", counters.requests / seconds);
+	result.insert("cyclesPerSecond", cycles / seconds);
+	result.insert("latencyP50", client.metrics()->latencyPercentile(50.0));
+	result.insert("latencyP99", client.metrics()->latencyPercentile(99.0));
+	result.insert("latencyMax", client.metrics()->latencyPercentile(100.0));
+	result.insert("cpuPerRequest", cpuSeconds * 1.0e6 / counters.requests);
+	m_results.append(result);
+
+	qInfo().noquote() << QJsonDocument(result).toJson(QJsonDocument::Compact);
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::benchmark_Polling)
+#include "benchmark_Polling.moc"
+
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,63 @@
+#include <cutehmi/modbus/DummyClient.hpp>
+#include <cutehmi/modbus/HoldingRegisterController.hpp>
+
+#include <QtTest/QtTest>
+
+namespace cutehmi {
+namespace modbus {
+
+class test_AbstractDevice:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void requestUpdatesControllers();
+};
+
+void test_AbstractDevice::requestUpdatesControllers()
+{
+	static constexpr quint16 ADDRESS = 10;
+
+	DummyClient client;
+	client.setLatency(0);
+	client.setConnectLatency(0);
+
+	HoldingRegisterController controller;
+	controller.setAddress(ADDRESS);
+	controller.setDevice(& client);
+
+	QSignalSpy startedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+	// Wait for initial read issued by the controller.
+	QTRY_VERIFY(!controller.busy());
+	QCOMPARE(controller.value(), 0.0);
+
+	// Controller does not react to writes issued by someone else.
+	QSignalSpy completedSpy(& client, & AbstractDevice::requestCompleted);
+	client.requestWriteHoldingRegister(ADDRESS, 42);
+	QVERIFY(completedSpy.wait());
+	QVERIFY(completedSpy.at(0).at(1).toJsonObject().value("success").toBool());
+	QCOMPARE(controller.value(), 0.0);
+
+	// Read issued through JSON facade must refresh controller, without waiting for polling.
+	client.requestReadHoldingRegisters(ADDRESS, 1);
+	QVERIFY(completedSpy.wait());
+	QVERIFY(completedSpy.at(1).at(1).toJsonObject().value("success").toBool());
+	QTRY_COMPARE(controller.value(), 42.0);
+
+	client.close();
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::test_AbstractDevice)
+#include "test_AbstractDevice.moc"
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,134 @@
+#include <cutehmi/modbus/DeviceMetrics.hpp>
+#include <cutehmi/modbus/AbstractDevice.hpp>
+
+#include <QtTest/QtTest>
+#include <QModbusDevice>
+
+namespace cutehmi {
+namespace modbus {
+
+class test_DeviceMetrics:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void buckets();
+
+		void counters();
+
+		void latencyPercentile();
+
+		void update();
+};
+
+void test_DeviceMetrics::buckets()
+{
+	// Small latencies are recorded exactly.
+	for (qint64 latency = 0; latency < DeviceMetrics::SUB_BUCKET_COUNT; latency++)
+		QCOMPARE(DeviceMetrics::BucketUpperBound(DeviceMetrics::BucketIndex(latency)), latency);
+
+	// Bucket of each latency must contain it and relative error must be bounded by bucket resolution.
+	for (qint64 latency = 1; latency < (Q_INT64_C(1) << DeviceMetrics::MAX_LATENCY_BITS); latency = latency * 3 / 2 + 1) {
+		int index = DeviceMetrics::BucketIndex(latency);
+		QVERIFY(index >= 0 && index < DeviceMetrics::BUCKET_COUNT);
+		QVERIFY(DeviceMetrics::BucketUpperBound(index) >= latency);
+		QVERIFY(index == 0 || DeviceMetrics::BucketUpperBound(index - 1) < latency);
+		QVERIFY(DeviceMetrics::BucketUpperBound(index) - latency <= latency / DeviceMetrics::SUB_BUCKET_COUNT);
+	}
+
+	// Latencies out of range are clamped.
+	QCOMPARE(DeviceMetrics::BucketIndex(-1), 0);
+	QCOMPARE(DeviceMetrics::BucketIndex(Q_INT64_C(1) << 40), DeviceMetrics::BUCKET_COUNT - 1);
+	QCOMPARE(DeviceMetrics::BucketUpperBound(DeviceMetrics::BUCKET_COUNT - 1), (Q_INT64_C(1) << DeviceMetrics::MAX_LATENCY_BITS) - 1);
+}
+
+void test_DeviceMetrics::counters()
+{
+	DeviceMetrics metrics;
+	metrics.record(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS, 1000, true);
+	metrics.record(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS, 1000, false, QModbusDevice::TimeoutError);
+	metrics.record(AbstractDevice::FUNCTION_WRITE_COIL, 1000, false, QModbusDevice::ProtocolError, 2);
+	metrics.record(AbstractDevice::FUNCTION_REPORT_SLAVE_ID, 1000, true);
+
+	DeviceMetrics::Counters all = metrics.counters();
+	QCOMPARE(all.requests, 4u);
+	QCOMPARE(all.errors, 2u);
+	QCOMPARE(all.timeouts, 1u);
+	QCOMPARE(all.exceptions, 1u);
+
+	DeviceMetrics::Counters read = metrics.counters(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS);
+	QCOMPARE(read.requests, 2u);
+	QCOMPARE(read.errors, 1u);
+	QCOMPARE(read.timeouts, 1u);
+	QCOMPARE(read.exceptions, 0u);
+
+	QCOMPARE(metrics.counters(AbstractDevice::FUNCTION_READ_COILS).requests, 0u);
+	QCOMPARE(metrics.exceptionCodeCount(2), 1u);
+	QCOMPARE(metrics.exceptionCodeCount(3), 0u);
+	QCOMPARE(metrics.exceptionCodeCount(-1), 0u);
+
+	metrics.reset();
+	QCOMPARE(metrics.counters().requests, 0u);
+	QCOMPARE(metrics.exceptionCodeCount(2), 0u);
+}
+
+void test_DeviceMetrics::latencyPercentile()
+{
+	DeviceMetrics metrics;
+	QCOMPARE(metrics.latencyPercentile(50.0), 0.0);
+
+	for (qint64 latency = 1; latency <= 100; latency++)
+		metrics.record(AbstractDevice::FUNCTION_READ_INPUT_REGISTERS, latency * 1000, true);
+	metrics.record(AbstractDevice::FUNCTION_WRITE_HOLDING_REGISTER, 500000, true);
+
+	// Percentiles are reported with relative error bounded by bucket resolution.
+	qreal tolerance = 1.0 / DeviceMetrics::SUB_BUCKET_COUNT;
+	qreal p50 = metrics.latencyPercentile(50.0, AbstractDevice::FUNCTION_READ_INPUT_REGISTERS);
+	QVERIFY(p50 >= 50.0 && p50 <= 50.0 * (1.0 + tolerance));
+	qreal p99 = metrics.latencyPercentile(99.0, AbstractDevice::FUNCTION_READ_INPUT_REGISTERS);
+	QVERIFY(p99 >= 99.0 && p99 <= 99.0 * (1.0 + tolerance));
+	qreal max = metrics.latencyPercentile(100.0);
+	QVERIFY(max >= 500.0 && max <= 500.0 * (1.0 + tolerance));
+}
+
+void test_DeviceMetrics::update()
+{
+	DeviceMetrics metrics;
+	metrics.setUpdateInterval(0);
+	QSignalSpy updatedSpy(& metrics, & DeviceMetrics::updated);
+
+	metrics.record(AbstractDevice::FUNCTION_READ_COILS, 2000, true);
+	metrics.record(AbstractDevice::FUNCTION_READ_COILS, 4000, false, QModbusDevice::TimeoutError);
+	QCOMPARE(metrics.requestCount(), 0u);
+
+	QMetaObject::invokeMethod(& metrics, "update");
+	QCOMPARE(updatedSpy.count(), 1);
+	QCOMPARE(metrics.requestCount(), 2u);
+	QCOMPARE(metrics.errorCount(), 1u);
+	QCOMPARE(metrics.timeoutCount(), 1u);
+	QCOMPARE(metrics.latencyP50(), DeviceMetrics::BucketUpperBound(DeviceMetrics::BucketIndex(2000)) / 1000.0);
+	QCOMPARE(metrics.latencyMax(), DeviceMetrics::BucketUpperBound(DeviceMetrics::BucketIndex(4000)) / 1000.0);
+
+	// Latencies are computed over last interval only.
+	metrics.record(AbstractDevice::FUNCTION_READ_COILS, 1000, true);
+	QMetaObject::invokeMethod(& metrics, "update");
+	QCOMPARE(metrics.requestCount(), 3u);
+	QCOMPARE(metrics.latencyMax(), DeviceMetrics::BucketUpperBound(DeviceMetrics::BucketIndex(1000)) / 1000.0);
+
+	QMetaObject::invokeMethod(& metrics, "update");
+	QCOMPARE(metrics.latencyMax(), 0.0);
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::test_DeviceMetrics)
+#include "test_DeviceMetrics.moc"
+
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
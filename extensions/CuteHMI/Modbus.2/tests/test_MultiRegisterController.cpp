@@ -0,0 +1,111 @@
+#include <cutehmi/modbus/MultiRegisterController.hpp>
+
+#include <QtTest/QtTest>
+
+#include <array>
+
+namespace cutehmi {
+namespace modbus {
+
+typedef std::array<quint16, MultiRegisterController::MAX_REGISTERS> Words;
+
+}
+}
+
+Q_DECLARE_METATYPE(cutehmi::modbus::Words)
+
+namespace cutehmi {
+namespace modbus {
+
+class test_MultiRegisterController:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void decode_data();
+
+		void decode();
+
+		void encode_data();
+
+		void encode();
+
+		void roundTrip();
+};
+
+void test_MultiRegisterController::decode_data()
+{
+	QTest::addColumn<int>("encoding");
+	QTest::addColumn<int>("byteOrder");
+	QTest::addColumn<int>("wordOrder");
+	QTest::addColumn<Words>("words");
+	QTest::addColumn<qreal>("value");
+
+	QTest::newRow("uint32") << int(MultiRegisterController::UINT32) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::HIGH_WORD_FIRST) << Words{0x1234, 0x5678} << qreal(0x12345678);
+	QTest::newRow("uint32 low word first") << int(MultiRegisterController::UINT32) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::LOW_WORD_FIRST) << Words{0x5678, 0x1234} << qreal(0x12345678);
+	QTest::newRow("uint32 low byte first") << int(MultiRegisterController::UINT32) << int(MultiRegisterController::LOW_BYTE_FIRST) << int(MultiRegisterController::HIGH_WORD_FIRST) << Words{0x3412, 0x7856} << qreal(0x12345678);
+	QTest::newRow("uint32 reversed") << int(MultiRegisterController::UINT32) << int(MultiRegisterController::LOW_BYTE_FIRST) << int(MultiRegisterController::LOW_WORD_FIRST) << Words{0x7856, 0x3412} << qreal(0x12345678);
+	QTest::newRow("int32") << int(MultiRegisterController::INT32) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::HIGH_WORD_FIRST) << Words{0xFFFF, 0xFFFE} << qreal(-2);
+	QTest::newRow("float32") << int(MultiRegisterController::FLOAT32) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::HIGH_WORD_FIRST) << Words{0x3F80, 0x0000} << qreal(1.0);
+	QTest::newRow("float32 low word first") << int(MultiRegisterController::FLOAT32) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::LOW_WORD_FIRST) << Words{0x0000, 0xC020} << qreal(-2.5);
+	QTest::newRow("int64") << int(MultiRegisterController::INT64) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::HIGH_WORD_FIRST) << Words{0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF} << qreal(-1);
+	QTest::newRow("uint64") << int(MultiRegisterController::UINT64) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::HIGH_WORD_FIRST) << Words{0x0000, 0x0001, 0x0000, 0x0000} << qreal(Q_UINT64_C(0x100000000));
+	QTest::newRow("float64") << int(MultiRegisterController::FLOAT64) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::HIGH_WORD_FIRST) << Words{0x3FF0, 0x0000, 0x0000, 0x0000} << qreal(1.0);
+	QTest::newRow("float64 low word first") << int(MultiRegisterController::FLOAT64) << int(MultiRegisterController::HIGH_BYTE_FIRST) << int(MultiRegisterController::LOW_WORD_FIRST) << Words{0x0000, 0x0000, 0x0000, 0x3FF0} << qreal(1.0);
+}
+
+void test_MultiRegisterController::decode()
+{
+	QFETCH(int, encoding);
+	QFETCH(int, byteOrder);
+	QFETCH(int, wordOrder);
+	QFETCH(Words, words);
+	QFETCH(qreal, value);
+
+	QCOMPARE(MultiRegisterController::Decode(words.data(), static_cast<MultiRegisterController::Encoding>(encoding),
+			static_cast<MultiRegisterController::ByteOrder>(byteOrder), static_cast<MultiRegisterController::WordOrder>(wordOrder)), value);
+}
+
+void test_MultiRegisterController::encode_data()
+{
+	decode_data();
+}
+
+void test_MultiRegisterController::encode()
+{
+	QFETCH(int, encoding);
+	QFETCH(int, byteOrder);
+	QFETCH(int, wordOrder);
+	QFETCH(Words, words);
+	QFETCH(qreal, value);
+
+	Words encoded {};
+	MultiRegisterController::Encode(value, static_cast<MultiRegisterController::Encoding>(encoding),
+			static_cast<MultiRegisterController::ByteOrder>(byteOrder), static_cast<MultiRegisterController::WordOrder>(wordOrder), encoded.data());
+	QVERIFY(encoded == words);
+}
+
+void test_MultiRegisterController::roundTrip()
+{
+	// Value, which is not exactly representable in single precision, should survive round trip in double precision only.
+	Words words {};
+	MultiRegisterController::Encode(0.1, MultiRegisterController::FLOAT64, MultiRegisterController::LOW_BYTE_FIRST, MultiRegisterController::LOW_WORD_FIRST, words.data());
+	QCOMPARE(MultiRegisterController::Decode(words.data(), MultiRegisterController::FLOAT64, MultiRegisterController::LOW_BYTE_FIRST, MultiRegisterController::LOW_WORD_FIRST), 0.1);
+
+	MultiRegisterController::Encode(0.1, MultiRegisterController::FLOAT32, MultiRegisterController::HIGH_BYTE_FIRST, MultiRegisterController::HIGH_WORD_FIRST, words.data());
+	QCOMPARE(MultiRegisterController::Decode(words.data(), MultiRegisterController::FLOAT32, MultiRegisterController::HIGH_BYTE_FIRST, MultiRegisterController::HIGH_WORD_FIRST), static_cast<qreal>(0.1f));
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::test_MultiRegisterController)
+#include "test_MultiRegisterController.moc"
+
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,375 @@
+#include <cutehmi/modbus/RTUClient.hpp>
+#include <cutehmi/modbus/internal/DataRequest.hpp>
+#include <cutehmi/modbus/internal/NativeRTUClientBackend.hpp>
+
+#include <QtTest/QtTest>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+namespace cutehmi {
+namespace modbus {
+
+namespace {
+
+#ifdef Q_OS_UNIX
+
+/**
+ * Fake Modbus RTU slave listening on a master side of pseudoterminal. Slave answers read holding registers requests with
+ * registers containing their addresses and responds with illegal function exception to any other request. Broadcast requests
+ * are counted, but not responded to.
+ */
+class PseudoterminalSlave
+{
+	public:
+		static constexpr int SLAVE_ADDRESS = 1;
+
+		PseudoterminalSlave():
+			m_fd(posix_openpt(O_RDWR | O_NOCTTY)),
+			m_stop(false),
+			m_broadcasts(0)
+		{
+			if (m_fd >= 0 && grantpt(m_fd) == 0 && unlockpt(m_fd) == 0)
+				m_portName = QString::fromLocal8Bit(ptsname(m_fd));
+		}
+
+		~PseudoterminalSlave()
+		{
+			stop();
+			if (m_fd >= 0)
+				::close(m_fd);
+		}
+
+		QString portName() const
+		{
+			return m_portName;
+		}
+
+		void start()
+		{
+			m_thread = std::thread(& PseudoterminalSlave::run, this);
+		}
+
+		void stop()
+		{
+			m_stop = true;
+			if (m_thread.joinable())
+				m_thread.join();
+		}
+
+		/**
+		 * Get gaps between the end of each response and the beginning of subsequent request.
+		 * @return list of gaps.
+		 */
+		std::vector<std::chrono::microseconds> gaps() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_gaps;
+		}
+
+		/**
+		 * Get amount of received broadcast requests.
+		 * @return amount of broadcast requests.
+		 */
+		int broadcasts() const
+		{
+			return m_broadcasts;
+		}
+
+		static quint16 CRC16(const quint8 * data, int size)
+		{
+			quint16 crc = 0xFFFF;
+			for (int i = 0; i < size; i++) {
+				crc ^= data[i];
+				for (int bit = 0; bit < 8; bit++)
+					crc = crc & 1 ? static_cast<quint16>(crc >> 1 ^ 0xA001) : static_cast<quint16>(crc >> 1);
+			}
+			return crc;
+		}
+
+	private:
+		static constexpr int REQUEST_SIZE = 8;	// All the requests issued by test functions are 8 bytes long.
+
+		void run()
+		{
+			std::chrono::steady_clock::time_point lastResponse;
+			bool responded = false;
+			quint8 request[REQUEST_SIZE];
+			int received = 0;
+			while (!m_stop) {
+				pollfd descriptor {m_fd, POLLIN, 0};
+				if (poll(& descriptor, 1, 20) <= 0 || !(descriptor.revents & POLLIN))
+					continue;
+
+				ssize_t count = ::read(m_fd, request + received, static_cast<std::size_t>(REQUEST_SIZE - received));
+				if (count <= 0)
+					continue;
+
+				if (received == 0 && responded) {
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_gaps.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lastResponse));
+				}
+				received += static_cast<int>(count);
+				if (received < REQUEST_SIZE)
+					continue;
+				received = 0;
+
+				if (CRC16(request, REQUEST_SIZE - 2) != (request[REQUEST_SIZE - 2] | request[REQUEST_SIZE - 1] << 8))
+					continue;
+
+				if (request[0] == 0) {
+					m_broadcasts++;
+					continue;
+				}
+
+				respond(request);
+				lastResponse = std::chrono::steady_clock::now();
+				responded = true;
+			}
+		}
+
+		void respond(const quint8 * request)
+		{
+			quint8 response[256];
+			int size = 0;
+			response[size++] = request[0];
+			if (request[1] == AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS) {
+				quint16 address = static_cast<quint16>(request[2] << 8 | request[3]);
+				quint16 amount = static_cast<quint16>(request[4] << 8 | request[5]);
+				response[size++] = request[1];
+				response[size++] = static_cast<quint8>(amount * 2);
+				for (quint16 i = 0; i < amount; i++) {
+					response[size++] = static_cast<quint8>((address + i) >> 8);
+					response[size++] = static_cast<quint8>(address + i);
+				}
+			} else {
+				response[size++] = static_cast<quint8>(request[1] | 0x80);
+				response[size++] = 0x01;	// Illegal function.
+			}
+			quint16 crc = CRC16(response, size);
+			response[size++] = static_cast<quint8>(crc);
+			response[size++] = static_cast<quint8>(crc >> 8);
+
+			if (::write(m_fd, response, static_cast<std::size_t>(size)) != size)
+				qWarning("Slave could not write a response.");
+		}
+
+		int m_fd;
+		QString m_portName;
+		std::atomic<bool> m_stop;
+		std::atomic<int> m_broadcasts;
+		std::thread m_thread;
+		mutable std::mutex m_mutex;
+		std::vector<std::chrono::microseconds> m_gaps;
+};
+
+#endif
+
+}
+
+class test_RTUClient:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void readHoldingRegisters();
+
+		void backToBackRequests();
+
+		void exceptionResponse();
+
+		void broadcast();
+
+		void deadbandFirstRead();
+};
+
+void test_RTUClient::readHoldingRegisters()
+{
+#ifdef Q_OS_UNIX
+	PseudoterminalSlave slave;
+	QVERIFY(!slave.portName().isEmpty());
+	slave.start();
+
+	RTUClient client;
+	client.setPort(slave.portName());
+	client.setSlaveAddress(PseudoterminalSlave::SLAVE_ADDRESS);
+	QSignalSpy startedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+
+	QSignalSpy completedSpy(& client, & AbstractDevice::requestCompleted);
+	client.requestReadHoldingRegisters(10, 3);
+	QVERIFY(completedSpy.wait());
+
+	QJsonObject reply = completedSpy.at(0).at(1).toJsonObject();
+	QVERIFY(reply.value("success").toBool());
+	QCOMPARE(reply.value("values").toArray(), QJsonArray({10, 11, 12}));
+
+	client.close();
+#else
+	QSKIP("Pseudoterminals are not available on this platform.");
+#endif
+}
+
+void test_RTUClient::backToBackRequests()
+{
+#ifdef Q_OS_UNIX
+	static constexpr int REQUESTS = 8;
+
+	PseudoterminalSlave slave;
+	QVERIFY(!slave.portName().isEmpty());
+	slave.start();
+
+	RTUClient client;
+	client.setPort(slave.portName());
+	client.setBaudRate(QSerialPort::Baud9600);
+	client.setSlaveAddress(PseudoterminalSlave::SLAVE_ADDRESS);
+	QSignalSpy startedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+
+	QSignalSpy completedSpy(& client, & AbstractDevice::requestCompleted);
+	for (int i = 0; i < REQUESTS; i++)
+		client.requestReadHoldingRegisters(static_cast<quint16>(i), 1);
+	QTRY_COMPARE_WITH_TIMEOUT(completedSpy.count(), REQUESTS, 5000);
+
+	for (int i = 0; i < REQUESTS; i++) {
+		QJsonObject reply = completedSpy.at(i).at(1).toJsonObject();
+		QVERIFY(reply.value("success").toBool());
+	}
+
+	// At 9600 baud 3.5 character times of 11 bits last approximately 4 ms.
+	std::vector<std::chrono::microseconds> gaps = slave.gaps();
+	QCOMPARE(static_cast<int>(gaps.size()), REQUESTS - 1);
+	for (auto gap : gaps)
+		QVERIFY2(gap >= std::chrono::microseconds(4000), qPrintable(QString("Gap of %1 us is shorter than silent interval.").arg(gap.count())));
+
+	client.close();
+#else
+	QSKIP("Pseudoterminals are not available on this platform.");
+#endif
+}
+
+void test_RTUClient::exceptionResponse()
+{
+#ifdef Q_OS_UNIX
+	PseudoterminalSlave slave;
+	QVERIFY(!slave.portName().isEmpty());
+	slave.start();
+
+	RTUClient client;
+	client.setPort(slave.portName());
+	client.setSlaveAddress(PseudoterminalSlave::SLAVE_ADDRESS);
+	QSignalSpy startedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+
+	QSignalSpy completedSpy(& client, & AbstractDevice::requestCompleted);
+	client.requestReadCoils(0, 8);
+	QVERIFY(completedSpy.wait());
+
+	QJsonObject reply = completedSpy.at(0).at(1).toJsonObject();
+	QVERIFY(!reply.value("success").toBool());
+	QCOMPARE(reply.value("protocolErrorCode").toInt(), 1);
+
+	client.close();
+#else
+	QSKIP("Pseudoterminals are not available on this platform.");
+#endif
+}
+
+void test_RTUClient::broadcast()
+{
+#ifdef Q_OS_UNIX
+	PseudoterminalSlave slave;
+	QVERIFY(!slave.portName().isEmpty());
+	slave.start();
+
+	RTUClient client;
+	client.setPort(slave.portName());
+	client.setSlaveAddress(0);
+	QSignalSpy startedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+
+	QSignalSpy completedSpy(& client, & AbstractDevice::requestCompleted);
+	QElapsedTimer timer;
+	timer.start();
+	client.requestWriteHoldingRegister(10, 42);
+	QVERIFY(completedSpy.wait());
+
+	// Transaction should complete after turnaround delay, without waiting for response timeout.
+	QVERIFY(timer.elapsed() >= internal::NativeRTUClientBackend::BROADCAST_TURNAROUND_DELAY);
+	QVERIFY(timer.elapsed() < internal::NativeRTUClientBackend::RESPONSE_TIMEOUT);
+	QVERIFY(completedSpy.at(0).at(1).toJsonObject().value("success").toBool());
+	QCOMPARE(slave.broadcasts(), 1);
+
+	// Read functions can not be broadcast.
+	client.requestReadHoldingRegisters(10, 1);
+	QTRY_COMPARE(completedSpy.count(), 2);
+	QVERIFY(!completedSpy.at(1).at(1).toJsonObject().value("success").toBool());
+	QCOMPARE(slave.broadcasts(), 1);
+
+	// Line should be released for requests addressed to particular slave.
+	client.setSlaveAddress(PseudoterminalSlave::SLAVE_ADDRESS);
+	client.requestReadHoldingRegisters(10, 1);
+	QTRY_COMPARE(completedSpy.count(), 3);
+	QVERIFY(completedSpy.at(2).at(1).toJsonObject().value("success").toBool());
+
+	client.close();
+#else
+	QSKIP("Pseudoterminals are not available on this platform.");
+#endif
+}
+
+void test_RTUClient::deadbandFirstRead()
+{
+#ifdef Q_OS_UNIX
+	static constexpr quint16 ADDRESS = 5;	// Slave responds with register address, which lies within the deadband of initial value.
+
+	PseudoterminalSlave slave;
+	QVERIFY(!slave.portName().isEmpty());
+	slave.start();
+
+	RTUClient client;
+	client.setPort(slave.portName());
+	client.setSlaveAddress(PseudoterminalSlave::SLAVE_ADDRESS);
+	client.setRegisterDeadband(10);
+	QSignalSpy startedSpy(& client, & AbstractDevice::started);
+	client.open();
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+
+	HoldingRegister * reg = client.holdingRegisterAt(ADDRESS);
+	QVERIFY(!reg->valid());
+	client.requestData(internal::DataRequest::Read(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS, ADDRESS, 1));
+	QTRY_VERIFY_WITH_TIMEOUT(reg->valid(), 5000);
+	QCOMPARE(reg->value(), ADDRESS);
+
+	client.close();
+#else
+	QSKIP("Pseudoterminals are not available on this platform.");
+#endif
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::test_RTUClient)
+#include "test_RTUClient.moc"
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,155 @@
+#include <cutehmi/modbus/DummyClient.hpp>
+#include <cutehmi/modbus/HoldingRegisterController.hpp>
+
+#include <QtTest/QtTest>
+
+namespace cutehmi {
+namespace modbus {
+
+namespace {
+
+constexpr quint16 ADDRESS = 10;
+
+/**
+ * Write holding register and read it back. Controllers do not react to writes issued by someone else, so they can be
+ * updated only by the subsequent read.
+ * @param device device.
+ * @param value raw register value.
+ * @return @p true if both requests have been completed, @p false otherwise.
+ */
+bool WriteAndRead(AbstractDevice & device, quint16 value)
+{
+	QSignalSpy completedSpy(& device, & AbstractDevice::requestCompleted);
+	device.requestWriteHoldingRegister(ADDRESS, value);
+	if (!completedSpy.wait())
+		return false;
+	device.requestReadHoldingRegisters(ADDRESS, 1);
+	return completedSpy.wait();
+}
+
+}
+
+class test_Register16Controller:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void init();
+
+		void cleanup();
+
+		void deadband();
+
+		void relativeDeadband();
+
+		void minUpdateInterval();
+
+	private:
+		DummyClient * m_client;
+		HoldingRegisterController * m_controller;
+};
+
+void test_Register16Controller::init()
+{
+	m_client = new DummyClient;
+	m_client->setLatency(0);
+	m_client->setConnectLatency(0);
+
+	m_controller = new HoldingRegisterController;
+	m_controller->setAddress(ADDRESS);
+	m_controller->setDevice(m_client);
+
+	QSignalSpy startedSpy(m_client, & AbstractDevice::started);
+	m_client->open();
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+	// Wait for initial read issued by the controller.
+	QTRY_VERIFY(!m_controller->busy());
+	QCOMPARE(m_controller->value(), 0.0);
+}
+
+void test_Register16Controller::cleanup()
+{
+	delete m_controller;
+	delete m_client;
+}
+
+void test_Register16Controller::deadband()
+{
+	m_controller->setDeadband(5.0);
+
+	QVERIFY(WriteAndRead(*m_client, 3));
+	QCOMPARE(m_controller->value(), 0.0);
+
+	QVERIFY(WriteAndRead(*m_client, 10));
+	QCOMPARE(m_controller->value(), 10.0);
+
+	QVERIFY(WriteAndRead(*m_client, 5));
+	QCOMPARE(m_controller->value(), 10.0);
+
+	QVERIFY(WriteAndRead(*m_client, 4));
+	QCOMPARE(m_controller->value(), 4.0);
+}
+
+void test_Register16Controller::relativeDeadband()
+{
+	m_controller->setEncoding(Register16Controller::INT16);
+	m_controller->setRelativeDeadband(50.0);
+
+	QVERIFY(WriteAndRead(*m_client, 100));
+	QCOMPARE(m_controller->value(), 100.0);
+
+	QVERIFY(WriteAndRead(*m_client, 150));
+	QCOMPARE(m_controller->value(), 100.0);
+
+	QVERIFY(WriteAndRead(*m_client, 151));
+	QCOMPARE(m_controller->value(), 151.0);
+
+	// Relative deadband of signed value is computed from its magnitude rather than from raw register word.
+	QVERIFY(WriteAndRead(*m_client, static_cast<quint16>(-10)));
+	QCOMPARE(m_controller->value(), -10.0);
+
+	QVERIFY(WriteAndRead(*m_client, static_cast<quint16>(-14)));
+	QCOMPARE(m_controller->value(), -10.0);
+
+	QVERIFY(WriteAndRead(*m_client, static_cast<quint16>(-16)));
+	QCOMPARE(m_controller->value(), -16.0);
+}
+
+void test_Register16Controller::minUpdateInterval()
+{
+	static constexpr int MIN_UPDATE_INTERVAL = 500;
+
+	m_controller->setMinUpdateInterval(MIN_UPDATE_INTERVAL);
+
+	// Value is delivered either right away or once update timer fires, depending on time elapsed since initial read.
+	QVERIFY(WriteAndRead(*m_client, 1));
+	QTRY_COMPARE_WITH_TIMEOUT(m_controller->value(), 1.0, MIN_UPDATE_INTERVAL * 2);
+
+	// Controller has just been updated, so subsequent values are held back.
+	QSignalSpy valueChangedSpy(m_controller, & Register16Controller::valueChanged);
+	QElapsedTimer timer;
+	timer.start();
+	QVERIFY(WriteAndRead(*m_client, 2));
+	QVERIFY(WriteAndRead(*m_client, 3));
+	QCOMPARE(m_controller->value(), 1.0);
+	QCOMPARE(valueChangedSpy.count(), 0);
+
+	// Update timer releases only the most recent value.
+	QTRY_COMPARE_WITH_TIMEOUT(m_controller->value(), 3.0, MIN_UPDATE_INTERVAL * 2);
+	QCOMPARE(valueChangedSpy.count(), 1);
+	QVERIFY(timer.elapsed() < MIN_UPDATE_INTERVAL * 2);
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::test_Register16Controller)
+#include "test_Register16Controller.moc"
+
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
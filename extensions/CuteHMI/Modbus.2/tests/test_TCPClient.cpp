@@ -0,0 +1,270 @@
+#include <cutehmi/modbus/TCPClient.hpp>
+#include <cutehmi/modbus/internal/NativeTCPClientBackend.hpp>
+
+#include <QtTest/QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <algorithm>
+#include <memory>
+
+namespace cutehmi {
+namespace modbus {
+
+namespace {
+
+/**
+ * Raw Modbus TCP server. Contrary to TCPServer, test functions decide when and in what order responses are sent, so that client
+ * can be fed with replies, which arrive out of order, carry unknown transaction identifiers or are split across multiple
+ * segments. Only read holding registers requests are expected. Registers contain their addresses.
+ */
+class RawServer
+{
+	public:
+		struct Request
+		{
+			quint16 transactionId;
+			quint8 unit;
+			quint16 address;
+			quint16 amount;
+		};
+
+		bool listen()
+		{
+			return m_server.listen(QHostAddress::LocalHost);
+		}
+
+		int port() const
+		{
+			return m_server.serverPort();
+		}
+
+		bool waitForConnection()
+		{
+			if (!m_server.waitForNewConnection(5000))
+				return false;
+			m_socket.reset(m_server.nextPendingConnection());
+			return m_socket != nullptr;
+		}
+
+		/**
+		 * Receive requests.
+		 * @param count amount of requests to receive.
+		 * @return received requests or empty list if requests did not arrive in time.
+		 */
+		QVector<Request> receive(int count)
+		{
+			QVector<Request> result;
+			while (m_buffer.size() < count * REQUEST_SIZE)
+				if (!m_socket->waitForReadyRead(5000))
+					return result;
+				else
+					m_buffer.append(m_socket->readAll());
+
+			for (int i = 0; i < count; i++) {
+				const uchar * adu = reinterpret_cast<const uchar *>(m_buffer.constData()) + i * REQUEST_SIZE;
+				result.append(Request{static_cast<quint16>(adu[0] << 8 | adu[1]), adu[6], static_cast<quint16>(adu[8] << 8 | adu[9]), static_cast<quint16>(adu[10] << 8 | adu[11])});
+			}
+			m_buffer.remove(0, count * REQUEST_SIZE);
+			return result;
+		}
+
+		void send(const QByteArray & data)
+		{
+			m_socket->write(data);
+			m_socket->flush();
+			m_socket->waitForBytesWritten(5000);
+		}
+
+		/**
+		 * Compose response to read holding registers request.
+		 * @param request request.
+		 * @param transactionId transaction identifier to be put into MBAP header.
+		 * @return response frame.
+		 */
+		static QByteArray Response(const Request & request, quint16 transactionId)
+		{
+			QByteArray result;
+			QDataStream stream(& result, QIODevice::WriteOnly);
+			stream << transactionId << quint16(0) << static_cast<quint16>(3 + request.amount * 2) << request.unit;
+			stream << quint8(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS) << static_cast<quint8>(request.amount * 2);
+			for (quint16 i = 0; i < request.amount; i++)
+				stream << static_cast<quint16>(request.address + i);
+			return result;
+		}
+
+		static QByteArray Response(const Request & request)
+		{
+			return Response(request, request.transactionId);
+		}
+
+	private:
+		static constexpr int REQUEST_SIZE = 12;	// MBAP header and read holding registers PDU.
+
+		QTcpServer m_server;
+		std::unique_ptr<QTcpSocket> m_socket;
+		QByteArray m_buffer;
+};
+
+/**
+ * Get address requested by the request, which has been completed.
+ * @param arguments arguments of AbstractDevice::requestCompleted() signal.
+ * @return requested address.
+ */
+int RequestedAddress(const QList<QVariant> & arguments)
+{
+	return arguments.at(0).toJsonObject().value("payload").toObject().value("address").toInt();
+}
+
+}
+
+class test_TCPClient:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void init();
+
+		void cleanup();
+
+		void outOfOrderReplies();
+
+		void unknownTransactionId();
+
+		void splitFrames();
+
+		void responseTimeout();
+
+	private:
+		RawServer * m_server;
+		TCPClient * m_client;
+};
+
+void test_TCPClient::init()
+{
+	m_server = new RawServer;
+	QVERIFY(m_server->listen());
+
+	m_client = new TCPClient;
+	m_client->setHost("127.0.0.1");
+	m_client->setPort(m_server->port());
+	QSignalSpy startedSpy(m_client, & AbstractDevice::started);
+	m_client->open();
+	QVERIFY(m_server->waitForConnection());
+	QVERIFY(startedSpy.count() == 1 || startedSpy.wait());
+}
+
+void test_TCPClient::cleanup()
+{
+	delete m_client;
+	delete m_server;
+}
+
+void test_TCPClient::outOfOrderReplies()
+{
+	QSignalSpy completedSpy(m_client, & AbstractDevice::requestCompleted);
+	m_client->requestReadHoldingRegisters(10, 1);
+	m_client->requestReadHoldingRegisters(20, 2);
+	m_client->requestReadHoldingRegisters(30, 3);
+
+	QVector<RawServer::Request> requests = m_server->receive(3);
+	QCOMPARE(requests.count(), 3);
+	std::reverse(requests.begin(), requests.end());
+	for (auto && request : requests)
+		m_server->send(RawServer::Response(request));
+
+	QTRY_COMPARE(completedSpy.count(), 3);
+	// Each reply must be matched with its request by transaction identifier rather than by the order of arrival.
+	QCOMPARE(RequestedAddress(completedSpy.at(0)), 30);
+	QCOMPARE(RequestedAddress(completedSpy.at(1)), 20);
+	QCOMPARE(RequestedAddress(completedSpy.at(2)), 10);
+	for (auto && arguments : completedSpy) {
+		int address = RequestedAddress(arguments);
+		QJsonObject reply = arguments.at(1).toJsonObject();
+		QVERIFY(reply.value("success").toBool());
+		QJsonArray expected;
+		for (int i = 0; i < address / 10; i++)
+			expected.append(address + i);
+		QCOMPARE(reply.value("values").toArray(), expected);
+	}
+}
+
+void test_TCPClient::unknownTransactionId()
+{
+	QSignalSpy completedSpy(m_client, & AbstractDevice::requestCompleted);
+	QSignalSpy erroredSpy(m_client, & AbstractDevice::errored);
+	m_client->requestReadHoldingRegisters(10, 1);
+
+	QVector<RawServer::Request> requests = m_server->receive(1);
+	QCOMPARE(requests.count(), 1);
+	RawServer::Request unknown = requests.at(0);
+	unknown.address = 100;
+	m_server->send(RawServer::Response(unknown, static_cast<quint16>(requests.at(0).transactionId + 100)));
+	m_server->send(RawServer::Response(requests.at(0)));
+
+	// Response with unknown transaction identifier is discarded without dropping the connection.
+	QVERIFY(completedSpy.wait());
+	QCOMPARE(completedSpy.count(), 1);
+	QJsonObject reply = completedSpy.at(0).at(1).toJsonObject();
+	QVERIFY(reply.value("success").toBool());
+	QCOMPARE(reply.value("values").toArray(), QJsonArray({10}));
+	QCOMPARE(erroredSpy.count(), 0);
+	QCOMPARE(m_client->state(), AbstractDevice::OPENED);
+}
+
+void test_TCPClient::splitFrames()
+{
+	QSignalSpy completedSpy(m_client, & AbstractDevice::requestCompleted);
+	m_client->requestReadHoldingRegisters(10, 2);
+	m_client->requestReadHoldingRegisters(20, 2);
+
+	QVector<RawServer::Request> requests = m_server->receive(2);
+	QCOMPARE(requests.count(), 2);
+	QByteArray first = RawServer::Response(requests.at(0));
+	QByteArray responses = first + RawServer::Response(requests.at(1));
+
+	// Split the first MBAP header, then the first PDU together with a part of the second frame.
+	m_server->send(responses.left(3));
+	QTest::qWait(50);
+	QCOMPARE(completedSpy.count(), 0);
+	m_server->send(responses.mid(3, first.size() + 2 - 3));
+	QTRY_COMPARE(completedSpy.count(), 1);
+	QTest::qWait(50);
+	QCOMPARE(completedSpy.count(), 1);
+	m_server->send(responses.mid(first.size() + 2));
+	QTRY_COMPARE(completedSpy.count(), 2);
+
+	QCOMPARE(completedSpy.at(0).at(1).toJsonObject().value("values").toArray(), QJsonArray({10, 11}));
+	QCOMPARE(completedSpy.at(1).at(1).toJsonObject().value("values").toArray(), QJsonArray({20, 21}));
+}
+
+void test_TCPClient::responseTimeout()
+{
+	static constexpr int TIMEOUT = internal::NativeTCPClientBackend::RESPONSE_TIMEOUT + internal::NativeTCPClientBackend::SWEEP_INTERVAL;
+
+	QSignalSpy completedSpy(m_client, & AbstractDevice::requestCompleted);
+	QElapsedTimer timer;
+	timer.start();
+	m_client->requestReadHoldingRegisters(10, 1);
+	QCOMPARE(m_server->receive(1).count(), 1);
+
+	// Server does not respond, so transaction is expected to be failed by backend long before AbstractDevice::requestTimeout.
+	QTRY_COMPARE_WITH_TIMEOUT(completedSpy.count(), 1, TIMEOUT * 2);
+	QVERIFY(timer.elapsed() >= internal::NativeTCPClientBackend::RESPONSE_TIMEOUT);
+	QVERIFY(!completedSpy.at(0).at(1).toJsonObject().value("success").toBool());
+	QCOMPARE(m_client->state(), AbstractDevice::OPENED);
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::test_TCPClient)
+#include "test_TCPClient.moc"
+
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.
@@ -0,0 +1,237 @@
+#include <cutehmi/modbus/TCPGateway.hpp>
+#include <cutehmi/modbus/TCPGatewayClient.hpp>
+
+#include <QtTest/QtTest>
+#include <QModbusDevice>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <memory>
+
+namespace cutehmi {
+namespace modbus {
+
+namespace {
+
+/**
+ * Raw Modbus TCP server standing in for a TCP to RTU gateway. Test functions receive requests and reply to them one by one, so
+ * that the order in which gateway dispatches transactions of its clients can be observed. Only read holding registers requests
+ * are expected.
+ */
+class RawServer
+{
+	public:
+		struct Request
+		{
+			quint16 transactionId;
+			quint8 unit;
+		};
+
+		bool listen()
+		{
+			return m_server.listen(QHostAddress::LocalHost);
+		}
+
+		int port() const
+		{
+			return m_server.serverPort();
+		}
+
+		bool waitForConnection()
+		{
+			if (!m_server.waitForNewConnection(5000))
+				return false;
+			m_socket.reset(m_server.nextPendingConnection());
+			return m_socket != nullptr;
+		}
+
+		/**
+		 * Receive requests.
+		 * @param count amount of requests to receive.
+		 * @param timeout time [ms] to wait for requests.
+		 * @return received requests or empty list if requests did not arrive in time.
+		 */
+		QVector<Request> receive(int count, int timeout = 5000)
+		{
+			QVector<Request> result;
+			while (m_buffer.size() < count * REQUEST_SIZE)
+				if (!m_socket->waitForReadyRead(timeout))
+					return result;
+				else
+					m_buffer.append(m_socket->readAll());
+
+			for (int i = 0; i < count; i++) {
+				const uchar * adu = reinterpret_cast<const uchar *>(m_buffer.constData()) + i * REQUEST_SIZE;
+				result.append(Request{static_cast<quint16>(adu[0] << 8 | adu[1]), adu[6]});
+			}
+			m_buffer.remove(0, count * REQUEST_SIZE);
+			return result;
+		}
+
+		/**
+		 * Reply to read holding registers request with a single register containing unit identifier.
+		 * @param request request.
+		 */
+		void reply(const Request & request)
+		{
+			QByteArray response;
+			QDataStream stream(& response, QIODevice::WriteOnly);
+			stream << request.transactionId << quint16(0) << quint16(5) << request.unit;
+			stream << quint8(AbstractDevice::FUNCTION_READ_HOLDING_REGISTERS) << quint8(2) << quint16(request.unit);
+			m_socket->write(response);
+			m_socket->flush();
+			m_socket->waitForBytesWritten(5000);
+		}
+
+	private:
+		static constexpr int REQUEST_SIZE = 12;	// MBAP header and read holding registers PDU.
+
+		QTcpServer m_server;
+		std::unique_ptr<QTcpSocket> m_socket;
+		QByteArray m_buffer;
+};
+
+}
+
+class test_TCPGateway:
+	public QObject
+{
+		Q_OBJECT
+
+	private slots:
+		void init();
+
+		void cleanup();
+
+		void roundRobin();
+
+		void detachAbortsQueued();
+
+	private:
+		static constexpr int CLIENTS = 3;
+
+		RawServer * m_server;
+		TCPGateway * m_gateway;
+		TCPGatewayClient * m_clients[CLIENTS];
+};
+
+constexpr int test_TCPGateway::CLIENTS;
+
+void test_TCPGateway::init()
+{
+	m_server = new RawServer;
+	QVERIFY(m_server->listen());
+
+	m_gateway = new TCPGateway;
+	m_gateway->setHost("127.0.0.1");
+	m_gateway->setPort(m_server->port());
+
+	for (int i = 0; i < CLIENTS; i++) {
+		m_clients[i] = new TCPGatewayClient;
+		m_clients[i]->setGateway(m_gateway);
+		m_clients[i]->setSlaveAddress(i + 1);
+	}
+
+	for (int i = 0; i < CLIENTS; i++)
+		m_clients[i]->open();
+	QVERIFY(m_server->waitForConnection());
+	QTRY_COMPARE(m_gateway->state(), AbstractDevice::OPENED);
+	for (int i = 0; i < CLIENTS; i++)
+		QTRY_COMPARE(m_clients[i]->state(), AbstractDevice::OPENED);
+}
+
+void test_TCPGateway::cleanup()
+{
+	for (int i = 0; i < CLIENTS; i++)
+		delete m_clients[i];
+	delete m_gateway;
+	delete m_server;
+}
+
+void test_TCPGateway::roundRobin()
+{
+	static constexpr int MAX_IN_FLIGHT = 2;
+	static constexpr int REQUESTS = 3;	// Requests per client.
+
+	m_gateway->setMaxInFlight(MAX_IN_FLIGHT);
+
+	// Each client queues all of its requests at once, so that a client, which comes first, could starve the others.
+	std::unique_ptr<QSignalSpy> completedSpies[CLIENTS];
+	for (int i = 0; i < CLIENTS; i++) {
+		completedSpies[i].reset(new QSignalSpy(m_clients[i], & AbstractDevice::requestCompleted));
+		for (int request = 0; request < REQUESTS; request++)
+			m_clients[i]->requestReadHoldingRegisters(0, 1);
+	}
+
+	QVector<quint8> units;
+	QVector<RawServer::Request> inFlight = m_server->receive(MAX_IN_FLIGHT);
+	QCOMPARE(inFlight.count(), MAX_IN_FLIGHT);
+	for (auto && request : inFlight)
+		units.append(request.unit);
+	while (!inFlight.isEmpty()) {
+		// Gateway must not exceed maxInFlight, so nothing more should arrive until a reply is sent.
+		QVERIFY(m_server->receive(1, 100).isEmpty());
+
+		m_server->reply(inFlight.takeFirst());
+		if (units.count() < CLIENTS * REQUESTS) {
+			QVector<RawServer::Request> next = m_server->receive(1);
+			QCOMPARE(next.count(), 1);
+			units.append(next.at(0).unit);
+			inFlight.append(next.at(0));
+		}
+	}
+
+	// First client takes both slots before the others submit anything. From then on each client gets a slot in turn, whereas
+	// transactions dispatched in order of submission would go as 1, 1, 1, 2, 2, 2, 3, 3, 3.
+	QCOMPARE(units, QVector<quint8>({1, 1, 2, 3, 1, 2, 3, 2, 3}));
+	for (int i = 0; i < CLIENTS; i++) {
+		QTRY_COMPARE(completedSpies[i]->count(), REQUESTS);
+		for (auto && arguments : *completedSpies[i])
+			QCOMPARE(arguments.at(1).toJsonObject().value("values").toArray(), QJsonArray({i + 1}));
+	}
+}
+
+void test_TCPGateway::detachAbortsQueued()
+{
+	// Default maxInFlight lets only one transaction on the wire, so the request of the second client remains queued.
+	QCOMPARE(m_gateway->maxInFlight(), 1);
+
+	QSignalSpy firstCompletedSpy(m_clients[0], & AbstractDevice::requestCompleted);
+	QSignalSpy secondCompletedSpy(m_clients[1], & AbstractDevice::requestCompleted);
+	m_clients[0]->requestReadHoldingRegisters(0, 1);
+	m_clients[1]->requestReadHoldingRegisters(0, 1);
+	m_clients[1]->requestReadHoldingRegisters(0, 1);
+
+	QVector<RawServer::Request> requests = m_server->receive(1);
+	QCOMPARE(requests.count(), 1);
+	QCOMPARE(requests.at(0).unit, quint8(1));
+
+	// Queued transactions are aborted as soon as client detaches from the gateway.
+	m_clients[1]->close();
+	QCOMPARE(secondCompletedSpy.count(), 2);
+	for (auto && arguments : secondCompletedSpy) {
+		QJsonObject reply = arguments.at(1).toJsonObject();
+		QVERIFY(!reply.value("success").toBool());
+		QCOMPARE(reply.value("errorCode").toInt(), static_cast<int>(QModbusDevice::ReplyAbortedError));
+	}
+
+	// Aborted transactions must not be dispatched once the slot is released; connection remains open for other clients.
+	m_server->reply(requests.at(0));
+	QTRY_COMPARE(firstCompletedSpy.count(), 1);
+	QVERIFY(firstCompletedSpy.at(0).at(1).toJsonObject().value("success").toBool());
+	QVERIFY(m_server->receive(1, 200).isEmpty());
+	QCOMPARE(m_gateway->state(), AbstractDevice::OPENED);
+}
+
+}
+}
+
+QTEST_MAIN(cutehmi::modbus::test_TCPGateway)
+#include "test_TCPGateway.moc"
+
+
+//(c)C: Copyright © 2020, Michał Policht <michal@policht.pl>. All rights reserved.
+//(c)C: This file is a part of CuteHMI.
+//(c)C: CuteHMI is free software: you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+//(c)C: CuteHMI is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+//(c)C: You should have received a copy of the GNU Lesser General Public License along with CuteHMI.  If not, see <https://www.gnu.org/licenses/>.